@@ -304,6 +304,12 @@ void CFlowTomlNode_SaveDocument::ProcessEvent(EFlowEvent evt, SActivationInfo* p
                 case CTomlManager::SaveDocumentError::UnableToCreateFile:
                     ActivateOutput(pActInfo, static_cast<int>(EOutputs::UnableToCreateFile), 0);
                     break;
+                case CTomlManager::SaveDocumentError::PartialDocument:
+                    CryWarning(
+                        VALIDATOR_MODULE_FLOWGRAPH,
+                        VALIDATOR_WARNING,
+                        "The document was opened partially from this file, unable to save document (document %d).", documentId);
+                    break;
                 }
             }
         }
@@ -327,6 +333,9 @@ void CFlowTomlNode_OpenDocument::GetConfiguration(SFlowNodeConfig& config)
         InputPortConfig_Void("Open", _HELP("Opens TOML document from file."), "Open"),
         InputPortConfig<string>("FileName", _HELP("Name of the file without \".toml\" extension for the document."), "File Name"),
         InputPortConfig<string>("DirectoryName", _HELP("Usually your game name. Directory for file (will be appended to the base path)."), "Directory Name"),
+        InputPortConfig<bool>("Lazy", false, _HELP("Parse top-level tables on first access (faster open of large documents when only some tables are used)."), "Lazy"),
+        InputPortConfig<bool>("Parallel", false, _HELP("Parse large documents on multiple threads (ignored if Lazy is set)."), "Parallel"),
+        InputPortConfig<bool>("Frozen", false, _HELP("Open as a read-only frozen document that is memory-mapped from a cache file (ignored if Lazy or Parallel is set)."), "Frozen"),
         { 0 }
     };
     static const SOutputPortConfig out_config[] = {
@@ -360,10 +369,19 @@ void CFlowTomlNode_OpenDocument::ProcessEvent(EFlowEvent evt, SActivationInfo* p
             // Get inputs.
             const auto fileName = GetPortString(pActInfo, static_cast<int>(EInputs::FileName));
             const auto directoryName = GetPortString(pActInfo, static_cast<int>(EInputs::DirectoryName));
+            const auto bLazy = GetPortBool(pActInfo, static_cast<int>(EInputs::Lazy));
+            const auto bParallel = GetPortBool(pActInfo, static_cast<int>(EInputs::Parallel));
+            const auto bFrozen = GetPortBool(pActInfo, static_cast<int>(EInputs::Frozen));
 
             // Open document.
-            const auto result
-                = pPluginInstance->GetTomlManager()->OpenDocument(std::string(fileName), std::string(directoryName));
+            const auto pTomlManager = pPluginInstance->GetTomlManager();
+            const auto result = bLazy
+                ? pTomlManager->OpenDocumentLazy(std::string(fileName), std::string(directoryName))
+                : (bParallel
+                    ? pTomlManager->OpenDocumentParallel(std::string(fileName), std::string(directoryName))
+                    : (bFrozen
+                        ? pTomlManager->OpenFrozenDocument(std::string(fileName), std::string(directoryName))
+                        : pTomlManager->OpenDocument(std::string(fileName), std::string(directoryName))));
 
             if (std::holds_alternative<int>(result))
             {
@@ -588,14 +606,14 @@ void CFlowTomlNode_GetAllDocuments::ProcessEvent(EFlowEvent evt, SActivationInfo
             // Get inputs.
             const auto directoryName = GetPortString(pActInfo, static_cast<int>(EInputs::DirectoryName));
 
-            // Get documents.
+            // Get documents (the listing is cached while the directory is not modified).
             const auto result
-                = pPluginInstance->GetTomlManager()->GetAllDocuments(std::string(directoryName));
+                = pPluginInstance->GetTomlManager()->GetCachedDocumentListing(std::string(directoryName));
 
             // Process results.
-            if (std::holds_alternative<std::vector<std::string>>(result))
+            if (std::holds_alternative<std::shared_ptr<const std::vector<std::string>>>(result))
             {
-                const auto foundDocumentNames = std::get<std::vector<std::string>>(std::move(result));
+                const auto& foundDocumentNames = *std::get<std::shared_ptr<const std::vector<std::string>>>(result);
 
                 // Convert to string and use pipe to separate elements.
                 std::string array;
@@ -709,6 +727,1596 @@ void CFlowTomlNode_RemoveDocument::GetMemoryUsage(ICrySizer* s) const
 }
 
 const char* CFlowTomlNode_RemoveDocument::GetNodeName()
+{
+    return m_nodeName;
+}
+
+void CFlowTomlNode_AppendValue::GetConfiguration(SFlowNodeConfig& config)
+{
+    static const SInputPortConfig in_config[] = {
+        InputPortConfig<int>("DocumentID",  _HELP("Document that contains the array."), "Document ID"),
+        InputPortConfig<string>("SectionName",  _HELP("[Optional] Name of the section of the array."), "Section Name"),
+        InputPortConfig<string>("Key",  _HELP("Name of the key of the array."), "Key"),
+        InputPortConfig_Void("Value",  _HELP("Value to append (will be converted to string)."), "Value"),
+        { 0 }
+    };
+    static const SOutputPortConfig out_config[] = {
+        OutputPortConfig<int>("DocumentID", _HELP("Executed when the value is appended successfully. Unique identifier of the document."), "Document ID"),
+        OutputPortConfig_Void("DocumentNotFound", _HELP("Executed when the specified document ID is incorrect."), "Document Not Found"),
+        OutputPortConfig_Void("ValueTypeMismatch", _HELP("Executed when the value for the specified key/section is not an array."), "Value Type Mismatch"),
+        OutputPortConfig_Void("FailedToConvertValue", _HELP("Executed when failed to convert the specified value to string."), "Failed To Convert Value"),
+        { 0 }
+    };
+    config.sDescription = _HELP("Appends a string value to the end of an array in TOML document (creates the array if it does not exist).");
+    config.pInputPorts = in_config;
+    config.pOutputPorts = out_config;
+    config.SetCategory(EFLN_APPROVED);
+}
+
+void CFlowTomlNode_AppendValue::ProcessEvent(EFlowEvent evt, SActivationInfo* pActInfo)
+{
+    switch (evt)
+    {
+    case eFE_Activate:
+        if (IsPortActive(pActInfo, static_cast<int>(EInputs::DocumentId)))
+        {
+            // Get plugin instance.
+            const auto pPluginInstance = CToml4CryenginePlugin::GetInstance();
+            if (!pPluginInstance)
+            {
+                CryFatalError("Plugin is not initialized.");
+                return;
+            }
+
+            // Get inputs.
+            int documentId = GetPortInt(pActInfo, static_cast<int>(EInputs::DocumentId));
+            const auto sectionName = GetPortString(pActInfo, static_cast<int>(EInputs::SectionName));
+            const auto keyName = GetPortString(pActInfo, static_cast<int>(EInputs::KeyName));
+            const TFlowInputData valueData = GetPortAny(pActInfo, static_cast<int>(EInputs::Value));
+            string value;
+            if (!valueData.GetValueWithConversion(value))
+            {
+                ActivateOutput(pActInfo, static_cast<int>(EOutputs::FailedToConvertValue), 0);
+                return;
+            }
+
+            // Append value.
+            const auto optionalError
+                = pPluginInstance->GetTomlManager()->AppendValue<std::string>(documentId, std::string(keyName), std::string(value), std::string(sectionName));
+
+            if (!optionalError.has_value())
+            {
+                // Trigger output pin.
+                ActivateOutput(pActInfo, static_cast<int>(EOutputs::DocumentId), documentId);
+            }
+            else
+            {
+                switch (optionalError.value())
+                {
+                case CTomlManager::ArrayOperationError::KeyEmpty:
+                    CryWarning(
+                        VALIDATOR_MODULE_FLOWGRAPH,
+                        VALIDATOR_WARNING,
+                        "The specified key name cannot be empty, unable to modify array (document %d).", documentId);
+                    break;
+                case CTomlManager::ArrayOperationError::DocumentNotFound:
+                    ActivateOutput(pActInfo, static_cast<int>(EOutputs::DocumentNotFound), 0);
+                    break;
+                case CTomlManager::ArrayOperationError::ValueTypeMismatch:
+                    ActivateOutput(pActInfo, static_cast<int>(EOutputs::ValueTypeMismatch), 0);
+                    break;
+                }
+            }
+        }
+        break;
+    }
+}
+
+void CFlowTomlNode_AppendValue::GetMemoryUsage(ICrySizer* s) const
+{
+    s->Add(*this);
+}
+
+const char* CFlowTomlNode_AppendValue::GetNodeName()
+{
+    return m_nodeName;
+}
+
+void CFlowTomlNode_InsertAt::GetConfiguration(SFlowNodeConfig& config)
+{
+    static const SInputPortConfig in_config[] = {
+        InputPortConfig<int>("DocumentID",  _HELP("Document that contains the array."), "Document ID"),
+        InputPortConfig<string>("SectionName",  _HELP("[Optional] Name of the section of the array."), "Section Name"),
+        InputPortConfig<string>("Key",  _HELP("Name of the key of the array."), "Key"),
+        InputPortConfig<int>("Index",  _HELP("Index of the element to insert the value before (array size to append)."), "Index"),
+        InputPortConfig_Void("Value",  _HELP("Value to insert (will be converted to string)."), "Value"),
+        { 0 }
+    };
+    static const SOutputPortConfig out_config[] = {
+        OutputPortConfig<int>("DocumentID", _HELP("Executed when the value is inserted successfully. Unique identifier of the document."), "Document ID"),
+        OutputPortConfig_Void("DocumentNotFound", _HELP("Executed when the specified document ID is incorrect."), "Document Not Found"),
+        OutputPortConfig_Void("ValueNotFound", _HELP("Executed when the array for the specified key/section is not found."), "Value Not Found"),
+        OutputPortConfig_Void("ValueTypeMismatch", _HELP("Executed when the value for the specified key/section is not an array."), "Value Type Mismatch"),
+        OutputPortConfig_Void("IndexOutOfRange", _HELP("Executed when the specified index is out of array bounds."), "Index Out Of Range"),
+        OutputPortConfig_Void("FailedToConvertValue", _HELP("Executed when failed to convert the specified value to string."), "Failed To Convert Value"),
+        { 0 }
+    };
+    config.sDescription = _HELP("Inserts a string value into an array in TOML document.");
+    config.pInputPorts = in_config;
+    config.pOutputPorts = out_config;
+    config.SetCategory(EFLN_APPROVED);
+}
+
+void CFlowTomlNode_InsertAt::ProcessEvent(EFlowEvent evt, SActivationInfo* pActInfo)
+{
+    switch (evt)
+    {
+    case eFE_Activate:
+        if (IsPortActive(pActInfo, static_cast<int>(EInputs::DocumentId)))
+        {
+            // Get plugin instance.
+            const auto pPluginInstance = CToml4CryenginePlugin::GetInstance();
+            if (!pPluginInstance)
+            {
+                CryFatalError("Plugin is not initialized.");
+                return;
+            }
+
+            // Get inputs.
+            int documentId = GetPortInt(pActInfo, static_cast<int>(EInputs::DocumentId));
+            const auto sectionName = GetPortString(pActInfo, static_cast<int>(EInputs::SectionName));
+            const auto keyName = GetPortString(pActInfo, static_cast<int>(EInputs::KeyName));
+            const auto index = GetPortInt(pActInfo, static_cast<int>(EInputs::Index));
+            const TFlowInputData valueData = GetPortAny(pActInfo, static_cast<int>(EInputs::Value));
+            string value;
+            if (!valueData.GetValueWithConversion(value))
+            {
+                ActivateOutput(pActInfo, static_cast<int>(EOutputs::FailedToConvertValue), 0);
+                return;
+            }
+
+            // Check index.
+            if (index < 0)
+            {
+                ActivateOutput(pActInfo, static_cast<int>(EOutputs::IndexOutOfRange), 0);
+                return;
+            }
+
+            // Insert value.
+            const auto optionalError
+                = pPluginInstance->GetTomlManager()->InsertAt<std::string>(documentId, std::string(keyName), static_cast<size_t>(index), std::string(value), std::string(sectionName));
+
+            if (!optionalError.has_value())
+            {
+                // Trigger output pin.
+                ActivateOutput(pActInfo, static_cast<int>(EOutputs::DocumentId), documentId);
+            }
+            else
+            {
+                switch (optionalError.value())
+                {
+                case CTomlManager::ArrayOperationError::KeyEmpty:
+                    CryWarning(
+                        VALIDATOR_MODULE_FLOWGRAPH,
+                        VALIDATOR_WARNING,
+                        "The specified key name cannot be empty, unable to modify array (document %d).", documentId);
+                    break;
+                case CTomlManager::ArrayOperationError::DocumentNotFound:
+                    ActivateOutput(pActInfo, static_cast<int>(EOutputs::DocumentNotFound), 0);
+                    break;
+                case CTomlManager::ArrayOperationError::ValueNotFound:
+                    ActivateOutput(pActInfo, static_cast<int>(EOutputs::ValueNotFound), 0);
+                    break;
+                case CTomlManager::ArrayOperationError::ValueTypeMismatch:
+                    ActivateOutput(pActInfo, static_cast<int>(EOutputs::ValueTypeMismatch), 0);
+                    break;
+                case CTomlManager::ArrayOperationError::IndexOutOfRange:
+                    ActivateOutput(pActInfo, static_cast<int>(EOutputs::IndexOutOfRange), 0);
+                    break;
+                }
+            }
+        }
+        break;
+    }
+}
+
+void CFlowTomlNode_InsertAt::GetMemoryUsage(ICrySizer* s) const
+{
+    s->Add(*this);
+}
+
+const char* CFlowTomlNode_InsertAt::GetNodeName()
+{
+    return m_nodeName;
+}
+
+void CFlowTomlNode_SetAt::GetConfiguration(SFlowNodeConfig& config)
+{
+    static const SInputPortConfig in_config[] = {
+        InputPortConfig<int>("DocumentID",  _HELP("Document that contains the array."), "Document ID"),
+        InputPortConfig<string>("SectionName",  _HELP("[Optional] Name of the section of the array."), "Section Name"),
+        InputPortConfig<string>("Key",  _HELP("Name of the key of the array."), "Key"),
+        InputPortConfig<int>("Index",  _HELP("Index of the element to replace."), "Index"),
+        InputPortConfig_Void("Value",  _HELP("Value to set (will be converted to string)."), "Value"),
+        { 0 }
+    };
+    static const SOutputPortConfig out_config[] = {
+        OutputPortConfig<int>("DocumentID", _HELP("Executed when the element is replaced successfully. Unique identifier of the document."), "Document ID"),
+        OutputPortConfig_Void("DocumentNotFound", _HELP("Executed when the specified document ID is incorrect."), "Document Not Found"),
+        OutputPortConfig_Void("ValueNotFound", _HELP("Executed when the array for the specified key/section is not found."), "Value Not Found"),
+        OutputPortConfig_Void("ValueTypeMismatch", _HELP("Executed when the value for the specified key/section is not an array."), "Value Type Mismatch"),
+        OutputPortConfig_Void("IndexOutOfRange", _HELP("Executed when the specified index is out of array bounds."), "Index Out Of Range"),
+        OutputPortConfig_Void("FailedToConvertValue", _HELP("Executed when failed to convert the specified value to string."), "Failed To Convert Value"),
+        { 0 }
+    };
+    config.sDescription = _HELP("Replaces an element of an array in TOML document with a string value.");
+    config.pInputPorts = in_config;
+    config.pOutputPorts = out_config;
+    config.SetCategory(EFLN_APPROVED);
+}
+
+void CFlowTomlNode_SetAt::ProcessEvent(EFlowEvent evt, SActivationInfo* pActInfo)
+{
+    switch (evt)
+    {
+    case eFE_Activate:
+        if (IsPortActive(pActInfo, static_cast<int>(EInputs::DocumentId)))
+        {
+            // Get plugin instance.
+            const auto pPluginInstance = CToml4CryenginePlugin::GetInstance();
+            if (!pPluginInstance)
+            {
+                CryFatalError("Plugin is not initialized.");
+                return;
+            }
+
+            // Get inputs.
+            int documentId = GetPortInt(pActInfo, static_cast<int>(EInputs::DocumentId));
+            const auto sectionName = GetPortString(pActInfo, static_cast<int>(EInputs::SectionName));
+            const auto keyName = GetPortString(pActInfo, static_cast<int>(EInputs::KeyName));
+            const auto index = GetPortInt(pActInfo, static_cast<int>(EInputs::Index));
+            const TFlowInputData valueData = GetPortAny(pActInfo, static_cast<int>(EInputs::Value));
+            string value;
+            if (!valueData.GetValueWithConversion(value))
+            {
+                ActivateOutput(pActInfo, static_cast<int>(EOutputs::FailedToConvertValue), 0);
+                return;
+            }
+
+            // Check index.
+            if (index < 0)
+            {
+                ActivateOutput(pActInfo, static_cast<int>(EOutputs::IndexOutOfRange), 0);
+                return;
+            }
+
+            // Set element.
+            const auto optionalError
+                = pPluginInstance->GetTomlManager()->SetAt<std::string>(documentId, std::string(keyName), static_cast<size_t>(index), std::string(value), std::string(sectionName));
+
+            if (!optionalError.has_value())
+            {
+                // Trigger output pin.
+                ActivateOutput(pActInfo, static_cast<int>(EOutputs::DocumentId), documentId);
+            }
+            else
+            {
+                switch (optionalError.value())
+                {
+                case CTomlManager::ArrayOperationError::KeyEmpty:
+                    CryWarning(
+                        VALIDATOR_MODULE_FLOWGRAPH,
+                        VALIDATOR_WARNING,
+                        "The specified key name cannot be empty, unable to modify array (document %d).", documentId);
+                    break;
+                case CTomlManager::ArrayOperationError::DocumentNotFound:
+                    ActivateOutput(pActInfo, static_cast<int>(EOutputs::DocumentNotFound), 0);
+                    break;
+                case CTomlManager::ArrayOperationError::ValueNotFound:
+                    ActivateOutput(pActInfo, static_cast<int>(EOutputs::ValueNotFound), 0);
+                    break;
+                case CTomlManager::ArrayOperationError::ValueTypeMismatch:
+                    ActivateOutput(pActInfo, static_cast<int>(EOutputs::ValueTypeMismatch), 0);
+                    break;
+                case CTomlManager::ArrayOperationError::IndexOutOfRange:
+                    ActivateOutput(pActInfo, static_cast<int>(EOutputs::IndexOutOfRange), 0);
+                    break;
+                }
+            }
+        }
+        break;
+    }
+}
+
+void CFlowTomlNode_SetAt::GetMemoryUsage(ICrySizer* s) const
+{
+    s->Add(*this);
+}
+
+const char* CFlowTomlNode_SetAt::GetNodeName()
+{
+    return m_nodeName;
+}
+
+void CFlowTomlNode_EraseAt::GetConfiguration(SFlowNodeConfig& config)
+{
+    static const SInputPortConfig in_config[] = {
+        InputPortConfig<int>("DocumentID",  _HELP("Document that contains the array."), "Document ID"),
+        InputPortConfig<string>("SectionName",  _HELP("[Optional] Name of the section of the array."), "Section Name"),
+        InputPortConfig<string>("Key",  _HELP("Name of the key of the array."), "Key"),
+        InputPortConfig<int>("Index",  _HELP("Index of the element to remove."), "Index"),
+        { 0 }
+    };
+    static const SOutputPortConfig out_config[] = {
+        OutputPortConfig<int>("DocumentID", _HELP("Executed when the element is removed successfully. Unique identifier of the document."), "Document ID"),
+        OutputPortConfig_Void("DocumentNotFound", _HELP("Executed when the specified document ID is incorrect."), "Document Not Found"),
+        OutputPortConfig_Void("ValueNotFound", _HELP("Executed when the array for the specified key/section is not found."), "Value Not Found"),
+        OutputPortConfig_Void("ValueTypeMismatch", _HELP("Executed when the value for the specified key/section is not an array."), "Value Type Mismatch"),
+        OutputPortConfig_Void("IndexOutOfRange", _HELP("Executed when the specified index is out of array bounds."), "Index Out Of Range"),
+        { 0 }
+    };
+    config.sDescription = _HELP("Removes an element from an array in TOML document.");
+    config.pInputPorts = in_config;
+    config.pOutputPorts = out_config;
+    config.SetCategory(EFLN_APPROVED);
+}
+
+void CFlowTomlNode_EraseAt::ProcessEvent(EFlowEvent evt, SActivationInfo* pActInfo)
+{
+    switch (evt)
+    {
+    case eFE_Activate:
+        if (IsPortActive(pActInfo, static_cast<int>(EInputs::DocumentId)))
+        {
+            // Get plugin instance.
+            const auto pPluginInstance = CToml4CryenginePlugin::GetInstance();
+            if (!pPluginInstance)
+            {
+                CryFatalError("Plugin is not initialized.");
+                return;
+            }
+
+            // Get inputs.
+            int documentId = GetPortInt(pActInfo, static_cast<int>(EInputs::DocumentId));
+            const auto sectionName = GetPortString(pActInfo, static_cast<int>(EInputs::SectionName));
+            const auto keyName = GetPortString(pActInfo, static_cast<int>(EInputs::KeyName));
+            const auto index = GetPortInt(pActInfo, static_cast<int>(EInputs::Index));
+
+            // Check index.
+            if (index < 0)
+            {
+                ActivateOutput(pActInfo, static_cast<int>(EOutputs::IndexOutOfRange), 0);
+                return;
+            }
+
+            // Remove element.
+            const auto optionalError
+                = pPluginInstance->GetTomlManager()->EraseAt(documentId, std::string(keyName), static_cast<size_t>(index), std::string(sectionName));
+
+            if (!optionalError.has_value())
+            {
+                // Trigger output pin.
+                ActivateOutput(pActInfo, static_cast<int>(EOutputs::DocumentId), documentId);
+            }
+            else
+            {
+                switch (optionalError.value())
+                {
+                case CTomlManager::ArrayOperationError::KeyEmpty:
+                    CryWarning(
+                        VALIDATOR_MODULE_FLOWGRAPH,
+                        VALIDATOR_WARNING,
+                        "The specified key name cannot be empty, unable to modify array (document %d).", documentId);
+                    break;
+                case CTomlManager::ArrayOperationError::DocumentNotFound:
+                    ActivateOutput(pActInfo, static_cast<int>(EOutputs::DocumentNotFound), 0);
+                    break;
+                case CTomlManager::ArrayOperationError::ValueNotFound:
+                    ActivateOutput(pActInfo, static_cast<int>(EOutputs::ValueNotFound), 0);
+                    break;
+                case CTomlManager::ArrayOperationError::ValueTypeMismatch:
+                    ActivateOutput(pActInfo, static_cast<int>(EOutputs::ValueTypeMismatch), 0);
+                    break;
+                case CTomlManager::ArrayOperationError::IndexOutOfRange:
+                    ActivateOutput(pActInfo, static_cast<int>(EOutputs::IndexOutOfRange), 0);
+                    break;
+                }
+            }
+        }
+        break;
+    }
+}
+
+void CFlowTomlNode_EraseAt::GetMemoryUsage(ICrySizer* s) const
+{
+    s->Add(*this);
+}
+
+const char* CFlowTomlNode_EraseAt::GetNodeName()
+{
+    return m_nodeName;
+}
+
+template<typename T>
+void CFlowTomlNode_SetTypedValue<T>::GetConfiguration(SFlowNodeConfig& config)
+{
+    static const SInputPortConfig in_config[] = {
+        InputPortConfig<int>("DocumentID",  _HELP("Document to set new value to."), "Document ID"),
+        InputPortConfig<string>("SectionName",  _HELP("[Optional] Name of the section to set the value to."), "Section Name"),
+        InputPortConfig<string>("Key",  _HELP("Name of the key for the value."), "Key"),
+        InputPortConfig<T>("Value",  _HELP("Value to set."), "Value"),
+        { 0 }
+    };
+    static const SOutputPortConfig out_config[] = {
+        OutputPortConfig<int>("DocumentID", _HELP("Executed when the value is set successfully. Unique identifier of the document."), "Document ID"),
+        OutputPortConfig_Void("DocumentNotFound", _HELP("Executed when the specified document ID is incorrect."), "Document Not Found"),
+        { 0 }
+    };
+    config.sDescription = SFlowTomlTypedValueInfo<T>::setNodeDescription;
+    config.pInputPorts = in_config;
+    config.pOutputPorts = out_config;
+    config.SetCategory(EFLN_APPROVED);
+}
+
+template<typename T>
+void CFlowTomlNode_SetTypedValue<T>::ProcessEvent(EFlowEvent evt, SActivationInfo* pActInfo)
+{
+    switch (evt)
+    {
+    case eFE_Activate:
+        if (IsPortActive(pActInfo, static_cast<int>(EInputs::DocumentId)))
+        {
+            // Get plugin instance.
+            const auto pPluginInstance = CToml4CryenginePlugin::GetInstance();
+            if (!pPluginInstance)
+            {
+                CryFatalError("Plugin is not initialized.");
+                return;
+            }
+
+            // Get inputs.
+            int documentId = GetPortInt(pActInfo, static_cast<int>(EInputs::DocumentId));
+            const auto sectionName = GetPortString(pActInfo, static_cast<int>(EInputs::SectionName));
+            const auto keyName = GetPortString(pActInfo, static_cast<int>(EInputs::KeyName));
+
+            // Get value (using native type, without string conversion).
+            typename SFlowTomlTypedValueInfo<T>::StorageType value;
+            if constexpr (std::is_same_v<T, int>)
+            {
+                value = GetPortInt(pActInfo, static_cast<int>(EInputs::Value));
+            }
+            else if constexpr (std::is_same_v<T, float>)
+            {
+                value = GetPortFloat(pActInfo, static_cast<int>(EInputs::Value));
+            }
+            else if constexpr (std::is_same_v<T, bool>)
+            {
+                value = GetPortBool(pActInfo, static_cast<int>(EInputs::Value));
+            }
+            else if constexpr (std::is_same_v<T, Vec3>)
+            {
+                value = GetPortVec3(pActInfo, static_cast<int>(EInputs::Value));
+            }
+            else if constexpr (std::is_same_v<T, string>)
+            {
+                value = GetPortString(pActInfo, static_cast<int>(EInputs::Value)).c_str();
+            }
+
+            // Set value.
+            const auto optionalError = pPluginInstance->GetTomlManager()->SetValue(
+                documentId, std::string(keyName), std::move(value), std::string(sectionName));
+
+            if (!optionalError.has_value())
+            {
+                // Trigger output pin.
+                ActivateOutput(pActInfo, static_cast<int>(EOutputs::DocumentId), documentId);
+            }
+            else
+            {
+                switch (optionalError.value())
+                {
+                case CTomlManager::SetValueError::KeyEmpty:
+                    CryWarning(
+                        VALIDATOR_MODULE_FLOWGRAPH,
+                        VALIDATOR_WARNING,
+                        "The specified key name cannot be empty, unable to set value (document %d).", documentId);
+                    break;
+                case CTomlManager::SetValueError::DocumentNotFound:
+                    ActivateOutput(pActInfo, static_cast<int>(EOutputs::DocumentNotFound), 0);
+                    break;
+                }
+            }
+        }
+        break;
+    }
+}
+
+template<typename T>
+void CFlowTomlNode_SetTypedValue<T>::GetMemoryUsage(ICrySizer* s) const
+{
+    s->Add(*this);
+}
+
+template<typename T>
+const char* CFlowTomlNode_SetTypedValue<T>::GetNodeName()
+{
+    return SFlowTomlTypedValueInfo<T>::setNodeName;
+}
+
+template<typename T>
+void CFlowTomlNode_GetTypedValue<T>::GetConfiguration(SFlowNodeConfig& config)
+{
+    static const SInputPortConfig in_config[] = {
+        InputPortConfig<int>("DocumentID",  _HELP("Document to get value from."), "Document ID"),
+        InputPortConfig<string>("SectionName",  _HELP("[Optional] Name of the section to get the value from."), "Section Name"),
+        InputPortConfig<string>("Key",  _HELP("Name of the key for the value."), "Key"),
+        { 0 }
+    };
+    static const SOutputPortConfig out_config[] = {
+        OutputPortConfig<T>("Value", _HELP("Executed when the value is read successfully."), "Value"),
+        OutputPortConfig_Void("DocumentNotFound", _HELP("Executed when the specified document ID is incorrect."), "Document Not Found"),
+        OutputPortConfig_Void("ValueNotFound", _HELP("Executed when the value for the specified key/section is not found."), "Value Not Found"),
+        OutputPortConfig_Void("ValueTypeMismatch", _HELP("Executed when the type for the specified key/section value is different."), "Value Type Mismatch"),
+        { 0 }
+    };
+    config.sDescription = SFlowTomlTypedValueInfo<T>::getNodeDescription;
+    config.pInputPorts = in_config;
+    config.pOutputPorts = out_config;
+    config.SetCategory(EFLN_APPROVED);
+}
+
+template<typename T>
+void CFlowTomlNode_GetTypedValue<T>::ProcessEvent(EFlowEvent evt, SActivationInfo* pActInfo)
+{
+    switch (evt)
+    {
+    case eFE_Activate:
+        if (IsPortActive(pActInfo, static_cast<int>(EInputs::DocumentId)))
+        {
+            // Get plugin instance.
+            const auto pPluginInstance = CToml4CryenginePlugin::GetInstance();
+            if (!pPluginInstance)
+            {
+                CryFatalError("Plugin is not initialized.");
+                return;
+            }
+
+            // Get inputs.
+            int documentId = GetPortInt(pActInfo, static_cast<int>(EInputs::DocumentId));
+            const auto sectionName = GetPortString(pActInfo, static_cast<int>(EInputs::SectionName));
+            const auto keyName = GetPortString(pActInfo, static_cast<int>(EInputs::KeyName));
+
+            // Get value.
+            using StorageType = typename SFlowTomlTypedValueInfo<T>::StorageType;
+            const auto result
+                = pPluginInstance->GetTomlManager()->GetValue<StorageType>(documentId, std::string(keyName), std::string(sectionName));
+
+            if (std::holds_alternative<StorageType>(result))
+            {
+                // Trigger output pin.
+                if constexpr (std::is_same_v<T, string>)
+                {
+                    ActivateOutput(pActInfo, static_cast<int>(EOutputs::Value), string(std::get<StorageType>(result).c_str()));
+                }
+                else
+                {
+                    ActivateOutput(pActInfo, static_cast<int>(EOutputs::Value), std::get<StorageType>(result));
+                }
+            }
+            else
+            {
+                const auto err = std::get<CTomlManager::GetValueError>(result);
+                switch (err)
+                {
+                case CTomlManager::GetValueError::KeyEmpty:
+                    CryWarning(
+                        VALIDATOR_MODULE_FLOWGRAPH,
+                        VALIDATOR_WARNING,
+                        "The specified key name cannot be empty, unable to get value (document %d).", documentId);
+                    break;
+                case CTomlManager::GetValueError::DocumentNotFound:
+                    ActivateOutput(pActInfo, static_cast<int>(EOutputs::DocumentNotFound), 0);
+                    break;
+                case CTomlManager::GetValueError::ValueNotFound:
+                    ActivateOutput(pActInfo, static_cast<int>(EOutputs::ValueNotFound), 0);
+                    break;
+                case CTomlManager::GetValueError::ValueTypeMismatch:
+                    ActivateOutput(pActInfo, static_cast<int>(EOutputs::ValueTypeMismatch), 0);
+                    break;
+                }
+            }
+        }
+        break;
+    }
+}
+
+template<typename T>
+void CFlowTomlNode_GetTypedValue<T>::GetMemoryUsage(ICrySizer* s) const
+{
+    s->Add(*this);
+}
+
+template<typename T>
+const char* CFlowTomlNode_GetTypedValue<T>::GetNodeName()
+{
+    return SFlowTomlTypedValueInfo<T>::getNodeName;
+}
+
+template class CFlowTomlNode_SetTypedValue<int>;
+template class CFlowTomlNode_GetTypedValue<int>;
+template class CFlowTomlNode_SetTypedValue<float>;
+template class CFlowTomlNode_GetTypedValue<float>;
+template class CFlowTomlNode_SetTypedValue<bool>;
+template class CFlowTomlNode_GetTypedValue<bool>;
+template class CFlowTomlNode_SetTypedValue<Vec3>;
+template class CFlowTomlNode_GetTypedValue<Vec3>;
+template class CFlowTomlNode_SetTypedValue<string>;
+template class CFlowTomlNode_GetTypedValue<string>;
+
+//! Converts a TOML value to Flow Graph data.
+//! 
+//! \param value Value to convert.
+//! 
+//! \return Empty if the value has a type that has no Flow Graph counterpart, otherwise converted value.
+static std::optional<TFlowInputData> ConvertTomlValueToFlowData(const toml::value& value)
+{
+    switch (value.type())
+    {
+    case toml::value_t::integer:
+        return TFlowInputData(static_cast<int>(value.as_integer(std::nothrow)));
+    case toml::value_t::floating:
+        return TFlowInputData(static_cast<float>(value.as_floating(std::nothrow)));
+    case toml::value_t::boolean:
+        return TFlowInputData(value.as_boolean(std::nothrow));
+    case toml::value_t::string:
+        return TFlowInputData(string(value.as_string(std::nothrow).str.c_str()));
+    case toml::value_t::array:
+        try
+        {
+            return TFlowInputData(toml::get<Vec3>(value));
+        }
+        catch (toml::type_error&)
+        {
+            return {};
+        }
+    default:
+        return {};
+    }
+}
+
+IFlowNodePtr CFlowTomlNode_GetBoundValue::Clone(SActivationInfo* pActInfo)
+{
+    return new CFlowTomlNode_GetBoundValue(pActInfo);
+}
+
+void CFlowTomlNode_GetBoundValue::GetConfiguration(SFlowNodeConfig& config)
+{
+    static const SInputPortConfig in_config[] = {
+        InputPortConfig<int>("DocumentID",  _HELP("Document to bind to, binds the node and reads the value."), "Document ID"),
+        InputPortConfig<string>("SectionName",  _HELP("[Optional] Name of the section of the value."), "Section Name"),
+        InputPortConfig<string>("Key",  _HELP("Name of the key of the value."), "Key"),
+        InputPortConfig_Void("Get",  _HELP("Reads the bound value (served from cache if the document was not modified since the last read)."), "Get"),
+        { 0 }
+    };
+    static const SOutputPortConfig out_config[] = {
+        OutputPortConfig_AnyType("Value", _HELP("Executed when the value is read successfully (integer, float, bool, string or Vec3)."), "Value"),
+        OutputPortConfig_Void("DocumentNotFound", _HELP("Executed when the bound document ID is incorrect."), "Document Not Found"),
+        OutputPortConfig_Void("ValueNotFound", _HELP("Executed when the value for the bound key/section is not found."), "Value Not Found"),
+        OutputPortConfig_Void("ValueTypeMismatch", _HELP("Executed when the bound value is a table, a date or an array that is not Vec3."), "Value Type Mismatch"),
+        { 0 }
+    };
+    config.sDescription = _HELP("Binds to a value of TOML document and caches it, use for values that are read often (for example every frame).");
+    config.pInputPorts = in_config;
+    config.pOutputPorts = out_config;
+    config.SetCategory(EFLN_APPROVED);
+}
+
+void CFlowTomlNode_GetBoundValue::ProcessEvent(EFlowEvent evt, SActivationInfo* pActInfo)
+{
+    switch (evt)
+    {
+    case eFE_Initialize:
+        m_documentId = -1;
+        m_cachedRevision.reset();
+        break;
+    case eFE_Activate:
+        if (IsPortActive(pActInfo, static_cast<int>(EInputs::DocumentId)))
+        {
+            Bind(pActInfo);
+            Read(pActInfo);
+        }
+        else if (IsPortActive(pActInfo, static_cast<int>(EInputs::Get)))
+        {
+            if (m_documentId < 0)
+            {
+                // Bind on first activation.
+                Bind(pActInfo);
+            }
+            Read(pActInfo);
+        }
+        break;
+    }
+}
+
+void CFlowTomlNode_GetBoundValue::Bind(SActivationInfo* pActInfo)
+{
+    m_documentId = GetPortInt(pActInfo, static_cast<int>(EInputs::DocumentId));
+    m_sectionName = GetPortString(pActInfo, static_cast<int>(EInputs::SectionName)).c_str();
+    m_keyName = GetPortString(pActInfo, static_cast<int>(EInputs::KeyName)).c_str();
+    m_cachedRevision.reset();
+}
+
+void CFlowTomlNode_GetBoundValue::Read(SActivationInfo* pActInfo)
+{
+    // Get plugin instance.
+    const auto pPluginInstance = CToml4CryenginePlugin::GetInstance();
+    if (!pPluginInstance)
+    {
+        CryFatalError("Plugin is not initialized.");
+        return;
+    }
+    const auto pTomlManager = pPluginInstance->GetTomlManager();
+
+    // Check if the cached value is still up to date.
+    const auto optionalRevision = pTomlManager->GetDocumentRevision(m_documentId);
+    if (!optionalRevision.has_value())
+    {
+        m_cachedRevision.reset();
+        ActivateOutput(pActInfo, static_cast<int>(EOutputs::DocumentNotFound), 0);
+        return;
+    }
+    if (m_cachedRevision == optionalRevision)
+    {
+        ActivateOutput(pActInfo, static_cast<int>(EOutputs::Value), m_cachedValue);
+        return;
+    }
+
+    // Read value.
+    const auto result = pTomlManager->GetValue<toml::value>(m_documentId, m_keyName, m_sectionName);
+    if (std::holds_alternative<CTomlManager::GetValueError>(result))
+    {
+        switch (std::get<CTomlManager::GetValueError>(result))
+        {
+        case CTomlManager::GetValueError::KeyEmpty:
+            CryWarning(
+                VALIDATOR_MODULE_FLOWGRAPH,
+                VALIDATOR_WARNING,
+                "The specified key name cannot be empty, unable to get value (document %d).", m_documentId);
+            break;
+        case CTomlManager::GetValueError::DocumentNotFound:
+            ActivateOutput(pActInfo, static_cast<int>(EOutputs::DocumentNotFound), 0);
+            break;
+        case CTomlManager::GetValueError::ValueNotFound:
+            ActivateOutput(pActInfo, static_cast<int>(EOutputs::ValueNotFound), 0);
+            break;
+        case CTomlManager::GetValueError::ValueTypeMismatch:
+            ActivateOutput(pActInfo, static_cast<int>(EOutputs::ValueTypeMismatch), 0);
+            break;
+        }
+        return;
+    }
+
+    // Convert value.
+    auto optionalValue = ConvertTomlValueToFlowData(std::get<toml::value>(result));
+    if (!optionalValue.has_value())
+    {
+        ActivateOutput(pActInfo, static_cast<int>(EOutputs::ValueTypeMismatch), 0);
+        return;
+    }
+
+    // Cache value.
+    m_cachedValue = std::move(optionalValue.value());
+    m_cachedRevision = optionalRevision;
+
+    // Trigger output pin.
+    ActivateOutput(pActInfo, static_cast<int>(EOutputs::Value), m_cachedValue);
+}
+
+void CFlowTomlNode_GetBoundValue::GetMemoryUsage(ICrySizer* s) const
+{
+    s->Add(*this);
+}
+
+const char* CFlowTomlNode_GetBoundValue::GetNodeName()
+{
+    return m_nodeName;
+}
+
+CFlowTomlNode_OnValueChanged::~CFlowTomlNode_OnValueChanged()
+{
+    Unsubscribe(nullptr);
+}
+
+IFlowNodePtr CFlowTomlNode_OnValueChanged::Clone(SActivationInfo* pActInfo)
+{
+    return new CFlowTomlNode_OnValueChanged(pActInfo);
+}
+
+void CFlowTomlNode_OnValueChanged::GetConfiguration(SFlowNodeConfig& config)
+{
+    static const SInputPortConfig in_config[] = {
+        InputPortConfig<int>("DocumentID",  _HELP("Document to observe, starts observing the value."), "Document ID"),
+        InputPortConfig<string>("SectionName",  _HELP("[Optional] Name of the section of the value."), "Section Name"),
+        InputPortConfig<string>("Key",  _HELP("Name of the key of the value."), "Key"),
+        InputPortConfig_Void("Stop",  _HELP("Stops observing the value."), "Stop"),
+        { 0 }
+    };
+    static const SOutputPortConfig out_config[] = {
+        OutputPortConfig_Void("Changed", _HELP("Executed when the observed value was modified (at most once per frame)."), "Changed"),
+        OutputPortConfig_Void("DocumentNotFound", _HELP("Executed when the specified document ID is incorrect."), "Document Not Found"),
+        { 0 }
+    };
+    config.sDescription = _HELP("Fires when a value of TOML document is modified. Observing stops when the document is closed.");
+    config.pInputPorts = in_config;
+    config.pOutputPorts = out_config;
+    config.SetCategory(EFLN_APPROVED);
+}
+
+void CFlowTomlNode_OnValueChanged::ProcessEvent(EFlowEvent evt, SActivationInfo* pActInfo)
+{
+    switch (evt)
+    {
+    case eFE_Initialize:
+        Unsubscribe(pActInfo);
+        break;
+    case eFE_Activate:
+        if (IsPortActive(pActInfo, static_cast<int>(EInputs::Stop)))
+        {
+            Unsubscribe(pActInfo);
+        }
+        else if (IsPortActive(pActInfo, static_cast<int>(EInputs::DocumentId)))
+        {
+            // Get plugin instance.
+            const auto pPluginInstance = CToml4CryenginePlugin::GetInstance();
+            if (!pPluginInstance)
+            {
+                CryFatalError("Plugin is not initialized.");
+                return;
+            }
+
+            // Remove previous subscription.
+            Unsubscribe(pActInfo);
+
+            // Get inputs.
+            int documentId = GetPortInt(pActInfo, static_cast<int>(EInputs::DocumentId));
+            const auto sectionName = GetPortString(pActInfo, static_cast<int>(EInputs::SectionName));
+            const auto keyName = GetPortString(pActInfo, static_cast<int>(EInputs::KeyName));
+
+            // Subscribe.
+            const auto result = pPluginInstance->GetTomlManager()->Subscribe(
+                documentId, std::string(keyName), std::string(sectionName),
+                [this](int, const std::string&, const std::string&) { m_bValueChanged = true; });
+
+            if (std::holds_alternative<size_t>(result))
+            {
+                m_documentId = documentId;
+                m_subscriptionId = std::get<size_t>(result);
+                pActInfo->pGraph->SetRegularlyUpdated(pActInfo->myID, true);
+            }
+            else
+            {
+                switch (std::get<CTomlManager::SubscribeError>(result))
+                {
+                case CTomlManager::SubscribeError::KeyEmpty:
+                    CryWarning(
+                        VALIDATOR_MODULE_FLOWGRAPH,
+                        VALIDATOR_WARNING,
+                        "The specified key name cannot be empty, unable to observe value (document %d).", documentId);
+                    break;
+                case CTomlManager::SubscribeError::DocumentNotFound:
+                    ActivateOutput(pActInfo, static_cast<int>(EOutputs::DocumentNotFound), 0);
+                    break;
+                }
+            }
+        }
+        break;
+    case eFE_Update:
+        if (m_bValueChanged.exchange(false))
+        {
+            ActivateOutput(pActInfo, static_cast<int>(EOutputs::Changed), 0);
+        }
+        break;
+    }
+}
+
+void CFlowTomlNode_OnValueChanged::Unsubscribe(SActivationInfo* pActInfo)
+{
+    if (m_subscriptionId.has_value())
+    {
+        const auto pPluginInstance = CToml4CryenginePlugin::GetInstance();
+        if (pPluginInstance)
+        {
+            pPluginInstance->GetTomlManager()->Unsubscribe(m_documentId, m_subscriptionId.value());
+        }
+        m_subscriptionId.reset();
+    }
+
+    m_bValueChanged = false;
+
+    if (pActInfo != nullptr)
+    {
+        pActInfo->pGraph->SetRegularlyUpdated(pActInfo->myID, false);
+    }
+}
+
+void CFlowTomlNode_OnValueChanged::GetMemoryUsage(ICrySizer* s) const
+{
+    s->Add(*this);
+}
+
+const char* CFlowTomlNode_OnValueChanged::GetNodeName()
+{
+    return m_nodeName;
+}
+
+IFlowNodePtr CFlowTomlNode_ForEachDocument::Clone(SActivationInfo* pActInfo)
+{
+    return new CFlowTomlNode_ForEachDocument(pActInfo);
+}
+
+void CFlowTomlNode_ForEachDocument::GetConfiguration(SFlowNodeConfig& config)
+{
+    static const SInputPortConfig in_config[] = {
+        InputPortConfig<string>("DirectoryName",  _HELP("Usually your game name. Directory for documents (will be appended to the base path)."), "Directory Name"),
+        InputPortConfig<int>("Offset", 0, _HELP("Index of the first document name to output (names are sorted)."), "Offset"),
+        InputPortConfig<int>("Count", 0, _HELP("Maximum number of document names to output (0 to output all)."), "Count"),
+        InputPortConfig<bool>("Refresh", false, _HELP("Scan the directory even if it looks unchanged since the last scan."), "Refresh"),
+        InputPortConfig_Void("ForEach",  _HELP("Starts iteration and outputs the first document name."), "For Each"),
+        InputPortConfig_Void("Next",  _HELP("Outputs the next document name."), "Next"),
+        { 0 }
+    };
+    static const SOutputPortConfig out_config[] = {
+        OutputPortConfig<string>("DocumentName", _HELP("Name of the document file (without extension)."), "Document Name"),
+        OutputPortConfig<int>("Index", _HELP("Index of the outputted document name in the sorted listing."), "Index"),
+        OutputPortConfig<int>("Done", _HELP("Executed when there are no more names to output. Total number of documents in the directory."), "Done"),
+        OutputPortConfig_Void("FailedToGetBasePath", _HELP("Executed when failed to get base path for storing your documents (see logs for details)."), "Failed To Get Base Path"),
+        { 0 }
+    };
+    config.sDescription = _HELP("Iterates over names of documents (without extensions, excluding backup files) in the specified directory, one name per activation. The directory listing is cached.");
+    config.pInputPorts = in_config;
+    config.pOutputPorts = out_config;
+    config.SetCategory(EFLN_APPROVED);
+}
+
+void CFlowTomlNode_ForEachDocument::ProcessEvent(EFlowEvent evt, SActivationInfo* pActInfo)
+{
+    switch (evt)
+    {
+    case eFE_Initialize:
+        m_pDocumentNames = nullptr;
+        m_nextIndex = 0;
+        m_endIndex = 0;
+        break;
+    case eFE_Activate:
+        if (IsPortActive(pActInfo, static_cast<int>(EInputs::ForEach)))
+        {
+            // Get plugin instance.
+            const auto pPluginInstance = CToml4CryenginePlugin::GetInstance();
+            if (!pPluginInstance)
+            {
+                CryFatalError("Plugin is not initialized.");
+                return;
+            }
+
+            // Get inputs.
+            const auto directoryName = GetPortString(pActInfo, static_cast<int>(EInputs::DirectoryName));
+            const auto offset = static_cast<size_t>(std::max(GetPortInt(pActInfo, static_cast<int>(EInputs::Offset)), 0));
+            const auto count = static_cast<size_t>(std::max(GetPortInt(pActInfo, static_cast<int>(EInputs::Count)), 0));
+            const auto bRefresh = GetPortBool(pActInfo, static_cast<int>(EInputs::Refresh));
+
+            // Get documents.
+            const auto result
+                = pPluginInstance->GetTomlManager()->GetCachedDocumentListing(std::string(directoryName), bRefresh);
+
+            if (std::holds_alternative<CTomlManager::GetAllDocumentsError>(result))
+            {
+                m_pDocumentNames = nullptr;
+
+                const auto error = std::get<CTomlManager::GetAllDocumentsError>(result);
+                switch (error)
+                {
+                case CTomlManager::GetAllDocumentsError::DirectoryNameEmpty:
+                    CryWarning(
+                        VALIDATOR_MODULE_FLOWGRAPH,
+                        VALIDATOR_WARNING,
+                        "The specified directory name cannot be empty, unable to get document names.");
+                    return;
+                case CTomlManager::GetAllDocumentsError::FailedToGetBasePath:
+                    ActivateOutput(pActInfo, static_cast<int>(EOutputs::FailedToGetBasePath), 0);
+                    break;
+                }
+                return;
+            }
+
+            // Start iteration.
+            m_pDocumentNames = std::get<std::shared_ptr<const std::vector<std::string>>>(result);
+            const auto size = m_pDocumentNames->size();
+            m_nextIndex = std::min(offset, size);
+            m_endIndex = count == 0 ? size : std::min(m_nextIndex + count, size);
+
+            OutputNext(pActInfo);
+        }
+        else if (IsPortActive(pActInfo, static_cast<int>(EInputs::Next)))
+        {
+            OutputNext(pActInfo);
+        }
+        break;
+    }
+}
+
+void CFlowTomlNode_ForEachDocument::OutputNext(SActivationInfo* pActInfo)
+{
+    if (m_pDocumentNames == nullptr)
+    {
+        // Iteration was not started.
+        return;
+    }
+
+    if (m_nextIndex >= m_endIndex)
+    {
+        ActivateOutput(pActInfo, static_cast<int>(EOutputs::Done), static_cast<int>(m_pDocumentNames->size()));
+        m_pDocumentNames = nullptr;
+        return;
+    }
+
+    const auto index = m_nextIndex;
+    m_nextIndex += 1;
+
+    ActivateOutput(pActInfo, static_cast<int>(EOutputs::Index), static_cast<int>(index));
+    ActivateOutput(pActInfo, static_cast<int>(EOutputs::DocumentName), string(m_pDocumentNames->operator[](index).c_str()));
+}
+
+void CFlowTomlNode_ForEachDocument::GetMemoryUsage(ICrySizer* s) const
+{
+    s->Add(*this);
+}
+
+const char* CFlowTomlNode_ForEachDocument::GetNodeName()
+{
+    return m_nodeName;
+}
+
+void CFlowTomlNode_OpenDocumentsMetadata::GetConfiguration(SFlowNodeConfig& config)
+{
+    static const SInputPortConfig in_config[] = {
+        InputPortConfig_Void("Open", _HELP("Opens metadata of all documents of the directory as a new document."), "Open"),
+        InputPortConfig<string>("DirectoryName", _HELP("Usually your game name. Directory for documents (will be appended to the base path)."), "Directory Name"),
+        { 0 }
+    };
+    static const SOutputPortConfig out_config[] = {
+        OutputPortConfig<int>("DocumentId", _HELP("Executed if successfully opened metadata. Document that has a section per document name."), "Document Id"),
+        OutputPortConfig_Void("FailedToGetBasePath", _HELP("Executed when failed to get base path (see logs for details)."), "Failed To Get Base Path"),
+        { 0 }
+    };
+    config.sDescription = _HELP("Opens \"metadata\" sections of all documents of the directory as a new document (remember to call CloseDocument later), use GetValue with a document name as section name to read them. Uses the metadata index updated by SaveDocument so documents are not opened.");
+    config.pInputPorts = in_config;
+    config.pOutputPorts = out_config;
+    config.SetCategory(EFLN_APPROVED);
+}
+
+void CFlowTomlNode_OpenDocumentsMetadata::ProcessEvent(EFlowEvent evt, SActivationInfo* pActInfo)
+{
+    switch (evt)
+    {
+    case eFE_Activate:
+        if (IsPortActive(pActInfo, static_cast<int>(EInputs::Open)))
+        {
+            // Get plugin instance.
+            const auto pPluginInstance = CToml4CryenginePlugin::GetInstance();
+            if (!pPluginInstance)
+            {
+                CryFatalError("Plugin is not initialized.");
+                return;
+            }
+
+            // Get inputs.
+            const auto directoryName = GetPortString(pActInfo, static_cast<int>(EInputs::DirectoryName));
+
+            // Open metadata.
+            const auto result
+                = pPluginInstance->GetTomlManager()->OpenDocumentsMetadata(std::string(directoryName));
+
+            if (std::holds_alternative<int>(result))
+            {
+                // Trigger output pin.
+                ActivateOutput(pActInfo, static_cast<int>(EOutputs::DocumentId), std::get<int>(result));
+            }
+            else
+            {
+                const auto error = std::get<CTomlManager::OpenDocumentError>(result);
+                switch (error)
+                {
+                case CTomlManager::OpenDocumentError::DirectoryNameEmpty:
+                    CryWarning(
+                        VALIDATOR_MODULE_FLOWGRAPH,
+                        VALIDATOR_WARNING,
+                        "The specified directory name cannot be empty, unable to open documents metadata.");
+                    break;
+                case CTomlManager::OpenDocumentError::FailedToGetBasePath:
+                    ActivateOutput(pActInfo, static_cast<int>(EOutputs::FailedToGetBasePath), 0);
+                    break;
+                default:
+                    break;
+                }
+            }
+        }
+        break;
+    }
+}
+
+void CFlowTomlNode_OpenDocumentsMetadata::GetMemoryUsage(ICrySizer* s) const
+{
+    s->Add(*this);
+}
+
+const char* CFlowTomlNode_OpenDocumentsMetadata::GetNodeName()
+{
+    return m_nodeName;
+}
+
+void CFlowTomlNode_CloneDocument::GetConfiguration(SFlowNodeConfig& config)
+{
+    static const SInputPortConfig in_config[] = {
+        InputPortConfig_Void("Clone", _HELP("Create a copy of the document."), "Clone"),
+        InputPortConfig<int>("DocumentId", _HELP("Document to copy."), "Document ID"),
+        { 0 }
+    };
+    static const SOutputPortConfig out_config[] = {
+        OutputPortConfig<int>("DocumentId", _HELP("Executed if successfully created the copy, contains ID of the copy."), "Document Id"),
+        OutputPortConfig_Void("DocumentNotFound", _HELP("Executed when the specified document ID is incorrect."), "Document Not Found"),
+        { 0 }
+    };
+    config.sDescription = _HELP("Creates a copy of the document (remember to call CloseDocument later), values are copied only when modified in one of the documents.");
+    config.pInputPorts = in_config;
+    config.pOutputPorts = out_config;
+    config.SetCategory(EFLN_APPROVED);
+}
+
+void CFlowTomlNode_CloneDocument::ProcessEvent(EFlowEvent evt, SActivationInfo* pActInfo)
+{
+    switch (evt)
+    {
+    case eFE_Activate:
+        if (IsPortActive(pActInfo, static_cast<int>(EInputs::Clone)))
+        {
+            // Get plugin instance.
+            const auto pPluginInstance = CToml4CryenginePlugin::GetInstance();
+            if (!pPluginInstance)
+            {
+                CryFatalError("Plugin is not initialized.");
+                return;
+            }
+
+            // Get inputs.
+            const auto documentId = GetPortInt(pActInfo, static_cast<int>(EInputs::DocumentId));
+
+            // Clone document.
+            const auto optionalCloneId = pPluginInstance->GetTomlManager()->CloneDocument(documentId);
+
+            if (optionalCloneId.has_value())
+            {
+                ActivateOutput(pActInfo, static_cast<int>(EOutputs::DocumentId), optionalCloneId.value());
+            }
+            else
+            {
+                ActivateOutput(pActInfo, static_cast<int>(EOutputs::DocumentNotFound), 0);
+            }
+        }
+        break;
+    }
+}
+
+void CFlowTomlNode_CloneDocument::GetMemoryUsage(ICrySizer* s) const
+{
+    s->Add(*this);
+}
+
+const char* CFlowTomlNode_CloneDocument::GetNodeName()
+{
+    return m_nodeName;
+}
+
+void CFlowTomlNode_CreateLayeredDocument::GetConfiguration(SFlowNodeConfig& config)
+{
+    static const SInputPortConfig in_config[] = {
+        InputPortConfig_Void("Create", _HELP("Create a layered document."), "Create"),
+        InputPortConfig<int>("BottomDocumentId", -1, _HELP("Bottom layer (for example defaults), -1 to skip."), "Bottom Document ID"),
+        InputPortConfig<int>("MiddleDocumentId", -1, _HELP("Middle layer (for example user settings), -1 to skip."), "Middle Document ID"),
+        InputPortConfig<int>("TopDocumentId", -1, _HELP("Top layer (for example mod overrides), receives written values, -1 to skip."), "Top Document ID"),
+        { 0 }
+    };
+    static const SOutputPortConfig out_config[] = {
+        OutputPortConfig<int>("DocumentId", _HELP("Executed if successfully created the layered document, contains its ID."), "Document Id"),
+        OutputPortConfig_Void("InvalidLayers", _HELP("Executed when no layers were specified or one of the document IDs is incorrect."), "Invalid Layers"),
+        { 0 }
+    };
+    config.sDescription = _HELP("Creates a document that reads values from the top-most layer that has them (remember to call CloseDocument later), values are written to the top layer and saving the document saves only the top layer.");
+    config.pInputPorts = in_config;
+    config.pOutputPorts = out_config;
+    config.SetCategory(EFLN_APPROVED);
+}
+
+void CFlowTomlNode_CreateLayeredDocument::ProcessEvent(EFlowEvent evt, SActivationInfo* pActInfo)
+{
+    switch (evt)
+    {
+    case eFE_Activate:
+        if (IsPortActive(pActInfo, static_cast<int>(EInputs::Create)))
+        {
+            // Get plugin instance.
+            const auto pPluginInstance = CToml4CryenginePlugin::GetInstance();
+            if (!pPluginInstance)
+            {
+                CryFatalError("Plugin is not initialized.");
+                return;
+            }
+
+            // Get inputs (bottom layer first).
+            std::vector<int> layerDocumentIds;
+            for (const auto input : { EInputs::BottomDocumentId, EInputs::MiddleDocumentId, EInputs::TopDocumentId })
+            {
+                const auto documentId = GetPortInt(pActInfo, static_cast<int>(input));
+                if (documentId >= 0)
+                {
+                    layerDocumentIds.push_back(documentId);
+                }
+            }
+
+            // Create layered document.
+            const auto optionalDocumentId = pPluginInstance->GetTomlManager()->CreateLayeredDocument(layerDocumentIds);
+
+            if (optionalDocumentId.has_value())
+            {
+                ActivateOutput(pActInfo, static_cast<int>(EOutputs::DocumentId), optionalDocumentId.value());
+            }
+            else
+            {
+                ActivateOutput(pActInfo, static_cast<int>(EOutputs::InvalidLayers), 0);
+            }
+        }
+        break;
+    }
+}
+
+void CFlowTomlNode_CreateLayeredDocument::GetMemoryUsage(ICrySizer* s) const
+{
+    s->Add(*this);
+}
+
+const char* CFlowTomlNode_CreateLayeredDocument::GetNodeName()
+{
+    return m_nodeName;
+}
+
+void CFlowTomlNode_EnableSaveJournal::GetConfiguration(SFlowNodeConfig& config)
+{
+    static const SInputPortConfig in_config[] = {
+        InputPortConfig_Void("Enable", _HELP("Start journaling the document."), "Enable"),
+        InputPortConfig<int>("DocumentID", _HELP("Document to persist."), "Document ID"),
+        InputPortConfig<string>("FileName", _HELP("Name of the file without \".toml\" extension for the document."), "File Name"),
+        InputPortConfig<string>("DirectoryName", _HELP("Usually your game name. Directory for file (will be appended to the base path)."), "Directory Name"),
+        { 0 }
+    };
+    static const SOutputPortConfig out_config[] = {
+        OutputPortConfig_Void("Done", _HELP("Executed if successfully finished the operation."), "Done"),
+        OutputPortConfig_Void("DocumentNotFound", _HELP("Executed when the specified document ID is incorrect."), "Document Not Found"),
+        OutputPortConfig_Void("FailedToGetBasePath", _HELP("Executed when failed to get base path (see logs for details)."), "Failed To Get Base Path"),
+        OutputPortConfig_Void("JournalInUse", _HELP("Executed when another document already journals the same file."), "Journal In Use"),
+        OutputPortConfig_Void("UnableToCreateFile", _HELP("Executed when failed to create/open the file or its journal."), "Unable To Create File"),
+        { 0 }
+    };
+    config.sDescription = _HELP("Saves TOML document to file once, then every change of the document is appended to a journal file instead of rewriting the whole file (the document stays open, CloseDocument writes the whole file). Journaled changes are applied when the file is opened after a crash.");
+    config.pInputPorts = in_config;
+    config.pOutputPorts = out_config;
+    config.SetCategory(EFLN_APPROVED);
+}
+
+void CFlowTomlNode_EnableSaveJournal::ProcessEvent(EFlowEvent evt, SActivationInfo* pActInfo)
+{
+    switch (evt)
+    {
+    case eFE_Activate:
+        if (IsPortActive(pActInfo, static_cast<int>(EInputs::Enable)))
+        {
+            // Get plugin instance.
+            const auto pPluginInstance = CToml4CryenginePlugin::GetInstance();
+            if (!pPluginInstance)
+            {
+                CryFatalError("Plugin is not initialized.");
+                return;
+            }
+
+            // Get inputs.
+            const auto documentId = GetPortInt(pActInfo, static_cast<int>(EInputs::DocumentId));
+            const auto fileName = GetPortString(pActInfo, static_cast<int>(EInputs::FileName));
+            const auto directoryName = GetPortString(pActInfo, static_cast<int>(EInputs::DirectoryName));
+
+            // Enable journal.
+            const auto optionalError
+                = pPluginInstance->GetTomlManager()->EnableSaveJournal(documentId, std::string(fileName), std::string(directoryName));
+
+            if (!optionalError.has_value())
+            {
+                // Trigger output pin.
+                ActivateOutput(pActInfo, static_cast<int>(EOutputs::Done), 0);
+            }
+            else
+            {
+                switch (optionalError.value())
+                {
+                case CTomlManager::SaveJournalError::FileNameEmpty:
+                    CryWarning(
+                        VALIDATOR_MODULE_FLOWGRAPH,
+                        VALIDATOR_WARNING,
+                        "The specified file name cannot be empty, unable to enable save journal (document %d).", documentId);
+                    break;
+                case CTomlManager::SaveJournalError::DirectoryNameEmpty:
+                    CryWarning(
+                        VALIDATOR_MODULE_FLOWGRAPH,
+                        VALIDATOR_WARNING,
+                        "The specified directory name cannot be empty, unable to enable save journal (document %d).", documentId);
+                    break;
+                case CTomlManager::SaveJournalError::DocumentNotFound:
+                case CTomlManager::SaveJournalError::JournalNotEnabled:
+                    ActivateOutput(pActInfo, static_cast<int>(EOutputs::DocumentNotFound), 0);
+                    break;
+                case CTomlManager::SaveJournalError::FailedToGetBasePath:
+                    ActivateOutput(pActInfo, static_cast<int>(EOutputs::FailedToGetBasePath), 0);
+                    break;
+                case CTomlManager::SaveJournalError::JournalInUse:
+                    ActivateOutput(pActInfo, static_cast<int>(EOutputs::JournalInUse), 0);
+                    break;
+                case CTomlManager::SaveJournalError::UnableToCreateFile:
+                    ActivateOutput(pActInfo, static_cast<int>(EOutputs::UnableToCreateFile), 0);
+                    break;
+                case CTomlManager::SaveJournalError::PartialDocument:
+                    CryWarning(
+                        VALIDATOR_MODULE_FLOWGRAPH,
+                        VALIDATOR_WARNING,
+                        "The document was opened partially from this file, unable to enable save journal (document %d).", documentId);
+                    break;
+                }
+            }
+        }
+        break;
+    }
+}
+
+void CFlowTomlNode_EnableSaveJournal::GetMemoryUsage(ICrySizer* s) const
+{
+    s->Add(*this);
+}
+
+const char* CFlowTomlNode_EnableSaveJournal::GetNodeName()
+{
+    return m_nodeName;
+}
+
+CFlowTomlNode_HotReload::~CFlowTomlNode_HotReload()
+{
+    Disable(nullptr);
+}
+
+IFlowNodePtr CFlowTomlNode_HotReload::Clone(SActivationInfo* pActInfo)
+{
+    return new CFlowTomlNode_HotReload(pActInfo);
+}
+
+void CFlowTomlNode_HotReload::GetConfiguration(SFlowNodeConfig& config)
+{
+    static const SInputPortConfig in_config[] = {
+        InputPortConfig_Void("Enable", _HELP("Start updating the document when its file is modified."), "Enable"),
+        InputPortConfig_Void("Disable", _HELP("Stop updating the document."), "Disable"),
+        InputPortConfig<int>("DocumentID", _HELP("Document to update."), "Document ID"),
+        InputPortConfig<string>("FileName", _HELP("Name of the file without \".toml\" extension for the document."), "File Name"),
+        InputPortConfig<string>("DirectoryName", _HELP("Usually your game name. Directory for file (will be appended to the base path)."), "Directory Name"),
+        { 0 }
+    };
+    static const SOutputPortConfig out_config[] = {
+        OutputPortConfig_Void("Enabled", _HELP("Executed if successfully enabled hot reload."), "Enabled"),
+        OutputPortConfig<string>("SectionName", _HELP("Section name of the modified value (empty for root keys)."), "Section Name"),
+        OutputPortConfig<string>("Key", _HELP("Key name of the modified value."), "Key"),
+        OutputPortConfig_Void("Changed", _HELP("Executed for every value modified by a reload (one value per frame) after \"Section Name\" and \"Key\"."), "Changed"),
+        OutputPortConfig_Void("DocumentNotFound", _HELP("Executed when the specified document ID is incorrect."), "Document Not Found"),
+        OutputPortConfig_Void("FailedToGetBasePath", _HELP("Executed when failed to get base path (see logs for details)."), "Failed To Get Base Path"),
+        { 0 }
+    };
+    config.sDescription = _HELP("Updates TOML document when its file is modified on the disk (files are parsed on worker threads) and outputs the modified values. Hot reload stops when the document is closed.");
+    config.pInputPorts = in_config;
+    config.pOutputPorts = out_config;
+    config.SetCategory(EFLN_APPROVED);
+}
+
+void CFlowTomlNode_HotReload::ProcessEvent(EFlowEvent evt, SActivationInfo* pActInfo)
+{
+    switch (evt)
+    {
+    case eFE_Initialize:
+        Disable(pActInfo);
+        break;
+    case eFE_Activate:
+        if (IsPortActive(pActInfo, static_cast<int>(EInputs::Disable)))
+        {
+            Disable(pActInfo);
+        }
+        else if (IsPortActive(pActInfo, static_cast<int>(EInputs::Enable)))
+        {
+            // Get plugin instance.
+            const auto pPluginInstance = CToml4CryenginePlugin::GetInstance();
+            if (!pPluginInstance)
+            {
+                CryFatalError("Plugin is not initialized.");
+                return;
+            }
+
+            // Stop previous hot reload.
+            Disable(pActInfo);
+
+            // Get inputs.
+            const auto documentId = GetPortInt(pActInfo, static_cast<int>(EInputs::DocumentId));
+            const auto fileName = GetPortString(pActInfo, static_cast<int>(EInputs::FileName));
+            const auto directoryName = GetPortString(pActInfo, static_cast<int>(EInputs::DirectoryName));
+
+            // Enable hot reload.
+            const auto optionalError = pPluginInstance->GetTomlManager()->EnableHotReload(
+                documentId, std::string(fileName), std::string(directoryName),
+                [this](int, const std::vector<CTomlManager::SValueChange>& changes)
+                {
+                    std::scoped_lock guard(m_mtxChanges);
+                    for (const auto& change : changes)
+                    {
+                        m_changes.emplace_back(change.sectionName, change.keyName);
+                    }
+                });
+
+            if (!optionalError.has_value())
+            {
+                m_documentId = documentId;
+                pActInfo->pGraph->SetRegularlyUpdated(pActInfo->myID, true);
+
+                // Trigger output pin.
+                ActivateOutput(pActInfo, static_cast<int>(EOutputs::Enabled), 0);
+            }
+            else
+            {
+                switch (optionalError.value())
+                {
+                case CTomlManager::HotReloadError::FileNameEmpty:
+                    CryWarning(
+                        VALIDATOR_MODULE_FLOWGRAPH,
+                        VALIDATOR_WARNING,
+                        "The specified file name cannot be empty, unable to enable hot reload (document %d).", documentId);
+                    break;
+                case CTomlManager::HotReloadError::DirectoryNameEmpty:
+                    CryWarning(
+                        VALIDATOR_MODULE_FLOWGRAPH,
+                        VALIDATOR_WARNING,
+                        "The specified directory name cannot be empty, unable to enable hot reload (document %d).", documentId);
+                    break;
+                case CTomlManager::HotReloadError::DocumentNotFound:
+                    ActivateOutput(pActInfo, static_cast<int>(EOutputs::DocumentNotFound), 0);
+                    break;
+                case CTomlManager::HotReloadError::FailedToGetBasePath:
+                    ActivateOutput(pActInfo, static_cast<int>(EOutputs::FailedToGetBasePath), 0);
+                    break;
+                }
+            }
+        }
+        break;
+    case eFE_Update:
+    {
+        // Output one modified value per frame.
+        std::pair<std::string, std::string> change;
+        {
+            std::scoped_lock guard(m_mtxChanges);
+            if (m_changes.empty())
+            {
+                break;
+            }
+            change = std::move(m_changes.front());
+            m_changes.pop_front();
+        }
+
+        ActivateOutput(pActInfo, static_cast<int>(EOutputs::SectionName), string(change.first.c_str()));
+        ActivateOutput(pActInfo, static_cast<int>(EOutputs::KeyName), string(change.second.c_str()));
+        ActivateOutput(pActInfo, static_cast<int>(EOutputs::Changed), 0);
+    }
+    break;
+    }
+}
+
+void CFlowTomlNode_HotReload::Disable(SActivationInfo* pActInfo)
+{
+    if (m_documentId.has_value())
+    {
+        const auto pPluginInstance = CToml4CryenginePlugin::GetInstance();
+        if (pPluginInstance)
+        {
+            pPluginInstance->GetTomlManager()->DisableHotReload(m_documentId.value());
+        }
+        m_documentId.reset();
+    }
+
+    {
+        std::scoped_lock guard(m_mtxChanges);
+        m_changes.clear();
+    }
+
+    if (pActInfo != nullptr)
+    {
+        pActInfo->pGraph->SetRegularlyUpdated(pActInfo->myID, false);
+    }
+}
+
+void CFlowTomlNode_HotReload::GetMemoryUsage(ICrySizer* s) const
+{
+    s->Add(*this);
+}
+
+const char* CFlowTomlNode_HotReload::GetNodeName()
+{
+    return m_nodeName;
+}
+
+void CFlowTomlNode_SyncDocument::GetConfiguration(SFlowNodeConfig& config)
+{
+    static const SInputPortConfig in_config[] = {
+        InputPortConfig_Void("Sync", _HELP("Make the document equal to the source document."), "Sync"),
+        InputPortConfig<int>("DocumentId", _HELP("Document to modify."), "Document ID"),
+        InputPortConfig<int>("SourceDocumentId", _HELP("Document to copy values from."), "Source Document ID"),
+        { 0 }
+    };
+    static const SOutputPortConfig out_config[] = {
+        OutputPortConfig<int>("ChangeCount", _HELP("Executed if successfully synchronized the document, contains number of applied changes."), "Change Count"),
+        OutputPortConfig_Void("DocumentNotFound", _HELP("Executed when one of the specified document IDs is incorrect."), "Document Not Found"),
+        { 0 }
+    };
+    config.sDescription = _HELP("Compares the documents and applies only the differences to the document (for example to restore default settings), observers are notified only about changed values.");
+    config.pInputPorts = in_config;
+    config.pOutputPorts = out_config;
+    config.SetCategory(EFLN_APPROVED);
+}
+
+void CFlowTomlNode_SyncDocument::ProcessEvent(EFlowEvent evt, SActivationInfo* pActInfo)
+{
+    switch (evt)
+    {
+    case eFE_Activate:
+        if (IsPortActive(pActInfo, static_cast<int>(EInputs::Sync)))
+        {
+            // Get plugin instance.
+            const auto pPluginInstance = CToml4CryenginePlugin::GetInstance();
+            if (!pPluginInstance)
+            {
+                CryFatalError("Plugin is not initialized.");
+                return;
+            }
+
+            // Get inputs.
+            const auto documentId = GetPortInt(pActInfo, static_cast<int>(EInputs::DocumentId));
+            const auto sourceDocumentId = GetPortInt(pActInfo, static_cast<int>(EInputs::SourceDocumentId));
+
+            // Compare documents and apply the differences.
+            const auto pTomlManager = pPluginInstance->GetTomlManager();
+            const auto optionalPatch = pTomlManager->Diff(documentId, sourceDocumentId);
+            if (!optionalPatch.has_value() || pTomlManager->ApplyPatch(documentId, optionalPatch.value()).has_value())
+            {
+                ActivateOutput(pActInfo, static_cast<int>(EOutputs::DocumentNotFound), 0);
+                return;
+            }
+
+            ActivateOutput(pActInfo, static_cast<int>(EOutputs::ChangeCount), static_cast<int>(optionalPatch->GetOperations().size()));
+        }
+        break;
+    }
+}
+
+void CFlowTomlNode_SyncDocument::GetMemoryUsage(ICrySizer* s) const
+{
+    s->Add(*this);
+}
+
+const char* CFlowTomlNode_SyncDocument::GetNodeName()
 {
     return m_nodeName;
 }
\ No newline at end of file
@@ -1,6 +1,13 @@
 #pragma once
 
 #include <CryGame/IGameFramework.h>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
 
 //! Describes the "NewDocument" node to initialize new TOML documents.
 class CFlowTomlNode_NewDocument : public CFlowBaseNode<eNCT_Singleton>
@@ -201,6 +208,9 @@ private:
         Open = 0,
         FileName,
         DirectoryName,
+        Lazy,
+        Parallel,
+        Frozen,
     };
 
     //! Output ports of this node.
@@ -375,6 +385,858 @@ private:
     };
 };
 
+//! Describes the "AppendValue" node to append a value to an array in TOML document.
+class CFlowTomlNode_AppendValue : public CFlowBaseNode<eNCT_Singleton>
+{
+public:
+    CFlowTomlNode_AppendValue(SActivationInfo* pActInfo) {};
+
+    //! Returns node configuration (input, output ports, description, etc.).
+    virtual void GetConfiguration(SFlowNodeConfig& config) override;
+
+    //! Processes Flow Graph events.
+    virtual void ProcessEvent(EFlowEvent evt, SActivationInfo* pActInfo) override;
+
+    //! Returns memory usage of this object.
+    virtual void GetMemoryUsage(ICrySizer* s) const override;
+
+    //! Returns name of this node.
+    //! 
+    //! \return Name of this node.
+    static const char* GetNodeName();
+
+private:
+
+    //! Name of this node.
+    static inline const char* m_nodeName = "TOML:AppendValue";
+
+    //! Input ports of this node.
+    enum class EInputs : int
+    {
+        DocumentId = 0,
+        SectionName,
+        KeyName,
+        Value,
+    };
+
+    //! Output ports of this node.
+    enum class EOutputs : int
+    {
+        DocumentId = 0,
+        DocumentNotFound,
+        ValueTypeMismatch,
+        FailedToConvertValue,
+    };
+};
+
+//! Describes the "InsertAt" node to insert a value into an array in TOML document.
+class CFlowTomlNode_InsertAt : public CFlowBaseNode<eNCT_Singleton>
+{
+public:
+    CFlowTomlNode_InsertAt(SActivationInfo* pActInfo) {};
+
+    //! Returns node configuration (input, output ports, description, etc.).
+    virtual void GetConfiguration(SFlowNodeConfig& config) override;
+
+    //! Processes Flow Graph events.
+    virtual void ProcessEvent(EFlowEvent evt, SActivationInfo* pActInfo) override;
+
+    //! Returns memory usage of this object.
+    virtual void GetMemoryUsage(ICrySizer* s) const override;
+
+    //! Returns name of this node.
+    //! 
+    //! \return Name of this node.
+    static const char* GetNodeName();
+
+private:
+
+    //! Name of this node.
+    static inline const char* m_nodeName = "TOML:InsertAt";
+
+    //! Input ports of this node.
+    enum class EInputs : int
+    {
+        DocumentId = 0,
+        SectionName,
+        KeyName,
+        Index,
+        Value,
+    };
+
+    //! Output ports of this node.
+    enum class EOutputs : int
+    {
+        DocumentId = 0,
+        DocumentNotFound,
+        ValueNotFound,
+        ValueTypeMismatch,
+        IndexOutOfRange,
+        FailedToConvertValue,
+    };
+};
+
+//! Describes the "SetAt" node to replace an element of an array in TOML document.
+class CFlowTomlNode_SetAt : public CFlowBaseNode<eNCT_Singleton>
+{
+public:
+    CFlowTomlNode_SetAt(SActivationInfo* pActInfo) {};
+
+    //! Returns node configuration (input, output ports, description, etc.).
+    virtual void GetConfiguration(SFlowNodeConfig& config) override;
+
+    //! Processes Flow Graph events.
+    virtual void ProcessEvent(EFlowEvent evt, SActivationInfo* pActInfo) override;
+
+    //! Returns memory usage of this object.
+    virtual void GetMemoryUsage(ICrySizer* s) const override;
+
+    //! Returns name of this node.
+    //! 
+    //! \return Name of this node.
+    static const char* GetNodeName();
+
+private:
+
+    //! Name of this node.
+    static inline const char* m_nodeName = "TOML:SetAt";
+
+    //! Input ports of this node.
+    enum class EInputs : int
+    {
+        DocumentId = 0,
+        SectionName,
+        KeyName,
+        Index,
+        Value,
+    };
+
+    //! Output ports of this node.
+    enum class EOutputs : int
+    {
+        DocumentId = 0,
+        DocumentNotFound,
+        ValueNotFound,
+        ValueTypeMismatch,
+        IndexOutOfRange,
+        FailedToConvertValue,
+    };
+};
+
+//! Describes the "EraseAt" node to remove an element from an array in TOML document.
+class CFlowTomlNode_EraseAt : public CFlowBaseNode<eNCT_Singleton>
+{
+public:
+    CFlowTomlNode_EraseAt(SActivationInfo* pActInfo) {};
+
+    //! Returns node configuration (input, output ports, description, etc.).
+    virtual void GetConfiguration(SFlowNodeConfig& config) override;
+
+    //! Processes Flow Graph events.
+    virtual void ProcessEvent(EFlowEvent evt, SActivationInfo* pActInfo) override;
+
+    //! Returns memory usage of this object.
+    virtual void GetMemoryUsage(ICrySizer* s) const override;
+
+    //! Returns name of this node.
+    //! 
+    //! \return Name of this node.
+    static const char* GetNodeName();
+
+private:
+
+    //! Name of this node.
+    static inline const char* m_nodeName = "TOML:EraseAt";
+
+    //! Input ports of this node.
+    enum class EInputs : int
+    {
+        DocumentId = 0,
+        SectionName,
+        KeyName,
+        Index,
+    };
+
+    //! Output ports of this node.
+    enum class EOutputs : int
+    {
+        DocumentId = 0,
+        DocumentNotFound,
+        ValueNotFound,
+        ValueTypeMismatch,
+        IndexOutOfRange,
+    };
+};
+
+//! Describes Flow Graph node names and TOML storage type for values of type T (see typed SetValue/GetValue nodes).
+template<typename T>
+struct SFlowTomlTypedValueInfo;
+
+//! Describes Flow Graph node names for Int values.
+template<>
+struct SFlowTomlTypedValueInfo<int>
+{
+    //! Type that is used to store the value in TOML document.
+    using StorageType = int;
+
+    //! Name of the node that sets values of this type.
+    static inline const char* setNodeName = "TOML:SetValueInt";
+
+    //! Name of the node that gets values of this type.
+    static inline const char* getNodeName = "TOML:GetValueInt";
+
+    //! Description of the node that sets values of this type.
+    static inline const char* setNodeDescription = _HELP("Sets an integer value to TOML document (stored as TOML integer).");
+
+    //! Description of the node that gets values of this type.
+    static inline const char* getNodeDescription = _HELP("Gets an integer value from TOML document (stored as TOML integer).");
+};
+
+//! Describes Flow Graph node names for Float values.
+template<>
+struct SFlowTomlTypedValueInfo<float>
+{
+    //! Type that is used to store the value in TOML document.
+    using StorageType = float;
+
+    //! Name of the node that sets values of this type.
+    static inline const char* setNodeName = "TOML:SetValueFloat";
+
+    //! Name of the node that gets values of this type.
+    static inline const char* getNodeName = "TOML:GetValueFloat";
+
+    //! Description of the node that sets values of this type.
+    static inline const char* setNodeDescription = _HELP("Sets a float value to TOML document (stored as TOML float).");
+
+    //! Description of the node that gets values of this type.
+    static inline const char* getNodeDescription = _HELP("Gets a float value from TOML document (stored as TOML float).");
+};
+
+//! Describes Flow Graph node names for Bool values.
+template<>
+struct SFlowTomlTypedValueInfo<bool>
+{
+    //! Type that is used to store the value in TOML document.
+    using StorageType = bool;
+
+    //! Name of the node that sets values of this type.
+    static inline const char* setNodeName = "TOML:SetValueBool";
+
+    //! Name of the node that gets values of this type.
+    static inline const char* getNodeName = "TOML:GetValueBool";
+
+    //! Description of the node that sets values of this type.
+    static inline const char* setNodeDescription = _HELP("Sets a boolean value to TOML document (stored as TOML boolean).");
+
+    //! Description of the node that gets values of this type.
+    static inline const char* getNodeDescription = _HELP("Gets a boolean value from TOML document (stored as TOML boolean).");
+};
+
+//! Describes Flow Graph node names for Vec3 values.
+template<>
+struct SFlowTomlTypedValueInfo<Vec3>
+{
+    //! Type that is used to store the value in TOML document.
+    using StorageType = Vec3;
+
+    //! Name of the node that sets values of this type.
+    static inline const char* setNodeName = "TOML:SetValueVec3";
+
+    //! Name of the node that gets values of this type.
+    static inline const char* getNodeName = "TOML:GetValueVec3";
+
+    //! Description of the node that sets values of this type.
+    static inline const char* setNodeDescription = _HELP("Sets a Vec3 value to TOML document (stored as an array of 3 numbers).");
+
+    //! Description of the node that gets values of this type.
+    static inline const char* getNodeDescription = _HELP("Gets a Vec3 value from TOML document (stored as an array of 3 numbers).");
+};
+
+//! Describes Flow Graph node names for String values.
+template<>
+struct SFlowTomlTypedValueInfo<string>
+{
+    //! Type that is used to store the value in TOML document.
+    using StorageType = std::string;
+
+    //! Name of the node that sets values of this type.
+    static inline const char* setNodeName = "TOML:SetValueString";
+
+    //! Name of the node that gets values of this type.
+    static inline const char* getNodeName = "TOML:GetValueString";
+
+    //! Description of the node that sets values of this type.
+    static inline const char* setNodeDescription = _HELP("Sets a string value to TOML document.");
+
+    //! Description of the node that gets values of this type.
+    static inline const char* getNodeDescription = _HELP("Gets a string value from TOML document.");
+};
+
+//! Describes the "SetValue" node for values of type T, the value is stored using a native TOML type (not converted to string).
+template<typename T>
+class CFlowTomlNode_SetTypedValue : public CFlowBaseNode<eNCT_Singleton>
+{
+public:
+    CFlowTomlNode_SetTypedValue(SActivationInfo* pActInfo) {};
+
+    //! Returns node configuration (input, output ports, description, etc.).
+    virtual void GetConfiguration(SFlowNodeConfig& config) override;
+
+    //! Processes Flow Graph events.
+    virtual void ProcessEvent(EFlowEvent evt, SActivationInfo* pActInfo) override;
+
+    //! Returns memory usage of this object.
+    virtual void GetMemoryUsage(ICrySizer* s) const override;
+
+    //! Returns name of this node.
+    //! 
+    //! \return Name of this node.
+    static const char* GetNodeName();
+
+private:
+
+    //! Input ports of this node.
+    enum class EInputs : int
+    {
+        DocumentId = 0,
+        SectionName,
+        KeyName,
+        Value,
+    };
+
+    //! Output ports of this node.
+    enum class EOutputs : int
+    {
+        DocumentId = 0,
+        DocumentNotFound,
+    };
+};
+
+//! Describes the "GetValue" node for values of type T, the value is read using a native TOML type (not converted from string).
+template<typename T>
+class CFlowTomlNode_GetTypedValue : public CFlowBaseNode<eNCT_Singleton>
+{
+public:
+    CFlowTomlNode_GetTypedValue(SActivationInfo* pActInfo) {};
+
+    //! Returns node configuration (input, output ports, description, etc.).
+    virtual void GetConfiguration(SFlowNodeConfig& config) override;
+
+    //! Processes Flow Graph events.
+    virtual void ProcessEvent(EFlowEvent evt, SActivationInfo* pActInfo) override;
+
+    //! Returns memory usage of this object.
+    virtual void GetMemoryUsage(ICrySizer* s) const override;
+
+    //! Returns name of this node.
+    //! 
+    //! \return Name of this node.
+    static const char* GetNodeName();
+
+private:
+
+    //! Input ports of this node.
+    enum class EInputs : int
+    {
+        DocumentId = 0,
+        SectionName,
+        KeyName,
+    };
+
+    //! Output ports of this node.
+    enum class EOutputs : int
+    {
+        Value = 0,
+        DocumentNotFound,
+        ValueNotFound,
+        ValueTypeMismatch,
+    };
+};
+
+using CFlowTomlNode_SetValueInt = CFlowTomlNode_SetTypedValue<int>;
+using CFlowTomlNode_GetValueInt = CFlowTomlNode_GetTypedValue<int>;
+using CFlowTomlNode_SetValueFloat = CFlowTomlNode_SetTypedValue<float>;
+using CFlowTomlNode_GetValueFloat = CFlowTomlNode_GetTypedValue<float>;
+using CFlowTomlNode_SetValueBool = CFlowTomlNode_SetTypedValue<bool>;
+using CFlowTomlNode_GetValueBool = CFlowTomlNode_GetTypedValue<bool>;
+using CFlowTomlNode_SetValueVec3 = CFlowTomlNode_SetTypedValue<Vec3>;
+using CFlowTomlNode_GetValueVec3 = CFlowTomlNode_GetTypedValue<Vec3>;
+using CFlowTomlNode_SetValueString = CFlowTomlNode_SetTypedValue<string>;
+using CFlowTomlNode_GetValueString = CFlowTomlNode_GetTypedValue<string>;
+
+//! Describes the "GetBoundValue" node that binds to a value of TOML document and caches it,
+//! subsequent reads are served from the cache until the document is modified.
+class CFlowTomlNode_GetBoundValue : public CFlowBaseNode<eNCT_Instanced>
+{
+public:
+    CFlowTomlNode_GetBoundValue(SActivationInfo* pActInfo) {};
+
+    //! Creates a new instance of this node for a graph.
+    virtual IFlowNodePtr Clone(SActivationInfo* pActInfo) override;
+
+    //! Returns node configuration (input, output ports, description, etc.).
+    virtual void GetConfiguration(SFlowNodeConfig& config) override;
+
+    //! Processes Flow Graph events.
+    virtual void ProcessEvent(EFlowEvent evt, SActivationInfo* pActInfo) override;
+
+    //! Returns memory usage of this object.
+    virtual void GetMemoryUsage(ICrySizer* s) const override;
+
+    //! Returns name of this node.
+    //! 
+    //! \return Name of this node.
+    static const char* GetNodeName();
+
+private:
+
+    //! Binds this node to the value specified in the input ports and clears the cache.
+    //! 
+    //! \param pActInfo Activation info.
+    void Bind(SActivationInfo* pActInfo);
+
+    //! Triggers output ports with the bound value (reads the value from the document if the cache is outdated).
+    //! 
+    //! \param pActInfo Activation info.
+    void Read(SActivationInfo* pActInfo);
+
+    //! Name of this node.
+    static inline const char* m_nodeName = "TOML:GetBoundValue";
+
+    //! Input ports of this node.
+    enum class EInputs : int
+    {
+        DocumentId = 0,
+        SectionName,
+        KeyName,
+        Get,
+    };
+
+    //! Output ports of this node.
+    enum class EOutputs : int
+    {
+        Value = 0,
+        DocumentNotFound,
+        ValueNotFound,
+        ValueTypeMismatch,
+    };
+
+    //! Bound document.
+    int m_documentId = -1;
+
+    //! Section name of the bound value.
+    std::string m_sectionName;
+
+    //! Key name of the bound value.
+    std::string m_keyName;
+
+    //! Last read value.
+    TFlowInputData m_cachedValue;
+
+    //! Revision of the document when \ref m_cachedValue was read, empty if there is no cached value.
+    std::optional<size_t> m_cachedRevision;
+};
+
+//! Describes the "OnValueChanged" node that fires when a value of TOML document is modified (no polling needed).
+class CFlowTomlNode_OnValueChanged : public CFlowBaseNode<eNCT_Instanced>
+{
+public:
+    CFlowTomlNode_OnValueChanged(SActivationInfo* pActInfo) {};
+
+    //! Removes the subscription (if exists).
+    virtual ~CFlowTomlNode_OnValueChanged() override;
+
+    //! Creates a new instance of this node for a graph.
+    virtual IFlowNodePtr Clone(SActivationInfo* pActInfo) override;
+
+    //! Returns node configuration (input, output ports, description, etc.).
+    virtual void GetConfiguration(SFlowNodeConfig& config) override;
+
+    //! Processes Flow Graph events.
+    virtual void ProcessEvent(EFlowEvent evt, SActivationInfo* pActInfo) override;
+
+    //! Returns memory usage of this object.
+    virtual void GetMemoryUsage(ICrySizer* s) const override;
+
+    //! Returns name of this node.
+    //! 
+    //! \return Name of this node.
+    static const char* GetNodeName();
+
+private:
+
+    //! Removes the subscription (if exists) and disables regular updates.
+    //! 
+    //! \param pActInfo Activation info (can be nullptr if the node is being destroyed).
+    void Unsubscribe(SActivationInfo* pActInfo);
+
+    //! Name of this node.
+    static inline const char* m_nodeName = "TOML:OnValueChanged";
+
+    //! Input ports of this node.
+    enum class EInputs : int
+    {
+        DocumentId = 0,
+        SectionName,
+        KeyName,
+        Stop,
+    };
+
+    //! Output ports of this node.
+    enum class EOutputs : int
+    {
+        Changed = 0,
+        DocumentNotFound,
+    };
+
+    //! Observed document.
+    int m_documentId = -1;
+
+    //! ID of the subscription in TOML manager, empty if not subscribed.
+    std::optional<size_t> m_subscriptionId;
+
+    //! Set by the subscription callback (that can be called from any thread), checked on update.
+    std::atomic<bool> m_bValueChanged{ false };
+};
+
+//! Describes the "ForEachDocument" node that iterates over document names of a directory one name per activation.
+class CFlowTomlNode_ForEachDocument : public CFlowBaseNode<eNCT_Instanced>
+{
+public:
+    CFlowTomlNode_ForEachDocument(SActivationInfo* pActInfo) {};
+
+    //! Creates a new instance of this node for a graph.
+    virtual IFlowNodePtr Clone(SActivationInfo* pActInfo) override;
+
+    //! Returns node configuration (input, output ports, description, etc.).
+    virtual void GetConfiguration(SFlowNodeConfig& config) override;
+
+    //! Processes Flow Graph events.
+    virtual void ProcessEvent(EFlowEvent evt, SActivationInfo* pActInfo) override;
+
+    //! Returns memory usage of this object.
+    virtual void GetMemoryUsage(ICrySizer* s) const override;
+
+    //! Returns name of this node.
+    //! 
+    //! \return Name of this node.
+    static const char* GetNodeName();
+
+private:
+
+    //! Outputs the current document name and advances the iteration or outputs "Done".
+    //! 
+    //! \param pActInfo Activation info.
+    void OutputNext(SActivationInfo* pActInfo);
+
+    //! Name of this node.
+    static inline const char* m_nodeName = "TOML:ForEachDocument";
+
+    //! Input ports of this node.
+    enum class EInputs : int
+    {
+        DirectoryName = 0,
+        Offset,
+        Count,
+        Refresh,
+        ForEach,
+        Next,
+    };
+
+    //! Output ports of this node.
+    enum class EOutputs : int
+    {
+        DocumentName = 0,
+        Index,
+        Done,
+        FailedToGetBasePath,
+    };
+
+    //! Listing that is being iterated (shared with TOML manager's cache).
+    std::shared_ptr<const std::vector<std::string>> m_pDocumentNames;
+
+    //! Index of the next name to output.
+    size_t m_nextIndex = 0;
+
+    //! Index after the last name to output.
+    size_t m_endIndex = 0;
+};
+
+//! Describes the "OpenDocumentsMetadata" node to read metadata of all documents of a directory without opening them.
+class CFlowTomlNode_OpenDocumentsMetadata : public CFlowBaseNode<eNCT_Singleton>
+{
+public:
+    CFlowTomlNode_OpenDocumentsMetadata(SActivationInfo* pActInfo) {};
+
+    //! Returns node configuration (input, output ports, description, etc.).
+    virtual void GetConfiguration(SFlowNodeConfig& config) override;
+
+    //! Processes Flow Graph events.
+    virtual void ProcessEvent(EFlowEvent evt, SActivationInfo* pActInfo) override;
+
+    //! Returns memory usage of this object.
+    virtual void GetMemoryUsage(ICrySizer* s) const override;
+
+    //! Returns name of this node.
+    //! 
+    //! \return Name of this node.
+    static const char* GetNodeName();
+
+private:
+
+    //! Name of this node.
+    static inline const char* m_nodeName = "TOML:OpenDocumentsMetadata";
+
+    //! Input ports of this node.
+    enum class EInputs : int
+    {
+        Open = 0,
+        DirectoryName,
+    };
+
+    //! Output ports of this node.
+    enum class EOutputs : int
+    {
+        DocumentId = 0,
+        FailedToGetBasePath,
+    };
+};
+
+//! Describes the "CloneDocument" node to create a copy of a document.
+class CFlowTomlNode_CloneDocument : public CFlowBaseNode<eNCT_Singleton>
+{
+public:
+    CFlowTomlNode_CloneDocument(SActivationInfo* pActInfo) {};
+
+    //! Returns node configuration (input, output ports, description, etc.).
+    virtual void GetConfiguration(SFlowNodeConfig& config) override;
+
+    //! Processes Flow Graph events.
+    virtual void ProcessEvent(EFlowEvent evt, SActivationInfo* pActInfo) override;
+
+    //! Returns memory usage of this object.
+    virtual void GetMemoryUsage(ICrySizer* s) const override;
+
+    //! Returns name of this node.
+    //! 
+    //! \return Name of this node.
+    static const char* GetNodeName();
+
+private:
+
+    //! Name of this node.
+    static inline const char* m_nodeName = "TOML:CloneDocument";
+
+    //! Input ports of this node.
+    enum class EInputs : int
+    {
+        Clone = 0,
+        DocumentId,
+    };
+
+    //! Output ports of this node.
+    enum class EOutputs : int
+    {
+        DocumentId = 0,
+        DocumentNotFound,
+    };
+};
+
+//! Describes the "CreateLayeredDocument" node to create a view of stacked documents (defaults, user settings, mod overrides).
+class CFlowTomlNode_CreateLayeredDocument : public CFlowBaseNode<eNCT_Singleton>
+{
+public:
+    CFlowTomlNode_CreateLayeredDocument(SActivationInfo* pActInfo) {};
+
+    //! Returns node configuration (input, output ports, description, etc.).
+    virtual void GetConfiguration(SFlowNodeConfig& config) override;
+
+    //! Processes Flow Graph events.
+    virtual void ProcessEvent(EFlowEvent evt, SActivationInfo* pActInfo) override;
+
+    //! Returns memory usage of this object.
+    virtual void GetMemoryUsage(ICrySizer* s) const override;
+
+    //! Returns name of this node.
+    //! 
+    //! \return Name of this node.
+    static const char* GetNodeName();
+
+private:
+
+    //! Name of this node.
+    static inline const char* m_nodeName = "TOML:CreateLayeredDocument";
+
+    //! Input ports of this node.
+    enum class EInputs : int
+    {
+        Create = 0,
+        BottomDocumentId,
+        MiddleDocumentId,
+        TopDocumentId,
+    };
+
+    //! Output ports of this node.
+    enum class EOutputs : int
+    {
+        DocumentId = 0,
+        InvalidLayers,
+    };
+};
+
+//! Describes the "EnableSaveJournal" node to persist a document by appending its changes to a journal file.
+class CFlowTomlNode_EnableSaveJournal : public CFlowBaseNode<eNCT_Singleton>
+{
+public:
+    CFlowTomlNode_EnableSaveJournal(SActivationInfo* pActInfo) {};
+
+    //! Returns node configuration (input, output ports, description, etc.).
+    virtual void GetConfiguration(SFlowNodeConfig& config) override;
+
+    //! Processes Flow Graph events.
+    virtual void ProcessEvent(EFlowEvent evt, SActivationInfo* pActInfo) override;
+
+    //! Returns memory usage of this object.
+    virtual void GetMemoryUsage(ICrySizer* s) const override;
+
+    //! Returns name of this node.
+    //! 
+    //! \return Name of this node.
+    static const char* GetNodeName();
+
+private:
+
+    //! Name of this node.
+    static inline const char* m_nodeName = "TOML:EnableSaveJournal";
+
+    //! Input ports of this node.
+    enum class EInputs : int
+    {
+        Enable = 0,
+        DocumentId,
+        FileName,
+        DirectoryName,
+    };
+
+    //! Output ports of this node.
+    enum class EOutputs : int
+    {
+        Done = 0,
+        DocumentNotFound,
+        FailedToGetBasePath,
+        JournalInUse,
+        UnableToCreateFile,
+    };
+};
+
+//! Describes the "HotReload" node that updates a document when its file is modified on the disk and outputs modified values.
+class CFlowTomlNode_HotReload : public CFlowBaseNode<eNCT_Instanced>
+{
+public:
+    CFlowTomlNode_HotReload(SActivationInfo* pActInfo) {};
+
+    //! Stops the hot reload (if enabled).
+    virtual ~CFlowTomlNode_HotReload() override;
+
+    //! Creates a new instance of this node for a graph.
+    virtual IFlowNodePtr Clone(SActivationInfo* pActInfo) override;
+
+    //! Returns node configuration (input, output ports, description, etc.).
+    virtual void GetConfiguration(SFlowNodeConfig& config) override;
+
+    //! Processes Flow Graph events.
+    virtual void ProcessEvent(EFlowEvent evt, SActivationInfo* pActInfo) override;
+
+    //! Returns memory usage of this object.
+    virtual void GetMemoryUsage(ICrySizer* s) const override;
+
+    //! Returns name of this node.
+    //! 
+    //! \return Name of this node.
+    static const char* GetNodeName();
+
+private:
+
+    //! Stops the hot reload (if enabled), discards not output changes and disables regular updates.
+    //! 
+    //! \param pActInfo Activation info (can be nullptr if the node is being destroyed).
+    void Disable(SActivationInfo* pActInfo);
+
+    //! Name of this node.
+    static inline const char* m_nodeName = "TOML:HotReload";
+
+    //! Input ports of this node.
+    enum class EInputs : int
+    {
+        Enable = 0,
+        Disable,
+        DocumentId,
+        FileName,
+        DirectoryName,
+    };
+
+    //! Output ports of this node.
+    enum class EOutputs : int
+    {
+        Enabled = 0,
+        SectionName,
+        KeyName,
+        Changed,
+        DocumentNotFound,
+        FailedToGetBasePath,
+    };
+
+    //! Reloaded document, empty if hot reload is not enabled by this node.
+    std::optional<int> m_documentId;
+
+    //! Modified values that were not output yet (section name and key name).
+    std::deque<std::pair<std::string, std::string>> m_changes;
+
+    //! Mutex for \ref m_changes.
+    std::mutex m_mtxChanges;
+};
+
+//! Describes the "SyncDocument" node to make a document equal to another one by applying only their differences.
+class CFlowTomlNode_SyncDocument : public CFlowBaseNode<eNCT_Singleton>
+{
+public:
+    CFlowTomlNode_SyncDocument(SActivationInfo* pActInfo) {};
+
+    //! Returns node configuration (input, output ports, description, etc.).
+    virtual void GetConfiguration(SFlowNodeConfig& config) override;
+
+    //! Processes Flow Graph events.
+    virtual void ProcessEvent(EFlowEvent evt, SActivationInfo* pActInfo) override;
+
+    //! Returns memory usage of this object.
+    virtual void GetMemoryUsage(ICrySizer* s) const override;
+
+    //! Returns name of this node.
+    //! 
+    //! \return Name of this node.
+    static const char* GetNodeName();
+
+private:
+
+    //! Name of this node.
+    static inline const char* m_nodeName = "TOML:SyncDocument";
+
+    //! Input ports of this node.
+    enum class EInputs : int
+    {
+        Sync = 0,
+        DocumentId,
+        SourceDocumentId,
+    };
+
+    //! Output ports of this node.
+    enum class EOutputs : int
+    {
+        ChangeCount = 0,
+        DocumentNotFound,
+    };
+};
+
 REGISTER_FLOW_NODE(CFlowTomlNode_NewDocument::GetNodeName(), CFlowTomlNode_NewDocument)
 REGISTER_FLOW_NODE(CFlowTomlNode_SetValue::GetNodeName(), CFlowTomlNode_SetValue)
 REGISTER_FLOW_NODE(CFlowTomlNode_GetValue::GetNodeName(), CFlowTomlNode_GetValue)
@@ -383,4 +1245,27 @@ REGISTER_FLOW_NODE(CFlowTomlNode_OpenDocument::GetNodeName(), CFlowTomlNode_Open
 REGISTER_FLOW_NODE(CFlowTomlNode_CloseDocument::GetNodeName(), CFlowTomlNode_CloseDocument)
 REGISTER_FLOW_NODE(CFlowTomlNode_GetDirectoryPathForDocuments::GetNodeName(), CFlowTomlNode_GetDirectoryPathForDocuments)
 REGISTER_FLOW_NODE(CFlowTomlNode_GetAllDocuments::GetNodeName(), CFlowTomlNode_GetAllDocuments)
-REGISTER_FLOW_NODE(CFlowTomlNode_RemoveDocument::GetNodeName(), CFlowTomlNode_RemoveDocument)
\ No newline at end of file
+REGISTER_FLOW_NODE(CFlowTomlNode_RemoveDocument::GetNodeName(), CFlowTomlNode_RemoveDocument)
+REGISTER_FLOW_NODE(CFlowTomlNode_AppendValue::GetNodeName(), CFlowTomlNode_AppendValue)
+REGISTER_FLOW_NODE(CFlowTomlNode_InsertAt::GetNodeName(), CFlowTomlNode_InsertAt)
+REGISTER_FLOW_NODE(CFlowTomlNode_SetAt::GetNodeName(), CFlowTomlNode_SetAt)
+REGISTER_FLOW_NODE(CFlowTomlNode_EraseAt::GetNodeName(), CFlowTomlNode_EraseAt)
+REGISTER_FLOW_NODE(CFlowTomlNode_SetValueInt::GetNodeName(), CFlowTomlNode_SetValueInt)
+REGISTER_FLOW_NODE(CFlowTomlNode_GetValueInt::GetNodeName(), CFlowTomlNode_GetValueInt)
+REGISTER_FLOW_NODE(CFlowTomlNode_SetValueFloat::GetNodeName(), CFlowTomlNode_SetValueFloat)
+REGISTER_FLOW_NODE(CFlowTomlNode_GetValueFloat::GetNodeName(), CFlowTomlNode_GetValueFloat)
+REGISTER_FLOW_NODE(CFlowTomlNode_SetValueBool::GetNodeName(), CFlowTomlNode_SetValueBool)
+REGISTER_FLOW_NODE(CFlowTomlNode_GetValueBool::GetNodeName(), CFlowTomlNode_GetValueBool)
+REGISTER_FLOW_NODE(CFlowTomlNode_SetValueVec3::GetNodeName(), CFlowTomlNode_SetValueVec3)
+REGISTER_FLOW_NODE(CFlowTomlNode_GetValueVec3::GetNodeName(), CFlowTomlNode_GetValueVec3)
+REGISTER_FLOW_NODE(CFlowTomlNode_SetValueString::GetNodeName(), CFlowTomlNode_SetValueString)
+REGISTER_FLOW_NODE(CFlowTomlNode_GetValueString::GetNodeName(), CFlowTomlNode_GetValueString)
+REGISTER_FLOW_NODE(CFlowTomlNode_GetBoundValue::GetNodeName(), CFlowTomlNode_GetBoundValue)
+REGISTER_FLOW_NODE(CFlowTomlNode_OnValueChanged::GetNodeName(), CFlowTomlNode_OnValueChanged)
+REGISTER_FLOW_NODE(CFlowTomlNode_ForEachDocument::GetNodeName(), CFlowTomlNode_ForEachDocument)
+REGISTER_FLOW_NODE(CFlowTomlNode_OpenDocumentsMetadata::GetNodeName(), CFlowTomlNode_OpenDocumentsMetadata)
+REGISTER_FLOW_NODE(CFlowTomlNode_CloneDocument::GetNodeName(), CFlowTomlNode_CloneDocument)
+REGISTER_FLOW_NODE(CFlowTomlNode_CreateLayeredDocument::GetNodeName(), CFlowTomlNode_CreateLayeredDocument)
+REGISTER_FLOW_NODE(CFlowTomlNode_EnableSaveJournal::GetNodeName(), CFlowTomlNode_EnableSaveJournal)
+REGISTER_FLOW_NODE(CFlowTomlNode_HotReload::GetNodeName(), CFlowTomlNode_HotReload)
+REGISTER_FLOW_NODE(CFlowTomlNode_SyncDocument::GetNodeName(), CFlowTomlNode_SyncDocument)
\ No newline at end of file
@@ -47,9 +47,17 @@ bool CToml4CryenginePlugin::Initialize(SSystemGlobalEnvironment& env, const SSys
 {
 	gEnv->pSystem->GetISystemEventDispatcher()->RegisterListener(this ,"CToml4CryenginePlugin");
 
+	// Hot reloaded documents are updated on the main thread.
+	EnableUpdate(EUpdateStep::MainUpdate, true);
+
 	return true;
 }
 
+void CToml4CryenginePlugin::MainUpdate(float frameTime)
+{
+	m_tomlManager.UpdateHotReload();
+}
+
 void CToml4CryenginePlugin::OnSystemEvent(ESystemEvent event, UINT_PTR wparam, UINT_PTR lparam)
 {
 	switch (event)
@@ -31,6 +31,7 @@ public:
 	// Cry::IEnginePlugin
 	virtual bool Initialize(SSystemGlobalEnvironment& env, const SSystemInitParams& initParams) override;
 	virtual const char* GetName() const override;
+	virtual void MainUpdate(float frameTime) override;
 	// ~Cry::IEnginePlugin
 	
 	// ISystemEventListener
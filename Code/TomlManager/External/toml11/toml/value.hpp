@@ -828,6 +828,27 @@ class basic_value
         assigner(this->array_, ary);
         return *this;
     }
+    basic_value(array_type&& ary)
+        : type_(value_t::array),
+          region_info_(std::make_shared<region_base>(region_base{}))
+    {
+        assigner(this->array_, std::move(ary));
+    }
+    basic_value(array_type&& ary, std::vector<std::string> com)
+        : type_(value_t::array),
+          region_info_(std::make_shared<region_base>(region_base{})),
+          comments_(std::move(com))
+    {
+        assigner(this->array_, std::move(ary));
+    }
+    basic_value& operator=(array_type&& ary)
+    {
+        this->cleanup();
+        this->type_ = value_t::array ;
+        this->region_info_ = std::make_shared<region_base>(region_base{});
+        assigner(this->array_, std::move(ary));
+        return *this;
+    }
 
     // array (initializer_list) ----------------------------------------------
 
@@ -918,6 +939,51 @@ class basic_value
         return *this;
     }
 
+    // array (STL Containers, moved) -----------------------------------------
+    //
+    // elements of an rvalue container are moved into the array instead of
+    // being copied.
+
+    template<typename T, typename std::enable_if<detail::conjunction<
+            detail::negation<std::is_reference<T>>,
+            detail::negation<std::is_const<T>>,
+            detail::negation<std::is_same<T, array_type>>,
+            detail::is_container<T>
+        >::value, std::nullptr_t>::type = nullptr>
+    basic_value(T&& list)
+        : type_(value_t::array),
+          region_info_(std::make_shared<region_base>(region_base{}))
+    {
+        static_assert(std::is_convertible<typename T::value_type, value_type>::value,
+            "elements of a container should be convertible to toml::value");
+
+        array_type ary;
+        ary.reserve(list.size());
+        for(auto&& elem : list) {ary.emplace_back(std::move(elem));}
+        assigner(this->array_, std::move(ary));
+    }
+    template<typename T, typename std::enable_if<detail::conjunction<
+            detail::negation<std::is_reference<T>>,
+            detail::negation<std::is_const<T>>,
+            detail::negation<std::is_same<T, array_type>>,
+            detail::is_container<T>
+        >::value, std::nullptr_t>::type = nullptr>
+    basic_value& operator=(T&& list)
+    {
+        static_assert(std::is_convertible<typename T::value_type, value_type>::value,
+            "elements of a container should be convertible to toml::value");
+
+        array_type ary;
+        ary.reserve(list.size());
+        for(auto&& elem : list) {ary.emplace_back(std::move(elem));}
+
+        this->cleanup();
+        this->type_ = value_t::array;
+        this->region_info_ = std::make_shared<region_base>(region_base{});
+        assigner(this->array_, std::move(ary));
+        return *this;
+    }
+
     // table ================================================================
 
     basic_value(const table_type& tab)
@@ -941,6 +1007,27 @@ class basic_value
         assigner(this->table_, tab);
         return *this;
     }
+    basic_value(table_type&& tab)
+        : type_(value_t::table),
+          region_info_(std::make_shared<region_base>(region_base{}))
+    {
+        assigner(this->table_, std::move(tab));
+    }
+    basic_value(table_type&& tab, std::vector<std::string> com)
+        : type_(value_t::table),
+          region_info_(std::make_shared<region_base>(region_base{})),
+          comments_(std::move(com))
+    {
+        assigner(this->table_, std::move(tab));
+    }
+    basic_value& operator=(table_type&& tab)
+    {
+        this->cleanup();
+        this->type_ = value_t::table;
+        this->region_info_ = std::make_shared<region_base>(region_base{});
+        assigner(this->table_, std::move(tab));
+        return *this;
+    }
 
     // initializer-list ------------------------------------------------------
 
@@ -1018,6 +1105,43 @@ class basic_value
         return *this;
     }
 
+    // other table-like (moved) ---------------------------------------------
+    //
+    // mapped values of an rvalue map are moved into the table instead of
+    // being copied.
+
+    template<typename Map, typename std::enable_if<detail::conjunction<
+            detail::negation<std::is_reference<Map>>,
+            detail::negation<std::is_const<Map>>,
+            detail::negation<std::is_same<Map, table_type>>,
+            detail::is_map<Map>
+        >::value, std::nullptr_t>::type = nullptr>
+    basic_value(Map&& mp)
+        : type_(value_t::table),
+          region_info_(std::make_shared<region_base>(region_base{}))
+    {
+        table_type tab;
+        for(auto& elem : mp) {tab[elem.first] = std::move(elem.second);}
+        assigner(this->table_, std::move(tab));
+    }
+    template<typename Map, typename std::enable_if<detail::conjunction<
+            detail::negation<std::is_reference<Map>>,
+            detail::negation<std::is_const<Map>>,
+            detail::negation<std::is_same<Map, table_type>>,
+            detail::is_map<Map>
+        >::value, std::nullptr_t>::type = nullptr>
+    basic_value& operator=(Map&& mp)
+    {
+        table_type tab;
+        for(auto& elem : mp) {tab[elem.first] = std::move(elem.second);}
+
+        this->cleanup();
+        this->type_ = value_t::table;
+        this->region_info_ = std::make_shared<region_base>(region_base{});
+        assigner(this->table_, std::move(tab));
+        return *this;
+    }
+
     // user-defined =========================================================
 
     // convert using into_toml() method -------------------------------------
@@ -0,0 +1,513 @@
+#include "TomlBinarySnapshot.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+template<typename T>
+bool CTomlBinarySnapshot::SReader::Read(T& output)
+{
+	if (bytes.size() - position < sizeof(T))
+	{
+		return false;
+	}
+
+	std::memcpy(&output, bytes.data() + position, sizeof(T));
+	position += sizeof(T);
+	return true;
+}
+
+bool CTomlBinarySnapshot::SReader::ReadString(std::string& output)
+{
+	std::uint32_t size = 0;
+	if (!Read(size) || bytes.size() - position < size)
+	{
+		return false;
+	}
+
+	output.assign(bytes.data() + position, size);
+	position += size;
+	return true;
+}
+
+template<typename T>
+void CTomlBinarySnapshot::WriteNumber(T number, std::string& output)
+{
+	char buffer[sizeof(T)];
+	std::memcpy(buffer, &number, sizeof(T));
+	output.append(buffer, sizeof(T));
+}
+
+void CTomlBinarySnapshot::WriteString(std::string_view text, std::string& output)
+{
+	WriteNumber(static_cast<std::uint32_t>(text.size()), output);
+	output.append(text);
+}
+
+bool CTomlBinarySnapshot::Write(const std::filesystem::path& snapshotPath, const std::filesystem::path& sourcePath, const toml::value& data)
+{
+	const auto optionalVersion = GetFileVersion(sourcePath);
+	if (!optionalVersion.has_value())
+	{
+		return false;
+	}
+	const auto snapshot = Serialize(data, optionalVersion->first, optionalVersion->second);
+
+	// Write to a temporary file first so that the snapshot is never left half-written.
+	auto tempSnapshotPath = snapshotPath;
+	tempSnapshotPath += ".tmp";
+	{
+		std::ofstream file(tempSnapshotPath, std::ios::binary);
+		if (!file.is_open())
+		{
+			return false;
+		}
+		file.write(snapshot.data(), static_cast<std::streamsize>(snapshot.size()));
+		if (!file.good())
+		{
+			return false;
+		}
+	}
+
+	std::error_code errorCode;
+	std::filesystem::rename(tempSnapshotPath, snapshotPath, errorCode);
+	return !errorCode;
+}
+
+std::optional<toml::value> CTomlBinarySnapshot::Read(const std::filesystem::path& snapshotPath, const std::filesystem::path& sourcePath)
+{
+	const auto optionalVersion = GetFileVersion(sourcePath);
+	if (!optionalVersion.has_value())
+	{
+		return {};
+	}
+
+	// Read file.
+	std::string snapshot;
+	{
+		std::ifstream file(snapshotPath, std::ios::binary);
+		if (!file.is_open())
+		{
+			return {};
+		}
+		std::ostringstream stream;
+		stream << file.rdbuf();
+		snapshot = std::move(stream).str();
+	}
+
+	return Deserialize(snapshot, optionalVersion->first, optionalVersion->second);
+}
+
+std::string CTomlBinarySnapshot::Serialize(const toml::value& data, std::uint64_t sourceFileSize, std::int64_t sourceWriteTime)
+{
+	std::string output;
+
+	// Header.
+	WriteNumber(m_magic, output);
+	WriteNumber(m_formatVersion, output);
+	WriteNumber(sourceFileSize, output);
+	WriteNumber(sourceWriteTime, output);
+
+	// Key table.
+	std::vector<const std::string*> keys;
+	std::unordered_map<std::string_view, std::uint32_t> indices;
+	InternKeys(data, keys, indices);
+	WriteNumber(static_cast<std::uint32_t>(keys.size()), output);
+	for (const auto pKey : keys)
+	{
+		WriteString(*pKey, output);
+	}
+
+	// Values.
+	WriteValue(data, indices, output);
+
+	return output;
+}
+
+std::optional<toml::value> CTomlBinarySnapshot::Deserialize(std::string_view snapshot, std::uint64_t sourceFileSize, std::int64_t sourceWriteTime)
+{
+	SReader reader;
+	reader.bytes = snapshot;
+
+	// Check header.
+	std::uint32_t magic = 0;
+	std::uint32_t formatVersion = 0;
+	std::uint64_t fileSize = 0;
+	std::int64_t writeTime = 0;
+	if (!reader.Read(magic) || !reader.Read(formatVersion) || !reader.Read(fileSize) || !reader.Read(writeTime)
+		|| magic != m_magic || formatVersion != m_formatVersion || fileSize != sourceFileSize || writeTime != sourceWriteTime)
+	{
+		return {};
+	}
+
+	// Read key table.
+	std::uint32_t keyCount = 0;
+	if (!reader.Read(keyCount) || keyCount > snapshot.size())
+	{
+		return {};
+	}
+	reader.keys.resize(keyCount);
+	for (auto& key : reader.keys)
+	{
+		if (!reader.ReadString(key))
+		{
+			return {};
+		}
+	}
+
+	// Read values.
+	toml::value data;
+	if (!ReadValue(reader, data, 0) || reader.position != snapshot.size())
+	{
+		return {};
+	}
+
+	return data;
+}
+
+std::optional<std::pair<std::uint64_t, std::int64_t>> CTomlBinarySnapshot::GetFileVersion(const std::filesystem::path& filePath)
+{
+	std::error_code errorCode;
+	const auto fileSize = std::filesystem::file_size(filePath, errorCode);
+	if (errorCode)
+	{
+		return {};
+	}
+	const auto writeTime = std::filesystem::last_write_time(filePath, errorCode);
+	if (errorCode)
+	{
+		return {};
+	}
+
+	return std::make_pair(
+		static_cast<std::uint64_t>(fileSize), static_cast<std::int64_t>(writeTime.time_since_epoch().count()));
+}
+
+void CTomlBinarySnapshot::InternKeys(
+	const toml::value& value, std::vector<const std::string*>& keys, std::unordered_map<std::string_view, std::uint32_t>& indices)
+{
+	if (value.is_array())
+	{
+		for (const auto& element : value.as_array(std::nothrow))
+		{
+			InternKeys(element, keys, indices);
+		}
+	}
+	else if (value.is_table())
+	{
+		for (const auto& [keyName, element] : value.as_table(std::nothrow))
+		{
+			if (indices.emplace(keyName, static_cast<std::uint32_t>(keys.size())).second)
+			{
+				keys.push_back(&keyName);
+			}
+			InternKeys(element, keys, indices);
+		}
+	}
+}
+
+void CTomlBinarySnapshot::WriteValue(
+	const toml::value& value, const std::unordered_map<std::string_view, std::uint32_t>& indices, std::string& output)
+{
+	const auto writeDate = [&output](const toml::local_date& date)
+	{
+		WriteNumber(date.year, output);
+		WriteNumber(date.month, output);
+		WriteNumber(date.day, output);
+	};
+	const auto writeTime = [&output](const toml::local_time& time)
+	{
+		WriteNumber(time.hour, output);
+		WriteNumber(time.minute, output);
+		WriteNumber(time.second, output);
+		WriteNumber(time.millisecond, output);
+		WriteNumber(time.microsecond, output);
+		WriteNumber(time.nanosecond, output);
+	};
+
+	switch (value.type())
+	{
+	case toml::value_t::boolean:
+		WriteNumber(EValueTag::Boolean, output);
+		WriteNumber(static_cast<std::uint8_t>(value.as_boolean(std::nothrow)), output);
+		break;
+	case toml::value_t::integer:
+		WriteNumber(EValueTag::Integer, output);
+		WriteNumber(value.as_integer(std::nothrow), output);
+		break;
+	case toml::value_t::floating:
+		WriteNumber(EValueTag::Floating, output);
+		WriteNumber(value.as_floating(std::nothrow), output);
+		break;
+	case toml::value_t::string:
+		WriteNumber(EValueTag::String, output);
+		WriteNumber(value.as_string(std::nothrow).kind, output);
+		WriteString(value.as_string(std::nothrow).str, output);
+		break;
+	case toml::value_t::offset_datetime:
+	{
+		const auto& datetime = value.as_offset_datetime(std::nothrow);
+		WriteNumber(EValueTag::OffsetDatetime, output);
+		writeDate(datetime.date);
+		writeTime(datetime.time);
+		WriteNumber(datetime.offset.hour, output);
+		WriteNumber(datetime.offset.minute, output);
+		break;
+	}
+	case toml::value_t::local_datetime:
+		WriteNumber(EValueTag::LocalDatetime, output);
+		writeDate(value.as_local_datetime(std::nothrow).date);
+		writeTime(value.as_local_datetime(std::nothrow).time);
+		break;
+	case toml::value_t::local_date:
+		WriteNumber(EValueTag::LocalDate, output);
+		writeDate(value.as_local_date(std::nothrow));
+		break;
+	case toml::value_t::local_time:
+		WriteNumber(EValueTag::LocalTime, output);
+		writeTime(value.as_local_time(std::nothrow));
+		break;
+	case toml::value_t::array:
+	{
+		const auto& array = value.as_array(std::nothrow);
+
+		// Store homogeneous arrays of numbers contiguously.
+		const auto elementType = array.empty() ? toml::value_t::empty : array.front().type();
+		const auto bIsHomogeneous = std::all_of(array.begin(), array.end(), [elementType](const toml::value& element)
+		{
+			return element.type() == elementType;
+		});
+		if (bIsHomogeneous && elementType == toml::value_t::integer)
+		{
+			WriteNumber(EValueTag::IntegerArray, output);
+			WriteNumber(static_cast<std::uint32_t>(array.size()), output);
+			for (const auto& element : array)
+			{
+				WriteNumber(element.as_integer(std::nothrow), output);
+			}
+			break;
+		}
+		if (bIsHomogeneous && elementType == toml::value_t::floating)
+		{
+			WriteNumber(EValueTag::FloatingArray, output);
+			WriteNumber(static_cast<std::uint32_t>(array.size()), output);
+			for (const auto& element : array)
+			{
+				WriteNumber(element.as_floating(std::nothrow), output);
+			}
+			break;
+		}
+
+		WriteNumber(EValueTag::Array, output);
+		WriteNumber(static_cast<std::uint32_t>(array.size()), output);
+		for (const auto& element : array)
+		{
+			WriteValue(element, indices, output);
+		}
+		break;
+	}
+	case toml::value_t::table:
+	{
+		const auto& table = value.as_table(std::nothrow);
+		WriteNumber(EValueTag::Table, output);
+		WriteNumber(static_cast<std::uint32_t>(table.size()), output);
+		for (const auto& [keyName, element] : table)
+		{
+			WriteNumber(indices.at(keyName), output);
+			WriteValue(element, indices, output);
+		}
+		break;
+	}
+	default:
+		WriteNumber(EValueTag::Empty, output);
+		break;
+	}
+}
+
+bool CTomlBinarySnapshot::ReadValue(SReader& reader, toml::value& output, size_t depth)
+{
+	if (depth > m_maxDepth)
+	{
+		return false;
+	}
+
+	const auto readDate = [&reader](toml::local_date& date)
+	{
+		return reader.Read(date.year) && reader.Read(date.month) && reader.Read(date.day);
+	};
+	const auto readTime = [&reader](toml::local_time& time)
+	{
+		return reader.Read(time.hour) && reader.Read(time.minute) && reader.Read(time.second)
+			&& reader.Read(time.millisecond) && reader.Read(time.microsecond) && reader.Read(time.nanosecond);
+	};
+
+	EValueTag tag = EValueTag::Empty;
+	if (!reader.Read(tag))
+	{
+		return false;
+	}
+
+	switch (tag)
+	{
+	case EValueTag::Empty:
+		output = toml::value();
+		return true;
+	case EValueTag::Boolean:
+	{
+		std::uint8_t boolean = 0;
+		if (!reader.Read(boolean))
+		{
+			return false;
+		}
+		output = toml::value(boolean != 0);
+		return true;
+	}
+	case EValueTag::Integer:
+	{
+		toml::integer integer = 0;
+		if (!reader.Read(integer))
+		{
+			return false;
+		}
+		output = toml::value(integer);
+		return true;
+	}
+	case EValueTag::Floating:
+	{
+		toml::floating floating = 0.0;
+		if (!reader.Read(floating))
+		{
+			return false;
+		}
+		output = toml::value(floating);
+		return true;
+	}
+	case EValueTag::String:
+	{
+		toml::string_t kind = toml::string_t::basic;
+		std::string text;
+		if (!reader.Read(kind) || !reader.ReadString(text))
+		{
+			return false;
+		}
+		output = toml::value(std::move(text), kind);
+		return true;
+	}
+	case EValueTag::OffsetDatetime:
+	{
+		toml::offset_datetime datetime;
+		if (!readDate(datetime.date) || !readTime(datetime.time) || !reader.Read(datetime.offset.hour) || !reader.Read(datetime.offset.minute))
+		{
+			return false;
+		}
+		output = toml::value(datetime);
+		return true;
+	}
+	case EValueTag::LocalDatetime:
+	{
+		toml::local_datetime datetime;
+		if (!readDate(datetime.date) || !readTime(datetime.time))
+		{
+			return false;
+		}
+		output = toml::value(datetime);
+		return true;
+	}
+	case EValueTag::LocalDate:
+	{
+		toml::local_date date;
+		if (!readDate(date))
+		{
+			return false;
+		}
+		output = toml::value(date);
+		return true;
+	}
+	case EValueTag::LocalTime:
+	{
+		toml::local_time time;
+		if (!readTime(time))
+		{
+			return false;
+		}
+		output = toml::value(time);
+		return true;
+	}
+	case EValueTag::IntegerArray:
+	case EValueTag::FloatingArray:
+	{
+		std::uint32_t size = 0;
+		if (!reader.Read(size) || (reader.bytes.size() - reader.position) / 8 < size)
+		{
+			return false;
+		}
+
+		toml::array array;
+		array.reserve(size);
+		for (std::uint32_t i = 0; i < size; i++)
+		{
+			if (tag == EValueTag::IntegerArray)
+			{
+				toml::integer integer = 0;
+				reader.Read(integer);
+				array.emplace_back(integer);
+			}
+			else
+			{
+				toml::floating floating = 0.0;
+				reader.Read(floating);
+				array.emplace_back(floating);
+			}
+		}
+		output = toml::value(std::move(array));
+		return true;
+	}
+	case EValueTag::Array:
+	{
+		std::uint32_t size = 0;
+		if (!reader.Read(size) || reader.bytes.size() - reader.position < size)
+		{
+			return false;
+		}
+
+		toml::array array(size);
+		for (auto& element : array)
+		{
+			if (!ReadValue(reader, element, depth + 1))
+			{
+				return false;
+			}
+		}
+		output = toml::value(std::move(array));
+		return true;
+	}
+	case EValueTag::Table:
+	{
+		std::uint32_t size = 0;
+		if (!reader.Read(size) || reader.bytes.size() - reader.position < size)
+		{
+			return false;
+		}
+
+		toml::table table;
+		table.reserve(size);
+		for (std::uint32_t i = 0; i < size; i++)
+		{
+			std::uint32_t keyIndex = 0;
+			if (!reader.Read(keyIndex) || keyIndex >= reader.keys.size())
+			{
+				return false;
+			}
+			if (!ReadValue(reader, table[reader.keys[keyIndex]], depth + 1))
+			{
+				return false;
+			}
+		}
+		output = toml::value(std::move(table));
+		return true;
+	}
+	default:
+		return false;
+	}
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "External/toml11/toml.hpp"
+
+//! Compact binary serialization of TOML data that is stored next to a document file (as a cache)
+//! to load the document without parsing its text.
+//! 
+//! \remark Format: header (magic, version, size and last write time of the text file), table of interned
+//! keys, then the value tree where strings and arrays are length-prefixed and homogeneous arrays of numbers
+//! are stored contiguously. Numbers are stored in native byte order (the snapshot is only a local cache).
+class CTomlBinarySnapshot
+{
+public:
+	CTomlBinarySnapshot() = delete;
+
+	//! Writes a snapshot of document's TOML data.
+	//! 
+	//! \param snapshotPath Path to the snapshot file.
+	//! \param sourcePath   Path to the text file that the data was parsed from.
+	//! \param data         Parsed TOML data.
+	//! 
+	//! \return 'false' if failed to write the file, 'true' otherwise.
+	static bool Write(const std::filesystem::path& snapshotPath, const std::filesystem::path& sourcePath, const toml::value& data);
+
+	//! Reads a snapshot of document's TOML data.
+	//! 
+	//! \param snapshotPath Path to the snapshot file.
+	//! \param sourcePath   Path to the text file that the snapshot was created for.
+	//! 
+	//! \remark Values read from a snapshot don't have source locations (error messages of toml11
+	//! about such values don't point to the text file).
+	//! 
+	//! \return Empty if the snapshot does not exist, is corrupted or the text file was modified
+	//! since the snapshot was written, otherwise TOML data.
+	static std::optional<toml::value> Read(const std::filesystem::path& snapshotPath, const std::filesystem::path& sourcePath);
+
+	//! Serializes TOML data.
+	//! 
+	//! \param data            TOML data.
+	//! \param sourceFileSize  Size of the text file.
+	//! \param sourceWriteTime Last write time of the text file.
+	//! 
+	//! \return Snapshot bytes.
+	static std::string Serialize(const toml::value& data, std::uint64_t sourceFileSize, std::int64_t sourceWriteTime);
+
+	//! Deserializes TOML data.
+	//! 
+	//! \param snapshot        Snapshot bytes.
+	//! \param sourceFileSize  Expected size of the text file.
+	//! \param sourceWriteTime Expected last write time of the text file.
+	//! 
+	//! \return Empty if the snapshot is corrupted or was created for a different version of the text file,
+	//! otherwise TOML data.
+	static std::optional<toml::value> Deserialize(std::string_view snapshot, std::uint64_t sourceFileSize, std::int64_t sourceWriteTime);
+
+	//! Returns size and last write time of a file.
+	//! 
+	//! \param filePath File to check.
+	//! 
+	//! \return Empty if failed to get file info, otherwise pair of size and last write time.
+	static std::optional<std::pair<std::uint64_t, std::int64_t>> GetFileVersion(const std::filesystem::path& filePath);
+
+private:
+
+	//! Type of a serialized value.
+	enum class EValueTag : std::uint8_t
+	{
+		Empty = 0,
+		Boolean,
+		Integer,
+		Floating,
+		String,
+		OffsetDatetime,
+		LocalDatetime,
+		LocalDate,
+		LocalTime,
+		Array,
+		Table,
+		IntegerArray,  //!< Array of integers stored contiguously.
+		FloatingArray, //!< Array of floats stored contiguously.
+	};
+
+	//! Reads bytes of a snapshot.
+	struct SReader
+	{
+		//! Snapshot bytes.
+		std::string_view bytes;
+
+		//! Position of the next byte to read.
+		size_t position = 0;
+
+		//! Interned keys.
+		std::vector<std::string> keys;
+
+		//! Reads a number.
+		//! 
+		//! \param output Read number.
+		//! 
+		//! \return 'false' if there are not enough bytes.
+		template<typename T>
+		bool Read(T& output);
+
+		//! Reads a length-prefixed string.
+		//! 
+		//! \param output Read string.
+		//! 
+		//! \return 'false' if there are not enough bytes.
+		bool ReadString(std::string& output);
+	};
+
+	//! Adds keys of all tables to the key table.
+	//! 
+	//! \param value   Value to scan.
+	//! \param keys    Interned keys in order of their indices.
+	//! \param indices Key -> index of the key.
+	static void InternKeys(const toml::value& value, std::vector<const std::string*>& keys, std::unordered_map<std::string_view, std::uint32_t>& indices);
+
+	//! Serializes a value.
+	//! 
+	//! \param value   Value to serialize.
+	//! \param indices Indices of interned keys.
+	//! \param output  Bytes to append to.
+	static void WriteValue(const toml::value& value, const std::unordered_map<std::string_view, std::uint32_t>& indices, std::string& output);
+
+	//! Deserializes a value.
+	//! 
+	//! \param reader Snapshot reader.
+	//! \param output Deserialized value.
+	//! \param depth  Nesting depth of the value.
+	//! 
+	//! \return 'false' if the snapshot is corrupted.
+	static bool ReadValue(SReader& reader, toml::value& output, size_t depth);
+
+	//! Appends a number to bytes.
+	//! 
+	//! \param number Number to append.
+	//! \param output Bytes to append to.
+	template<typename T>
+	static void WriteNumber(T number, std::string& output);
+
+	//! Appends a length-prefixed string to bytes.
+	//! 
+	//! \param text   String to append.
+	//! \param output Bytes to append to.
+	static void WriteString(std::string_view text, std::string& output);
+
+	//! First bytes of a snapshot.
+	static inline const std::uint32_t m_magic = 0x424C4D54; // "TMLB"
+
+	//! Version of the format, snapshots of other versions are ignored.
+	static inline const std::uint32_t m_formatVersion = 1;
+
+	//! Maximum nesting depth of values (deeper snapshots are treated as corrupted).
+	static inline const size_t m_maxDepth = 512;
+};
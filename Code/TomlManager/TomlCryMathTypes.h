@@ -0,0 +1,216 @@
+#pragma once
+
+#include <CryMath/Cry_Math.h>
+#include <CryMath/Cry_Color.h>
+#include "External/toml11/toml.hpp"
+
+//! Helper functions to store CRYENGINE math types as TOML arrays of numbers.
+class CTomlCryMathTypes
+{
+public:
+	CTomlCryMathTypes() = delete;
+
+	//! Reads numbers of a TOML array (both integer and float elements are accepted).
+	//! 
+	//! \param value   Value that should be an array of numbers.
+	//! \param pOutput Buffer to write numbers to.
+	//! \param count   Expected number of elements in the array.
+	//! 
+	//! \remark Throws toml::type_error if the value is not an array of exactly 'count' numbers.
+	template<typename F>
+	static void ReadNumbers(const toml::value& value, F* pOutput, size_t count)
+	{
+		const auto& array = value.as_array();
+		if (array.size() != count)
+		{
+			throw toml::type_error(
+				"expected an array of " + std::to_string(count) + " numbers, got " + std::to_string(array.size()) + " elements",
+				value.location());
+		}
+
+		for (size_t i = 0; i < count; i++)
+		{
+			const auto& element = array[i];
+			if (element.is_floating())
+			{
+				pOutput[i] = static_cast<F>(element.as_floating(std::nothrow));
+			}
+			else if (element.is_integer())
+			{
+				pOutput[i] = static_cast<F>(element.as_integer(std::nothrow));
+			}
+			else
+			{
+				throw toml::type_error("expected an array of numbers", element.location());
+			}
+		}
+	}
+
+	//! Creates a TOML array of numbers.
+	//! 
+	//! \param pInput Numbers to store.
+	//! \param count  Number of elements.
+	//! 
+	//! \return TOML array.
+	template<typename F>
+	static toml::value WriteNumbers(const F* pInput, size_t count)
+	{
+		toml::array array;
+		array.reserve(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			array.emplace_back(pInput[i]);
+		}
+
+		return toml::value(std::move(array));
+	}
+};
+
+namespace toml
+{
+	//! Vec2 is stored as [x, y].
+	template<typename F>
+	struct from<Vec2_tpl<F>>
+	{
+		static Vec2_tpl<F> from_toml(const value& v)
+		{
+			F numbers[2];
+			CTomlCryMathTypes::ReadNumbers(v, numbers, 2);
+			return Vec2_tpl<F>(numbers[0], numbers[1]);
+		}
+	};
+
+	//! Vec2 is stored as [x, y].
+	template<typename F>
+	struct into<Vec2_tpl<F>>
+	{
+		static value into_toml(const Vec2_tpl<F>& v)
+		{
+			const F numbers[] = { v.x, v.y };
+			return CTomlCryMathTypes::WriteNumbers(numbers, 2);
+		}
+	};
+
+	//! Vec3 is stored as [x, y, z].
+	template<typename F>
+	struct from<Vec3_tpl<F>>
+	{
+		static Vec3_tpl<F> from_toml(const value& v)
+		{
+			F numbers[3];
+			CTomlCryMathTypes::ReadNumbers(v, numbers, 3);
+			return Vec3_tpl<F>(numbers[0], numbers[1], numbers[2]);
+		}
+	};
+
+	//! Vec3 is stored as [x, y, z].
+	template<typename F>
+	struct into<Vec3_tpl<F>>
+	{
+		static value into_toml(const Vec3_tpl<F>& v)
+		{
+			const F numbers[] = { v.x, v.y, v.z };
+			return CTomlCryMathTypes::WriteNumbers(numbers, 3);
+		}
+	};
+
+	//! Vec4 is stored as [x, y, z, w].
+	template<typename F>
+	struct from<Vec4_tpl<F>>
+	{
+		static Vec4_tpl<F> from_toml(const value& v)
+		{
+			F numbers[4];
+			CTomlCryMathTypes::ReadNumbers(v, numbers, 4);
+			return Vec4_tpl<F>(numbers[0], numbers[1], numbers[2], numbers[3]);
+		}
+	};
+
+	//! Vec4 is stored as [x, y, z, w].
+	template<typename F>
+	struct into<Vec4_tpl<F>>
+	{
+		static value into_toml(const Vec4_tpl<F>& v)
+		{
+			const F numbers[] = { v.x, v.y, v.z, v.w };
+			return CTomlCryMathTypes::WriteNumbers(numbers, 4);
+		}
+	};
+
+	//! Quat is stored as [w, x, y, z] (same order as Quat constructor).
+	template<typename F>
+	struct from<Quat_tpl<F>>
+	{
+		static Quat_tpl<F> from_toml(const value& v)
+		{
+			F numbers[4];
+			CTomlCryMathTypes::ReadNumbers(v, numbers, 4);
+			return Quat_tpl<F>(numbers[0], numbers[1], numbers[2], numbers[3]);
+		}
+	};
+
+	//! Quat is stored as [w, x, y, z] (same order as Quat constructor).
+	template<typename F>
+	struct into<Quat_tpl<F>>
+	{
+		static value into_toml(const Quat_tpl<F>& q)
+		{
+			const F numbers[] = { q.w, q.v.x, q.v.y, q.v.z };
+			return CTomlCryMathTypes::WriteNumbers(numbers, 4);
+		}
+	};
+
+	//! Color is stored as [r, g, b, a].
+	template<typename F>
+	struct from<Color_tpl<F>>
+	{
+		static Color_tpl<F> from_toml(const value& v)
+		{
+			F numbers[4];
+			CTomlCryMathTypes::ReadNumbers(v, numbers, 4);
+			return Color_tpl<F>(numbers[0], numbers[1], numbers[2], numbers[3]);
+		}
+	};
+
+	//! Color is stored as [r, g, b, a].
+	template<typename F>
+	struct into<Color_tpl<F>>
+	{
+		static value into_toml(const Color_tpl<F>& c)
+		{
+			const F numbers[] = { c.r, c.g, c.b, c.a };
+			return CTomlCryMathTypes::WriteNumbers(numbers, 4);
+		}
+	};
+
+	//! Matrix34 is stored as 12 numbers in row-major order [m00, m01, m02, m03, m10, ..., m23].
+	template<typename F>
+	struct from<Matrix34_tpl<F>>
+	{
+		static Matrix34_tpl<F> from_toml(const value& v)
+		{
+			F numbers[12];
+			CTomlCryMathTypes::ReadNumbers(v, numbers, 12);
+
+			Matrix34_tpl<F> m;
+			m.m00 = numbers[0]; m.m01 = numbers[1]; m.m02 = numbers[2];  m.m03 = numbers[3];
+			m.m10 = numbers[4]; m.m11 = numbers[5]; m.m12 = numbers[6];  m.m13 = numbers[7];
+			m.m20 = numbers[8]; m.m21 = numbers[9]; m.m22 = numbers[10]; m.m23 = numbers[11];
+			return m;
+		}
+	};
+
+	//! Matrix34 is stored as 12 numbers in row-major order [m00, m01, m02, m03, m10, ..., m23].
+	template<typename F>
+	struct into<Matrix34_tpl<F>>
+	{
+		static value into_toml(const Matrix34_tpl<F>& m)
+		{
+			const F numbers[] = {
+				m.m00, m.m01, m.m02, m.m03,
+				m.m10, m.m11, m.m12, m.m13,
+				m.m20, m.m21, m.m22, m.m23 };
+			return CTomlCryMathTypes::WriteNumbers(numbers, 12);
+		}
+	};
+}
@@ -0,0 +1,134 @@
+#include "TomlDirectoryWatcher.h"
+
+#if __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+CTomlDirectoryWatcher::CTomlDirectoryWatcher(const std::filesystem::path& directoryPath)
+	: m_directoryPath(directoryPath)
+{
+	StartNotifications();
+
+	// Remember initial state for polling.
+	PollModifications();
+}
+
+CTomlDirectoryWatcher::~CTomlDirectoryWatcher()
+{
+	StopNotifications();
+}
+
+bool CTomlDirectoryWatcher::ConsumeModifications()
+{
+#if __linux__
+	if (m_inotifyFd >= 0)
+	{
+		bool bModified = false;
+
+		// Drain all pending events.
+		alignas(inotify_event) char buffer[4096];
+		while (true)
+		{
+			const auto readBytes = read(m_inotifyFd, buffer, sizeof(buffer));
+			if (readBytes <= 0)
+			{
+				if (readBytes < 0 && errno == EINTR)
+				{
+					continue;
+				}
+				break;
+			}
+			bModified = true;
+
+			// The directory itself is gone, watch is removed by the kernel.
+			for (ssize_t offset = 0; offset < readBytes;)
+			{
+				const auto pEvent = reinterpret_cast<const inotify_event*>(buffer + offset);
+				if ((pEvent->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) != 0)
+				{
+					StopNotifications();
+					PollModifications();
+					return true;
+				}
+				offset += sizeof(inotify_event) + pEvent->len;
+			}
+		}
+
+		return bModified;
+	}
+#endif
+
+	const auto bModified = PollModifications();
+
+	// The directory might have been created, try to use notifications again.
+	if (bModified && m_bLastWriteTimeValid)
+	{
+		StartNotifications();
+	}
+
+	return bModified;
+}
+
+bool CTomlDirectoryWatcher::IsUsingNotifications() const
+{
+#if __linux__
+	return m_inotifyFd >= 0;
+#else
+	return false;
+#endif
+}
+
+void CTomlDirectoryWatcher::StartNotifications()
+{
+#if __linux__
+	if (m_inotifyFd >= 0)
+	{
+		return;
+	}
+
+	m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (m_inotifyFd < 0)
+	{
+		return;
+	}
+
+	// Only changes of the file list are interesting (not file contents).
+	const auto mask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF;
+	if (inotify_add_watch(m_inotifyFd, m_directoryPath.c_str(), mask) < 0)
+	{
+		// Probably the directory does not exist yet.
+		StopNotifications();
+	}
+#endif
+}
+
+void CTomlDirectoryWatcher::StopNotifications()
+{
+#if __linux__
+	if (m_inotifyFd >= 0)
+	{
+		close(m_inotifyFd);
+		m_inotifyFd = -1;
+	}
+#endif
+}
+
+bool CTomlDirectoryWatcher::PollModifications()
+{
+	// Creating, removing or renaming files changes directory's last write time.
+	std::error_code errorCode;
+	const auto lastWriteTime = std::filesystem::last_write_time(m_directoryPath, errorCode);
+	if (errorCode)
+	{
+		m_bLastWriteTimeValid = false;
+		return true;
+	}
+
+	const auto bModified = !m_bLastWriteTimeValid || lastWriteTime != m_lastWriteTime;
+	m_lastWriteTime = lastWriteTime;
+	m_bLastWriteTimeValid = true;
+
+	return bModified;
+}
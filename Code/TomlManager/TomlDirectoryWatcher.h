@@ -0,0 +1,60 @@
+#pragma once
+
+#include <filesystem>
+
+//! Detects modifications of a directory (files created, removed or renamed) without scanning it.
+//! Uses inotify on Linux and falls back to polling directory's last write time on other platforms
+//! (or if inotify is not available or the directory does not exist yet).
+class CTomlDirectoryWatcher
+{
+public:
+	//! Starts watching the directory.
+	//! 
+	//! \param directoryPath Directory to watch (might not exist).
+	CTomlDirectoryWatcher(const std::filesystem::path& directoryPath);
+
+	//! Stops watching the directory.
+	~CTomlDirectoryWatcher();
+
+	CTomlDirectoryWatcher(const CTomlDirectoryWatcher&) = delete;
+	CTomlDirectoryWatcher& operator=(const CTomlDirectoryWatcher&) = delete;
+
+	//! Checks whether the directory was modified since the last call (or since the watcher was created).
+	//! 
+	//! \remark Does not block.
+	//! 
+	//! \return 'true' if the directory might have been modified (or does not exist), 'false' otherwise.
+	bool ConsumeModifications();
+
+	//! Tells whether the directory is watched using OS notifications (without polling).
+	//! 
+	//! \return 'true' if OS notifications are used, 'false' if polling is used.
+	bool IsUsingNotifications() const;
+
+private:
+
+	//! Starts using OS notifications (if available and the directory exists).
+	void StartNotifications();
+
+	//! Stops using OS notifications and switches to polling.
+	void StopNotifications();
+
+	//! Checks whether directory's last write time changed since the last call.
+	//! 
+	//! \return 'true' if the directory might have been modified (or does not exist), 'false' otherwise.
+	bool PollModifications();
+
+	//! Watched directory.
+	std::filesystem::path m_directoryPath;
+
+	//! Directory's last write time that was seen by \ref PollModifications.
+	std::filesystem::file_time_type m_lastWriteTime;
+
+	//! Whether \ref m_lastWriteTime is valid (the directory existed).
+	bool m_bLastWriteTimeValid = false;
+
+#if __linux__
+	//! inotify instance (-1 if not used).
+	int m_inotifyFd = -1;
+#endif
+};
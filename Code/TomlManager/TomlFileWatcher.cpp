@@ -0,0 +1,236 @@
+#include "TomlFileWatcher.h"
+
+#include "TomlBinarySnapshot.h"
+#if __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+CTomlFileWatcher::CTomlFileWatcher()
+{
+#if __linux__
+	m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+}
+
+CTomlFileWatcher::~CTomlFileWatcher()
+{
+#if __linux__
+	if (m_inotifyFd >= 0)
+	{
+		close(m_inotifyFd);
+	}
+#endif
+}
+
+void CTomlFileWatcher::AddFile(const std::filesystem::path& filePath)
+{
+	auto& watchedFile = m_files[GetFileKey(filePath)];
+	watchedFile.referenceCount += 1;
+	if (watchedFile.referenceCount > 1)
+	{
+		return;
+	}
+
+	// Only modifications made after this call are reported.
+	watchedFile.filePath = filePath;
+	CheckFile(watchedFile);
+
+	WatchDirectory(filePath.parent_path());
+}
+
+void CTomlFileWatcher::RemoveFile(const std::filesystem::path& filePath)
+{
+	const auto fileIt = m_files.find(GetFileKey(filePath));
+	if (fileIt == m_files.end())
+	{
+		return;
+	}
+
+	fileIt->second.referenceCount -= 1;
+	if (fileIt->second.referenceCount > 0)
+	{
+		return;
+	}
+	m_files.erase(fileIt);
+
+	UnwatchDirectory(filePath.parent_path());
+}
+
+std::vector<std::filesystem::path> CTomlFileWatcher::ConsumeModifiedFiles()
+{
+	std::vector<std::filesystem::path> modifiedFiles;
+
+	// Check files that were reported by OS notifications.
+	std::vector<std::string> notifiedFileKeys;
+	const auto bCheckAllFiles = ReadNotifications(notifiedFileKeys);
+	for (const auto& fileKey : notifiedFileKeys)
+	{
+		const auto fileIt = m_files.find(fileKey);
+		if (!bCheckAllFiles && fileIt != m_files.end() && CheckFile(fileIt->second))
+		{
+			modifiedFiles.push_back(fileIt->second.filePath);
+		}
+	}
+
+	// Poll files that are not watched using OS notifications.
+	for (auto& [fileKey, watchedFile] : m_files)
+	{
+		if (!bCheckAllFiles && IsUsingNotifications(watchedFile.filePath))
+		{
+			continue;
+		}
+
+		const auto bExisted = watchedFile.fileVersion.has_value();
+		if (CheckFile(watchedFile))
+		{
+			modifiedFiles.push_back(watchedFile.filePath);
+		}
+
+		// The directory might have been created, try to use notifications again.
+		if (!bExisted && watchedFile.fileVersion.has_value())
+		{
+			WatchDirectory(watchedFile.filePath.parent_path());
+		}
+	}
+
+	return modifiedFiles;
+}
+
+bool CTomlFileWatcher::IsUsingNotifications(const std::filesystem::path& filePath) const
+{
+#if __linux__
+	return m_directoryWatches.find(GetFileKey(filePath.parent_path())) != m_directoryWatches.end();
+#else
+	return false;
+#endif
+}
+
+std::string CTomlFileWatcher::GetFileKey(const std::filesystem::path& filePath)
+{
+	return filePath.lexically_normal().string();
+}
+
+bool CTomlFileWatcher::CheckFile(SWatchedFile& watchedFile)
+{
+	const auto optionalFileVersion = CTomlBinarySnapshot::GetFileVersion(watchedFile.filePath);
+	const auto bModified = optionalFileVersion.has_value() && optionalFileVersion != watchedFile.fileVersion;
+	watchedFile.fileVersion = optionalFileVersion;
+
+	return bModified;
+}
+
+void CTomlFileWatcher::WatchDirectory(const std::filesystem::path& directoryPath)
+{
+#if __linux__
+	const auto directoryKey = GetFileKey(directoryPath);
+	if (m_inotifyFd < 0 || m_directoryWatches.find(directoryKey) != m_directoryWatches.end())
+	{
+		return;
+	}
+
+	// Files are either written in place or written to a temporary file that replaces them.
+	const auto mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF;
+	const auto watchDescriptor = inotify_add_watch(m_inotifyFd, directoryPath.c_str(), mask);
+	if (watchDescriptor < 0)
+	{
+		// Probably the directory does not exist yet, files are polled.
+		return;
+	}
+
+	m_directoryWatches[directoryKey] = watchDescriptor;
+	m_watchedDirectories[watchDescriptor] = directoryKey;
+#endif
+}
+
+void CTomlFileWatcher::UnwatchDirectory(const std::filesystem::path& directoryPath)
+{
+#if __linux__
+	const auto directoryKey = GetFileKey(directoryPath);
+	const auto watchIt = m_directoryWatches.find(directoryKey);
+	if (watchIt == m_directoryWatches.end())
+	{
+		return;
+	}
+
+	// Keep watching while other files of the directory are watched.
+	for (const auto& [fileKey, watchedFile] : m_files)
+	{
+		if (GetFileKey(watchedFile.filePath.parent_path()) == directoryKey)
+		{
+			return;
+		}
+	}
+
+	inotify_rm_watch(m_inotifyFd, watchIt->second);
+	m_watchedDirectories.erase(watchIt->second);
+	m_directoryWatches.erase(watchIt);
+#endif
+}
+
+bool CTomlFileWatcher::ReadNotifications(std::vector<std::string>& modifiedFileKeys)
+{
+	bool bCheckAllFiles = false;
+
+#if __linux__
+	if (m_inotifyFd < 0)
+	{
+		return false;
+	}
+
+	// Drain all pending events.
+	alignas(inotify_event) char buffer[4096];
+	while (true)
+	{
+		const auto readBytes = read(m_inotifyFd, buffer, sizeof(buffer));
+		if (readBytes <= 0)
+		{
+			if (readBytes < 0 && errno == EINTR)
+			{
+				continue;
+			}
+			break;
+		}
+
+		for (ssize_t offset = 0; offset < readBytes;)
+		{
+			const auto pEvent = reinterpret_cast<const inotify_event*>(buffer + offset);
+			offset += sizeof(inotify_event) + pEvent->len;
+
+			// Events were lost, all files need to be checked.
+			if ((pEvent->mask & IN_Q_OVERFLOW) != 0)
+			{
+				bCheckAllFiles = true;
+				continue;
+			}
+
+			const auto directoryIt = m_watchedDirectories.find(pEvent->wd);
+			if (directoryIt == m_watchedDirectories.end())
+			{
+				continue;
+			}
+
+			// The directory itself is gone, watch is removed by the kernel and its files are polled.
+			if ((pEvent->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) != 0)
+			{
+				if ((pEvent->mask & IN_IGNORED) == 0)
+				{
+					inotify_rm_watch(m_inotifyFd, pEvent->wd);
+				}
+				m_directoryWatches.erase(directoryIt->second);
+				m_watchedDirectories.erase(directoryIt);
+				bCheckAllFiles = true;
+				continue;
+			}
+
+			if (pEvent->len > 0)
+			{
+				modifiedFileKeys.push_back(GetFileKey(std::filesystem::path(directoryIt->second) / pEvent->name));
+			}
+		}
+	}
+#endif
+
+	return bCheckAllFiles;
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+//! Detects modifications of file contents (files written or replaced). Uses inotify on directories of the files
+//! on Linux and falls back to polling size and last write time of the files on other platforms
+//! (or if inotify is not available or the directory of a file does not exist yet).
+//! 
+//! \remark Not thread-safe.
+class CTomlFileWatcher
+{
+public:
+	//! Constructor.
+	CTomlFileWatcher();
+
+	//! Stops watching all files.
+	~CTomlFileWatcher();
+
+	CTomlFileWatcher(const CTomlFileWatcher&) = delete;
+	CTomlFileWatcher& operator=(const CTomlFileWatcher&) = delete;
+
+	//! Starts watching a file (a file can be added several times, it's watched until it's removed the same number of times).
+	//! 
+	//! \param filePath File to watch (might not exist).
+	void AddFile(const std::filesystem::path& filePath);
+
+	//! Stops watching a file added with \ref AddFile.
+	//! 
+	//! \param filePath Watched file.
+	void RemoveFile(const std::filesystem::path& filePath);
+
+	//! Returns files that were modified since the last call (or since they were added).
+	//! 
+	//! \remark Does not block. Removed files are not reported.
+	//! 
+	//! \return Paths of modified files (as they were added).
+	std::vector<std::filesystem::path> ConsumeModifiedFiles();
+
+	//! Tells whether a file is watched using OS notifications (without polling).
+	//! 
+	//! \param filePath Watched file.
+	//! 
+	//! \return 'true' if OS notifications are used, 'false' if polling is used or the file is not watched.
+	bool IsUsingNotifications(const std::filesystem::path& filePath) const;
+
+private:
+
+	//! Describes a watched file.
+	struct SWatchedFile
+	{
+		//! Path to the file as it was added.
+		std::filesystem::path filePath;
+
+		//! Number of times the file was added.
+		size_t referenceCount = 0;
+
+		//! Size and last write time of the file that was seen last, empty if the file did not exist.
+		std::optional<std::pair<std::uint64_t, std::int64_t>> fileVersion;
+	};
+
+	//! Returns key of a file in \ref m_files.
+	//! 
+	//! \param filePath Path to the file.
+	//! 
+	//! \return Normalized path.
+	static std::string GetFileKey(const std::filesystem::path& filePath);
+
+	//! Checks whether a file was modified since it was seen last and remembers its current version.
+	//! 
+	//! \param watchedFile File to check.
+	//! 
+	//! \return 'true' if the file exists and was modified, 'false' otherwise.
+	static bool CheckFile(SWatchedFile& watchedFile);
+
+	//! Starts using OS notifications for a directory (if available and the directory exists).
+	//! 
+	//! \param directoryPath Directory of watched files.
+	void WatchDirectory(const std::filesystem::path& directoryPath);
+
+	//! Stops using OS notifications for a directory (if it has no watched files).
+	//! 
+	//! \param directoryPath Directory of watched files.
+	void UnwatchDirectory(const std::filesystem::path& directoryPath);
+
+	//! Reads pending OS notifications.
+	//! 
+	//! \param modifiedFileKeys Keys of files that were reported as modified (might be not modified).
+	//! 
+	//! \return 'true' if all files should be checked (notifications were lost), 'false' otherwise.
+	bool ReadNotifications(std::vector<std::string>& modifiedFileKeys);
+
+	//! Watched files (normalized path -> file).
+	std::unordered_map<std::string, SWatchedFile> m_files;
+
+#if __linux__
+	//! inotify instance (-1 if not used).
+	int m_inotifyFd = -1;
+
+	//! Watched directories (normalized path -> watch descriptor).
+	std::unordered_map<std::string, int> m_directoryWatches;
+
+	//! Watched directories (watch descriptor -> normalized path).
+	std::unordered_map<int, std::string> m_watchedDirectories;
+#endif
+};
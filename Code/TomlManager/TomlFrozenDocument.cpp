@@ -0,0 +1,686 @@
+#include "TomlFrozenDocument.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <vector>
+#include "TomlBinarySnapshot.h"
+#if defined(WIN32)
+#include <windows.h>
+#elif __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+CTomlFrozenDocument::~CTomlFrozenDocument()
+{
+	if (m_pMappedView == nullptr)
+	{
+		return;
+	}
+
+#if defined(WIN32)
+	UnmapViewOfFile(m_pMappedView);
+#elif __linux__
+	munmap(m_pMappedView, m_bufferSize);
+#endif
+}
+
+template<typename T>
+void CTomlFrozenDocument::WriteNumber(T number, std::string& output)
+{
+	char buffer[sizeof(T)];
+	std::memcpy(buffer, &number, sizeof(T));
+	output.append(buffer, sizeof(T));
+}
+
+template<typename T>
+bool CTomlFrozenDocument::Read(size_t offset, T& output) const
+{
+	if (offset > m_bufferSize || m_bufferSize - offset < sizeof(T))
+	{
+		return false;
+	}
+
+	std::memcpy(&output, m_pBuffer + offset, sizeof(T));
+	return true;
+}
+
+void CTomlFrozenDocument::WriteSlot(const SValue& value, std::string& output)
+{
+	WriteNumber(value.tag, output);
+	WriteNumber(value.stringKind, output);
+	WriteNumber(static_cast<std::uint16_t>(0), output);
+	WriteNumber(static_cast<std::uint32_t>(0), output);
+	WriteNumber(value.payload, output);
+}
+
+void CTomlFrozenDocument::Align(std::string& output)
+{
+	output.resize((output.size() + 7) / 8 * 8, '\0');
+}
+
+std::optional<std::string> CTomlFrozenDocument::Freeze(const toml::value& data, std::uint64_t sourceFileSize, std::int64_t sourceWriteTime)
+{
+	// Nodes (the header is written when the root slot is known).
+	std::string output(m_headerSize, '\0');
+	std::unordered_map<std::string_view, std::uint32_t> keys;
+	const auto root = WriteValue(data, keys, output);
+	if (output.size() > std::numeric_limits<std::uint32_t>::max())
+	{
+		return {};
+	}
+
+	// Header.
+	std::string header;
+	WriteNumber(m_magic, header);
+	WriteNumber(m_formatVersion, header);
+	WriteNumber(sourceFileSize, header);
+	WriteNumber(sourceWriteTime, header);
+	WriteSlot(root, header);
+	output.replace(0, m_headerSize, header);
+
+	return output;
+}
+
+std::unique_ptr<CTomlFrozenDocument> CTomlFrozenDocument::Load(std::string buffer)
+{
+	std::unique_ptr<CTomlFrozenDocument> pDocument(new CTomlFrozenDocument());
+	pDocument->m_ownedBuffer = std::move(buffer);
+	pDocument->m_pBuffer = pDocument->m_ownedBuffer.data();
+	pDocument->m_bufferSize = pDocument->m_ownedBuffer.size();
+	if (!pDocument->ReadHeader())
+	{
+		return nullptr;
+	}
+
+	return pDocument;
+}
+
+std::unique_ptr<CTomlFrozenDocument> CTomlFrozenDocument::LoadView(const void* pBuffer, size_t size)
+{
+	std::unique_ptr<CTomlFrozenDocument> pDocument(new CTomlFrozenDocument());
+	pDocument->m_pBuffer = static_cast<const char*>(pBuffer);
+	pDocument->m_bufferSize = size;
+	if (pBuffer == nullptr || !pDocument->ReadHeader())
+	{
+		return nullptr;
+	}
+
+	return pDocument;
+}
+
+std::unique_ptr<CTomlFrozenDocument> CTomlFrozenDocument::Map(const std::filesystem::path& frozenPath, const std::filesystem::path& sourcePath)
+{
+	const auto optionalVersion = CTomlBinarySnapshot::GetFileVersion(sourcePath);
+	if (!optionalVersion.has_value())
+	{
+		return nullptr;
+	}
+
+	std::unique_ptr<CTomlFrozenDocument> pDocument(new CTomlFrozenDocument());
+#if defined(WIN32)
+	const auto fileHandle = CreateFileW(
+		frozenPath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		return nullptr;
+	}
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(fileHandle, &fileSize) || static_cast<std::uint64_t>(fileSize.QuadPart) < m_headerSize)
+	{
+		CloseHandle(fileHandle);
+		return nullptr;
+	}
+	const auto mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(fileHandle);
+	if (mappingHandle == nullptr)
+	{
+		return nullptr;
+	}
+
+	// The view keeps the mapping alive.
+	const auto pView = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mappingHandle);
+	if (pView == nullptr)
+	{
+		return nullptr;
+	}
+	pDocument->m_pMappedView = pView;
+	pDocument->m_bufferSize = static_cast<size_t>(fileSize.QuadPart);
+	pDocument->m_pBuffer = static_cast<const char*>(pView);
+#elif __linux__
+	const auto fileDescriptor = open(frozenPath.c_str(), O_RDONLY);
+	if (fileDescriptor < 0)
+	{
+		return nullptr;
+	}
+	struct stat fileInfo;
+	if (fstat(fileDescriptor, &fileInfo) != 0 || fileInfo.st_size < static_cast<off_t>(m_headerSize))
+	{
+		close(fileDescriptor);
+		return nullptr;
+	}
+
+	// The mapping stays valid after the file is closed.
+	const auto pView = mmap(nullptr, static_cast<size_t>(fileInfo.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+	close(fileDescriptor);
+	if (pView == MAP_FAILED)
+	{
+		return nullptr;
+	}
+	pDocument->m_pMappedView = pView;
+	pDocument->m_bufferSize = static_cast<size_t>(fileInfo.st_size);
+	pDocument->m_pBuffer = static_cast<const char*>(pView);
+#else
+	// No memory mapping, read the whole file.
+	{
+		std::ifstream file(frozenPath, std::ios::binary);
+		if (!file.is_open())
+		{
+			return nullptr;
+		}
+		std::ostringstream stream;
+		stream << file.rdbuf();
+		pDocument->m_ownedBuffer = std::move(stream).str();
+	}
+	pDocument->m_pBuffer = pDocument->m_ownedBuffer.data();
+	pDocument->m_bufferSize = pDocument->m_ownedBuffer.size();
+#endif
+
+	if (!pDocument->ReadHeader()
+		|| pDocument->m_sourceFileSize != optionalVersion->first || pDocument->m_sourceWriteTime != optionalVersion->second)
+	{
+		return nullptr;
+	}
+
+	return pDocument;
+}
+
+bool CTomlFrozenDocument::WriteFile(const std::filesystem::path& frozenPath, std::string_view buffer)
+{
+	// Write to a temporary file first so that the buffer is never left half-written.
+	auto tempFrozenPath = frozenPath;
+	tempFrozenPath += ".tmp";
+	{
+		std::ofstream file(tempFrozenPath, std::ios::binary);
+		if (!file.is_open())
+		{
+			return false;
+		}
+		file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+		if (!file.good())
+		{
+			return false;
+		}
+	}
+
+	std::error_code errorCode;
+	std::filesystem::rename(tempFrozenPath, frozenPath, errorCode);
+	return !errorCode;
+}
+
+bool CTomlFrozenDocument::ReadHeader()
+{
+	std::uint32_t magic = 0;
+	std::uint32_t formatVersion = 0;
+	if (!Read(0, magic) || !Read(4, formatVersion) || !Read(8, m_sourceFileSize) || !Read(16, m_sourceWriteTime)
+		|| !ReadSlot(24, m_root))
+	{
+		return false;
+	}
+
+	return magic == m_magic && formatVersion == m_formatVersion;
+}
+
+CTomlFrozenDocument::SValue CTomlFrozenDocument::GetRoot() const
+{
+	return m_root;
+}
+
+bool CTomlFrozenDocument::ReadSlot(size_t offset, SValue& output) const
+{
+	if (!Read(offset, output.tag) || !Read(offset + 1, output.stringKind) || !Read(offset + 8, output.payload))
+	{
+		return false;
+	}
+
+	return output.tag <= EValueTag::Table;
+}
+
+bool CTomlFrozenDocument::ReadKey(size_t entryOffset, std::string_view& output) const
+{
+	std::uint32_t keyOffset = 0;
+	std::uint32_t keyLength = 0;
+	if (!Read(entryOffset, keyOffset) || !Read(entryOffset + 4, keyLength)
+		|| keyOffset > m_bufferSize || m_bufferSize - keyOffset < keyLength)
+	{
+		return false;
+	}
+
+	output = std::string_view(m_pBuffer + keyOffset, keyLength);
+	return true;
+}
+
+bool CTomlFrozenDocument::ReadCount(size_t nodeOffset, size_t elementSize, std::uint32_t& output) const
+{
+	if (!Read(nodeOffset, output) || m_bufferSize - nodeOffset < m_nodeHeaderSize)
+	{
+		return false;
+	}
+
+	return (m_bufferSize - nodeOffset - m_nodeHeaderSize) / elementSize >= output;
+}
+
+std::optional<CTomlFrozenDocument::SValue> CTomlFrozenDocument::Find(const SValue& table, std::string_view keyName) const
+{
+	std::uint32_t count = 0;
+	if (table.tag != EValueTag::Table || !ReadCount(table.payload, m_entrySize, count))
+	{
+		return {};
+	}
+
+	// Binary search over sorted keys.
+	const auto entriesOffset = table.payload + m_nodeHeaderSize;
+	size_t first = 0;
+	size_t last = count;
+	while (first < last)
+	{
+		const auto middle = first + (last - first) / 2;
+		const auto entryOffset = entriesOffset + middle * m_entrySize;
+
+		std::string_view entryKey;
+		if (!ReadKey(entryOffset, entryKey))
+		{
+			return {};
+		}
+
+		const auto comparison = entryKey.compare(keyName);
+		if (comparison == 0)
+		{
+			SValue value;
+			if (!ReadSlot(entryOffset + 8, value))
+			{
+				return {};
+			}
+			return value;
+		}
+
+		if (comparison < 0)
+		{
+			first = middle + 1;
+		}
+		else
+		{
+			last = middle;
+		}
+	}
+
+	return {};
+}
+
+size_t CTomlFrozenDocument::GetSize(const SValue& value) const
+{
+	std::uint32_t count = 0;
+	if (value.tag == EValueTag::Array && ReadCount(value.payload, m_slotSize, count))
+	{
+		return count;
+	}
+	if (value.tag == EValueTag::Table && ReadCount(value.payload, m_entrySize, count))
+	{
+		return count;
+	}
+
+	return 0;
+}
+
+std::optional<CTomlFrozenDocument::SValue> CTomlFrozenDocument::GetElement(const SValue& array, size_t index) const
+{
+	std::uint32_t count = 0;
+	if (array.tag != EValueTag::Array || !ReadCount(array.payload, m_slotSize, count) || index >= count)
+	{
+		return {};
+	}
+
+	SValue element;
+	if (!ReadSlot(array.payload + m_nodeHeaderSize + index * m_slotSize, element))
+	{
+		return {};
+	}
+
+	return element;
+}
+
+std::optional<std::pair<std::string_view, CTomlFrozenDocument::SValue>> CTomlFrozenDocument::GetEntry(const SValue& table, size_t index) const
+{
+	std::uint32_t count = 0;
+	if (table.tag != EValueTag::Table || !ReadCount(table.payload, m_entrySize, count) || index >= count)
+	{
+		return {};
+	}
+
+	const auto entryOffset = table.payload + m_nodeHeaderSize + index * m_entrySize;
+	std::string_view keyName;
+	SValue value;
+	if (!ReadKey(entryOffset, keyName) || !ReadSlot(entryOffset + 8, value))
+	{
+		return {};
+	}
+
+	return std::make_pair(keyName, value);
+}
+
+toml::floating CTomlFrozenDocument::GetFloating(const SValue& value)
+{
+	toml::floating floating = 0.0;
+	std::memcpy(&floating, &value.payload, sizeof(floating));
+	return floating;
+}
+
+std::string_view CTomlFrozenDocument::GetString(const SValue& value) const
+{
+	std::uint32_t size = 0;
+	if (value.tag != EValueTag::String || !Read(value.payload, size) || m_bufferSize - value.payload - sizeof(size) < size)
+	{
+		return {};
+	}
+
+	return std::string_view(m_pBuffer + value.payload + sizeof(size), size);
+}
+
+std::optional<toml::value> CTomlFrozenDocument::ToValue(const SValue& value) const
+{
+	toml::value output;
+	if (!ReadValue(value, output, 0))
+	{
+		return {};
+	}
+
+	return output;
+}
+
+CTomlFrozenDocument::SValue CTomlFrozenDocument::WriteValue(
+	const toml::value& value, std::unordered_map<std::string_view, std::uint32_t>& keys, std::string& output)
+{
+	const auto writeDate = [&output](const toml::local_date& date)
+	{
+		WriteNumber(date.year, output);
+		WriteNumber(date.month, output);
+		WriteNumber(date.day, output);
+	};
+	const auto writeTime = [&output](const toml::local_time& time)
+	{
+		WriteNumber(time.hour, output);
+		WriteNumber(time.minute, output);
+		WriteNumber(time.second, output);
+		WriteNumber(time.millisecond, output);
+		WriteNumber(time.microsecond, output);
+		WriteNumber(time.nanosecond, output);
+	};
+
+	SValue slot;
+	switch (value.type())
+	{
+	case toml::value_t::boolean:
+		slot.tag = EValueTag::Boolean;
+		slot.payload = value.as_boolean(std::nothrow) ? 1 : 0;
+		break;
+	case toml::value_t::integer:
+		slot.tag = EValueTag::Integer;
+		slot.payload = static_cast<std::uint64_t>(value.as_integer(std::nothrow));
+		break;
+	case toml::value_t::floating:
+	{
+		const auto floating = value.as_floating(std::nothrow);
+		slot.tag = EValueTag::Floating;
+		std::memcpy(&slot.payload, &floating, sizeof(floating));
+		break;
+	}
+	case toml::value_t::string:
+	{
+		const auto& string = value.as_string(std::nothrow);
+		slot.tag = EValueTag::String;
+		slot.stringKind = static_cast<std::uint8_t>(string.kind);
+		slot.payload = output.size();
+		WriteNumber(static_cast<std::uint32_t>(string.str.size()), output);
+		output.append(string.str);
+		break;
+	}
+	case toml::value_t::offset_datetime:
+	{
+		const auto& datetime = value.as_offset_datetime(std::nothrow);
+		slot.tag = EValueTag::OffsetDatetime;
+		slot.payload = output.size();
+		writeDate(datetime.date);
+		writeTime(datetime.time);
+		WriteNumber(datetime.offset.hour, output);
+		WriteNumber(datetime.offset.minute, output);
+		break;
+	}
+	case toml::value_t::local_datetime:
+		slot.tag = EValueTag::LocalDatetime;
+		slot.payload = output.size();
+		writeDate(value.as_local_datetime(std::nothrow).date);
+		writeTime(value.as_local_datetime(std::nothrow).time);
+		break;
+	case toml::value_t::local_date:
+		slot.tag = EValueTag::LocalDate;
+		slot.payload = output.size();
+		writeDate(value.as_local_date(std::nothrow));
+		break;
+	case toml::value_t::local_time:
+		slot.tag = EValueTag::LocalTime;
+		slot.payload = output.size();
+		writeTime(value.as_local_time(std::nothrow));
+		break;
+	case toml::value_t::array:
+	{
+		// Nested values are written before the array node so that its slots are contiguous.
+		const auto& array = value.as_array(std::nothrow);
+		std::vector<SValue> elements;
+		elements.reserve(array.size());
+		for (const auto& element : array)
+		{
+			elements.push_back(WriteValue(element, keys, output));
+		}
+
+		Align(output);
+		slot.tag = EValueTag::Array;
+		slot.payload = output.size();
+		WriteNumber(static_cast<std::uint32_t>(elements.size()), output);
+		WriteNumber(static_cast<std::uint32_t>(0), output);
+		for (const auto& element : elements)
+		{
+			WriteSlot(element, output);
+		}
+		break;
+	}
+	case toml::value_t::table:
+	{
+		// Nested values are written before the table node so that its entries are contiguous.
+		const auto& table = value.as_table(std::nothrow);
+		std::vector<std::pair<std::string_view, SValue>> entries;
+		entries.reserve(table.size());
+		for (const auto& [keyName, element] : table)
+		{
+			entries.emplace_back(keyName, WriteValue(element, keys, output));
+		}
+		std::sort(entries.begin(), entries.end(), [](const auto& left, const auto& right)
+		{
+			return left.first < right.first;
+		});
+
+		// Intern keys.
+		for (const auto& entry : entries)
+		{
+			if (keys.find(entry.first) == keys.end())
+			{
+				keys.emplace(entry.first, static_cast<std::uint32_t>(output.size()));
+				output.append(entry.first);
+			}
+		}
+
+		Align(output);
+		slot.tag = EValueTag::Table;
+		slot.payload = output.size();
+		WriteNumber(static_cast<std::uint32_t>(entries.size()), output);
+		WriteNumber(static_cast<std::uint32_t>(0), output);
+		for (const auto& [keyName, element] : entries)
+		{
+			WriteNumber(keys.at(keyName), output);
+			WriteNumber(static_cast<std::uint32_t>(keyName.size()), output);
+			WriteSlot(element, output);
+		}
+		break;
+	}
+	default:
+		break;
+	}
+
+	return slot;
+}
+
+bool CTomlFrozenDocument::ReadValue(const SValue& value, toml::value& output, size_t depth) const
+{
+	if (depth > m_maxDepth)
+	{
+		return false;
+	}
+
+	auto offset = static_cast<size_t>(value.payload);
+	const auto readNumber = [this, &offset](auto& number)
+	{
+		if (!Read(offset, number))
+		{
+			return false;
+		}
+		offset += sizeof(number);
+		return true;
+	};
+	const auto readDate = [&readNumber](toml::local_date& date)
+	{
+		return readNumber(date.year) && readNumber(date.month) && readNumber(date.day);
+	};
+	const auto readTime = [&readNumber](toml::local_time& time)
+	{
+		return readNumber(time.hour) && readNumber(time.minute) && readNumber(time.second)
+			&& readNumber(time.millisecond) && readNumber(time.microsecond) && readNumber(time.nanosecond);
+	};
+
+	switch (value.tag)
+	{
+	case EValueTag::Empty:
+		output = toml::value();
+		return true;
+	case EValueTag::Boolean:
+		output = toml::value(GetBoolean(value));
+		return true;
+	case EValueTag::Integer:
+		output = toml::value(GetInteger(value));
+		return true;
+	case EValueTag::Floating:
+		output = toml::value(GetFloating(value));
+		return true;
+	case EValueTag::String:
+	{
+		std::uint32_t size = 0;
+		if (!Read(offset, size) || m_bufferSize - offset - sizeof(size) < size)
+		{
+			return false;
+		}
+		output = toml::value(std::string(GetString(value)), static_cast<toml::string_t>(value.stringKind));
+		return true;
+	}
+	case EValueTag::OffsetDatetime:
+	{
+		toml::offset_datetime datetime;
+		if (!readDate(datetime.date) || !readTime(datetime.time) || !readNumber(datetime.offset.hour) || !readNumber(datetime.offset.minute))
+		{
+			return false;
+		}
+		output = toml::value(datetime);
+		return true;
+	}
+	case EValueTag::LocalDatetime:
+	{
+		toml::local_datetime datetime;
+		if (!readDate(datetime.date) || !readTime(datetime.time))
+		{
+			return false;
+		}
+		output = toml::value(datetime);
+		return true;
+	}
+	case EValueTag::LocalDate:
+	{
+		toml::local_date date;
+		if (!readDate(date))
+		{
+			return false;
+		}
+		output = toml::value(date);
+		return true;
+	}
+	case EValueTag::LocalTime:
+	{
+		toml::local_time time;
+		if (!readTime(time))
+		{
+			return false;
+		}
+		output = toml::value(time);
+		return true;
+	}
+	case EValueTag::Array:
+	{
+		std::uint32_t count = 0;
+		if (!ReadCount(offset, m_slotSize, count))
+		{
+			return false;
+		}
+
+		toml::array array(count);
+		for (std::uint32_t i = 0; i < count; i++)
+		{
+			SValue element;
+			if (!ReadSlot(offset + m_nodeHeaderSize + i * m_slotSize, element) || !ReadValue(element, array[i], depth + 1))
+			{
+				return false;
+			}
+		}
+		output = toml::value(std::move(array));
+		return true;
+	}
+	case EValueTag::Table:
+	{
+		std::uint32_t count = 0;
+		if (!ReadCount(offset, m_entrySize, count))
+		{
+			return false;
+		}
+
+		toml::table table;
+		table.reserve(count);
+		for (std::uint32_t i = 0; i < count; i++)
+		{
+			const auto entryOffset = offset + m_nodeHeaderSize + i * m_entrySize;
+
+			std::string_view keyName;
+			SValue element;
+			if (!ReadKey(entryOffset, keyName) || !ReadSlot(entryOffset + 8, element)
+				|| !ReadValue(element, table[std::string(keyName)], depth + 1))
+			{
+				return false;
+			}
+		}
+		output = toml::value(std::move(table));
+		return true;
+	}
+	default:
+		return false;
+	}
+}
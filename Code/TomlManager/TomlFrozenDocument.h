@@ -0,0 +1,299 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include "External/toml11/toml.hpp"
+
+//! Read-only TOML data flattened into one contiguous buffer that is read without unpacking it
+//! (values are found by binary search over sorted keys), the buffer is relocatable so it can be
+//! stored in a file and memory-mapped.
+//! 
+//! \remark Format: header (magic, version, size and last write time of the text file, root value), then nodes
+//! aligned to 8 bytes. A value is a 16-byte slot (type tag, string kind, payload), booleans, integers and floats
+//! are stored in the payload, other values store offset of their node. Table node is a count followed by entries
+//! (key offset, key length, value slot) sorted by key, array node is a count followed by value slots, keys are
+//! interned. Numbers are stored in native byte order (the buffer is only a local cache).
+class CTomlFrozenDocument
+{
+public:
+	//! Type of a frozen value.
+	enum class EValueTag : std::uint8_t
+	{
+		Empty = 0,
+		Boolean,
+		Integer,
+		Floating,
+		String,
+		OffsetDatetime,
+		LocalDatetime,
+		LocalDate,
+		LocalTime,
+		Array,
+		Table,
+	};
+
+	//! Reference to a value in the buffer.
+	struct SValue
+	{
+		//! Type of the value.
+		EValueTag tag = EValueTag::Empty;
+
+		//! Kind of a string value (basic or literal).
+		std::uint8_t stringKind = 0;
+
+		//! Boolean, integer or float bits, otherwise offset of value's node.
+		std::uint64_t payload = 0;
+	};
+
+	CTomlFrozenDocument(const CTomlFrozenDocument&) = delete;
+	CTomlFrozenDocument& operator=(const CTomlFrozenDocument&) = delete;
+
+	//! Destructor, unmaps the file (if the buffer is mapped).
+	~CTomlFrozenDocument();
+
+	//! Flattens TOML data into a frozen buffer.
+	//! 
+	//! \param data            TOML data.
+	//! \param sourceFileSize  Size of the text file the data was parsed from (0 if none).
+	//! \param sourceWriteTime Last write time of the text file the data was parsed from (0 if none).
+	//! 
+	//! \return Empty if the data is too large (offsets are 32-bit), otherwise buffer bytes.
+	static std::optional<std::string> Freeze(const toml::value& data, std::uint64_t sourceFileSize, std::int64_t sourceWriteTime);
+
+	//! Creates a frozen document that owns the specified buffer.
+	//! 
+	//! \param buffer Buffer created by \ref Freeze.
+	//! 
+	//! \return nullptr if the buffer header is invalid, otherwise frozen document.
+	static std::unique_ptr<CTomlFrozenDocument> Load(std::string buffer);
+
+	//! Creates a frozen document that reads the specified buffer without copying it.
+	//! 
+	//! \param pBuffer Buffer created by \ref Freeze (must stay valid while the document exists,
+	//! for example static data generated by the embedding tool).
+	//! \param size    Size of the buffer in bytes.
+	//! 
+	//! \return nullptr if the buffer header is invalid, otherwise frozen document.
+	static std::unique_ptr<CTomlFrozenDocument> LoadView(const void* pBuffer, size_t size);
+
+	//! Maps a frozen buffer file into memory.
+	//! 
+	//! \param frozenPath Path to the file with a buffer created by \ref Freeze.
+	//! \param sourcePath Path to the text file that the buffer was created for.
+	//! 
+	//! \return nullptr if the file does not exist, its header is invalid or the text file was modified
+	//! since the buffer was created, otherwise frozen document.
+	static std::unique_ptr<CTomlFrozenDocument> Map(const std::filesystem::path& frozenPath, const std::filesystem::path& sourcePath);
+
+	//! Writes a frozen buffer to a file.
+	//! 
+	//! \param frozenPath Path to the file.
+	//! \param buffer     Buffer created by \ref Freeze.
+	//! 
+	//! \return 'false' if failed to write the file, 'true' otherwise.
+	static bool WriteFile(const std::filesystem::path& frozenPath, std::string_view buffer);
+
+	//! Returns the root value.
+	//! 
+	//! \return Root value (usually a table).
+	SValue GetRoot() const;
+
+	//! Looks for a value of a table.
+	//! 
+	//! \param table   Table to look in.
+	//! \param keyName Key of the value.
+	//! 
+	//! \return Empty if the value is not a table, the key was not found or the buffer is corrupted, otherwise found value.
+	std::optional<SValue> Find(const SValue& table, std::string_view keyName) const;
+
+	//! Returns number of elements of an array or entries of a table.
+	//! 
+	//! \param value Array or table.
+	//! 
+	//! \return 0 if the value is not an array/table or the buffer is corrupted, otherwise number of elements.
+	size_t GetSize(const SValue& value) const;
+
+	//! Returns an element of an array.
+	//! 
+	//! \param array Array to get element of.
+	//! \param index Index of the element.
+	//! 
+	//! \return Empty if the value is not an array, the index is out of range or the buffer is corrupted, otherwise element.
+	std::optional<SValue> GetElement(const SValue& array, size_t index) const;
+
+	//! Returns an entry of a table (entries are sorted by key).
+	//! 
+	//! \param table Table to get entry of.
+	//! \param index Index of the entry.
+	//! 
+	//! \return Empty if the value is not a table, the index is out of range or the buffer is corrupted, otherwise
+	//! key (points into the buffer) and value of the entry.
+	std::optional<std::pair<std::string_view, SValue>> GetEntry(const SValue& table, size_t index) const;
+
+	//! Returns value of a boolean.
+	//! 
+	//! \param value Boolean value.
+	//! 
+	//! \return Boolean.
+	static bool GetBoolean(const SValue& value) { return value.payload != 0; }
+
+	//! Returns value of an integer.
+	//! 
+	//! \param value Integer value.
+	//! 
+	//! \return Integer.
+	static toml::integer GetInteger(const SValue& value) { return static_cast<toml::integer>(value.payload); }
+
+	//! Returns value of a float.
+	//! 
+	//! \param value Float value.
+	//! 
+	//! \return Float.
+	static toml::floating GetFloating(const SValue& value);
+
+	//! Returns text of a string (points into the buffer).
+	//! 
+	//! \param value String value.
+	//! 
+	//! \return Empty if the value is not a string or the buffer is corrupted, otherwise text.
+	std::string_view GetString(const SValue& value) const;
+
+	//! Converts a frozen value (with all nested values) to TOML value.
+	//! 
+	//! \param value Value to convert.
+	//! 
+	//! \return Empty if the buffer is corrupted, otherwise TOML value.
+	std::optional<toml::value> ToValue(const SValue& value) const;
+
+	//! Returns size of the buffer.
+	//! 
+	//! \return Size in bytes.
+	size_t GetBufferSize() const { return m_bufferSize; }
+
+private:
+	//! Constructor.
+	CTomlFrozenDocument() = default;
+
+	//! Checks header of the buffer and reads the root value.
+	//! 
+	//! \return 'false' if the header is invalid.
+	bool ReadHeader();
+
+	//! Reads a number from the buffer.
+	//! 
+	//! \param offset Offset of the number.
+	//! \param output Read number.
+	//! 
+	//! \return 'false' if the number is out of the buffer bounds.
+	template<typename T>
+	bool Read(size_t offset, T& output) const;
+
+	//! Reads a value slot from the buffer.
+	//! 
+	//! \param offset Offset of the slot.
+	//! \param output Read value.
+	//! 
+	//! \return 'false' if the slot is out of the buffer bounds.
+	bool ReadSlot(size_t offset, SValue& output) const;
+
+	//! Returns key of a table entry.
+	//! 
+	//! \param entryOffset Offset of the entry.
+	//! \param output      Key (points into the buffer).
+	//! 
+	//! \return 'false' if the key is out of the buffer bounds.
+	bool ReadKey(size_t entryOffset, std::string_view& output) const;
+
+	//! Returns number of elements of an array/table node and checks that all elements are in the buffer bounds.
+	//! 
+	//! \param nodeOffset  Offset of the node.
+	//! \param elementSize Size of one element.
+	//! \param output      Number of elements.
+	//! 
+	//! \return 'false' if the node is out of the buffer bounds.
+	bool ReadCount(size_t nodeOffset, size_t elementSize, std::uint32_t& output) const;
+
+	//! Converts a frozen value to TOML value.
+	//! 
+	//! \param value  Value to convert.
+	//! \param output TOML value.
+	//! \param depth  Nesting depth of the value.
+	//! 
+	//! \return 'false' if the buffer is corrupted.
+	bool ReadValue(const SValue& value, toml::value& output, size_t depth) const;
+
+	//! Appends a value (and its nested values) to a buffer.
+	//! 
+	//! \param value  Value to append.
+	//! \param keys   Offsets of interned keys (key -> offset).
+	//! \param output Buffer to append to.
+	//! 
+	//! \return Slot of the value.
+	static SValue WriteValue(const toml::value& value, std::unordered_map<std::string_view, std::uint32_t>& keys, std::string& output);
+
+	//! Appends a number to a buffer.
+	//! 
+	//! \param number Number to append.
+	//! \param output Buffer to append to.
+	template<typename T>
+	static void WriteNumber(T number, std::string& output);
+
+	//! Appends a value slot to a buffer.
+	//! 
+	//! \param value  Value to append.
+	//! \param output Buffer to append to.
+	static void WriteSlot(const SValue& value, std::string& output);
+
+	//! Appends zeros to a buffer until its size is a multiple of 8.
+	//! 
+	//! \param output Buffer to align.
+	static void Align(std::string& output);
+
+	//! First bytes of a frozen buffer.
+	static inline const std::uint32_t m_magic = 0x464C4D54; // "TMLF"
+
+	//! Version of the format, buffers of other versions are ignored.
+	static inline const std::uint32_t m_formatVersion = 1;
+
+	//! Size of the header in bytes.
+	static inline const size_t m_headerSize = 40;
+
+	//! Size of a value slot in bytes.
+	static inline const size_t m_slotSize = 16;
+
+	//! Size of a table entry in bytes (key offset, key length, value slot).
+	static inline const size_t m_entrySize = 8 + m_slotSize;
+
+	//! Size of an array/table node header in bytes (count and padding).
+	static inline const size_t m_nodeHeaderSize = 8;
+
+	//! Maximum nesting depth of values (deeper buffers are treated as corrupted).
+	static inline const size_t m_maxDepth = 512;
+
+	//! Buffer owned by the document (empty if the buffer is mapped or not owned).
+	std::string m_ownedBuffer;
+
+	//! Mapped view of a file, nullptr if the buffer is owned.
+	void* m_pMappedView = nullptr;
+
+	//! Start of the buffer.
+	const char* m_pBuffer = nullptr;
+
+	//! Size of the buffer.
+	size_t m_bufferSize = 0;
+
+	//! Size of the text file the buffer was created for.
+	std::uint64_t m_sourceFileSize = 0;
+
+	//! Last write time of the text file the buffer was created for.
+	std::int64_t m_sourceWriteTime = 0;
+
+	//! Root value.
+	SValue m_root;
+};
@@ -0,0 +1,367 @@
+#include "TomlHeaderScanner.h"
+
+#include <fstream>
+#include <unordered_set>
+
+std::optional<std::string> CTomlHeaderScanner::ScanLine(std::string_view line, bool* pIsTopLevelArrayElement)
+{
+	if (pIsTopLevelArrayElement != nullptr)
+	{
+		*pIsTopLevelArrayElement = false;
+	}
+
+	size_t position = 0;
+
+	// Finish multi-line string from previous lines.
+	if (m_state != EState::Normal)
+	{
+		SkipMultilineString(line, position);
+		if (m_state != EState::Normal)
+		{
+			return {};
+		}
+	}
+
+	// Headers can only appear at the start of a line outside of values.
+	if (position == 0 && m_bracketDepth == 0)
+	{
+		const auto firstCharPosition = line.find_first_not_of(" \t");
+		if (firstCharPosition != std::string_view::npos && line[firstCharPosition] == '[')
+		{
+			return ParseHeaderName(line.substr(firstCharPosition), pIsTopLevelArrayElement);
+		}
+	}
+
+	// Skip key/value text, keep track of strings and brackets.
+	while (position < line.size())
+	{
+		const auto character = line[position];
+		if (character == '#')
+		{
+			// Comment until the end of the line.
+			break;
+		}
+		else if (character == '"' || character == '\'')
+		{
+			// Multi-line string.
+			if (line.substr(position, 3) == std::string_view(character == '"' ? "\"\"\"" : "'''"))
+			{
+				m_state = character == '"' ? EState::MultilineBasicString : EState::MultilineLiteralString;
+				position += 3;
+				SkipMultilineString(line, position);
+				continue;
+			}
+
+			// Single-line string.
+			position += 1;
+			while (position < line.size() && line[position] != character)
+			{
+				if (character == '"' && line[position] == '\\')
+				{
+					position += 1;
+				}
+				position += 1;
+			}
+			position += 1;
+			continue;
+		}
+		else if (character == '[' || character == '{')
+		{
+			m_bracketDepth += 1;
+		}
+		else if ((character == ']' || character == '}') && m_bracketDepth > 0)
+		{
+			m_bracketDepth -= 1;
+		}
+
+		position += 1;
+	}
+
+	return {};
+}
+
+void CTomlHeaderScanner::SkipMultilineString(std::string_view line, size_t& position)
+{
+	const auto bIsBasic = m_state == EState::MultilineBasicString;
+	const auto quote = bIsBasic ? '"' : '\'';
+
+	while (position < line.size())
+	{
+		if (bIsBasic && line[position] == '\\')
+		{
+			position += 2;
+			continue;
+		}
+
+		if (line[position] == quote && line.substr(position, 3) == std::string_view(bIsBasic ? "\"\"\"" : "'''"))
+		{
+			// Up to 2 additional quotes are part of the string.
+			position += 3;
+			for (size_t i = 0; i < 2 && position < line.size() && line[position] == quote; i++)
+			{
+				position += 1;
+			}
+			m_state = EState::Normal;
+			return;
+		}
+
+		position += 1;
+	}
+
+	position = line.size();
+}
+
+CTomlHeaderScanner::STopLevelTables CTomlHeaderScanner::FindTopLevelTables(std::string_view text)
+{
+	STopLevelTables tables;
+	tables.rootEnd = text.size();
+
+	CTomlHeaderScanner scanner;
+	std::optional<std::string> currentTableName;
+	size_t tableStart = 0;
+	for (size_t lineStart = 0; lineStart < text.size();)
+	{
+		auto lineEnd = text.find('\n', lineStart);
+		lineEnd = lineEnd == std::string_view::npos ? text.size() : lineEnd + 1;
+
+		const auto optionalTableName = scanner.ScanLine(text.substr(lineStart, lineEnd - lineStart));
+		if (optionalTableName.has_value() && optionalTableName != currentTableName)
+		{
+			if (currentTableName.has_value())
+			{
+				tables.tableRanges[currentTableName.value()].push_back({ tableStart, lineStart });
+			}
+			else
+			{
+				tables.rootEnd = lineStart;
+			}
+
+			if (tables.tableRanges.find(optionalTableName.value()) == tables.tableRanges.end())
+			{
+				tables.tableOrder.push_back(optionalTableName.value());
+			}
+
+			currentTableName = optionalTableName;
+			tableStart = lineStart;
+		}
+
+		lineStart = lineEnd;
+	}
+	if (currentTableName.has_value())
+	{
+		tables.tableRanges[currentTableName.value()].push_back({ tableStart, text.size() });
+	}
+
+	return tables;
+}
+
+std::optional<std::string> CTomlHeaderScanner::ParseHeaderName(std::string_view line, bool* pIsTopLevelArrayElement)
+{
+	// Skip "[" or "[[".
+	size_t position = 1;
+	const auto bIsArrayOfTables = position < line.size() && line[position] == '[';
+	if (bIsArrayOfTables)
+	{
+		position += 1;
+	}
+
+	// Skip whitespace.
+	while (position < line.size() && (line[position] == ' ' || line[position] == '\t'))
+	{
+		position += 1;
+	}
+	if (position >= line.size())
+	{
+		return {};
+	}
+
+	std::string name;
+	const auto character = line[position];
+	if (character == '"')
+	{
+		// Basic string key.
+		position += 1;
+		while (position < line.size() && line[position] != '"')
+		{
+			if (line[position] == '\\' && position + 1 < line.size())
+			{
+				position += 1;
+				switch (line[position])
+				{
+				case 'n': name += '\n'; break;
+				case 't': name += '\t'; break;
+				case 'r': name += '\r'; break;
+				case 'b': name += '\b'; break;
+				case 'f': name += '\f'; break;
+				default: name += line[position]; break;
+				}
+			}
+			else
+			{
+				name += line[position];
+			}
+			position += 1;
+		}
+		if (position >= line.size())
+		{
+			return {};
+		}
+		position += 1;
+	}
+	else if (character == '\'')
+	{
+		// Literal string key.
+		const auto endPosition = line.find('\'', position + 1);
+		if (endPosition == std::string_view::npos)
+		{
+			return {};
+		}
+		name = line.substr(position + 1, endPosition - position - 1);
+		position = endPosition + 1;
+	}
+	else
+	{
+		// Bare key.
+		while (position < line.size())
+		{
+			const auto bareCharacter = line[position];
+			if (!((bareCharacter >= 'a' && bareCharacter <= 'z') || (bareCharacter >= 'A' && bareCharacter <= 'Z')
+				|| (bareCharacter >= '0' && bareCharacter <= '9') || bareCharacter == '_' || bareCharacter == '-'))
+			{
+				break;
+			}
+			name += bareCharacter;
+			position += 1;
+		}
+		if (name.empty())
+		{
+			return {};
+		}
+	}
+
+	if (pIsTopLevelArrayElement != nullptr && bIsArrayOfTables)
+	{
+		// Single key component if the header is closed right after the name.
+		while (position < line.size() && (line[position] == ' ' || line[position] == '\t'))
+		{
+			position += 1;
+		}
+		*pIsTopLevelArrayElement = line.substr(position, 2) == "]]";
+	}
+
+	return name;
+}
+
+std::optional<std::string> CTomlHeaderScanner::ReadTopLevelTables(
+	const std::filesystem::path& filePath, const std::vector<std::string>& tableNames, size_t* pReadBytes)
+{
+	std::ifstream file(filePath, std::ios::binary);
+	if (!file.is_open())
+	{
+		return {};
+	}
+
+	const std::unordered_set<std::string> requestedTableNames(tableNames.begin(), tableNames.end());
+	auto remainingTableNames = requestedTableNames;
+
+	CTomlHeaderScanner scanner;
+	std::string output;
+	std::string buffer;
+	size_t readBytes = 0;
+
+	// Root key/values are always read.
+	std::optional<std::string> currentTableName;
+	bool bCopyCurrentTable = true;
+	bool bDone = false;
+
+	// Handles the start of a new top-level table, returns 'true' if reading should stop.
+	const auto startTable = [&](const std::string& tableName, size_t lineStart)
+	{
+		if (bCopyCurrentTable)
+		{
+			output.append(buffer, 0, lineStart);
+		}
+		buffer.erase(0, lineStart);
+
+		if (currentTableName.has_value())
+		{
+			remainingTableNames.erase(currentTableName.value());
+		}
+		if (remainingTableNames.empty())
+		{
+			return true;
+		}
+
+		currentTableName = tableName;
+		bCopyCurrentTable = requestedTableNames.find(tableName) != requestedTableNames.end();
+		return false;
+	};
+
+	size_t lineStart = 0;
+	while (!bDone)
+	{
+		// Read next chunk.
+		const auto previousSize = buffer.size();
+		buffer.resize(previousSize + m_chunkSize);
+		file.read(buffer.data() + previousSize, m_chunkSize);
+		const auto chunkSize = static_cast<size_t>(file.gcount());
+		buffer.resize(previousSize + chunkSize);
+		readBytes += chunkSize;
+		const auto bIsEndOfFile = chunkSize == 0;
+
+		// Scan complete lines (and the last line at the end of the file).
+		while (lineStart < buffer.size())
+		{
+			auto lineEnd = buffer.find('\n', lineStart);
+			if (lineEnd == std::string::npos)
+			{
+				if (!bIsEndOfFile)
+				{
+					break;
+				}
+				lineEnd = buffer.size() - 1;
+			}
+
+			const auto optionalTableName = scanner.ScanLine(std::string_view(buffer).substr(lineStart, lineEnd + 1 - lineStart));
+			if (optionalTableName.has_value() && optionalTableName != currentTableName)
+			{
+				if (startTable(optionalTableName.value(), lineStart))
+				{
+					bDone = true;
+					break;
+				}
+				lineStart = 0;
+				lineEnd = buffer.find('\n');
+				if (lineEnd == std::string::npos)
+				{
+					lineEnd = buffer.size() - 1;
+				}
+			}
+
+			lineStart = lineEnd + 1;
+		}
+
+		if (bIsEndOfFile && !bDone)
+		{
+			if (bCopyCurrentTable)
+			{
+				output += buffer;
+			}
+			break;
+		}
+
+		// Free memory of skipped tables.
+		if (!bCopyCurrentTable)
+		{
+			buffer.erase(0, lineStart);
+			lineStart = 0;
+		}
+	}
+
+	if (pReadBytes != nullptr)
+	{
+		*pReadBytes = readBytes;
+	}
+
+	return output;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+//! Finds table headers in TOML text without parsing values (strings, multi-line strings,
+//! multi-line arrays and comments are skipped so that their content is never mistaken for a header).
+class CTomlHeaderScanner
+{
+public:
+	//! Byte ranges of top-level tables in TOML text.
+	struct STopLevelTables
+	{
+		//! End of the root key/values (start of the first table header).
+		size_t rootEnd = 0;
+
+		//! Names of top-level tables in order of their first appearance.
+		std::vector<std::string> tableOrder;
+
+		//! Byte ranges [begin, end) of text of each top-level table, a table has multiple ranges if its
+		//! headers are interleaved with headers of other tables.
+		std::unordered_map<std::string, std::vector<std::pair<size_t, size_t>>> tableRanges;
+	};
+
+	//! Processes a line of TOML text, lines must be passed in order starting from the first line of the text.
+	//! 
+	//! \param line                   Line of text (can include the line break).
+	//! \param pIsTopLevelArrayElement Optional. Set to 'true' if the line is an array of tables header with
+	//! a single key component (such as "[[items]]") that starts a new element of a top-level array, otherwise 'false'.
+	//! 
+	//! \return Normalized first key component of the table header (without quotes) if the line is a table
+	//! or array of tables header, otherwise empty.
+	std::optional<std::string> ScanLine(std::string_view line, bool* pIsTopLevelArrayElement = nullptr);
+
+	//! Finds byte ranges of the root key/values and top-level tables in TOML text.
+	//! 
+	//! \param text TOML text.
+	//! 
+	//! \return Ranges of top-level tables.
+	static STopLevelTables FindTopLevelTables(std::string_view text);
+
+	//! Reads only the parts of a TOML file that are needed for the root key/values and the specified
+	//! top-level tables, stops reading the file as soon as all specified tables were read.
+	//! 
+	//! \param filePath   File to read.
+	//! \param tableNames Names of top-level tables to read (empty to only read the root key/values).
+	//! \param pReadBytes Optional. Number of bytes read from the file will be written here.
+	//! 
+	//! \remark A table "ends" when a header with a different top-level name is found, so headers of a table
+	//! that are placed after other tables (for example "[a]", "[b]", "[a.c]") might be skipped if all
+	//! specified tables were already read.
+	//! 
+	//! \return Empty if failed to open the file, otherwise TOML text to parse.
+	static std::optional<std::string> ReadTopLevelTables(
+		const std::filesystem::path& filePath, const std::vector<std::string>& tableNames, size_t* pReadBytes = nullptr);
+
+private:
+
+	//! Describes scanner's position relative to multi-line values.
+	enum class EState
+	{
+		Normal,
+		MultilineBasicString,
+		MultilineLiteralString,
+	};
+
+	//! Parses the first key component of a table header.
+	//! 
+	//! \param line                   Line that starts with '[' (after whitespace).
+	//! \param pIsTopLevelArrayElement Optional. See \ref ScanLine.
+	//! 
+	//! \return Empty if the header is malformed, otherwise normalized first key component.
+	static std::optional<std::string> ParseHeaderName(std::string_view line, bool* pIsTopLevelArrayElement);
+
+	//! Skips text until the end of a multi-line string.
+	//! 
+	//! \param line     Line to scan.
+	//! \param position Position to start from, will be set to the position after the string (or line size).
+	void SkipMultilineString(std::string_view line, size_t& position);
+
+	//! Current state.
+	EState m_state = EState::Normal;
+
+	//! Number of unclosed '[' and '{' of values (multi-line arrays).
+	size_t m_bracketDepth = 0;
+
+	//! Size of chunks to read files with.
+	static inline const size_t m_chunkSize = 16 * 1024;
+};
@@ -0,0 +1,497 @@
+#include "TomlJournal.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#if defined(WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+//! Opens a file for binary writing (truncates an existing file).
+//! 
+//! \param filePath Path to the file.
+//! 
+//! \return nullptr if failed to open the file, otherwise opened file.
+static std::FILE* OpenFileForWriting(const std::filesystem::path& filePath)
+{
+#if defined(WIN32)
+	return _wfopen(filePath.c_str(), L"wb");
+#else
+	return std::fopen(filePath.c_str(), "wb");
+#endif
+}
+
+CTomlJournal::CTomlJournal(const std::filesystem::path& journalPath, std::FILE* pFile)
+	: m_journalPath(journalPath), m_pFile(pFile)
+{
+}
+
+CTomlJournal::~CTomlJournal()
+{
+	Flush();
+
+	if (m_pFile != nullptr)
+	{
+		std::fclose(m_pFile);
+	}
+
+	std::scoped_lock guard(m_mtxOpenJournals);
+	m_openJournals.erase(m_journalPath.string());
+}
+
+std::unique_ptr<CTomlJournal> CTomlJournal::Create(const std::filesystem::path& journalPath)
+{
+	std::scoped_lock guard(m_mtxOpenJournals);
+
+	// Only one journal can write to a file.
+	if (m_openJournals.find(journalPath.string()) != m_openJournals.end())
+	{
+		return nullptr;
+	}
+
+	const auto pFile = OpenFileForWriting(journalPath);
+	if (pFile == nullptr)
+	{
+		return nullptr;
+	}
+
+	// Make sure that the file is empty on the disk (it might contain records of a previous run).
+	if (!SyncFile(pFile))
+	{
+		std::fclose(pFile);
+		return nullptr;
+	}
+
+	m_openJournals.insert(journalPath.string());
+	return std::unique_ptr<CTomlJournal>(new CTomlJournal(journalPath, pFile));
+}
+
+bool CTomlJournal::Append(const CTomlPatch::SOperation& operation)
+{
+	if (m_bFlushFailed)
+	{
+		return false;
+	}
+
+	// Create payload.
+	CTomlPatch patch;
+	switch (operation.type)
+	{
+	case CTomlPatch::EOperation::SetValue:
+		patch.SetValue(operation.sectionName, operation.keyName, operation.value);
+		break;
+	case CTomlPatch::EOperation::RemoveValue:
+		patch.RemoveValue(operation.sectionName, operation.keyName);
+		break;
+	case CTomlPatch::EOperation::SetElements:
+		patch.SetElements(operation.sectionName, operation.keyName, operation.index, operation.value.as_array());
+		break;
+	case CTomlPatch::EOperation::InsertElements:
+		patch.InsertElements(operation.sectionName, operation.keyName, operation.index, operation.value.as_array());
+		break;
+	case CTomlPatch::EOperation::EraseElements:
+		patch.EraseElements(operation.sectionName, operation.keyName, operation.index, operation.count);
+		break;
+	}
+	const auto payload = patch.Serialize();
+	if (payload.size() > std::numeric_limits<std::uint32_t>::max())
+	{
+		return false;
+	}
+
+	// Add the header and the payload to the records written by the next flush.
+	const auto payloadSize = static_cast<std::uint32_t>(payload.size());
+	const auto checksum = GetChecksum(payload);
+	{
+		std::scoped_lock guard(m_mtxPendingRecords);
+		m_pendingRecords.append(reinterpret_cast<const char*>(&payloadSize), sizeof(payloadSize));
+		m_pendingRecords.append(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+		m_pendingRecords += payload;
+	}
+
+	m_size += m_recordHeaderSize + payload.size();
+	return true;
+}
+
+bool CTomlJournal::Flush()
+{
+	std::scoped_lock guard(m_mtxFile);
+
+	// Take the records appended so far (other threads can append while the file is written).
+	std::string bytes;
+	{
+		std::scoped_lock pendingGuard(m_mtxPendingRecords);
+		bytes.swap(m_pendingRecords);
+	}
+	if (bytes.empty())
+	{
+		return m_pFile != nullptr;
+	}
+
+	// Write all records with one call.
+	m_flushedSize += bytes.size();
+	if (m_pFile == nullptr || std::fwrite(bytes.data(), 1, bytes.size(), m_pFile) != bytes.size() || !SyncFile(m_pFile))
+	{
+		// The file might end with a part of a record, stop appending so that the records before it
+		// stay readable (see Rebase).
+		if (m_pFile != nullptr)
+		{
+			std::fclose(m_pFile);
+			m_pFile = nullptr;
+		}
+		m_bFlushFailed = true;
+		return false;
+	}
+
+	return true;
+}
+
+bool CTomlJournal::Rebase(const std::filesystem::path& filePath, const std::filesystem::path& newFilePath, std::uint32_t fileChecksum, size_t baseSize)
+{
+	std::scoped_lock guard(m_mtxFile, m_mtxPendingRecords);
+
+	// Records appended after the new file version was taken were lost by a failed flush.
+	if (m_bFlushFailed && baseSize < m_flushedSize)
+	{
+		return false;
+	}
+
+	// Read records appended after the new file version was taken (flushed ones from the file, then the pending ones).
+	auto bytes = CreateHeader(fileChecksum);
+	if (baseSize < m_flushedSize)
+	{
+		if (m_pFile != nullptr && std::fflush(m_pFile) != 0)
+		{
+			return false;
+		}
+		std::ifstream file(m_journalPath, std::ios::binary);
+		const auto headerSize = bytes.size();
+		bytes.resize(headerSize + m_flushedSize - baseSize);
+		if (!file.seekg(static_cast<std::streamoff>(baseSize)) || !file.read(bytes.data() + headerSize, static_cast<std::streamsize>(m_flushedSize - baseSize)))
+		{
+			return false;
+		}
+	}
+	bytes.append(m_pendingRecords, std::min(m_pendingRecords.size(), baseSize > m_flushedSize ? baseSize - m_flushedSize : 0));
+
+	// Write the new journal, then replace the file (if the process stops before the journal is replaced,
+	// Replay picks the new journal by the checksum of the file).
+	const auto newJournalPath = GetNewJournalPath(m_journalPath);
+	if (!WriteSyncedFile(newJournalPath, bytes))
+	{
+		return false;
+	}
+	std::error_code errorCode;
+	std::filesystem::rename(newFilePath, filePath, errorCode);
+	if (errorCode)
+	{
+		std::filesystem::remove(newJournalPath, errorCode);
+		return false;
+	}
+	m_rebaseCount += 1;
+
+	// Pending records are in the new journal now.
+	m_pendingRecords.clear();
+
+	// Replace the journal (it has to be closed to be replaced on Windows).
+	if (m_pFile != nullptr)
+	{
+		std::fclose(m_pFile);
+		m_pFile = nullptr;
+	}
+	std::filesystem::rename(newJournalPath, m_journalPath, errorCode);
+	if (errorCode)
+	{
+		// Records of the old journal don't apply to the new file, the next rebase starts from the header.
+		m_size = 0;
+		m_flushedSize = 0;
+		m_bFlushFailed = true;
+		return false;
+	}
+#if defined(WIN32)
+	m_pFile = _wfopen(m_journalPath.c_str(), L"ab");
+#else
+	m_pFile = std::fopen(m_journalPath.c_str(), "ab");
+#endif
+	m_size = m_pFile != nullptr ? bytes.size() : 0;
+	m_flushedSize = m_size;
+	m_bFlushFailed = m_pFile == nullptr;
+
+	return m_pFile != nullptr;
+}
+
+bool CTomlJournal::IsOpen(const std::filesystem::path& journalPath)
+{
+	std::scoped_lock guard(m_mtxOpenJournals);
+	return m_openJournals.find(journalPath.string()) != m_openJournals.end();
+}
+
+std::optional<size_t> CTomlJournal::Replay(const std::filesystem::path& journalPath, std::uint32_t fileChecksum, toml::value& data)
+{
+	// The process stopped while the journal was rebased, the new journal is used if the file was replaced.
+	const auto newJournalPath = GetNewJournalPath(journalPath);
+	if (std::filesystem::exists(newJournalPath))
+	{
+		const auto optionalNewBytes = ReadFile(newJournalPath);
+		std::error_code errorCode;
+		if (optionalNewBytes.has_value() && IsRebasedOn(optionalNewBytes.value(), fileChecksum))
+		{
+			std::filesystem::rename(newJournalPath, journalPath, errorCode);
+		}
+		else
+		{
+			std::filesystem::remove(newJournalPath, errorCode);
+		}
+	}
+
+	// Read file.
+	const auto optionalBytes = ReadFile(journalPath);
+	if (!optionalBytes.has_value())
+	{
+		return {};
+	}
+	const auto& bytes = optionalBytes.value();
+
+	if (!data.is_table())
+	{
+		data = toml::table();
+	}
+
+	// Records of another file version are already in the file.
+	if (!IsRebasedOn(bytes, fileChecksum))
+	{
+		return 0;
+	}
+
+	size_t appliedRecordCount = 0;
+	size_t position = m_headerSize;
+	while (bytes.size() - position >= m_recordHeaderSize)
+	{
+		// Read header.
+		std::uint32_t payloadSize = 0;
+		std::uint32_t checksum = 0;
+		std::memcpy(&payloadSize, bytes.data() + position, sizeof(payloadSize));
+		std::memcpy(&checksum, bytes.data() + position + sizeof(payloadSize), sizeof(checksum));
+		if (bytes.size() - position - m_recordHeaderSize < payloadSize)
+		{
+			break;
+		}
+
+		// Read payload.
+		const auto payload = std::string_view(bytes).substr(position + m_recordHeaderSize, payloadSize);
+		if (GetChecksum(payload) != checksum)
+		{
+			break;
+		}
+		const auto optionalPatch = CTomlPatch::Deserialize(payload);
+		if (!optionalPatch.has_value())
+		{
+			break;
+		}
+		position += m_recordHeaderSize + payloadSize;
+
+		// Apply the change.
+		bool bApplied = true;
+		for (const auto& operation : optionalPatch->GetOperations())
+		{
+			bApplied = bApplied && ApplyOperation(operation, data.as_table());
+		}
+		if (!bApplied)
+		{
+			break;
+		}
+		appliedRecordCount += 1;
+	}
+
+	return appliedRecordCount;
+}
+
+std::optional<std::filesystem::path> CTomlJournal::WriteNewFile(const std::filesystem::path& filePath, std::string_view text)
+{
+	// Versions can be written by several threads at once.
+	auto newFilePath = filePath;
+	newFilePath += "." + std::to_string(m_newFileCount++) + ".tmp";
+	if (!WriteSyncedFile(newFilePath, text))
+	{
+		std::error_code errorCode;
+		std::filesystem::remove(newFilePath, errorCode);
+		return {};
+	}
+
+	return newFilePath;
+}
+
+bool CTomlJournal::WriteFile(const std::filesystem::path& filePath, std::string_view text)
+{
+	// Write to a temporary file first so that the file is never left half-written.
+	auto tempFilePath = filePath;
+	tempFilePath += ".tmp";
+	if (!WriteSyncedFile(tempFilePath, text))
+	{
+		return false;
+	}
+
+	std::error_code errorCode;
+	std::filesystem::rename(tempFilePath, filePath, errorCode);
+	return !errorCode;
+}
+
+std::optional<std::string> CTomlJournal::ReadFile(const std::filesystem::path& filePath)
+{
+	std::ifstream file(filePath, std::ios::binary);
+	if (!file.is_open())
+	{
+		return {};
+	}
+	std::ostringstream stream;
+	stream << file.rdbuf();
+
+	return std::move(stream).str();
+}
+
+bool CTomlJournal::WriteSyncedFile(const std::filesystem::path& filePath, std::string_view bytes)
+{
+	const auto pFile = OpenFileForWriting(filePath);
+	if (pFile == nullptr)
+	{
+		return false;
+	}
+	const auto bWritten = std::fwrite(bytes.data(), 1, bytes.size(), pFile) == bytes.size() && SyncFile(pFile);
+	std::fclose(pFile);
+
+	return bWritten;
+}
+
+std::string CTomlJournal::CreateHeader(std::uint32_t fileChecksum)
+{
+	std::string bytes;
+	bytes.append(reinterpret_cast<const char*>(&m_formatTag), sizeof(m_formatTag));
+	bytes.append(reinterpret_cast<const char*>(&fileChecksum), sizeof(fileChecksum));
+
+	return bytes;
+}
+
+bool CTomlJournal::IsRebasedOn(std::string_view bytes, std::uint32_t fileChecksum)
+{
+	return bytes.size() >= m_headerSize && bytes.substr(0, m_headerSize) == CreateHeader(fileChecksum);
+}
+
+bool CTomlJournal::ApplyOperation(const CTomlPatch::SOperation& operation, toml::table& rootTable)
+{
+	// Find the table of the value (values and inserted elements create their section).
+	const auto bCreate = operation.type == CTomlPatch::EOperation::SetValue || operation.type == CTomlPatch::EOperation::InsertElements;
+	auto pTable = &rootTable;
+	if (!operation.sectionName.empty())
+	{
+		auto sectionIt = rootTable.find(operation.sectionName);
+		if (sectionIt == rootTable.end() || !sectionIt->second.is_table())
+		{
+			if (!bCreate)
+			{
+				// Nothing to remove.
+				return sectionIt == rootTable.end() && operation.type == CTomlPatch::EOperation::RemoveValue;
+			}
+			sectionIt = rootTable.insert_or_assign(operation.sectionName, toml::table()).first;
+		}
+		pTable = &sectionIt->second.as_table();
+	}
+
+	switch (operation.type)
+	{
+	case CTomlPatch::EOperation::SetValue:
+		(*pTable)[operation.keyName] = operation.value;
+		return true;
+	case CTomlPatch::EOperation::RemoveValue:
+		pTable->erase(operation.keyName);
+		return true;
+	default:
+		break;
+	}
+
+	// Find the array (appended elements create it).
+	auto valueIt = pTable->find(operation.keyName);
+	if (valueIt == pTable->end() && bCreate)
+	{
+		valueIt = pTable->emplace(operation.keyName, toml::array()).first;
+	}
+	if (valueIt == pTable->end() || !valueIt->second.is_array())
+	{
+		return false;
+	}
+	auto& elements = valueIt->second.as_array();
+
+	// Change elements.
+	switch (operation.type)
+	{
+	case CTomlPatch::EOperation::SetElements:
+	{
+		const auto& newElements = operation.value.as_array();
+		if (operation.index > elements.size() || newElements.size() > elements.size() - operation.index)
+		{
+			return false;
+		}
+		std::copy(newElements.begin(), newElements.end(), elements.begin() + operation.index);
+		return true;
+	}
+	case CTomlPatch::EOperation::InsertElements:
+	{
+		const auto& newElements = operation.value.as_array();
+		if (operation.index > elements.size())
+		{
+			return false;
+		}
+		elements.insert(elements.begin() + operation.index, newElements.begin(), newElements.end());
+		return true;
+	}
+	case CTomlPatch::EOperation::EraseElements:
+		if (operation.index > elements.size() || operation.count > elements.size() - operation.index)
+		{
+			return false;
+		}
+		elements.erase(elements.begin() + operation.index, elements.begin() + operation.index + operation.count);
+		return true;
+	default:
+		return false;
+	}
+}
+
+std::filesystem::path CTomlJournal::GetNewJournalPath(const std::filesystem::path& journalPath)
+{
+	auto newJournalPath = journalPath;
+	newJournalPath += ".tmp";
+
+	return newJournalPath;
+}
+
+bool CTomlJournal::SyncFile(std::FILE* pFile)
+{
+	if (std::fflush(pFile) != 0)
+	{
+		return false;
+	}
+
+#if defined(WIN32)
+	return _commit(_fileno(pFile)) == 0;
+#elif __linux__
+	// File size changes are flushed too, but not the access/modification time.
+	return fdatasync(fileno(pFile)) == 0;
+#else
+	return fsync(fileno(pFile)) == 0;
+#endif
+}
+
+std::uint32_t CTomlJournal::GetChecksum(std::string_view bytes)
+{
+	std::uint32_t hash = 2166136261u;
+	for (const auto character : bytes)
+	{
+		hash ^= static_cast<unsigned char>(character);
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
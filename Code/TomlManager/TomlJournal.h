@@ -0,0 +1,231 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include "External/toml11/toml.hpp"
+#include "TomlPatch.h"
+
+//! Append-only file with changes of a document (write-ahead journal), a journaled document is persisted by
+//! appending only the changes instead of rewriting the whole file.
+//! 
+//! \remark Format: header - format tag and FNV-1a checksum of the document file text that the journal applies to
+//! (32-bit numbers), then a sequence of records. A record is payload size and FNV-1a checksum of the payload
+//! followed by the payload - serialized patch (see CTomlPatch) with one operation (a new value, a removed key or
+//! an inserted, overwritten or removed array element). A record that is cut off or doesn't match its checksum ends
+//! the journal (the process stopped while the record was written).
+//! 
+//! \remark Records are appended to memory (\ref Append) and written to the file by \ref Flush, so that the caller
+//! can append records while documents are locked and flush them after documents are unlocked. \ref Append and
+//! \ref Rebase have to be called from one thread at a time (the manager calls them while documents are locked),
+//! \ref Flush can be called from any thread at the same time.
+class CTomlJournal
+{
+public:
+	CTomlJournal(const CTomlJournal&) = delete;
+	CTomlJournal& operator=(const CTomlJournal&) = delete;
+
+	//! Destructor, writes records that were not flushed and closes the file.
+	~CTomlJournal();
+
+	//! Creates an empty journal file (an existing file is truncated) and opens it for appending,
+	//! records are applied only after the journal is rebased on a document file (see \ref Rebase).
+	//! 
+	//! \param journalPath Path to the journal file.
+	//! 
+	//! \return nullptr if the file is already open in this process or failed to create it, otherwise journal.
+	static std::unique_ptr<CTomlJournal> Create(const std::filesystem::path& journalPath);
+
+	//! Appends a record to the records that are written by the next \ref Flush (doesn't access the file).
+	//! 
+	//! \param operation Change of the document.
+	//! 
+	//! \return 'false' if failed to create the record or a previous flush failed (no records are appended until
+	//! the journal is rebased), 'true' otherwise.
+	bool Append(const CTomlPatch::SOperation& operation);
+
+	//! Writes appended records to the file and flushes it to the disk, records appended by other threads
+	//! meanwhile are written by the next call.
+	//! 
+	//! \return 'false' if failed to write the records (no records are appended until the journal is rebased),
+	//! 'true' otherwise.
+	bool Flush();
+
+	//! Replaces the document file with a new version written by \ref WriteNewFile and removes the records that
+	//! the new version already contains (records appended after the new version was taken are kept).
+	//! 
+	//! \param filePath     Path to the document file.
+	//! \param newFilePath  Path to the new version of the file.
+	//! \param fileChecksum Checksum of the text of the new version (see \ref GetChecksum).
+	//! \param baseSize     Size of the journal (see \ref GetSize) when the new version was taken.
+	//! 
+	//! \remark If the process stops while the journal is rebased, \ref Replay applies the records that match
+	//! the file on the disk. Records that were not flushed yet are written to the new journal.
+	//! 
+	//! \return 'false' if failed to replace the file or the journal (or records appended after the new version
+	//! was taken were lost by a failed flush), 'true' otherwise.
+	bool Rebase(const std::filesystem::path& filePath, const std::filesystem::path& newFilePath, std::uint32_t fileChecksum, size_t baseSize);
+
+	//! Returns size of the journal file including appended records that were not flushed yet.
+	//! 
+	//! \return Size in bytes.
+	size_t GetSize() const { return m_size; }
+
+	//! Returns number of times the document file was replaced by \ref Rebase, sizes of the journal are comparable
+	//! only while the number stays the same.
+	//! 
+	//! \return Number of rebases.
+	size_t GetRebaseCount() const { return m_rebaseCount; }
+
+	//! Checks whether a journal file is open by a journal of this process.
+	//! 
+	//! \param journalPath Path to the journal file.
+	//! 
+	//! \return 'true' if the journal is open, 'false' otherwise.
+	static bool IsOpen(const std::filesystem::path& journalPath);
+
+	//! Applies records of a journal file to TOML data, a journal that was rebased on another version of
+	//! the document file is not applied (the file was written after the records).
+	//! 
+	//! \param journalPath  Path to the journal file.
+	//! \param fileChecksum Checksum of the text of the document file (see \ref GetChecksum).
+	//! \param data         TOML data of the document (made a table if it's not).
+	//! 
+	//! \return Empty if failed to read the file, otherwise number of applied records.
+	static std::optional<size_t> Replay(const std::filesystem::path& journalPath, std::uint32_t fileChecksum, toml::value& data);
+
+	//! Writes a new version of a file next to it, to replace the file by \ref Rebase.
+	//! 
+	//! \param filePath Path to the file.
+	//! \param text     New content of the file.
+	//! 
+	//! \return Empty if failed to write the file, otherwise path to the new version.
+	static std::optional<std::filesystem::path> WriteNewFile(const std::filesystem::path& filePath, std::string_view text);
+
+	//! Replaces a file with the specified text, the text is flushed to the disk before the file is replaced
+	//! so that the file is never left half-written.
+	//! 
+	//! \param filePath Path to the file.
+	//! \param text     New content of the file.
+	//! 
+	//! \return 'false' if failed to write the file, 'true' otherwise.
+	static bool WriteFile(const std::filesystem::path& filePath, std::string_view text);
+
+	//! Calculates checksum of a record payload or of a document file text.
+	//! 
+	//! \param bytes Payload or text.
+	//! 
+	//! \return FNV-1a hash of the bytes.
+	static std::uint32_t GetChecksum(std::string_view bytes);
+
+private:
+	//! Reads a whole file.
+	//! 
+	//! \param filePath Path to the file.
+	//! 
+	//! \return Empty if failed to read the file, otherwise its bytes.
+	static std::optional<std::string> ReadFile(const std::filesystem::path& filePath);
+
+	//! Writes a file and flushes it to the disk.
+	//! 
+	//! \param filePath Path to the file (an existing file is truncated).
+	//! \param bytes    Content of the file.
+	//! 
+	//! \return 'false' if failed to write the file, 'true' otherwise.
+	static bool WriteSyncedFile(const std::filesystem::path& filePath, std::string_view bytes);
+
+	//! Creates a journal header.
+	//! 
+	//! \param fileChecksum Checksum of the document file text.
+	//! 
+	//! \return Header bytes.
+	static std::string CreateHeader(std::uint32_t fileChecksum);
+
+	//! Checks whether journal bytes start with the header for a document file.
+	//! 
+	//! \param bytes        Bytes of the journal file.
+	//! \param fileChecksum Checksum of the document file text.
+	//! 
+	//! \return 'true' if the journal applies to the file, 'false' otherwise.
+	static bool IsRebasedOn(std::string_view bytes, std::uint32_t fileChecksum);
+
+	//! Applies an operation of a record to TOML data.
+	//! 
+	//! \param operation Operation of the record.
+	//! \param rootTable Root table of the document.
+	//! 
+	//! \return 'false' if the operation doesn't match the data, 'true' otherwise.
+	static bool ApplyOperation(const CTomlPatch::SOperation& operation, toml::table& rootTable);
+
+	//! Returns path to the journal written by \ref Rebase before it replaces the journal.
+	//! 
+	//! \param journalPath Path to the journal file.
+	//! 
+	//! \return Path to the new journal.
+	static std::filesystem::path GetNewJournalPath(const std::filesystem::path& journalPath);
+
+	//! Constructor.
+	//! 
+	//! \param journalPath Path to the journal file.
+	//! \param pFile       Opened journal file.
+	CTomlJournal(const std::filesystem::path& journalPath, std::FILE* pFile);
+
+	//! Flushes written data of a file to the disk.
+	//! 
+	//! \param pFile File to flush.
+	//! 
+	//! \return 'false' if failed to flush the file, 'true' otherwise.
+	static bool SyncFile(std::FILE* pFile);
+
+	//! Size of a record header in bytes (payload size and checksum).
+	static inline const size_t m_recordHeaderSize = 8;
+
+	//! Size of the journal header in bytes (format tag and file checksum).
+	static inline const size_t m_headerSize = 8;
+
+	//! Format tag at the start of a journal file.
+	static inline const std::uint32_t m_formatTag = 0x4C4E4A54; // "TJNL"
+
+	//! Number of new file versions written by this process (makes their paths unique).
+	static inline std::atomic<size_t> m_newFileCount = 0;
+
+	//! Protects \ref m_openJournals.
+	static inline std::mutex m_mtxOpenJournals;
+
+	//! Paths of journal files open in this process.
+	static inline std::unordered_set<std::string> m_openJournals;
+
+	//! Path to the journal file.
+	std::filesystem::path m_journalPath;
+
+	//! Opened journal file, nullptr if a flush failed (protected by \ref m_mtxFile).
+	std::FILE* m_pFile = nullptr;
+
+	//! Size of the journal including records that were not flushed yet (see \ref GetSize).
+	size_t m_size = 0;
+
+	//! Size of the journal that was flushed (or lost by a failed flush), protected by \ref m_mtxFile.
+	size_t m_flushedSize = 0;
+
+	//! Appended records that were not flushed yet (protected by \ref m_mtxPendingRecords).
+	std::string m_pendingRecords;
+
+	//! Whether a flush failed, records are not appended until the journal is rebased.
+	std::atomic<bool> m_bFlushFailed = false;
+
+	//! Mutex for \ref m_pFile and \ref m_flushedSize, held while records are written to the file.
+	std::mutex m_mtxFile;
+
+	//! Mutex for \ref m_pendingRecords, never held while the file is written.
+	std::mutex m_mtxPendingRecords;
+
+	//! Number of times the document file was replaced (see \ref GetRebaseCount).
+	size_t m_rebaseCount = 0;
+};
@@ -1,5 +1,15 @@
 #include "TomlManager.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <set>
+#include <unordered_set>
+#include <sstream>
+#include "TomlBinarySnapshot.h"
+#include "TomlParallelParser.h"
 #include <CrySystem/ISystem.h>
 #if defined(WIN32)
 #include <ShlObj.h>
@@ -21,7 +31,7 @@ int CTomlManager::NewDocument()
 	m_nextTomlDocumentId += 1;
 
 	// Create a fresh TOML object.
-	m_tomlDocuments[newDocumentId] = toml::value();
+	m_tomlDocuments[newDocumentId] = SDocument();
 
 	return newDocumentId;
 }
@@ -34,355 +44,4814 @@ bool CTomlManager::IsDocumentRegistered(int documentId)
 	return it != m_tomlDocuments.end();
 }
 
-std::variant<std::vector<std::string>, CTomlManager::GetAllDocumentsError> CTomlManager::GetAllDocuments(const std::string& directoryName)
+std::optional<int> CTomlManager::CloneDocument(int documentId)
 {
-	// Check that directory name is not empty.
-	if (directoryName.empty())
+	std::scoped_lock guard(m_mtxTomlDocuments);
+
+	const auto pDocument = GetDocument(documentId);
+	if (pDocument == nullptr)
 	{
-		return CTomlManager::GetAllDocumentsError::DirectoryNameEmpty;
+		return {};
 	}
 
-	// Get base directory to store configs.
-	const auto optionalBasePath = GetDirectoryForConfigs();
-	if (!optionalBasePath.has_value())
+	// Share document's sections (frozen content is shared as is).
+	ShareDocumentContent(*pDocument);
+
+	// Create a document that shares the content.
+	const auto cloneId = NewDocument();
+	auto pClone = GetDocument(cloneId);
+	const auto pSource = GetDocument(documentId);
+	pClone->content = pSource->content;
+	pClone->sharedSectionNames = pSource->sharedSectionNames;
+	pClone->pFrozenDocument = pSource->pFrozenDocument;
+	pClone->partialFilePath = pSource->partialFilePath;
+	if (pSource->pLayers != nullptr)
 	{
-		return CTomlManager::GetAllDocumentsError::FailedToGetBasePath;
+		pClone->pLayers = std::make_unique<SLayers>(*pSource->pLayers);
+		for (const auto layerId : pClone->pLayers->documentIds)
+		{
+			m_layeredDocumentIds[layerId].push_back(cloneId);
+		}
 	}
+	pClone->revision = pSource->revision;
+	pClone->pSource = pSource->pSource;
+	pClone->modifiedSourceKeys = pSource->modifiedSourceKeys;
+	pClone->pLazySource = pSource->pLazySource;
+	pClone->unparsedLazyTables = pSource->unparsedLazyTables;
 
-	// Construct directory path.
-	const auto directoryPath = optionalBasePath.value() / std::string(directoryName);
-	if (!std::filesystem::exists(directoryPath))
+	return cloneId;
+}
+
+void CTomlManager::ShareDocumentContent(SDocument& document)
+{
+	for (const auto& [sectionName, pSection] : document.content.sections)
 	{
-		return std::vector<std::string>();
+		document.sharedSectionNames.insert(sectionName);
 	}
+}
 
-	// Scan directory for documents.
-	std::vector<std::string> foundDocumentNames;
-	const auto directoryIterator = std::filesystem::directory_iterator(directoryPath);
-	for (const auto& entry : directoryIterator)
+CTomlManager::SDocumentContent CTomlManager::CreateDocumentContent(toml::value data)
+{
+	SDocumentContent content;
+	if (!data.is_table())
 	{
-		if (!entry.is_regular_file()) continue;
+		return content;
+	}
 
-		if (entry.path().extension().string() == m_backupFileExtension)
+	// Key/values of the root table that are not tables (a table with an empty name is kept in the root
+	// section because the empty section name refers to the root section).
+	auto pRootSection = std::make_shared<SDocumentSection>();
+	auto& rootTable = pRootSection->data.as_table(std::nothrow);
+	for (auto& [keyName, value] : data.as_table(std::nothrow))
+	{
+		if (value.is_table() && !keyName.empty())
 		{
-			// Backup file. See if original file exists.
-			const auto originalFilePath = directoryPath / entry.path().stem().string();
-			if (!std::filesystem::exists(originalFilePath))
-			{
-				// Backup file exists, but not the original file.
-				// Copy backup file as the original.
-				std::filesystem::copy_file(entry, originalFilePath);
-			}
+			auto pSection = std::make_shared<SDocumentSection>();
+			pSection->data = std::move(value);
+			content.sections.emplace(keyName, std::move(pSection));
+		}
+		else
+		{
+			rootTable.emplace(keyName, std::move(value));
+		}
+	}
+	content.sections.emplace("", std::move(pRootSection));
+
+	return content;
+}
+
+void CTomlManager::SetDocumentData(SDocument& document, toml::value data)
+{
+	document.content = CreateDocumentContent(std::move(data));
+	document.sharedSectionNames.clear();
+}
+
+toml::value CTomlManager::GetDocumentData(const SDocument& document)
+{
+	// Frozen content.
+	if (document.pFrozenDocument != nullptr)
+	{
+		const auto& frozenDocument = *document.pFrozenDocument;
+		return frozenDocument.ToValue(frozenDocument.GetRoot()).value_or(toml::value(toml::table()));
+	}
+
+	if (document.content.sections.empty())
+	{
+		return toml::value();
+	}
 
-			// Check if we already added the original file.
-			bool bFound = false;
-			std::string originalFileName = originalFilePath.stem().string();
-			for (const auto& fileName : foundDocumentNames)
+	// Join sections into the root table.
+	toml::value data = toml::table();
+	auto& rootTable = data.as_table(std::nothrow);
+	for (const auto& [sectionName, pSection] : document.content.sections)
+	{
+		const SDocumentSection& section = *pSection;
+		if (sectionName.empty())
+		{
+			for (const auto& [keyName, value] : section.data.as_table(std::nothrow))
 			{
-				if (originalFileName == fileName)
-				{
-					bFound = true;
-					break;
-				}
+				rootTable[keyName] = value;
 			}
-
-			if (!bFound)
+			for (const auto& [keyName, packedArray] : section.packedArrays)
 			{
-				foundDocumentNames.push_back(originalFileName);
+				rootTable[keyName] = UnpackArray(packedArray);
 			}
 		}
 		else
 		{
-			// Check if we already added this file.
-			bool bFound = false;
-			std::string entryFileName = entry.path().stem().string();
-			for (const auto& fileName : foundDocumentNames)
-			{
-				if (entryFileName == fileName)
-				{
-					bFound = true;
-					break;
-				}
-			}
-
-			if (!bFound)
+			auto& table = (rootTable[sectionName] = section.data).as_table(std::nothrow);
+			for (const auto& [keyName, packedArray] : section.packedArrays)
 			{
-				foundDocumentNames.push_back(entryFileName);
+				table[keyName] = UnpackArray(packedArray);
 			}
 		}
 	}
 
-	return foundDocumentNames;
+	return data;
 }
 
-std::optional<std::filesystem::path> CTomlManager::GetDirectoryPathForDocuments(const std::string& directoryName)
+const CTomlManager::SDocumentSection* CTomlManager::FindSection(const SDocument& document, const std::string& sectionName)
 {
-	// Check that directory name is not empty.
-	if (directoryName.empty())
+	const auto it = document.content.sections.find(sectionName);
+	return it != document.content.sections.end() ? it->second.get() : nullptr;
+}
+
+CTomlManager::SDocumentSection& CTomlManager::GetSectionForModification(SDocument& document, const std::string& sectionName)
+{
+	auto& pSection = document.content.sections[sectionName];
+	if (pSection == nullptr)
 	{
-		return {};
+		pSection = std::make_shared<SDocumentSection>();
 	}
-
-	// Get base directory to store configs.
-	const auto optionalBasePath = GetDirectoryForConfigs();
-	if (!optionalBasePath.has_value())
+	else if (document.sharedSectionNames.erase(sectionName) != 0 && pSection.use_count() > 1)
 	{
-		return {};
+		// Copy the shared section, other documents keep the old one.
+		pSection = std::make_shared<SDocumentSection>(*pSection);
 	}
 
-	// Construct directory path.
-	const auto directoryPath = optionalBasePath.value() / std::string(directoryName);
-
-	return directoryPath;
+	return *pSection;
 }
 
-toml::value* CTomlManager::GetTomlData(int documentId)
+const toml::value* CTomlManager::FindDocumentValue(const SDocument& document, const std::string& keyName, const std::string& sectionName)
 {
-	std::scoped_lock guard(m_mtxTomlDocuments);
+	// A root key might refer to a section.
+	if (sectionName.empty() && !keyName.empty())
+	{
+		if (const auto pSection = FindSection(document, keyName))
+		{
+			return &pSection->data;
+		}
+	}
 
-	const auto it = m_tomlDocuments.find(documentId);
-	if (it == m_tomlDocuments.end())
+	// Look for the key in the section.
+	const auto pSection = FindSection(document, sectionName);
+	if (pSection == nullptr)
 	{
 		return nullptr;
 	}
+	const auto& table = pSection->data.as_table(std::nothrow);
+	const auto it = table.find(keyName);
+	return it != table.end() ? &it->second : nullptr;
+}
 
-	return &it->second;
+bool CTomlManager::IsRootValue(const SDocument& document, const std::string& keyName)
+{
+	const auto pRootSection = FindSection(document, "");
+	return pRootSection != nullptr && (pRootSection->data.as_table(std::nothrow).count(keyName) != 0 || pRootSection->packedArrays.count(keyName) != 0);
 }
 
-std::optional<CTomlManager::SaveDocumentError> CTomlManager::SaveDocument(int documentId, const std::string& fileName, const std::string& directoryName, bool bEnableBackup)
+bool CTomlManager::IsPartialDocumentFile(const SDocument& document, const std::filesystem::path& filePath)
+{
+	if (document.partialFilePath.empty())
+	{
+		return false;
+	}
+
+	std::error_code errorCode;
+	return filePath == document.partialFilePath || std::filesystem::equivalent(filePath, document.partialFilePath, errorCode);
+}
+
+std::optional<int> CTomlManager::CreateLayeredDocument(const std::vector<int>& layerDocumentIds)
 {
 	std::scoped_lock guard(m_mtxTomlDocuments);
 
-	// Check that file name is not empty.
-	if (fileName.empty())
+	// Check layers.
+	if (layerDocumentIds.empty())
 	{
-		CloseDocument(documentId);
-		return CTomlManager::SaveDocumentError::FileNameEmpty;
+		return {};
 	}
-
-	// Check that directory name is not empty.
-	if (directoryName.empty())
+	for (const auto layerId : layerDocumentIds)
 	{
-		CloseDocument(documentId);
-		return CTomlManager::SaveDocumentError::DirectoryNameEmpty;
+		const auto pLayer = GetDocument(layerId);
+		if (pLayer == nullptr || pLayer->pLayers != nullptr)
+		{
+			return {};
+		}
 	}
 
-	// Check that document exists.
-	if (!IsDocumentRegistered(documentId))
+	// Register new document.
+	const auto documentId = NewDocument();
+	auto pLayers = std::make_unique<SLayers>();
+	pLayers->documentIds = layerDocumentIds;
+	GetDocument(documentId)->pLayers = std::move(pLayers);
+	for (const auto layerId : layerDocumentIds)
 	{
-		CloseDocument(documentId);
-		return CTomlManager::SaveDocumentError::DocumentNotFound;
+		auto& layeredDocumentIds = m_layeredDocumentIds[layerId];
+		if (std::find(layeredDocumentIds.begin(), layeredDocumentIds.end(), documentId) == layeredDocumentIds.end())
+		{
+			layeredDocumentIds.push_back(documentId);
+		}
 	}
+	GetDocumentRevision(documentId);
+
+	return documentId;
+}
 
-	// Get TOML data.
-	auto pTomlData = GetTomlData(documentId);
+bool CTomlManager::FreezeDocument(int documentId)
+{
+	std::scoped_lock guard(m_mtxTomlDocuments);
 
-	// See if document has something.
-	if (pTomlData->is_uninitialized())
+	const auto pExistingDocument = GetDocument(documentId);
+	if (pExistingDocument == nullptr || pExistingDocument->pLayers != nullptr)
 	{
-		CloseDocument(documentId);
-		return CTomlManager::SaveDocumentError::DocumentIsEmpty;
+		return false;
 	}
 
-	// Get base directory to store configs.
-	const auto optionalBasePath = GetDirectoryForConfigs();
-	if (!optionalBasePath.has_value())
+	// Document is already frozen (modification access would convert it back to TOML data).
+	if (pExistingDocument->pFrozenDocument != nullptr)
 	{
-		CloseDocument(documentId);
-		return CTomlManager::SaveDocumentError::FailedToGetBasePath;
+		return true;
 	}
 
-	// Construct directory path.
-	const auto directoryPath = optionalBasePath.value() / std::string(directoryName);
-	if (!std::filesystem::exists(directoryPath)) {
-		std::filesystem::create_directories(directoryPath);
+	const auto pDocument = GetDocumentForModification(documentId);
+	if (pDocument == nullptr)
+	{
+		return false;
 	}
 
-	// Construct file path.
-	const auto filePath = directoryPath / (std::string(fileName) + ".toml");
-
-	// Handle backup.
-	std::filesystem::path backupFile = filePath;
-	backupFile += m_backupFileExtension;
-	if (bEnableBackup)
+	// Parse all tables of a lazily opened document.
+	if (pDocument->pLazySource != nullptr)
 	{
-		// Check if we already had this file saved.
-		if (std::filesystem::exists(filePath))
+		ParseAllLazyTables(*pDocument);
+		if (pDocument->pLazySource != nullptr)
 		{
-			if (std::filesystem::exists(backupFile))
-			{
-				std::filesystem::remove(backupFile);
-			}
-			std::filesystem::rename(filePath, backupFile);
+			CryLogAlways("[%s]: can't freeze document %i because some of its tables failed to parse", m_logCategory, documentId);
+			return false;
 		}
 	}
 
-	// Save document.
-	std::ofstream outFile(filePath, std::ios::binary);
-	if (!outFile.is_open())
+	// Frozen buffer stores all values (including packed arrays).
+	auto optionalBuffer = CTomlFrozenDocument::Freeze(GetDocumentData(*pDocument), 0, 0);
+	if (!optionalBuffer.has_value())
 	{
-		CloseDocument(documentId);
-		return CTomlManager::SaveDocumentError::UnableToCreateFile;
+		CryLogAlways("[%s]: document %i is too large to freeze", m_logCategory, documentId);
+		return false;
 	}
-	outFile << *pTomlData;
-	outFile.close();
 
-	CryLogAlways("[%s]: saved TOML document at \"%s\" (document %i)", m_logCategory, filePath.string().c_str(), documentId);
+	pDocument->pFrozenDocument = CTomlFrozenDocument::Load(std::move(optionalBuffer.value()));
+	pDocument->content.sections.clear();
+	pDocument->sharedSectionNames.clear();
 
-	CloseDocument(documentId);
+	return true;
+}
 
-	if (bEnableBackup)
+std::optional<size_t> CTomlManager::GetDocumentRevision(int documentId)
+{
+	std::scoped_lock guard(m_mtxTomlDocuments);
+
+	const auto pDocument = GetDocument(documentId);
+	if (pDocument == nullptr)
 	{
-		// Create backup file if it does not exist.
-		if (!std::filesystem::exists(backupFile))
+		return {};
+	}
+
+	// Layered document changes when any of its layers is modified or closed.
+	if (pDocument->pLayers != nullptr)
+	{
+		auto& layers = *pDocument->pLayers;
+		std::vector<size_t> revisions;
+		revisions.reserve(layers.documentIds.size());
+		for (const auto layerId : layers.documentIds)
 		{
-			std::filesystem::copy_file(filePath, backupFile);
+			const auto pLayer = GetDocument(layerId);
+			revisions.push_back(pLayer != nullptr ? pLayer->revision : std::numeric_limits<size_t>::max());
+		}
+		if (revisions != layers.checkedRevisions)
+		{
+			// The first check only remembers revisions of the layers.
+			pDocument->revision += layers.checkedRevisions.empty() ? 0 : 1;
+			layers.checkedRevisions = std::move(revisions);
 		}
 	}
 
-	return {};
+	return pDocument->revision;
 }
 
-std::variant<int, CTomlManager::OpenDocumentError> CTomlManager::OpenDocument(const std::string& fileName, const std::string& directoryName)
+std::variant<std::vector<std::string>, CTomlManager::GetAllDocumentsError> CTomlManager::GetAllDocuments(const std::string& directoryName)
 {
-	std::scoped_lock guard(m_mtxTomlDocuments);
-
-	// Check that file name is not empty.
-	if (fileName.empty())
-	{
-		return CTomlManager::OpenDocumentError::FileNameEmpty;
-	}
-
 	// Check that directory name is not empty.
 	if (directoryName.empty())
 	{
-		return CTomlManager::OpenDocumentError::DirectoryNameEmpty;
+		return CTomlManager::GetAllDocumentsError::DirectoryNameEmpty;
 	}
 
 	// Get base directory to store configs.
 	const auto optionalBasePath = GetDirectoryForConfigs();
 	if (!optionalBasePath.has_value())
 	{
-		return CTomlManager::OpenDocumentError::FailedToGetBasePath;
+		return CTomlManager::GetAllDocumentsError::FailedToGetBasePath;
 	}
 
-	// Construct directory path.
-	const auto directoryPath = optionalBasePath.value() / std::string(directoryName);
-	if (!std::filesystem::exists(directoryPath)) {
-		std::filesystem::create_directories(directoryPath);
-	}
+	// Scan directory for documents.
+	return ScanDocumentDirectory(optionalBasePath.value() / std::string(directoryName), true);
+}
 
-	// Construct file path.
-	const auto filePath = directoryPath / (std::string(fileName) + ".toml");
+std::vector<std::string> CTomlManager::ScanDocumentDirectory(const std::filesystem::path& directoryPath, bool bRestoreBackups)
+{
+	if (!std::filesystem::exists(directoryPath))
+	{
+		return {};
+	}
 
-	// Handle backup.
-	std::filesystem::path backupFile = filePath;
-	backupFile += m_backupFileExtension;
-	if (!std::filesystem::exists(filePath))
+	// Scan directory for documents.
+	std::vector<std::string> foundDocumentNames;
+	std::unordered_set<std::string> foundDocumentNameSet;
+	const auto directoryIterator = std::filesystem::directory_iterator(directoryPath);
+	for (const auto& entry : directoryIterator)
 	{
-		// Check if backup file exists.
-		if (std::filesystem::exists(backupFile))
+		if (!entry.is_regular_file()) continue;
+
+		// Skip metadata index (and its temporary file).
+		const auto entryFileName = entry.path().filename().string();
+		if (entryFileName == m_metadataIndexFileName || entryFileName == std::string(m_metadataIndexFileName) + ".tmp") continue;
+
+		// Skip binary snapshots, frozen buffers, save journals and temporary files.
+		const auto extension = entry.path().extension();
+		if (extension == ".tmp" || extension == m_snapshotFileExtension || extension == m_frozenFileExtension || extension == m_saveJournalFileExtension) continue;
+
+		std::string documentName;
+		if (entry.path().extension().string() == m_backupFileExtension)
 		{
-			std::filesystem::copy_file(backupFile, filePath);
+			// Backup file. See if original file exists.
+			const auto originalFilePath = directoryPath / entry.path().stem().string();
+			if (bRestoreBackups && !std::filesystem::exists(originalFilePath))
+			{
+				// Backup file exists, but not the original file.
+				// Copy backup file as the original.
+				std::filesystem::copy_file(entry, originalFilePath);
+			}
+
+			documentName = originalFilePath.stem().string();
 		}
 		else
 		{
-			return CTomlManager::OpenDocumentError::FileNotFound;
+			documentName = entry.path().stem().string();
+		}
+
+		// Check if we already added this document.
+		if (foundDocumentNameSet.insert(documentName).second)
+		{
+			foundDocumentNames.push_back(std::move(documentName));
 		}
 	}
 
-	// Register new document.
-	const auto documentId = NewDocument();
+	return foundDocumentNames;
+}
+
+std::variant<std::shared_ptr<const std::vector<std::string>>, CTomlManager::GetAllDocumentsError> CTomlManager::GetCachedDocumentListing(
+	const std::string& directoryName, bool bForceRefresh)
+{
+	// Check that directory name is not empty.
+	if (directoryName.empty())
+	{
+		return CTomlManager::GetAllDocumentsError::DirectoryNameEmpty;
+	}
 
-	// Get TOML data.
-	auto pTomlData = GetTomlData(documentId);
+	std::scoped_lock guard(m_mtxDocumentListings);
 
-	// Try parsing file.
-	try
+	// Use cached listing if the directory was not modified.
+	auto& listing = m_documentListings[directoryName];
+	if (listing.pWatcher != nullptr && !listing.pWatcher->ConsumeModifications() && !bForceRefresh)
 	{
-		*pTomlData = toml::parse(filePath);
+		return listing.pDocumentNames;
 	}
-	catch (std::exception& exception)
+
+	// Get directory path.
+	const auto optionalDirectoryPath = GetDirectoryPathForDocuments(directoryName);
+	if (!optionalDirectoryPath.has_value())
 	{
-		CryLogAlways("[%s]: failed to parse file at \"%s\", error: %s", m_logCategory, filePath.string().c_str(), exception.what());
-		return CTomlManager::OpenDocumentError::ParsingFailed;
+		m_documentListings.erase(directoryName);
+		return CTomlManager::GetAllDocumentsError::FailedToGetBasePath;
 	}
 
-	return documentId;
+	// Start watching before scanning so that modifications made during the scan are not missed.
+	if (listing.pWatcher == nullptr)
+	{
+		listing.pWatcher = std::make_unique<CTomlDirectoryWatcher>(optionalDirectoryPath.value());
+	}
+
+	// Scan directory (backups are restored when their documents are opened, the scan doesn't write files).
+	auto documentNames = ScanDocumentDirectory(optionalDirectoryPath.value(), false);
+	std::sort(documentNames.begin(), documentNames.end());
+
+	listing.pDocumentNames = std::make_shared<const std::vector<std::string>>(std::move(documentNames));
+
+	return listing.pDocumentNames;
 }
 
-bool CTomlManager::CloseDocument(int documentId)
+std::optional<std::filesystem::path> CTomlManager::GetDirectoryPathForDocuments(const std::string& directoryName)
 {
-	std::scoped_lock guard(m_mtxTomlDocuments);
+	// Check that directory name is not empty.
+	if (directoryName.empty())
+	{
+		return {};
+	}
+
+	// Get base directory to store configs.
+	const auto optionalBasePath = GetDirectoryForConfigs();
+	if (!optionalBasePath.has_value())
+	{
+		return {};
+	}
+
+	// Construct directory path.
+	const auto directoryPath = optionalBasePath.value() / std::string(directoryName);
+
+	return directoryPath;
+}
+
+CTomlManager::SDocument* CTomlManager::GetDocument(int documentId)
+{
+	std::scoped_lock guard(m_mtxTomlDocuments);
 
-	// Find document with this ID.
 	const auto it = m_tomlDocuments.find(documentId);
 	if (it == m_tomlDocuments.end())
 	{
-		return false;
+		return nullptr;
 	}
 
-	// Remove document ID.
-	m_tomlDocuments.erase(it);
+	return &it->second;
+}
 
-	return true;
+CTomlManager::SDocument* CTomlManager::GetDocumentForModification(int documentId)
+{
+	std::scoped_lock guard(m_mtxTomlDocuments);
+
+	const auto pDocument = GetDocument(documentId);
+	if (pDocument != nullptr)
+	{
+		UnfreezeDocument(*pDocument);
+	}
+
+	return pDocument;
 }
 
-bool CTomlManager::RemoveDocument(const std::string& fileName, const std::string& directoryName)
+void CTomlManager::UnfreezeDocument(SDocument& document)
 {
-	// Check that file name is not empty.
-	if (fileName.empty())
+	if (document.pFrozenDocument == nullptr)
 	{
-		return false;
+		return;
 	}
 
-	// Check that directory name is not empty.
-	if (directoryName.empty())
+	// Convert frozen content back to TOML data.
+	const auto& frozenDocument = *document.pFrozenDocument;
+	auto optionalData = frozenDocument.ToValue(frozenDocument.GetRoot());
+	if (!optionalData.has_value())
 	{
-		return false;
+		CryLogAlways("[%s]: frozen document is corrupted, its values are discarded", m_logCategory);
 	}
+	SetDocumentData(document, std::move(optionalData).value_or(toml::value(toml::table())));
+	document.pFrozenDocument = nullptr;
 
-	// Get base directory to store configs.
-	const auto optionalBasePath = GetDirectoryForConfigs();
-	if (!optionalBasePath.has_value())
+	// Store large numeric arrays contiguously.
+	PackDocumentArrays(document);
+}
+
+int CTomlManager::GetWriteDocumentId(int documentId)
+{
+	std::scoped_lock guard(m_mtxTomlDocuments);
+
+	const auto pDocument = GetDocument(documentId);
+	if (pDocument == nullptr || pDocument->pLayers == nullptr)
 	{
-		return false;
+		return documentId;
 	}
 
-	// Construct directory path.
-	const auto directoryPath = optionalBasePath.value() / std::string(directoryName);
-	if (!std::filesystem::exists(directoryPath)) {
-		return false;
+	return pDocument->pLayers->documentIds.back();
+}
+
+std::optional<int> CTomlManager::FindValueLayer(SLayers& layers, const std::string& keyName, const std::string& sectionName)
+{
+	std::scoped_lock guard(m_mtxTomlDocuments);
+
+	// Drop cached lookups if any layer was modified or closed since they were cached.
+	layers.revisions.resize(layers.documentIds.size(), std::numeric_limits<size_t>::max());
+	for (size_t i = 0; i < layers.documentIds.size(); i++)
+	{
+		const auto pLayer = GetDocument(layers.documentIds[i]);
+		const auto revision = pLayer != nullptr ? pLayer->revision : std::numeric_limits<size_t>::max();
+		if (layers.revisions[i] != revision)
+		{
+			layers.resolvedLayers.clear();
+			layers.revisions[i] = revision;
+		}
 	}
 
-	// Construct file path.
-	const auto filePath = directoryPath / (std::string(fileName) + ".toml");
+	// Use the cached lookup.
+	auto& sectionLayers = layers.resolvedLayers[sectionName];
+	const auto resolvedIt = sectionLayers.find(keyName);
+	if (resolvedIt != sectionLayers.end())
+	{
+		return resolvedIt->second;
+	}
 
-	// Handle backup.
-	std::filesystem::path backupFile = filePath;
-	backupFile += m_backupFileExtension;
+	// Look from the top layer down.
+	std::optional<int> optionalLayerId;
+	for (auto it = layers.documentIds.rbegin(); it != layers.documentIds.rend(); ++it)
+	{
+		const auto pLayer = GetDocument(*it);
+		if (pLayer != nullptr && ContainsValue(*pLayer, keyName, sectionName))
+		{
+			optionalLayerId = *it;
+			break;
+		}
+	}
+	sectionLayers.emplace(keyName, optionalLayerId);
 
-	// Check that at least one exists.
-	if (!std::filesystem::exists(filePath) && !std::filesystem::exists(backupFile))
+	return optionalLayerId;
+}
+
+bool CTomlManager::ContainsValue(SDocument& document, const std::string& keyName, const std::string& sectionName)
+{
+	// Frozen document.
+	if (document.pFrozenDocument != nullptr)
+	{
+		const auto& frozenDocument = *document.pFrozenDocument;
+		auto optionalTable = std::make_optional(frozenDocument.GetRoot());
+		if (!sectionName.empty())
+		{
+			optionalTable = frozenDocument.Find(optionalTable.value(), sectionName);
+		}
+		return optionalTable.has_value() && frozenDocument.Find(optionalTable.value(), keyName).has_value();
+	}
+
+	// Packed array (also parses the table if the document is opened lazily).
+	if (FindPackedArrayForReading(document, keyName, sectionName) != nullptr)
+	{
+		return true;
+	}
+
+	// TOML data.
+	return FindDocumentValue(document, keyName, sectionName) != nullptr;
+}
+
+void CTomlManager::SetDocumentCacheMemoryLimit(size_t memoryLimit)
+{
+	std::scoped_lock guard(m_mtxDocumentCache);
+
+	m_documentCacheStats.memoryLimit = memoryLimit;
+	TrimDocumentCache();
+}
+
+void CTomlManager::SetMetadataSectionName(const std::string& sectionName)
+{
+	std::scoped_lock guard(m_mtxTomlDocuments);
+
+	m_metadataSectionName = sectionName;
+}
+
+void CTomlManager::ClearDocumentCache()
+{
+	std::scoped_lock guard(m_mtxDocumentCache);
+
+	m_documentCache.clear();
+	m_documentCacheUsage.clear();
+	m_documentCacheStats.documentCount = 0;
+	m_documentCacheStats.memorySize = 0;
+}
+
+CTomlManager::SDocumentCacheStats CTomlManager::GetDocumentCacheStats()
+{
+	std::scoped_lock guard(m_mtxDocumentCache);
+
+	return m_documentCacheStats;
+}
+
+bool CTomlManager::FindCachedDocument(const std::filesystem::path& filePath, SDocument& document)
+{
+	std::scoped_lock guard(m_mtxDocumentCache);
+
+	const auto cacheIt = m_documentCache.find(filePath.string());
+	if (cacheIt == m_documentCache.end())
 	{
+		m_documentCacheStats.missCount += 1;
 		return false;
 	}
+	auto& cachedDocument = cacheIt->second;
 
-	// Remove original file.
-	if (std::filesystem::exists(filePath))
+	// Make sure the file was not modified.
+	std::error_code errorCode;
+	const auto fileSize = std::filesystem::file_size(filePath, errorCode);
+	const auto lastWriteTime = std::filesystem::last_write_time(filePath, errorCode);
+	if (errorCode || fileSize != cachedDocument.fileSize || lastWriteTime != cachedDocument.lastWriteTime)
 	{
-		std::filesystem::remove(filePath);
+		m_documentCacheStats.memorySize -= cachedDocument.memorySize;
+		m_documentCacheUsage.erase(cachedDocument.usageIt);
+		m_documentCache.erase(cacheIt);
+		m_documentCacheStats.documentCount = m_documentCache.size();
+		m_documentCacheStats.missCount += 1;
+		return false;
 	}
 
-	// Remove backup.
-	if (std::filesystem::exists(backupFile))
+	// Mark as most recently used.
+	m_documentCacheUsage.splice(m_documentCacheUsage.begin(), m_documentCacheUsage, cachedDocument.usageIt);
+	m_documentCacheStats.hitCount += 1;
+
+	// Share cached sections with the document.
+	document.content = *cachedDocument.pContent;
+	ShareDocumentContent(document);
+	document.pSource = cachedDocument.pSource;
+	if (document.pSource == nullptr)
 	{
-		std::filesystem::remove(backupFile);
+		SetDocumentSource(document, filePath, nullptr);
 	}
 
 	return true;
 }
 
+void CTomlManager::AddCachedDocument(const std::filesystem::path& filePath, SDocument& document)
+{
+	// Lazily opened documents don't have the full content.
+	if (document.pLazySource != nullptr)
+	{
+		return;
+	}
+
+	std::scoped_lock guard(m_mtxDocumentCache);
+
+	if (m_documentCacheStats.memoryLimit == 0)
+	{
+		return;
+	}
+
+	// Get file info.
+	SCachedDocument cachedDocument;
+	std::error_code errorCode;
+	cachedDocument.fileSize = std::filesystem::file_size(filePath, errorCode);
+	cachedDocument.lastWriteTime = std::filesystem::last_write_time(filePath, errorCode);
+	if (errorCode)
+	{
+		return;
+	}
+
+	// Share document's sections with the cache.
+	ShareDocumentContent(document);
+	auto pContent = std::make_shared<const SDocumentContent>(document.content);
+	// Parsed values also keep the file text alive (for error messages).
+	cachedDocument.memorySize = EstimateMemorySize(*pContent) + static_cast<size_t>(cachedDocument.fileSize);
+	cachedDocument.pContent = std::move(pContent);
+	cachedDocument.pSource = document.pSource;
+
+	// Replace previous version.
+	const auto filePathString = filePath.string();
+	const auto cacheIt = m_documentCache.find(filePathString);
+	if (cacheIt != m_documentCache.end())
+	{
+		m_documentCacheStats.memorySize -= cacheIt->second.memorySize;
+		m_documentCacheUsage.erase(cacheIt->second.usageIt);
+		m_documentCache.erase(cacheIt);
+	}
+
+	// Add to cache.
+	m_documentCacheUsage.push_front(filePathString);
+	cachedDocument.usageIt = m_documentCacheUsage.begin();
+	m_documentCacheStats.memorySize += cachedDocument.memorySize;
+	m_documentCache[filePathString] = std::move(cachedDocument);
+	m_documentCacheStats.documentCount = m_documentCache.size();
+
+	TrimDocumentCache();
+}
+
+void CTomlManager::RemoveCachedDocument(const std::filesystem::path& filePath)
+{
+	std::scoped_lock guard(m_mtxDocumentCache);
+
+	const auto cacheIt = m_documentCache.find(filePath.string());
+	if (cacheIt == m_documentCache.end())
+	{
+		return;
+	}
+
+	m_documentCacheStats.memorySize -= cacheIt->second.memorySize;
+	m_documentCacheUsage.erase(cacheIt->second.usageIt);
+	m_documentCache.erase(cacheIt);
+	m_documentCacheStats.documentCount = m_documentCache.size();
+}
+
+void CTomlManager::TrimDocumentCache()
+{
+	while (!m_documentCacheUsage.empty() && m_documentCacheStats.memorySize > m_documentCacheStats.memoryLimit)
+	{
+		// Opened documents keep sharing the content of removed entries.
+		const auto cacheIt = m_documentCache.find(m_documentCacheUsage.back());
+		m_documentCacheStats.memorySize -= cacheIt->second.memorySize;
+		m_documentCache.erase(cacheIt);
+		m_documentCacheUsage.pop_back();
+	}
+	m_documentCacheStats.documentCount = m_documentCache.size();
+}
+
+size_t CTomlManager::EstimateMemorySize(const SDocumentContent& content)
+{
+	size_t memorySize = sizeof(SDocumentContent);
+
+	// Add size of TOML values.
+	std::function<void(const toml::value&)> addValueSize = [&](const toml::value& value)
+	{
+		memorySize += sizeof(toml::value);
+		switch (value.type())
+		{
+		case toml::value_t::string:
+			memorySize += value.as_string(std::nothrow).str.capacity();
+			break;
+		case toml::value_t::array:
+			for (const auto& element : value.as_array(std::nothrow))
+			{
+				addValueSize(element);
+			}
+			break;
+		case toml::value_t::table:
+			for (const auto& [keyName, element] : value.as_table(std::nothrow))
+			{
+				memorySize += keyName.capacity() + sizeof(void*) * 2;
+				addValueSize(element);
+			}
+			break;
+		default:
+			break;
+		}
+	};
+	for (const auto& [sectionName, pSection] : content.sections)
+	{
+		memorySize += sectionName.capacity() + sizeof(SDocumentSection);
+		addValueSize(pSection->data);
+
+		// Add size of packed arrays.
+		for (const auto& [keyName, packedArray] : pSection->packedArrays)
+		{
+			memorySize += keyName.capacity() + std::visit([](const auto& packedElements)
+			{
+				return packedElements.capacity() * sizeof(packedElements[0]);
+			}, packedArray);
+		}
+	}
+
+	return memorySize;
+}
+
+CTomlWorkerPool& CTomlManager::GetWorkerPool()
+{
+	std::scoped_lock guard(m_mtxWorkerPool);
+
+	if (m_pWorkerPool == nullptr)
+	{
+		m_pWorkerPool = std::make_unique<CTomlWorkerPool>();
+	}
+
+	return *m_pWorkerPool;
+}
+
+void CTomlManager::ParseLazyTable(SDocument& document, const std::string& tableName)
+{
+	const auto tableIt = document.unparsedLazyTables.find(tableName);
+	if (tableIt == document.unparsedLazyTables.end())
+	{
+		return;
+	}
+
+	// Keep the table unparsed if it failed to parse so that its text is saved as is.
+	auto optionalTableData = ParseLazyTableText(*document.pLazySource, tableName);
+	if (!optionalTableData.has_value())
+	{
+		return;
+	}
+	document.unparsedLazyTables.erase(tableIt);
+	MergeLazyTable(document, std::move(optionalTableData.value()));
+
+	// Release source text when all tables are parsed.
+	if (document.unparsedLazyTables.empty())
+	{
+		document.pLazySource = nullptr;
+	}
+}
+
+std::optional<toml::value> CTomlManager::ParseLazyTableText(const SLazySource& lazySource, const std::string& tableName)
+{
+	const auto tableIt = lazySource.tableRanges.find(tableName);
+	if (tableIt == lazySource.tableRanges.end())
+	{
+		return {};
+	}
+
+	// Collect text of the table.
+	std::string tableText;
+	for (const auto& [begin, end] : tableIt->second)
+	{
+		tableText.append(lazySource.text, begin, end - begin);
+	}
+
+	// Parse table.
+	try
+	{
+		std::istringstream stream(tableText);
+		return toml::parse(stream, "table \"" + tableName + "\"");
+	}
+	catch (std::exception& exception)
+	{
+		CryLogAlways("[%s]: failed to parse table \"%s\", error: %s", m_logCategory, tableName.c_str(), exception.what());
+		return {};
+	}
+}
+
+void CTomlManager::MergeLazyTable(SDocument& document, toml::value tableData)
+{
+	// Merge with document's sections (root key/values might already define some keys of the table).
+	for (auto& [keyName, value] : tableData.as_table(std::nothrow))
+	{
+		if (!keyName.empty() && FindSection(document, keyName) != nullptr && value.is_table())
+		{
+			auto& section = GetSectionForModification(document, keyName);
+			for (auto& [subKeyName, subValue] : value.as_table(std::nothrow))
+			{
+				section.data.as_table(std::nothrow)[subKeyName] = std::move(subValue);
+			}
+
+			// Store large numeric arrays contiguously.
+			PackSectionArrays(section);
+		}
+		else
+		{
+			SetDocumentValue(document, keyName, "", std::move(value));
+		}
+	}
+}
+
+CTomlManager::SDocumentContent CTomlManager::GetLazyDocumentContent(const SDocument& document)
+{
+	// Sections are shared with the document, the ones that tables are merged into are copied.
+	SDocument lazyDocument;
+	lazyDocument.content = document.content;
+	for (const auto& [sectionName, pSection] : lazyDocument.content.sections)
+	{
+		lazyDocument.sharedSectionNames.insert(sectionName);
+	}
+
+	if (document.pLazySource != nullptr)
+	{
+		for (const auto& tableName : document.pLazySource->tableOrder)
+		{
+			if (document.unparsedLazyTables.count(tableName) == 0)
+			{
+				continue;
+			}
+			if (auto optionalTableData = ParseLazyTableText(*document.pLazySource, tableName))
+			{
+				MergeLazyTable(lazyDocument, std::move(optionalTableData.value()));
+			}
+		}
+	}
+
+	return std::move(lazyDocument.content);
+}
+
+void CTomlManager::ParseAllLazyTables(SDocument& document)
+{
+	if (document.pLazySource == nullptr)
+	{
+		return;
+	}
+
+	// Parsing the last table releases the lazy source, keep it alive while iterating.
+	const auto pLazySource = document.pLazySource;
+	for (const auto& tableName : pLazySource->tableOrder)
+	{
+		ParseLazyTable(document, tableName);
+	}
+}
+
+const CTomlManager::PackedArray* CTomlManager::FindPackedArrayForReading(SDocument& document, const std::string& keyName, const std::string& sectionName)
+{
+	ParseLazyTable(document, sectionName.empty() ? keyName : sectionName);
+
+	const auto pSection = FindSection(document, sectionName);
+	if (pSection == nullptr)
+	{
+		return nullptr;
+	}
+
+	const auto arrayIt = pSection->packedArrays.find(keyName);
+	if (arrayIt == pSection->packedArrays.end())
+	{
+		return nullptr;
+	}
+
+	return &arrayIt->second;
+}
+
+CTomlManager::PackedArray* CTomlManager::FindPackedArrayForModification(SDocument& document, const std::string& keyName, const std::string& sectionName)
+{
+	UnfreezeDocument(document);
+
+	// Copy the section only if it has the array.
+	if (FindPackedArrayForReading(document, keyName, sectionName) == nullptr)
+	{
+		return nullptr;
+	}
+
+	return &GetSectionForModification(document, sectionName).packedArrays.at(keyName);
+}
+
+bool CTomlManager::CanPackArray(const toml::array& array)
+{
+	if (array.size() < m_minPackedArraySize)
+	{
+		return false;
+	}
+
+	// Make sure that the array is homogeneous.
+	const auto elementType = array.front().type();
+	if (elementType != toml::value_t::integer && elementType != toml::value_t::floating && elementType != toml::value_t::boolean)
+	{
+		return false;
+	}
+
+	return std::all_of(array.begin(), array.end(), [elementType](const toml::value& element) { return element.type() == elementType; });
+}
+
+std::optional<CTomlManager::PackedArray> CTomlManager::TryPackArray(const toml::array& array)
+{
+	if (!CanPackArray(array))
+	{
+		return {};
+	}
+
+	// Copy elements.
+	const auto elementType = array.front().type();
+	switch (elementType)
+	{
+	case toml::value_t::integer:
+	{
+		std::vector<toml::integer> packedElements(array.size());
+		for (size_t i = 0; i < array.size(); i++)
+		{
+			packedElements[i] = array[i].as_integer(std::nothrow);
+		}
+		return packedElements;
+	}
+	case toml::value_t::floating:
+	{
+		std::vector<toml::floating> packedElements(array.size());
+		for (size_t i = 0; i < array.size(); i++)
+		{
+			packedElements[i] = array[i].as_floating(std::nothrow);
+		}
+		return packedElements;
+	}
+	default:
+	{
+		std::vector<std::uint8_t> packedElements(array.size());
+		for (size_t i = 0; i < array.size(); i++)
+		{
+			packedElements[i] = array[i].as_boolean(std::nothrow) ? 1 : 0;
+		}
+		return packedElements;
+	}
+	}
+}
+
+toml::value CTomlManager::UnpackArray(const PackedArray& packedArray)
+{
+	toml::array array;
+
+	std::visit([&array](const auto& packedElements)
+	{
+		using Element = typename std::decay_t<decltype(packedElements)>::value_type;
+
+		array.reserve(packedElements.size());
+		for (const auto& element : packedElements)
+		{
+			if constexpr (std::is_same_v<Element, std::uint8_t>)
+			{
+				array.emplace_back(element != 0);
+			}
+			else
+			{
+				array.emplace_back(element);
+			}
+		}
+	}, packedArray);
+
+	return toml::value(std::move(array));
+}
+
+void CTomlManager::UnpackDocumentArray(SDocument& document, const std::string& keyName, const std::string& sectionName)
+{
+	const auto pSection = FindSection(document, sectionName);
+	if (pSection == nullptr || pSection->packedArrays.count(keyName) == 0)
+	{
+		return;
+	}
+
+	// Move array to TOML data.
+	auto& section = GetSectionForModification(document, sectionName);
+	const auto arrayIt = section.packedArrays.find(keyName);
+	section.data.as_table(std::nothrow)[keyName] = UnpackArray(arrayIt->second);
+	section.packedArrays.erase(arrayIt);
+}
+
+void CTomlManager::PackSectionArrays(SDocumentSection& section)
+{
+	auto& table = section.data.as_table(std::nothrow);
+	for (auto it = table.begin(); it != table.end();)
+	{
+		if (it->second.is_array())
+		{
+			auto optionalPackedArray = TryPackArray(it->second.as_array(std::nothrow));
+			if (optionalPackedArray.has_value())
+			{
+				section.packedArrays[it->first] = std::move(optionalPackedArray.value());
+				it = table.erase(it);
+				continue;
+			}
+		}
+		++it;
+	}
+}
+
+void CTomlManager::PackDocumentArrays(SDocument& document)
+{
+	for (const auto& [sectionName, pSection] : document.content.sections)
+	{
+		// Look for arrays to pack without copying a shared section.
+		const SDocumentSection& section = *pSection;
+		const auto& table = section.data.as_table(std::nothrow);
+		const auto bPackable = std::any_of(table.begin(), table.end(), [](const std::pair<const toml::key, toml::value>& keyValue)
+		{
+			return keyValue.second.is_array() && CanPackArray(keyValue.second.as_array(std::nothrow));
+		});
+		if (bPackable)
+		{
+			PackSectionArrays(GetSectionForModification(document, sectionName));
+		}
+	}
+}
+
+void CTomlManager::PrepareForOverwrite(SDocument& document, const std::string& keyName, const std::string& sectionName)
+{
+	if (sectionName.empty())
+	{
+		// Overwritten table does not need to be parsed.
+		if (document.unparsedLazyTables.erase(keyName) != 0 && document.unparsedLazyTables.empty())
+		{
+			document.pLazySource = nullptr;
+		}
+
+		// The section with this name is overwritten (a table with an empty name is a value of the root section).
+		if (!keyName.empty())
+		{
+			document.content.sections.erase(keyName);
+			document.sharedSectionNames.erase(keyName);
+		}
+	}
+	else
+	{
+		// New value is added to the section so it should be parsed.
+		ParseLazyTable(document, sectionName);
+	}
+
+	// Remove old value (a shared section is copied only if it has the value).
+	const auto pSection = FindSection(document, sectionName);
+	if (pSection != nullptr && (pSection->data.as_table(std::nothrow).count(keyName) != 0 || pSection->packedArrays.count(keyName) != 0))
+	{
+		auto& section = GetSectionForModification(document, sectionName);
+		section.data.as_table(std::nothrow).erase(keyName);
+		section.packedArrays.erase(keyName);
+	}
+}
+
+void CTomlManager::SetDocumentValue(SDocument& document, const std::string& keyName, const std::string& sectionName, toml::value value)
+{
+	PrepareForOverwrite(document, keyName, sectionName);
+
+	// Tables of the root table are sections (except a table with an empty name, see CreateDocumentContent).
+	if (sectionName.empty() && value.is_table() && !keyName.empty())
+	{
+		auto& section = GetSectionForModification(document, keyName);
+		section.data = std::move(value);
+
+		// Store large numeric arrays contiguously.
+		PackSectionArrays(section);
+		return;
+	}
+
+	// The section replaces a root value with the same name.
+	if (!sectionName.empty() && FindSection(document, sectionName) == nullptr && IsRootValue(document, sectionName))
+	{
+		PrepareForOverwrite(document, sectionName, "");
+	}
+
+	// Store large numeric arrays as packed arrays.
+	auto& section = GetSectionForModification(document, sectionName);
+	if (value.is_array())
+	{
+		if (auto optionalPackedArray = TryPackArray(value.as_array(std::nothrow)))
+		{
+			section.packedArrays[keyName] = std::move(optionalPackedArray.value());
+			return;
+		}
+	}
+	section.data.as_table(std::nothrow)[keyName] = std::move(value);
+}
+
+void CTomlManager::ReplaceDocumentValue(SDocument& document, const std::string& keyName, const std::string& sectionName, const toml::value* pValue)
+{
+	if (pValue == nullptr)
+	{
+		PrepareForOverwrite(document, keyName, sectionName);
+		return;
+	}
+
+	SetDocumentValue(document, keyName, sectionName, *pValue);
+}
+
+CTomlManager::CModificationLock::CModificationLock(CTomlManager& manager)
+	: m_manager(manager)
+{
+	m_manager.m_mtxTomlDocuments.lock();
+	m_manager.m_modificationLockDepth += 1;
+}
+
+CTomlManager::CModificationLock::~CModificationLock()
+{
+	// Take the queued work when the outermost lock is released.
+	std::vector<std::pair<int, std::shared_ptr<CTomlJournal>>> pendingJournalFlushes;
+	std::vector<int> pendingCompactions;
+	std::vector<std::tuple<std::shared_ptr<SSubscription>, int, std::string, std::string>> pendingNotifications;
+	m_manager.m_modificationLockDepth -= 1;
+	if (m_manager.m_modificationLockDepth == 0)
+	{
+		pendingJournalFlushes.swap(m_manager.m_pendingJournalFlushes);
+		pendingCompactions.swap(m_manager.m_pendingCompactions);
+		pendingNotifications.swap(m_manager.m_pendingNotifications);
+	}
+	m_manager.m_mtxTomlDocuments.unlock();
+
+	// Write appended save journal records (write the whole document if failed to write them).
+	for (const auto& [documentId, pJournal] : pendingJournalFlushes)
+	{
+		if (!pJournal->Flush() && std::find(pendingCompactions.begin(), pendingCompactions.end(), documentId) == pendingCompactions.end())
+		{
+			m_manager.WriteSaveJournalDocument(documentId);
+		}
+	}
+
+	// Write documents of large save journals.
+	for (const auto documentId : pendingCompactions)
+	{
+		m_manager.WriteSaveJournalDocument(documentId);
+	}
+
+	// Notify observers (they can lock documents again).
+	for (const auto& [pSubscription, documentId, sectionName, keyName] : pendingNotifications)
+	{
+		m_manager.CallValueObserver(*pSubscription, documentId, sectionName, keyName);
+	}
+}
+
+void CTomlManager::MarkDocumentModified(int documentId, SDocument& document, const std::string& keyName, const std::string& sectionName,
+	CTomlPatch::EOperation operation, size_t index)
+{
+	document.revision += 1;
+
+	// Add to journal.
+	if (document.changeJournal.size() == m_maxChangeJournalSize)
+	{
+		document.changeJournal.pop_front();
+	}
+	document.changeJournal.push_back({ document.revision, sectionName, keyName });
+
+	// Remember which values of the file text have to be compared when saving.
+	if (document.pSource != nullptr)
+	{
+		document.modifiedSourceKeys[sectionName].insert(keyName);
+	}
+
+	// Append the change to the save journal, write the whole document if the journal is too large
+	// (or if failed to append).
+	if (document.pSaveJournal != nullptr)
+	{
+		auto& saveJournal = *document.pSaveJournal;
+		CTomlPatch::SOperation journalOperation;
+		journalOperation.type = operation;
+		journalOperation.sectionName = sectionName;
+		journalOperation.keyName = keyName;
+		journalOperation.index = index;
+		if (operation == CTomlPatch::EOperation::EraseElements)
+		{
+			journalOperation.count = 1;
+		}
+		else if (operation != CTomlPatch::EOperation::SetValue)
+		{
+			// Write only the changed element.
+			auto optionalElement = CopyDocumentElement(document, keyName, sectionName, index);
+			journalOperation.type = optionalElement.has_value() ? operation : CTomlPatch::EOperation::SetValue;
+			journalOperation.value = optionalElement.has_value() ? toml::array{ std::move(optionalElement).value() } : toml::value();
+		}
+		if (journalOperation.type == CTomlPatch::EOperation::SetValue)
+		{
+			auto optionalValue = CopyDocumentValue(document, keyName, sectionName);
+			journalOperation.type = optionalValue.has_value() ? CTomlPatch::EOperation::SetValue : CTomlPatch::EOperation::RemoveValue;
+			journalOperation.value = std::move(optionalValue).value_or(toml::value());
+		}
+		auto bAppended = saveJournal.pJournal->Append(journalOperation);
+		if (bAppended)
+		{
+			// Write the record when the modification is finished (see CModificationLock).
+			if (m_modificationLockDepth != 0)
+			{
+				const auto flushIt = std::find_if(m_pendingJournalFlushes.begin(), m_pendingJournalFlushes.end(),
+					[&](const auto& pendingFlush) { return pendingFlush.second == saveJournal.pJournal; });
+				if (flushIt == m_pendingJournalFlushes.end())
+				{
+					m_pendingJournalFlushes.emplace_back(documentId, saveJournal.pJournal);
+				}
+			}
+			else
+			{
+				bAppended = saveJournal.pJournal->Flush();
+			}
+		}
+		if ((!bAppended || saveJournal.pJournal->GetSize() >= saveJournal.compactionSize) && !saveJournal.bCompactionQueued)
+		{
+			// Write the document when the modification is finished (see CModificationLock).
+			if (m_modificationLockDepth != 0)
+			{
+				saveJournal.bCompactionQueued = true;
+				m_pendingCompactions.push_back(documentId);
+			}
+			else
+			{
+				WriteSaveJournalDocument(documentId);
+			}
+		}
+	}
+
+	NotifyValueObservers(documentId, document, keyName, sectionName, nullptr);
+
+	// Notify observers of layered documents that show the value (it is not overridden by a higher layer).
+	const auto layeredDocumentsIt = m_layeredDocumentIds.find(documentId);
+	if (layeredDocumentsIt == m_layeredDocumentIds.end())
+	{
+		return;
+	}
+	const auto layeredDocumentIds = layeredDocumentsIt->second;
+	for (const auto layeredDocumentId : layeredDocumentIds)
+	{
+		const auto pLayeredDocument = GetDocument(layeredDocumentId);
+		if (pLayeredDocument == nullptr || pLayeredDocument->pLayers == nullptr || pLayeredDocument->subscriptions.empty())
+		{
+			continue;
+		}
+		const auto& layeredDocument = *pLayeredDocument;
+
+		const auto& layerIds = layeredDocument.pLayers->documentIds;
+		const auto layerIt = std::find(layerIds.rbegin(), layerIds.rend(), documentId);
+		if (layerIt == layerIds.rend())
+		{
+			continue;
+		}
+
+		NotifyValueObservers(layeredDocumentId, layeredDocument, keyName, sectionName,
+			[this, &layerIds, layerIt](const std::string& observedSectionName, const std::string& observedKeyName)
+			{
+				return std::none_of(layerIds.rbegin(), layerIt, [&](int layerId)
+				{
+					const auto pLayer = GetDocument(layerId);
+					return pLayer != nullptr && ContainsValue(*pLayer, observedKeyName, observedSectionName);
+				});
+			});
+	}
+}
+
+void CTomlManager::NotifyValueObservers(int documentId, const SDocument& document, const std::string& keyName, const std::string& sectionName,
+	const std::function<bool(const std::string& observedSectionName, const std::string& observedKeyName)>& isValueVisible)
+{
+	if (document.subscriptions.empty())
+	{
+		return;
+	}
+
+	// Collect observers of the value, the section that contains the value (if the whole section
+	// was overwritten) and the root key of the section.
+	std::vector<std::pair<size_t, std::shared_ptr<SSubscription>>> callbacks;
+	const auto collect = [&](const std::string& observedSectionName, const std::string* pObservedKeyName)
+	{
+		const auto sectionIt = document.subscriptions.find(observedSectionName);
+		if (sectionIt == document.subscriptions.end())
+		{
+			return;
+		}
+
+		for (const auto& [observedKeyName, keySubscriptions] : sectionIt->second)
+		{
+			if (pObservedKeyName != nullptr && observedKeyName != *pObservedKeyName)
+			{
+				continue;
+			}
+
+			// An observer of the whole section sees the modified value, other observers see the observed value.
+			const auto bSectionObserver = !sectionName.empty() && observedSectionName.empty();
+			if (isValueVisible != nullptr
+				&& !(bSectionObserver ? isValueVisible(sectionName, keyName) : isValueVisible(observedSectionName, observedKeyName)))
+			{
+				continue;
+			}
+			callbacks.insert(callbacks.end(), keySubscriptions.begin(), keySubscriptions.end());
+		}
+	};
+	if (sectionName.empty())
+	{
+		collect("", &keyName);
+		collect(keyName, nullptr);
+	}
+	else
+	{
+		collect(sectionName, &keyName);
+		collect("", &sectionName);
+	}
+
+	// Notify observers when the modification is finished (see CModificationLock).
+	for (const auto& [subscriptionId, pSubscription] : callbacks)
+	{
+		if (m_modificationLockDepth != 0)
+		{
+			m_pendingNotifications.emplace_back(pSubscription, documentId, sectionName, keyName);
+		}
+		else
+		{
+			CallValueObserver(*pSubscription, documentId, sectionName, keyName);
+		}
+	}
+}
+
+void CTomlManager::CallValueObserver(SSubscription& subscription, int documentId, const std::string& sectionName, const std::string& keyName)
+{
+	// Register the call so that Unsubscribe waits for it.
+	{
+		std::scoped_lock guard(m_mtxNotifications);
+		if (!subscription.bActive)
+		{
+			return;
+		}
+		m_runningNotifications.emplace(subscription.id, std::this_thread::get_id());
+	}
+
+	subscription.callback(documentId, sectionName, keyName);
+
+	// Remove the call (iterators are not kept because inserting might have rehashed the container).
+	{
+		std::scoped_lock guard(m_mtxNotifications);
+		const auto range = m_runningNotifications.equal_range(subscription.id);
+		const auto runningIt = std::find_if(range.first, range.second,
+			[](const auto& running) { return running.second == std::this_thread::get_id(); });
+		if (runningIt != range.second)
+		{
+			m_runningNotifications.erase(runningIt);
+		}
+	}
+	m_cvNotifications.notify_all();
+}
+
+void CTomlManager::DeactivateSubscriptions(SDocument& document)
+{
+	std::scoped_lock guard(m_mtxNotifications);
+
+	for (auto& [sectionName, sectionSubscriptions] : document.subscriptions)
+	{
+		for (auto& [keyName, keySubscriptions] : sectionSubscriptions)
+		{
+			for (auto& [subscriptionId, pSubscription] : keySubscriptions)
+			{
+				pSubscription->bActive = false;
+			}
+		}
+	}
+}
+
+std::variant<std::vector<CTomlManager::SValueChange>, CTomlManager::GetChangesError> CTomlManager::GetChangesSince(int documentId, size_t revision)
+{
+	std::scoped_lock guard(m_mtxTomlDocuments);
+
+	const auto pDocument = GetDocument(documentId);
+	if (pDocument == nullptr)
+	{
+		return CTomlManager::GetChangesError::DocumentNotFound;
+	}
+
+	// Check that all changes after the specified revision are in the journal.
+	if (revision < pDocument->revision
+		&& (pDocument->changeJournal.empty() || pDocument->changeJournal.front().revision > revision + 1))
+	{
+		return CTomlManager::GetChangesError::JournalOverflow;
+	}
+
+	std::vector<SValueChange> changes;
+	for (const auto& change : pDocument->changeJournal)
+	{
+		if (change.revision > revision)
+		{
+			changes.push_back(change);
+		}
+	}
+
+	return changes;
+}
+
+std::optional<CTomlPatch> CTomlManager::Diff(int documentId, int otherDocumentId)
+{
+	std::scoped_lock guard(m_mtxTomlDocuments);
+
+	// Layered documents are compared by their top layers.
+	documentId = GetWriteDocumentId(documentId);
+	otherDocumentId = GetWriteDocumentId(otherDocumentId);
+	const auto pDocument = GetDocument(documentId);
+	const auto pOtherDocument = GetDocument(otherDocumentId);
+	if (pDocument == nullptr || pOtherDocument == nullptr)
+	{
+		return {};
+	}
+
+	// Documents that share all values are equal.
+	if (pDocument->pFrozenDocument != nullptr && pDocument->pFrozenDocument == pOtherDocument->pFrozenDocument)
+	{
+		return CTomlPatch();
+	}
+
+	// Whole documents are compared (tables of lazily opened documents are parsed without adding them to the documents).
+	SDocumentContent lazyContent;
+	SDocumentContent otherLazyContent;
+	const auto& content = pDocument->pLazySource == nullptr ? pDocument->content : (lazyContent = GetLazyDocumentContent(*pDocument));
+	const auto& otherContent = pOtherDocument->pLazySource == nullptr ? pOtherDocument->content
+		: (otherLazyContent = GetLazyDocumentContent(*pOtherDocument));
+
+	CTomlPatch patch;
+	if (pDocument->pFrozenDocument == nullptr && pOtherDocument->pFrozenDocument == nullptr)
+	{
+		DiffContents(content, otherContent, patch);
+	}
+	else
+	{
+		DiffFrozenDocuments(pDocument->pFrozenDocument.get(), content, pOtherDocument->pFrozenDocument.get(), otherContent, patch);
+	}
+
+	return patch;
+}
+
+std::optional<CTomlManager::ApplyPatchError> CTomlManager::ApplyPatch(int documentId, const CTomlPatch& patch)
+{
+	CModificationLock guard(*this);
+
+	// Layered documents are written to their top layer.
+	documentId = GetWriteDocumentId(documentId);
+
+	// Check that document exists.
+	if (!IsDocumentRegistered(documentId))
+	{
+		return CTomlManager::ApplyPatchError::DocumentNotFound;
+	}
+
+	// Check that keys are not empty.
+	const auto& operations = patch.GetOperations();
+	if (std::any_of(operations.begin(), operations.end(), [](const CTomlPatch::SOperation& operation) { return operation.keyName.empty(); }))
+	{
+		return CTomlManager::ApplyPatchError::KeyEmpty;
+	}
+
+	// Check that array operations have arrays of new elements.
+	if (std::any_of(operations.begin(), operations.end(), [](const CTomlPatch::SOperation& operation)
+		{
+			return (operation.type == CTomlPatch::EOperation::SetElements || operation.type == CTomlPatch::EOperation::InsertElements)
+				&& !operation.value.is_array();
+		}))
+	{
+		return CTomlManager::ApplyPatchError::InvalidPatch;
+	}
+
+	// Patched values are read from the whole document.
+	auto pDocument = GetDocumentForModification(documentId);
+	ParseAllLazyTables(*pDocument);
+
+	// Operations modify copies of the values first so that the document is not modified if one of the operations fails.
+	std::map<std::pair<std::string, std::string>, std::optional<toml::value>> modifiedValues;
+	std::vector<std::pair<std::string, std::string>> modifiedKeys;
+	const auto getModifiedValue = [&](const std::string& sectionName, const std::string& keyName) -> std::optional<toml::value>*
+	{
+		if (sectionName.empty())
+		{
+			auto valueIt = modifiedValues.find({ sectionName, keyName });
+			if (valueIt == modifiedValues.end())
+			{
+				modifiedKeys.emplace_back(sectionName, keyName);
+				valueIt = modifiedValues.emplace(std::make_pair(sectionName, keyName), CopyDocumentValue(*pDocument, keyName, sectionName)).first;
+			}
+			auto& value = valueIt->second;
+
+			// The whole section is modified now, include its values modified by previous operations
+			// (also when the section was already modified, its values could be modified after that).
+			for (auto it = modifiedValues.lower_bound({ keyName, std::string() }); it != modifiedValues.end() && it->first.first == keyName;
+				it = modifiedValues.erase(it))
+			{
+				if (!value.has_value())
+				{
+					value = toml::table();
+				}
+				if (it->second.has_value())
+				{
+					value->as_table()[it->first.second] = it->second.value();
+				}
+				else
+				{
+					value->as_table().erase(it->first.second);
+				}
+			}
+			modifiedKeys.erase(std::remove_if(modifiedKeys.begin(), modifiedKeys.end(), [&keyName](const std::pair<std::string, std::string>& modifiedKey)
+			{
+				return modifiedKey.first == keyName;
+			}), modifiedKeys.end());
+
+			return &value;
+		}
+
+		const auto valueIt = modifiedValues.find({ sectionName, keyName });
+		if (valueIt != modifiedValues.end())
+		{
+			return &valueIt->second;
+		}
+
+		std::optional<toml::value> value;
+		if (const auto sectionIt = modifiedValues.find({ std::string(), sectionName }); sectionIt != modifiedValues.end())
+		{
+			// The section was modified by previous operations.
+			if (sectionIt->second.has_value())
+			{
+				if (!sectionIt->second->is_table())
+				{
+					return nullptr;
+				}
+				const auto& sectionTable = sectionIt->second->as_table();
+				const auto keyIt = sectionTable.find(keyName);
+				if (keyIt != sectionTable.end())
+				{
+					value = keyIt->second;
+				}
+			}
+		}
+		else
+		{
+			// The section should be a table.
+			if (IsRootValue(*pDocument, sectionName))
+			{
+				return nullptr;
+			}
+			value = CopyDocumentValue(*pDocument, keyName, sectionName);
+		}
+
+		modifiedKeys.emplace_back(sectionName, keyName);
+		return &(modifiedValues[{ sectionName, keyName }] = std::move(value));
+	};
+
+	for (const auto& operation : operations)
+	{
+		const auto pOptionalValue = getModifiedValue(operation.sectionName, operation.keyName);
+		if (pOptionalValue == nullptr)
+		{
+			return CTomlManager::ApplyPatchError::ValueTypeMismatch;
+		}
+		auto& optionalValue = *pOptionalValue;
+
+		if (operation.type == CTomlPatch::EOperation::SetValue)
+		{
+			optionalValue = operation.value;
+			continue;
+		}
+
+		if (!optionalValue.has_value())
+		{
+			return CTomlManager::ApplyPatchError::ValueNotFound;
+		}
+		if (operation.type == CTomlPatch::EOperation::RemoveValue)
+		{
+			optionalValue.reset();
+			continue;
+		}
+
+		// Modify the array.
+		if (!optionalValue->is_array())
+		{
+			return CTomlManager::ApplyPatchError::ValueTypeMismatch;
+		}
+		auto& array = optionalValue->as_array();
+		if (operation.index > array.size())
+		{
+			return CTomlManager::ApplyPatchError::IndexOutOfRange;
+		}
+		const auto elementsBegin = array.begin() + operation.index;
+		switch (operation.type)
+		{
+		case CTomlPatch::EOperation::SetElements:
+		{
+			const auto& elements = operation.value.as_array();
+			if (elements.size() > array.size() - operation.index)
+			{
+				return CTomlManager::ApplyPatchError::IndexOutOfRange;
+			}
+			std::copy(elements.begin(), elements.end(), elementsBegin);
+			break;
+		}
+		case CTomlPatch::EOperation::InsertElements:
+		{
+			const auto& elements = operation.value.as_array();
+			array.insert(elementsBegin, elements.begin(), elements.end());
+			break;
+		}
+		case CTomlPatch::EOperation::EraseElements:
+			if (operation.count > array.size() - operation.index)
+			{
+				return CTomlManager::ApplyPatchError::IndexOutOfRange;
+			}
+			array.erase(elementsBegin, elementsBegin + operation.count);
+			break;
+		default:
+			break;
+		}
+	}
+
+	// Set all values first so that observers see the whole patched document.
+	for (const auto& [sectionName, keyName] : modifiedKeys)
+	{
+		const auto& optionalValue = modifiedValues.at({ sectionName, keyName });
+		ReplaceDocumentValue(*pDocument, keyName, sectionName, optionalValue.has_value() ? &optionalValue.value() : nullptr);
+	}
+
+	// Notify observers.
+	for (const auto& [sectionName, keyName] : modifiedKeys)
+	{
+		MarkDocumentModified(documentId, *pDocument, keyName, sectionName);
+	}
+
+	return {};
+}
+
+std::variant<size_t, CTomlManager::SubscribeError> CTomlManager::Subscribe(
+	int documentId, const std::string& keyName, const std::string& sectionName, ValueChangedCallback callback)
+{
+	std::scoped_lock guard(m_mtxTomlDocuments);
+
+	// Check that key is not empty.
+	if (keyName.empty())
+	{
+		return CTomlManager::SubscribeError::KeyEmpty;
+	}
+
+	// Check that document exists.
+	const auto pDocument = GetDocument(documentId);
+	if (pDocument == nullptr)
+	{
+		return CTomlManager::SubscribeError::DocumentNotFound;
+	}
+
+	// Register callback.
+	auto pSubscription = std::make_shared<SSubscription>();
+	pSubscription->id = m_nextSubscriptionId;
+	pSubscription->callback = std::move(callback);
+	m_nextSubscriptionId += 1;
+	const auto subscriptionId = pSubscription->id;
+	pDocument->subscriptions[sectionName][keyName][subscriptionId] = std::move(pSubscription);
+
+	return subscriptionId;
+}
+
+bool CTomlManager::Unsubscribe(int documentId, size_t subscriptionId)
+{
+	// Remove the subscription from the document.
+	const auto pSubscription = [&]() -> std::shared_ptr<SSubscription>
+	{
+		std::scoped_lock guard(m_mtxTomlDocuments);
+
+		const auto pDocument = GetDocument(documentId);
+		if (pDocument == nullptr)
+		{
+			return nullptr;
+		}
+
+		for (auto sectionIt = pDocument->subscriptions.begin(); sectionIt != pDocument->subscriptions.end(); ++sectionIt)
+		{
+			for (auto keyIt = sectionIt->second.begin(); keyIt != sectionIt->second.end(); ++keyIt)
+			{
+				const auto subscriptionIt = keyIt->second.find(subscriptionId);
+				if (subscriptionIt == keyIt->second.end())
+				{
+					continue;
+				}
+				auto pFoundSubscription = std::move(subscriptionIt->second);
+				keyIt->second.erase(subscriptionIt);
+
+				// Remove empty containers.
+				if (keyIt->second.empty())
+				{
+					sectionIt->second.erase(keyIt);
+					if (sectionIt->second.empty())
+					{
+						pDocument->subscriptions.erase(sectionIt);
+					}
+				}
+				return pFoundSubscription;
+			}
+		}
+
+		return nullptr;
+	}();
+
+	// Drop queued notifications and wait for the callback running on other threads (even if the document
+	// was closed, its queued notifications might still run).
+	std::unique_lock guard(m_mtxNotifications);
+	if (pSubscription != nullptr)
+	{
+		pSubscription->bActive = false;
+	}
+	m_cvNotifications.wait(guard, [&]()
+	{
+		const auto range = m_runningNotifications.equal_range(subscriptionId);
+		return std::all_of(range.first, range.second, [](const auto& running) { return running.second == std::this_thread::get_id(); });
+	});
+
+	return pSubscription != nullptr;
+}
+
+std::variant<toml::array*, CTomlManager::ArrayOperationError> CTomlManager::GetArrayForModification(
+	int documentId, const std::string& keyName, const std::string& sectionName, bool bCreateIfMissing)
+{
+	std::scoped_lock guard(m_mtxTomlDocuments);
+
+	// Check that key is not empty.
+	if (keyName.empty())
+	{
+		return CTomlManager::ArrayOperationError::KeyEmpty;
+	}
+
+	// Check that document exists.
+	if (!IsDocumentRegistered(documentId))
+	{
+		return CTomlManager::ArrayOperationError::DocumentNotFound;
+	}
+
+	// Get document.
+	auto pDocument = GetDocumentForModification(documentId);
+
+	// Make sure the array is stored in TOML data.
+	ParseLazyTable(*pDocument, sectionName.empty() ? keyName : sectionName);
+	UnpackDocumentArray(*pDocument, keyName, sectionName);
+
+	// Section name might refer to a value that is not a table.
+	if (!sectionName.empty() && IsRootValue(*pDocument, sectionName))
+	{
+		return CTomlManager::ArrayOperationError::ValueTypeMismatch;
+	}
+
+	// Find array.
+	const auto pArrayValue = FindDocumentValue(*pDocument, keyName, sectionName);
+	if (pArrayValue == nullptr)
+	{
+		if (!bCreateIfMissing)
+		{
+			return CTomlManager::ArrayOperationError::ValueNotFound;
+		}
+	}
+	else if (!pArrayValue->is_array())
+	{
+		return CTomlManager::ArrayOperationError::ValueTypeMismatch;
+	}
+
+	// Copy the section of the array if it's shared.
+	auto& arrayValue = GetSectionForModification(*pDocument, sectionName).data.as_table(std::nothrow)[keyName];
+	if (!arrayValue.is_array())
+	{
+		arrayValue = toml::array();
+	}
+
+	return &arrayValue.as_array(std::nothrow);
+}
+
+std::variant<const toml::array*, const CTomlManager::PackedArray*, CTomlManager::SFrozenArray, CTomlManager::GetArrayError> CTomlManager::GetArrayForReading(
+	int documentId, const std::string& keyName, const std::string& sectionName)
+{
+	std::scoped_lock guard(m_mtxTomlDocuments);
+
+	// Check that key is not empty.
+	if (keyName.empty())
+	{
+		return CTomlManager::GetArrayError::KeyEmpty;
+	}
+
+	// Check that document exists.
+	const auto pDocument = GetDocument(documentId);
+	if (pDocument == nullptr)
+	{
+		return CTomlManager::GetArrayError::DocumentNotFound;
+	}
+
+	// Read the array from the top-most layer that has it.
+	if (pDocument->pLayers != nullptr)
+	{
+		const auto optionalLayerId = FindValueLayer(*pDocument->pLayers, keyName, sectionName);
+		if (!optionalLayerId.has_value())
+		{
+			return CTomlManager::GetArrayError::ValueNotFound;
+		}
+		return GetArrayForReading(optionalLayerId.value(), keyName, sectionName);
+	}
+
+	// Read frozen documents directly from their buffer.
+	if (pDocument->pFrozenDocument != nullptr)
+	{
+		const auto& frozenDocument = *pDocument->pFrozenDocument;
+		auto optionalTable = std::make_optional(frozenDocument.GetRoot());
+		if (!sectionName.empty())
+		{
+			optionalTable = frozenDocument.Find(optionalTable.value(), sectionName);
+		}
+
+		const auto optionalArray = optionalTable.has_value() ? frozenDocument.Find(optionalTable.value(), keyName) : std::nullopt;
+		if (!optionalArray.has_value())
+		{
+			return CTomlManager::GetArrayError::ValueNotFound;
+		}
+		if (optionalArray->tag != CTomlFrozenDocument::EValueTag::Array)
+		{
+			return CTomlManager::GetArrayError::ValueTypeMismatch;
+		}
+
+		return SFrozenArray{ &frozenDocument, optionalArray.value() };
+	}
+
+	// Look for a packed array first.
+	if (const auto pPackedArray = FindPackedArrayForReading(*pDocument, keyName, sectionName))
+	{
+		return pPackedArray;
+	}
+
+	// Find array.
+	const auto pArrayValue = FindDocumentValue(*pDocument, keyName, sectionName);
+	if (pArrayValue == nullptr)
+	{
+		return CTomlManager::GetArrayError::ValueNotFound;
+	}
+
+	const auto& arrayValue = *pArrayValue;
+	if (!arrayValue.is_array())
+	{
+		return CTomlManager::GetArrayError::ValueTypeMismatch;
+	}
+
+	return &arrayValue.as_array(std::nothrow);
+}
+
+std::variant<size_t, CTomlManager::GetArrayError> CTomlManager::GetArraySize(int documentId, const std::string& keyName, const std::string& sectionName)
+{
+	std::scoped_lock guard(m_mtxTomlDocuments);
+
+	// Get array.
+	const auto result = GetArrayForReading(documentId, keyName, sectionName);
+	if (std::holds_alternative<CTomlManager::GetArrayError>(result))
+	{
+		return std::get<CTomlManager::GetArrayError>(result);
+	}
+
+	if (std::holds_alternative<const PackedArray*>(result))
+	{
+		return std::visit([](const auto& packedElements) { return packedElements.size(); }, *std::get<const PackedArray*>(result));
+	}
+
+	if (std::holds_alternative<SFrozenArray>(result))
+	{
+		const auto& frozenArray = std::get<SFrozenArray>(result);
+		return frozenArray.pFrozenDocument->GetSize(frozenArray.array);
+	}
+
+	return std::get<const toml::array*>(result)->size();
+}
+
+std::optional<CTomlManager::ArrayOperationError> CTomlManager::EraseAt(int documentId, const std::string& keyName, size_t index, const std::string& sectionName)
+{
+	CModificationLock guard(*this);
+
+	// Layered documents are written to their top layer.
+	documentId = GetWriteDocumentId(documentId);
+
+	// Remove an element of a packed array directly.
+	const auto pDocument = GetDocument(documentId);
+	const auto pPackedArray = pDocument != nullptr ? FindPackedArrayForModification(*pDocument, keyName, sectionName) : nullptr;
+	if (pPackedArray != nullptr)
+	{
+		const auto optionalError = std::visit([index](auto& packedElements) -> std::optional<CTomlManager::ArrayOperationError>
+		{
+			if (index >= packedElements.size())
+			{
+				return CTomlManager::ArrayOperationError::IndexOutOfRange;
+			}
+			packedElements.erase(packedElements.begin() + index);
+			return {};
+		}, *pPackedArray);
+		if (!optionalError.has_value())
+		{
+			MarkDocumentModified(documentId, *pDocument, keyName, sectionName, CTomlPatch::EOperation::EraseElements, index);
+		}
+		return optionalError;
+	}
+
+	// Get array.
+	auto result = GetArrayForModification(documentId, keyName, sectionName, false);
+	if (std::holds_alternative<CTomlManager::ArrayOperationError>(result))
+	{
+		return std::get<CTomlManager::ArrayOperationError>(result);
+	}
+	auto pArray = std::get<toml::array*>(result);
+
+	// Check index.
+	if (index >= pArray->size())
+	{
+		return CTomlManager::ArrayOperationError::IndexOutOfRange;
+	}
+
+	// Remove value.
+	pArray->erase(pArray->begin() + index);
+	MarkDocumentModified(documentId, *GetDocument(documentId), keyName, sectionName, CTomlPatch::EOperation::EraseElements, index);
+
+	return {};
+}
+
+std::optional<CTomlManager::SaveDocumentError> CTomlManager::SaveDocument(int documentId, const std::string& fileName, const std::string& directoryName, bool bEnableBackup)
+{
+	std::scoped_lock guard(m_mtxTomlDocuments);
+
+	// Check that file name is not empty.
+	if (fileName.empty())
+	{
+		CloseDocument(documentId);
+		return CTomlManager::SaveDocumentError::FileNameEmpty;
+	}
+
+	// Check that directory name is not empty.
+	if (directoryName.empty())
+	{
+		CloseDocument(documentId);
+		return CTomlManager::SaveDocumentError::DirectoryNameEmpty;
+	}
+
+	// Check that document exists.
+	if (!IsDocumentRegistered(documentId))
+	{
+		CloseDocument(documentId);
+		return CTomlManager::SaveDocumentError::DocumentNotFound;
+	}
+
+	// Save only the top layer of a layered document.
+	const auto writeDocumentId = GetWriteDocumentId(documentId);
+	if (writeDocumentId != documentId)
+	{
+		CloseDocument(documentId);
+		return SaveDocument(writeDocumentId, fileName, directoryName, bEnableBackup);
+	}
+
+	// Get document.
+	auto pDocument = GetDocumentForModification(documentId);
+
+	// Metadata section is needed for the metadata index.
+	ParseLazyTable(*pDocument, m_metadataSectionName);
+
+	// See if document has something.
+	if (pDocument->content.sections.empty())
+	{
+		CloseDocument(documentId);
+		return CTomlManager::SaveDocumentError::DocumentIsEmpty;
+	}
+
+	// Get base directory to store configs.
+	const auto optionalBasePath = GetDirectoryForConfigs();
+	if (!optionalBasePath.has_value())
+	{
+		CloseDocument(documentId);
+		return CTomlManager::SaveDocumentError::FailedToGetBasePath;
+	}
+
+	// Construct directory path.
+	const auto directoryPath = optionalBasePath.value() / std::string(directoryName);
+	if (!std::filesystem::exists(directoryPath)) {
+		std::filesystem::create_directories(directoryPath);
+	}
+
+	// Construct file path.
+	const auto filePath = directoryPath / (std::string(fileName) + ".toml");
+
+	// A partially opened document doesn't have other tables of its file.
+	if (IsPartialDocumentFile(*pDocument, filePath))
+	{
+		CryLogAlways("[%s]: can't save partially opened document %i to the file it was read from (\"%s\")", m_logCategory,
+			documentId, filePath.string().c_str());
+		CloseDocument(documentId);
+		return CTomlManager::SaveDocumentError::PartialDocument;
+	}
+
+	// Get the text before the file is moved to the backup (it might be patched).
+	const auto text = GetDocumentText(*pDocument);
+
+	// Handle backup.
+	std::filesystem::path backupFile = filePath;
+	backupFile += m_backupFileExtension;
+	if (bEnableBackup)
+	{
+		// Check if we already had this file saved.
+		if (std::filesystem::exists(filePath))
+		{
+			if (std::filesystem::exists(backupFile))
+			{
+				std::filesystem::remove(backupFile);
+			}
+			std::filesystem::rename(filePath, backupFile);
+		}
+	}
+
+	// Save document.
+	std::ofstream outFile(filePath, std::ios::binary);
+	if (!outFile.is_open())
+	{
+		CloseDocument(documentId);
+		return CTomlManager::SaveDocumentError::UnableToCreateFile;
+	}
+	outFile << text;
+	outFile.close();
+	RemoveCachedDocument(filePath);
+	RemoveDocumentSnapshot(filePath);
+
+	// The whole file was written so its save journal is no longer needed.
+	const auto& pSaveJournal = pDocument->pSaveJournal;
+	if (pSaveJournal != nullptr && pSaveJournal->directoryPath == directoryPath && pSaveJournal->fileName == fileName)
+	{
+		pDocument->pSaveJournal = nullptr;
+	}
+	auto saveJournalPath = filePath;
+	saveJournalPath += m_saveJournalFileExtension;
+	if (std::filesystem::exists(saveJournalPath) && !CTomlJournal::IsOpen(saveJournalPath))
+	{
+		std::filesystem::remove(saveJournalPath);
+	}
+
+	CryLogAlways("[%s]: saved TOML document at \"%s\" (document %i)", m_logCategory, filePath.string().c_str(), documentId);
+
+	// Update metadata index.
+	const auto optionalMetadata = CopyDocumentValue(*pDocument, m_metadataSectionName, "");
+	if (optionalMetadata.has_value() && optionalMetadata->is_table())
+	{
+		UpdateMetadataIndex(directoryPath, m_metadataSectionName, fileName, &optionalMetadata.value());
+	}
+	else
+	{
+		UpdateMetadataIndex(directoryPath, m_metadataSectionName, fileName, nullptr);
+	}
+
+	CloseDocument(documentId);
+
+	if (bEnableBackup)
+	{
+		// Create backup file if it does not exist.
+		if (!std::filesystem::exists(backupFile))
+		{
+			std::filesystem::copy_file(filePath, backupFile);
+		}
+	}
+
+	return {};
+}
+
+std::optional<CTomlManager::SaveJournalError> CTomlManager::EnableSaveJournal(int documentId, const std::string& fileName, const std::string& directoryName, size_t compactionSize)
+{
+	std::scoped_lock guard(m_mtxTomlDocuments);
+
+	// Check that file name is not empty.
+	if (fileName.empty())
+	{
+		return CTomlManager::SaveJournalError::FileNameEmpty;
+	}
+
+	// Check that directory name is not empty.
+	if (directoryName.empty())
+	{
+		return CTomlManager::SaveJournalError::DirectoryNameEmpty;
+	}
+
+	// Journal the top layer of a layered document.
+	documentId = GetWriteDocumentId(documentId);
+	if (!IsDocumentRegistered(documentId))
+	{
+		return CTomlManager::SaveJournalError::DocumentNotFound;
+	}
+
+	// Get base directory to store configs.
+	const auto optionalBasePath = GetDirectoryForConfigs();
+	if (!optionalBasePath.has_value())
+	{
+		return CTomlManager::SaveJournalError::FailedToGetBasePath;
+	}
+
+	// Construct directory path.
+	const auto directoryPath = optionalBasePath.value() / std::string(directoryName);
+	if (!std::filesystem::exists(directoryPath)) {
+		std::filesystem::create_directories(directoryPath);
+	}
+
+	// Construct file paths.
+	const auto filePath = directoryPath / (std::string(fileName) + ".toml");
+	auto saveJournalPath = filePath;
+	saveJournalPath += m_saveJournalFileExtension;
+
+	// A partially opened document doesn't have other tables of its file.
+	if (IsPartialDocumentFile(*GetDocument(documentId), filePath))
+	{
+		return CTomlManager::SaveJournalError::PartialDocument;
+	}
+
+	// Finish the previous journal of the document.
+	if (GetDocument(documentId)->pSaveJournal != nullptr)
+	{
+		DisableSaveJournal(documentId);
+	}
+
+	// Start an empty journal, then write the whole document that the journal will be applied to.
+	auto pSaveJournal = std::make_unique<SSaveJournal>();
+	pSaveJournal->pJournal = CTomlJournal::Create(saveJournalPath);
+	if (pSaveJournal->pJournal == nullptr)
+	{
+		return CTomlJournal::IsOpen(saveJournalPath) ? CTomlManager::SaveJournalError::JournalInUse : CTomlManager::SaveJournalError::UnableToCreateFile;
+	}
+	pSaveJournal->directoryPath = directoryPath;
+	pSaveJournal->fileName = fileName;
+	pSaveJournal->compactionSize = compactionSize;
+	GetDocument(documentId)->pSaveJournal = std::move(pSaveJournal);
+	if (!WriteSaveJournalDocument(documentId))
+	{
+		GetDocument(documentId)->pSaveJournal = nullptr;
+		std::error_code errorCode;
+		std::filesystem::remove(saveJournalPath, errorCode);
+		return CTomlManager::SaveJournalError::UnableToCreateFile;
+	}
+
+	CryLogAlways("[%s]: enabled save journal of TOML document at \"%s\" (document %i)", m_logCategory, filePath.string().c_str(), documentId);
+
+	return {};
+}
+
+std::optional<CTomlManager::SaveJournalError> CTomlManager::CompactSaveJournal(int documentId)
+{
+	{
+		std::scoped_lock guard(m_mtxTomlDocuments);
+
+		documentId = GetWriteDocumentId(documentId);
+		const auto pDocument = GetDocument(documentId);
+		if (pDocument == nullptr)
+		{
+			return CTomlManager::SaveJournalError::DocumentNotFound;
+		}
+		if (pDocument->pSaveJournal == nullptr)
+		{
+			return CTomlManager::SaveJournalError::JournalNotEnabled;
+		}
+	}
+
+	// The file is written without locking documents.
+	if (!WriteSaveJournalDocument(documentId))
+	{
+		return CTomlManager::SaveJournalError::UnableToCreateFile;
+	}
+
+	return {};
+}
+
+std::optional<CTomlManager::SaveJournalError> CTomlManager::DisableSaveJournal(int documentId)
+{
+	std::scoped_lock guard(m_mtxTomlDocuments);
+
+	documentId = GetWriteDocumentId(documentId);
+	const auto pDocument = GetDocument(documentId);
+	if (pDocument == nullptr)
+	{
+		return CTomlManager::SaveJournalError::DocumentNotFound;
+	}
+	if (pDocument->pSaveJournal == nullptr)
+	{
+		return CTomlManager::SaveJournalError::JournalNotEnabled;
+	}
+
+	// Keep the journal if the file was not written (so that no changes are lost).
+	if (!WriteSaveJournalDocument(documentId))
+	{
+		return CTomlManager::SaveJournalError::UnableToCreateFile;
+	}
+
+	const auto& saveJournal = *pDocument->pSaveJournal;
+	auto saveJournalPath = saveJournal.directoryPath / (saveJournal.fileName + ".toml");
+	saveJournalPath += m_saveJournalFileExtension;
+	pDocument->pSaveJournal = nullptr;
+
+	std::error_code errorCode;
+	std::filesystem::remove(saveJournalPath, errorCode);
+
+	return {};
+}
+
+std::optional<CTomlManager::HotReloadError> CTomlManager::EnableHotReload(int documentId, const std::string& fileName, const std::string& directoryName,
+	DocumentReloadedCallback callback)
+{
+	std::scoped_lock guard(m_mtxTomlDocuments);
+
+	// Check that file name is not empty.
+	if (fileName.empty())
+	{
+		return CTomlManager::HotReloadError::FileNameEmpty;
+	}
+
+	// Check that directory name is not empty.
+	if (directoryName.empty())
+	{
+		return CTomlManager::HotReloadError::DirectoryNameEmpty;
+	}
+
+	// Reload the top layer of a layered document.
+	documentId = GetWriteDocumentId(documentId);
+	const auto pDocument = GetDocument(documentId);
+	if (pDocument == nullptr)
+	{
+		return CTomlManager::HotReloadError::DocumentNotFound;
+	}
+
+	// Get base directory to store configs.
+	const auto optionalBasePath = GetDirectoryForConfigs();
+	if (!optionalBasePath.has_value())
+	{
+		return CTomlManager::HotReloadError::FailedToGetBasePath;
+	}
+	const auto filePath = optionalBasePath.value() / std::string(directoryName) / (std::string(fileName) + ".toml");
+
+	// Reloaded files are compared with the whole document.
+	ParseAllLazyTables(*pDocument);
+
+	// Stop the previous hot reload of the document.
+	if (pDocument->pHotReload != nullptr)
+	{
+		DisableHotReload(documentId);
+	}
+
+	if (m_pFileWatcher == nullptr)
+	{
+		m_pFileWatcher = std::make_unique<CTomlFileWatcher>();
+	}
+	m_pFileWatcher->AddFile(filePath);
+
+	auto pHotReload = std::make_unique<SHotReload>();
+	pHotReload->filePath = filePath;
+	pHotReload->callback = std::move(callback);
+	pDocument->pHotReload = std::move(pHotReload);
+
+	CryLogAlways("[%s]: hot reload of document %i from \"%s\" enabled", m_logCategory, documentId, filePath.string().c_str());
+
+	return {};
+}
+
+bool CTomlManager::DisableHotReload(int documentId)
+{
+	std::scoped_lock guard(m_mtxTomlDocuments);
+
+	documentId = GetWriteDocumentId(documentId);
+	const auto pDocument = GetDocument(documentId);
+	if (pDocument == nullptr || pDocument->pHotReload == nullptr)
+	{
+		return false;
+	}
+
+	m_pFileWatcher->RemoveFile(pDocument->pHotReload->filePath);
+	pDocument->pHotReload = nullptr;
+
+	return true;
+}
+
+size_t CTomlManager::UpdateHotReload()
+{
+	size_t updatedDocumentCount = 0;
+	std::vector<std::tuple<DocumentReloadedCallback, int, std::vector<SValueChange>>> notifications;
+
+	// Parsed data and old contents of the results are freed on a worker thread after documents are unlocked.
+	std::vector<SHotReloadResult> results;
+	{
+		CModificationLock guard(*this);
+
+		if (m_pFileWatcher == nullptr)
+		{
+			return 0;
+		}
+
+		// Take finished reloads (before starting new ones so that reloads requested now are applied in a later update).
+		{
+			std::scoped_lock resultsGuard(m_pHotReloadQueue->mtxResults);
+			results.swap(m_pHotReloadQueue->results);
+		}
+
+		// Start reloading modified files.
+		for (const auto& filePath : m_pFileWatcher->ConsumeModifiedFiles())
+		{
+			RequestHotReload(filePath, nullptr);
+		}
+
+		// Update documents.
+		for (const auto& result : results)
+		{
+			if (ApplyHotReload(result, notifications))
+			{
+				updatedDocumentCount += 1;
+			}
+		}
+	}
+
+	// Freeing the parsed data of a large file can take longer than a frame.
+	if (!results.empty())
+	{
+		GetWorkerPool().Run([results = std::move(results)]() mutable
+		{
+			results.clear();
+		});
+	}
+
+	// Notify about changes without locking documents.
+	for (const auto& [callback, documentId, changes] : notifications)
+	{
+		callback(documentId, changes);
+	}
+
+	return updatedDocumentCount;
+}
+
+void CTomlManager::RequestHotReload(const std::filesystem::path& filePath, std::shared_ptr<const toml::value> pData, const int* pDocumentId)
+{
+	std::scoped_lock guard(m_mtxTomlDocuments);
+
+	// Take contents of documents that are reloaded from the file (sections are shared, not copied).
+	std::vector<SHotReloadTarget> targets;
+	for (auto& [documentId, document] : m_tomlDocuments)
+	{
+		if (document.pHotReload == nullptr || document.pHotReload->filePath != filePath
+			|| (pDocumentId != nullptr && static_cast<int>(documentId) != *pDocumentId))
+		{
+			continue;
+		}
+
+		ShareDocumentContent(document);
+		document.pHotReload->reloadNumber = m_nextHotReloadNumber++;
+
+		SHotReloadTarget target;
+		target.documentId = static_cast<int>(documentId);
+		target.reloadNumber = document.pHotReload->reloadNumber;
+		target.revision = document.revision;
+		target.content = document.content;
+		target.pFrozenDocument = document.pFrozenDocument;
+		targets.push_back(std::move(target));
+	}
+	if (targets.empty())
+	{
+		return;
+	}
+
+	// Parse and compare on a worker thread (the task doesn't access the manager).
+	GetWorkerPool().Run([pQueue = m_pHotReloadQueue, filePath, pData = std::move(pData), targets = std::move(targets)]() mutable
+	{
+		if (pData == nullptr)
+		{
+			try
+			{
+				pData = std::make_shared<const toml::value>(toml::parse(filePath));
+			}
+			catch (std::exception& exception)
+			{
+				// The file might be written right now, it's reloaded again when writing is finished.
+				CryLogAlways("[%s]: failed to reload file at \"%s\", error: %s", m_logCategory, filePath.string().c_str(), exception.what());
+			}
+		}
+
+		std::vector<SHotReloadResult> results;
+		for (auto& target : targets)
+		{
+			SHotReloadResult result;
+			if (pData != nullptr)
+			{
+				if (target.pFrozenDocument != nullptr)
+				{
+					const auto& frozenDocument = *target.pFrozenDocument;
+					const auto content = CreateDocumentContent(frozenDocument.ToValue(frozenDocument.GetRoot()).value_or(toml::value(toml::table())));
+					result.changedKeys = GetChangedKeys(content, *pData);
+				}
+				else
+				{
+					result.changedKeys = GetChangedKeys(target.content, *pData);
+				}
+			}
+			result.target = std::move(target);
+			result.filePath = filePath;
+			result.pData = pData;
+			results.push_back(std::move(result));
+		}
+
+		std::scoped_lock resultsGuard(pQueue->mtxResults);
+		for (auto& result : results)
+		{
+			pQueue->results.push_back(std::move(result));
+		}
+	});
+}
+
+bool CTomlManager::ApplyHotReload(const SHotReloadResult& result,
+	std::vector<std::tuple<DocumentReloadedCallback, int, std::vector<SValueChange>>>& notifications)
+{
+	// Ignore reloads of closed documents and reloads that were replaced by newer ones.
+	const auto documentId = result.target.documentId;
+	auto pDocument = GetDocument(documentId);
+	if (pDocument == nullptr || pDocument->pHotReload == nullptr || pDocument->pHotReload->reloadNumber != result.target.reloadNumber
+		|| result.pData == nullptr || !result.pData->is_table())
+	{
+		return false;
+	}
+
+	// Values modified after the document was compared are kept, other values are not modified so the comparison is valid.
+	auto changedKeys = result.changedKeys;
+	if (pDocument->revision != result.target.revision)
+	{
+		// Compare again if the change journal doesn't have all modifications.
+		const auto& changeJournal = pDocument->changeJournal;
+		if (changeJournal.empty() || changeJournal.front().revision > result.target.revision + 1)
+		{
+			RequestHotReload(result.filePath, result.pData, &documentId);
+			return false;
+		}
+
+		const auto isModified = [&changeJournal, &result](const std::string& sectionName, const std::string& keyName)
+		{
+			return std::any_of(changeJournal.begin(), changeJournal.end(), [&](const SValueChange& change)
+			{
+				if (change.revision <= result.target.revision)
+				{
+					return false;
+				}
+
+				// Overwritten sections and values of replaced sections.
+				return (change.sectionName == sectionName && change.keyName == keyName)
+					|| (sectionName.empty() && change.sectionName == keyName)
+					|| (change.sectionName.empty() && change.keyName == sectionName);
+			});
+		};
+		changedKeys.erase(std::remove_if(changedKeys.begin(), changedKeys.end(), [&isModified](const std::pair<std::string, std::string>& changedKey)
+		{
+			return isModified(changedKey.first, changedKey.second);
+		}), changedKeys.end());
+	}
+	if (changedKeys.empty())
+	{
+		return false;
+	}
+
+	// Set all values first so that observers see the whole updated document.
+	pDocument = GetDocumentForModification(documentId);
+	const auto& newRootTable = result.pData->as_table();
+	for (const auto& [sectionName, keyName] : changedKeys)
+	{
+		// Find the new value.
+		const toml::value* pValue = nullptr;
+		const auto rootIt = newRootTable.find(sectionName.empty() ? keyName : sectionName);
+		if (rootIt != newRootTable.end())
+		{
+			if (sectionName.empty())
+			{
+				pValue = &rootIt->second;
+			}
+			else if (rootIt->second.is_table())
+			{
+				const auto& newSectionTable = rootIt->second.as_table();
+				const auto valueIt = newSectionTable.find(keyName);
+				pValue = valueIt != newSectionTable.end() ? &valueIt->second : nullptr;
+			}
+		}
+
+		ReplaceDocumentValue(*pDocument, keyName, sectionName, pValue);
+	}
+
+	// Notify observers.
+	std::vector<SValueChange> changes;
+	changes.reserve(changedKeys.size());
+	for (const auto& [sectionName, keyName] : changedKeys)
+	{
+		MarkDocumentModified(documentId, *pDocument, keyName, sectionName);
+		changes.push_back({ pDocument->revision, sectionName, keyName });
+	}
+
+	CryLogAlways("[%s]: reloaded %zu value(s) of document %i from \"%s\"", m_logCategory, changes.size(), documentId, result.filePath.string().c_str());
+
+	if (pDocument->pHotReload != nullptr && pDocument->pHotReload->callback)
+	{
+		notifications.emplace_back(pDocument->pHotReload->callback, documentId, std::move(changes));
+	}
+
+	return true;
+}
+
+std::vector<std::pair<std::string, std::string>> CTomlManager::GetChangedKeys(const SDocumentContent& content, const toml::value& data)
+{
+	static const toml::table emptyTable;
+	const auto& newRootTable = data.is_table() ? data.as_table(std::nothrow) : emptyTable;
+
+	const auto findSection = [&content](const std::string& sectionName) -> const SDocumentSection*
+	{
+		const auto it = content.sections.find(sectionName);
+		return it != content.sections.end() ? it->second.get() : nullptr;
+	};
+	const auto findValue = [](const toml::table& table, const std::string& keyName) -> const toml::value*
+	{
+		const auto it = table.find(keyName);
+		return it != table.end() ? &it->second : nullptr;
+	};
+	const auto findPackedArray = [](const SDocumentSection* pSection, const std::string& keyName) -> const PackedArray*
+	{
+		if (pSection == nullptr)
+		{
+			return nullptr;
+		}
+		const auto arrayIt = pSection->packedArrays.find(keyName);
+		return arrayIt != pSection->packedArrays.end() ? &arrayIt->second : nullptr;
+	};
+	const auto isSame = [](const toml::value* pValue, const PackedArray* pPackedArray, const toml::value* pNewValue)
+	{
+		if (pPackedArray != nullptr)
+		{
+			return pNewValue != nullptr && IsSameValue(UnpackArray(*pPackedArray), *pNewValue);
+		}
+		if (pValue == nullptr || pNewValue == nullptr)
+		{
+			return pValue == pNewValue;
+		}
+		return IsSameValue(*pValue, *pNewValue);
+	};
+
+	// Keys of the root table and sections.
+	const auto pRootSection = findSection("");
+	const auto& rootTable = pRootSection != nullptr ? pRootSection->data.as_table(std::nothrow) : emptyTable;
+	std::set<std::string> rootKeyNames;
+	for (const auto& [sectionName, pSection] : content.sections)
+	{
+		if (!sectionName.empty())
+		{
+			rootKeyNames.insert(sectionName);
+		}
+	}
+	for (const auto& [keyName, value] : rootTable)
+	{
+		rootKeyNames.insert(keyName);
+	}
+	if (pRootSection != nullptr)
+	{
+		for (const auto& [keyName, packedArray] : pRootSection->packedArrays)
+		{
+			rootKeyNames.insert(keyName);
+		}
+	}
+	for (const auto& [keyName, value] : newRootTable)
+	{
+		rootKeyNames.insert(keyName);
+	}
+
+	std::vector<std::pair<std::string, std::string>> changedKeys;
+	for (const auto& rootKeyName : rootKeyNames)
+	{
+		const auto pSection = findSection(rootKeyName);
+		const auto pNewValue = findValue(newRootTable, rootKeyName);
+
+		// Compare keys of sections.
+		if (pSection != nullptr && pNewValue != nullptr && pNewValue->is_table())
+		{
+			const auto& table = pSection->data.as_table(std::nothrow);
+			const auto& newTable = pNewValue->as_table(std::nothrow);
+			std::set<std::string> keyNames;
+			for (const auto& [keyName, value] : table)
+			{
+				keyNames.insert(keyName);
+			}
+			for (const auto& [keyName, value] : newTable)
+			{
+				keyNames.insert(keyName);
+			}
+			for (const auto& [keyName, packedArray] : pSection->packedArrays)
+			{
+				keyNames.insert(keyName);
+			}
+
+			for (const auto& keyName : keyNames)
+			{
+				if (!isSame(findValue(table, keyName), findPackedArray(pSection, keyName), findValue(newTable, keyName)))
+				{
+					changedKeys.emplace_back(rootKeyName, keyName);
+				}
+			}
+			continue;
+		}
+
+		if (pSection != nullptr || !isSame(findValue(rootTable, rootKeyName), findPackedArray(pRootSection, rootKeyName), pNewValue))
+		{
+			changedKeys.emplace_back("", rootKeyName);
+		}
+	}
+
+	return changedKeys;
+}
+
+bool CTomlManager::IsSameValue(const toml::value& first, const toml::value& second)
+{
+	if (first.is_table() && second.is_table())
+	{
+		const auto& firstTable = first.as_table();
+		const auto& secondTable = second.as_table();
+		if (&firstTable == &secondTable)
+		{
+			return true;
+		}
+		if (firstTable.size() != secondTable.size())
+		{
+			return false;
+		}
+		for (const auto& [keyName, value] : firstTable)
+		{
+			const auto it = secondTable.find(keyName);
+			if (it == secondTable.end() || !IsSameValue(value, it->second))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	if (first.is_array() && second.is_array())
+	{
+		const auto& firstArray = first.as_array();
+		const auto& secondArray = second.as_array();
+		if (&firstArray == &secondArray)
+		{
+			return true;
+		}
+		if (firstArray.size() != secondArray.size())
+		{
+			return false;
+		}
+		for (size_t i = 0; i < firstArray.size(); i++)
+		{
+			if (!IsSameValue(firstArray[i], secondArray[i]))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	return IsSameScalar(first, second);
+}
+
+void CTomlManager::DiffContents(const SDocumentContent& content, const SDocumentContent& otherContent, CTomlPatch& patch)
+{
+	using SectionPackedArrays = std::unordered_map<std::string, PackedArray>;
+	static const toml::table emptyTable;
+	static const SectionPackedArrays emptyPackedArrays;
+
+	const auto findSection = [](const SDocumentContent& documentContent, const std::string& sectionName) -> const SDocumentSection*
+	{
+		const auto it = documentContent.sections.find(sectionName);
+		return it != documentContent.sections.end() ? it->second.get() : nullptr;
+	};
+	const auto findValue = [](const toml::table& table, const std::string& keyName) -> const toml::value*
+	{
+		const auto it = table.find(keyName);
+		return it != table.end() ? &it->second : nullptr;
+	};
+	const auto findPackedArray = [](const SectionPackedArrays& packedArrays, const std::string& keyName) -> const PackedArray*
+	{
+		const auto it = packedArrays.find(keyName);
+		return it != packedArrays.end() ? &it->second : nullptr;
+	};
+	const auto getSectionValue = [](const SDocumentSection& section)
+	{
+		toml::value value = section.data;
+		for (const auto& [keyName, packedArray] : section.packedArrays)
+		{
+			value.as_table(std::nothrow)[keyName] = UnpackArray(packedArray);
+		}
+		return value;
+	};
+
+	// Compares keys of a section (including its packed arrays), sections shared by both documents are equal.
+	const auto diffSection = [&](const std::string& sectionName, const SDocumentSection* pSection, const SDocumentSection* pOtherSection)
+	{
+		if (pSection == pOtherSection)
+		{
+			return;
+		}
+
+		const auto& table = pSection != nullptr ? pSection->data.as_table(std::nothrow) : emptyTable;
+		const auto& otherTable = pOtherSection != nullptr ? pOtherSection->data.as_table(std::nothrow) : emptyTable;
+		const auto& packedArrays = pSection != nullptr ? pSection->packedArrays : emptyPackedArrays;
+		const auto& otherPackedArrays = pOtherSection != nullptr ? pOtherSection->packedArrays : emptyPackedArrays;
+		const auto diffKey = [&](const std::string& keyName)
+		{
+			DiffValues(sectionName, keyName, findValue(table, keyName), findPackedArray(packedArrays, keyName),
+				findValue(otherTable, keyName), findPackedArray(otherPackedArrays, keyName), patch);
+		};
+
+		// Modified and removed keys.
+		for (const auto& [keyName, value] : table)
+		{
+			diffKey(keyName);
+		}
+		for (const auto& [keyName, packedArray] : packedArrays)
+		{
+			diffKey(keyName);
+		}
+
+		// Added keys.
+		for (const auto& [keyName, value] : otherTable)
+		{
+			if (table.count(keyName) == 0 && packedArrays.count(keyName) == 0)
+			{
+				diffKey(keyName);
+			}
+		}
+		for (const auto& [keyName, packedArray] : otherPackedArrays)
+		{
+			if (table.count(keyName) == 0 && packedArrays.count(keyName) == 0)
+			{
+				diffKey(keyName);
+			}
+		}
+	};
+
+	// Compares a root key (a value or a section).
+	const auto pRootSection = findSection(content, "");
+	const auto pOtherRootSection = findSection(otherContent, "");
+	const auto& rootTable = pRootSection != nullptr ? pRootSection->data.as_table(std::nothrow) : emptyTable;
+	const auto& otherRootTable = pOtherRootSection != nullptr ? pOtherRootSection->data.as_table(std::nothrow) : emptyTable;
+	const auto& rootPackedArrays = pRootSection != nullptr ? pRootSection->packedArrays : emptyPackedArrays;
+	const auto& otherRootPackedArrays = pOtherRootSection != nullptr ? pOtherRootSection->packedArrays : emptyPackedArrays;
+	const auto diffRootKey = [&](const std::string& keyName)
+	{
+		const auto pSection = findSection(content, keyName);
+		const auto pOtherSection = findSection(otherContent, keyName);
+		const auto pValue = findValue(rootTable, keyName);
+		const auto pPackedArray = findPackedArray(rootPackedArrays, keyName);
+		const auto pOtherValue = findValue(otherRootTable, keyName);
+		const auto pOtherPackedArray = findPackedArray(otherRootPackedArrays, keyName);
+
+		if (pSection != nullptr && pOtherSection != nullptr)
+		{
+			diffSection(keyName, pSection, pOtherSection);
+		}
+		else if (pSection != nullptr)
+		{
+			const auto section = getSectionValue(*pSection);
+			DiffValues("", keyName, &section, nullptr, pOtherValue, pOtherPackedArray, patch);
+		}
+		else if (pOtherSection != nullptr)
+		{
+			const auto otherSection = getSectionValue(*pOtherSection);
+			DiffValues("", keyName, pValue, pPackedArray, &otherSection, nullptr, patch);
+		}
+		else
+		{
+			DiffValues("", keyName, pValue, pPackedArray, pOtherValue, pOtherPackedArray, patch);
+		}
+	};
+	const auto hasRootKey = [&](const std::string& keyName)
+	{
+		return rootTable.count(keyName) != 0 || rootPackedArrays.count(keyName) != 0 || findSection(content, keyName) != nullptr;
+	};
+
+	// Modified and removed keys (key/values of the root table shared by both documents are equal).
+	const auto bSharedRoot = pRootSection == pOtherRootSection;
+	for (const auto& [keyName, value] : bSharedRoot ? emptyTable : rootTable)
+	{
+		diffRootKey(keyName);
+	}
+	for (const auto& [keyName, packedArray] : bSharedRoot ? emptyPackedArrays : rootPackedArrays)
+	{
+		diffRootKey(keyName);
+	}
+	for (const auto& [sectionName, pSection] : content.sections)
+	{
+		if (!sectionName.empty() && findSection(otherContent, sectionName) != pSection.get())
+		{
+			diffRootKey(sectionName);
+		}
+	}
+
+	// Added keys.
+	for (const auto& [keyName, value] : bSharedRoot ? emptyTable : otherRootTable)
+	{
+		if (!hasRootKey(keyName))
+		{
+			diffRootKey(keyName);
+		}
+	}
+	for (const auto& [keyName, packedArray] : bSharedRoot ? emptyPackedArrays : otherRootPackedArrays)
+	{
+		if (!hasRootKey(keyName))
+		{
+			diffRootKey(keyName);
+		}
+	}
+	for (const auto& [sectionName, pOtherSection] : otherContent.sections)
+	{
+		if (!sectionName.empty() && !hasRootKey(sectionName))
+		{
+			diffRootKey(sectionName);
+		}
+	}
+}
+
+void CTomlManager::DiffFrozenDocuments(const CTomlFrozenDocument* pFrozenDocument, const SDocumentContent& content,
+	const CTomlFrozenDocument* pOtherFrozenDocument, const SDocumentContent& otherContent, CTomlPatch& patch)
+{
+	// Collect root keys of both documents.
+	std::unordered_set<std::string> keyNames;
+	const auto collectKeyNames = [&keyNames](const CTomlFrozenDocument* pFrozen, const SDocumentContent& documentContent)
+	{
+		if (pFrozen != nullptr)
+		{
+			const auto root = pFrozen->GetRoot();
+			for (size_t i = 0, size = pFrozen->GetSize(root); i < size; i++)
+			{
+				if (const auto optionalEntry = pFrozen->GetEntry(root, i))
+				{
+					keyNames.emplace(optionalEntry->first);
+				}
+			}
+			return;
+		}
+
+		for (const auto& [sectionName, pSection] : documentContent.sections)
+		{
+			if (!sectionName.empty())
+			{
+				keyNames.insert(sectionName);
+				continue;
+			}
+			for (const auto& [keyName, value] : pSection->data.as_table(std::nothrow))
+			{
+				keyNames.insert(keyName);
+			}
+			for (const auto& [keyName, packedArray] : pSection->packedArrays)
+			{
+				keyNames.insert(keyName);
+			}
+		}
+	};
+	collectKeyNames(pFrozenDocument, content);
+	collectKeyNames(pOtherFrozenDocument, otherContent);
+
+	// Compares a root key of a frozen document with the key of the other document (frozen values are converted
+	// only to compare two frozen documents).
+	const auto isSame = [](const CTomlFrozenDocument& frozen, const CTomlFrozenDocument* pOtherFrozen, const SDocumentContent& other,
+		const std::string& keyName)
+	{
+		const auto optionalValue = frozen.Find(frozen.GetRoot(), keyName);
+		if (pOtherFrozen != nullptr)
+		{
+			const auto optionalOtherValue = pOtherFrozen->Find(pOtherFrozen->GetRoot(), keyName);
+			if (!optionalValue.has_value() || !optionalOtherValue.has_value())
+			{
+				return !optionalValue.has_value() && !optionalOtherValue.has_value();
+			}
+			const auto optionalConvertedValue = pOtherFrozen->ToValue(optionalOtherValue.value());
+			return optionalConvertedValue.has_value() && IsSameFrozenValue(frozen, optionalValue.value(), optionalConvertedValue.value());
+		}
+
+		// A section is compared with its packed arrays.
+		const auto sectionIt = other.sections.find(keyName);
+		if (sectionIt != other.sections.end())
+		{
+			const auto& section = *sectionIt->second;
+			const auto& table = section.data.as_table(std::nothrow);
+			if (!optionalValue.has_value() || frozen.GetSize(optionalValue.value()) != table.size() + section.packedArrays.size())
+			{
+				return false;
+			}
+			for (const auto& [sectionKeyName, value] : table)
+			{
+				const auto optionalKeyValue = frozen.Find(optionalValue.value(), sectionKeyName);
+				if (!optionalKeyValue.has_value() || !IsSameFrozenValue(frozen, optionalKeyValue.value(), value))
+				{
+					return false;
+				}
+			}
+			for (const auto& [sectionKeyName, packedArray] : section.packedArrays)
+			{
+				const auto optionalKeyValue = frozen.Find(optionalValue.value(), sectionKeyName);
+				if (!optionalKeyValue.has_value() || !IsSameFrozenArray(frozen, optionalKeyValue.value(), packedArray))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		const auto rootIt = other.sections.find("");
+		if (rootIt != other.sections.end())
+		{
+			const auto& rootTable = rootIt->second->data.as_table(std::nothrow);
+			const auto valueIt = rootTable.find(keyName);
+			if (valueIt != rootTable.end())
+			{
+				return optionalValue.has_value() && IsSameFrozenValue(frozen, optionalValue.value(), valueIt->second);
+			}
+			const auto arrayIt = rootIt->second->packedArrays.find(keyName);
+			if (arrayIt != rootIt->second->packedArrays.end())
+			{
+				return optionalValue.has_value() && IsSameFrozenArray(frozen, optionalValue.value(), arrayIt->second);
+			}
+		}
+
+		return !optionalValue.has_value();
+	};
+
+	// Adds a root key of a document to a partial content (sections of a document that is not frozen are shared).
+	const auto addRootKey = [](const CTomlFrozenDocument* pFrozen, const SDocumentContent& documentContent, const std::string& keyName,
+		SDocumentContent& partialContent)
+	{
+		const auto getRootSection = [&partialContent]() -> SDocumentSection&
+		{
+			auto& pRootSection = partialContent.sections[""];
+			if (pRootSection == nullptr)
+			{
+				pRootSection = std::make_shared<SDocumentSection>();
+			}
+			return *pRootSection;
+		};
+
+		if (pFrozen != nullptr)
+		{
+			const auto optionalValue = pFrozen->Find(pFrozen->GetRoot(), keyName);
+			auto optionalConvertedValue = optionalValue.has_value() ? pFrozen->ToValue(optionalValue.value()) : std::nullopt;
+			if (!optionalConvertedValue.has_value())
+			{
+				return;
+			}
+			if (optionalConvertedValue->is_table())
+			{
+				auto pSection = std::make_shared<SDocumentSection>();
+				pSection->data = std::move(optionalConvertedValue.value());
+				partialContent.sections[keyName] = std::move(pSection);
+			}
+			else
+			{
+				getRootSection().data.as_table(std::nothrow)[keyName] = std::move(optionalConvertedValue.value());
+			}
+			return;
+		}
+
+		const auto sectionIt = documentContent.sections.find(keyName);
+		if (sectionIt != documentContent.sections.end())
+		{
+			partialContent.sections[keyName] = sectionIt->second;
+			return;
+		}
+		const auto rootIt = documentContent.sections.find("");
+		if (rootIt != documentContent.sections.end())
+		{
+			const auto& rootSection = *rootIt->second;
+			const auto& rootTable = rootSection.data.as_table(std::nothrow);
+			if (const auto valueIt = rootTable.find(keyName); valueIt != rootTable.end())
+			{
+				getRootSection().data.as_table(std::nothrow)[keyName] = valueIt->second;
+			}
+			else if (const auto arrayIt = rootSection.packedArrays.find(keyName); arrayIt != rootSection.packedArrays.end())
+			{
+				getRootSection().packedArrays[keyName] = arrayIt->second;
+			}
+		}
+	};
+
+	// Only differing root keys are diffed in detail.
+	SDocumentContent partialContent;
+	SDocumentContent otherPartialContent;
+	for (const auto& keyName : keyNames)
+	{
+		const auto bSame = pFrozenDocument != nullptr ? isSame(*pFrozenDocument, pOtherFrozenDocument, otherContent, keyName)
+			: isSame(*pOtherFrozenDocument, pFrozenDocument, content, keyName);
+		if (!bSame)
+		{
+			addRootKey(pFrozenDocument, content, keyName, partialContent);
+			addRootKey(pOtherFrozenDocument, otherContent, keyName, otherPartialContent);
+		}
+	}
+	DiffContents(partialContent, otherPartialContent, patch);
+}
+
+bool CTomlManager::IsSameFrozenValue(const CTomlFrozenDocument& frozenDocument, const CTomlFrozenDocument::SValue& frozenValue, const toml::value& value)
+{
+	using EValueTag = CTomlFrozenDocument::EValueTag;
+
+	switch (frozenValue.tag)
+	{
+	case EValueTag::Boolean:
+		return value.is_boolean() && value.as_boolean() == CTomlFrozenDocument::GetBoolean(frozenValue);
+	case EValueTag::Integer:
+		return value.is_integer() && value.as_integer() == CTomlFrozenDocument::GetInteger(frozenValue);
+	case EValueTag::Floating:
+	{
+		const auto floating = CTomlFrozenDocument::GetFloating(frozenValue);
+		return value.is_floating() && (value.as_floating() == floating || (std::isnan(value.as_floating()) && std::isnan(floating)));
+	}
+	case EValueTag::String:
+		return value.is_string() && value.as_string().str == frozenDocument.GetString(frozenValue);
+	case EValueTag::Array:
+	{
+		if (!value.is_array() || value.as_array().size() != frozenDocument.GetSize(frozenValue))
+		{
+			return false;
+		}
+		const auto& array = value.as_array();
+		for (size_t i = 0; i < array.size(); i++)
+		{
+			const auto optionalElement = frozenDocument.GetElement(frozenValue, i);
+			if (!optionalElement.has_value() || !IsSameFrozenValue(frozenDocument, optionalElement.value(), array[i]))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+	case EValueTag::Table:
+	{
+		if (!value.is_table() || value.as_table().size() != frozenDocument.GetSize(frozenValue))
+		{
+			return false;
+		}
+		for (const auto& [keyName, keyValue] : value.as_table())
+		{
+			const auto optionalKeyValue = frozenDocument.Find(frozenValue, keyName);
+			if (!optionalKeyValue.has_value() || !IsSameFrozenValue(frozenDocument, optionalKeyValue.value(), keyValue))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+	default:
+	{
+		// Dates and times are compared after converting them.
+		const auto optionalValue = frozenDocument.ToValue(frozenValue);
+		return optionalValue.has_value() && IsSameScalar(optionalValue.value(), value);
+	}
+	}
+}
+
+bool CTomlManager::IsSameFrozenArray(const CTomlFrozenDocument& frozenDocument, const CTomlFrozenDocument::SValue& frozenValue, const PackedArray& packedArray)
+{
+	using EValueTag = CTomlFrozenDocument::EValueTag;
+
+	return std::visit([&frozenDocument, &frozenValue](const auto& packedElements)
+	{
+		using Element = typename std::decay_t<decltype(packedElements)>::value_type;
+
+		if (frozenValue.tag != EValueTag::Array || frozenDocument.GetSize(frozenValue) != packedElements.size())
+		{
+			return false;
+		}
+		for (size_t i = 0; i < packedElements.size(); i++)
+		{
+			const auto element = frozenDocument.GetElement(frozenValue, i).value_or(CTomlFrozenDocument::SValue());
+			if constexpr (std::is_same_v<Element, std::uint8_t>)
+			{
+				if (element.tag != EValueTag::Boolean || CTomlFrozenDocument::GetBoolean(element) != (packedElements[i] != 0))
+				{
+					return false;
+				}
+			}
+			else if constexpr (std::is_floating_point_v<Element>)
+			{
+				const auto floating = CTomlFrozenDocument::GetFloating(element);
+				if (element.tag != EValueTag::Floating || (floating != packedElements[i] && !(std::isnan(floating) && std::isnan(packedElements[i]))))
+				{
+					return false;
+				}
+			}
+			else
+			{
+				if (element.tag != EValueTag::Integer || CTomlFrozenDocument::GetInteger(element) != packedElements[i])
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}, packedArray);
+}
+
+void CTomlManager::DiffValues(const std::string& sectionName, const std::string& keyName, const toml::value* pValue, const PackedArray* pPackedArray,
+	const toml::value* pOtherValue, const PackedArray* pOtherPackedArray, CTomlPatch& patch)
+{
+	// Removed and added values.
+	if (pOtherValue == nullptr && pOtherPackedArray == nullptr)
+	{
+		if (pValue != nullptr || pPackedArray != nullptr)
+		{
+			patch.RemoveValue(sectionName, keyName);
+		}
+		return;
+	}
+	if (pValue == nullptr && pPackedArray == nullptr)
+	{
+		patch.SetValue(sectionName, keyName, pOtherPackedArray != nullptr ? UnpackArray(*pOtherPackedArray) : *pOtherValue);
+		return;
+	}
+
+	// Packed arrays of the same type are compared without unpacking them.
+	if (pPackedArray != nullptr && pOtherPackedArray != nullptr && pPackedArray->index() == pOtherPackedArray->index())
+	{
+		const auto bPatched = std::visit([&](const auto& packedElements)
+		{
+			using Elements = std::decay_t<decltype(packedElements)>;
+			using Element = typename Elements::value_type;
+
+			const auto isSame = [](Element first, Element second)
+			{
+				if constexpr (std::is_floating_point_v<Element>)
+				{
+					return first == second || (std::isnan(first) && std::isnan(second));
+				}
+				else
+				{
+					return first == second;
+				}
+			};
+			const auto toValue = [](Element element)
+			{
+				if constexpr (std::is_same_v<Element, std::uint8_t>)
+				{
+					return toml::value(element != 0);
+				}
+				else
+				{
+					return toml::value(element);
+				}
+			};
+			return DiffArrays(sectionName, keyName, packedElements, std::get<Elements>(*pOtherPackedArray), isSame, toValue, patch);
+		}, *pPackedArray);
+		if (!bPatched)
+		{
+			patch.SetValue(sectionName, keyName, UnpackArray(*pOtherPackedArray));
+		}
+		return;
+	}
+
+	// Modified arrays are patched element-wise (packed arrays are unpacked to compare them with TOML arrays).
+	toml::value unpackedValue;
+	toml::value otherUnpackedValue;
+	const auto& value = pPackedArray != nullptr ? (unpackedValue = UnpackArray(*pPackedArray)) : *pValue;
+	const auto& otherValue = pOtherPackedArray != nullptr ? (otherUnpackedValue = UnpackArray(*pOtherPackedArray)) : *pOtherValue;
+	if (value.is_array() && otherValue.is_array())
+	{
+		const auto toValue = [](const toml::value& element) { return element; };
+		if (!DiffArrays(sectionName, keyName, value.as_array(), otherValue.as_array(), &IsSameValue, toValue, patch))
+		{
+			patch.SetValue(sectionName, keyName, otherValue);
+		}
+		return;
+	}
+
+	if (!IsSameValue(value, otherValue))
+	{
+		patch.SetValue(sectionName, keyName, otherValue);
+	}
+}
+
+template<typename Array, typename OtherArray, typename IsSame, typename ToValue>
+bool CTomlManager::DiffArrays(const std::string& sectionName, const std::string& keyName, const Array& array, const OtherArray& otherArray,
+	IsSame isSame, ToValue toValue, CTomlPatch& patch)
+{
+	// Arrays shared by both documents are equal.
+	if (static_cast<const void*>(&array) == static_cast<const void*>(&otherArray))
+	{
+		return true;
+	}
+
+	// Skip equal elements at the beginning and at the end.
+	const auto size = array.size();
+	const auto otherSize = otherArray.size();
+	size_t prefixSize = 0;
+	while (prefixSize < size && prefixSize < otherSize && isSame(array[prefixSize], otherArray[prefixSize]))
+	{
+		prefixSize += 1;
+	}
+	size_t suffixSize = 0;
+	while (suffixSize < size - prefixSize && suffixSize < otherSize - prefixSize
+		&& isSame(array[size - 1 - suffixSize], otherArray[otherSize - 1 - suffixSize]))
+	{
+		suffixSize += 1;
+	}
+
+	// Find runs of differing elements that are overwritten, the remaining new elements are inserted after them
+	// (or the remaining old elements are erased).
+	const auto overwrittenEnd = std::min(size, otherSize) - suffixSize;
+	std::vector<std::pair<size_t, size_t>> runs;
+	size_t elementCount = otherSize > size ? otherSize - size : 0;
+	for (size_t i = prefixSize; i < overwrittenEnd;)
+	{
+		if (isSame(array[i], otherArray[i]))
+		{
+			i += 1;
+			continue;
+		}
+
+		const auto runBegin = i;
+		while (i < overwrittenEnd && !isSame(array[i], otherArray[i]))
+		{
+			i += 1;
+		}
+		runs.emplace_back(runBegin, i);
+		elementCount += i - runBegin;
+	}
+
+	// Setting the whole array is smaller (an operation costs about as much as an element).
+	const auto operationCount = runs.size() + (size != otherSize ? 1 : 0);
+	if (2 * (elementCount + operationCount) > otherSize)
+	{
+		return false;
+	}
+
+	for (const auto& [runBegin, runEnd] : runs)
+	{
+		toml::array elements;
+		elements.reserve(runEnd - runBegin);
+		for (size_t i = runBegin; i < runEnd; i++)
+		{
+			elements.push_back(toValue(otherArray[i]));
+		}
+		patch.SetElements(sectionName, keyName, runBegin, std::move(elements));
+	}
+
+	if (otherSize > size)
+	{
+		toml::array elements;
+		elements.reserve(otherSize - size);
+		for (size_t i = overwrittenEnd; i < overwrittenEnd + otherSize - size; i++)
+		{
+			elements.push_back(toValue(otherArray[i]));
+		}
+		patch.InsertElements(sectionName, keyName, overwrittenEnd, std::move(elements));
+	}
+	else if (size > otherSize)
+	{
+		patch.EraseElements(sectionName, keyName, overwrittenEnd, size - otherSize);
+	}
+
+	return true;
+}
+
+std::variant<int, CTomlManager::OpenDocumentError> CTomlManager::OpenDocument(const std::string& fileName, const std::string& directoryName)
+{
+	std::scoped_lock guard(m_mtxTomlDocuments);
+
+	// Get file path.
+	const auto filePathResult = GetDocumentFileToOpen(fileName, directoryName);
+	if (std::holds_alternative<CTomlManager::OpenDocumentError>(filePathResult))
+	{
+		return std::get<CTomlManager::OpenDocumentError>(filePathResult);
+	}
+	const auto& filePath = std::get<std::filesystem::path>(filePathResult);
+
+	// Use the cached document if the file was not modified.
+	SDocument cachedDocument;
+	if (FindCachedDocument(filePath, cachedDocument))
+	{
+		const auto documentId = NewDocument();
+		*GetDocument(documentId) = std::move(cachedDocument);
+		return documentId;
+	}
+
+	// Load binary snapshot if the file was not modified, otherwise parse the file and update the snapshot.
+	toml::value tomlData;
+	bool bParsed = false;
+	auto optionalSnapshotData = ReadDocumentSnapshot(filePath);
+	if (optionalSnapshotData.has_value())
+	{
+		tomlData = std::move(optionalSnapshotData.value());
+	}
+	else
+	{
+		// Try parsing file.
+		try
+		{
+			tomlData = toml::parse(filePath);
+		}
+		catch (std::exception& exception)
+		{
+			CryLogAlways("[%s]: failed to parse file at \"%s\", error: %s", m_logCategory, filePath.string().c_str(), exception.what());
+			return CTomlManager::OpenDocumentError::ParsingFailed;
+		}
+
+		WriteDocumentSnapshot(filePath, tomlData);
+		bParsed = true;
+	}
+
+	// Register new document.
+	const auto documentId = NewDocument();
+	auto pDocument = GetDocument(documentId);
+
+	// Remember the file text so that saving keeps its formatting.
+	SetDocumentSource(*pDocument, filePath, bParsed ? &tomlData : nullptr);
+	SetDocumentData(*pDocument, std::move(tomlData));
+
+	// Store large numeric arrays contiguously.
+	PackDocumentArrays(*pDocument);
+
+	// Share parsed content with the document cache.
+	AddCachedDocument(filePath, *pDocument);
+
+	return documentId;
+}
+
+std::variant<std::filesystem::path, CTomlManager::OpenDocumentError> CTomlManager::GetDocumentFileToOpen(const std::string& fileName, const std::string& directoryName)
+{
+	// Check that file name is not empty.
+	if (fileName.empty())
+	{
+		return CTomlManager::OpenDocumentError::FileNameEmpty;
+	}
+
+	// Check that directory name is not empty.
+	if (directoryName.empty())
+	{
+		return CTomlManager::OpenDocumentError::DirectoryNameEmpty;
+	}
+
+	// Get base directory to store configs.
+	const auto optionalBasePath = GetDirectoryForConfigs();
+	if (!optionalBasePath.has_value())
+	{
+		return CTomlManager::OpenDocumentError::FailedToGetBasePath;
+	}
+
+	// Construct directory path (documents are opened concurrently, see OpenDocuments, so filesystem errors
+	// are not thrown, for example when another thread creates the directory at the same time).
+	const auto directoryPath = optionalBasePath.value() / std::string(directoryName);
+	std::error_code errorCode;
+	if (!std::filesystem::exists(directoryPath, errorCode)) {
+		std::filesystem::create_directories(directoryPath, errorCode);
+	}
+
+	// Construct file path.
+	const auto filePath = directoryPath / (std::string(fileName) + ".toml");
+
+	// Apply changes that were journaled but not written to the file before the process stopped.
+	RecoverSaveJournal(directoryPath, fileName);
+
+	// Handle backup.
+	std::filesystem::path backupFile = filePath;
+	backupFile += m_backupFileExtension;
+	if (!std::filesystem::exists(filePath, errorCode))
+	{
+		// Restore the backup file if it exists (another thread might restore it at the same time).
+		if (std::filesystem::exists(backupFile, errorCode))
+		{
+			std::filesystem::copy_file(backupFile, filePath, std::filesystem::copy_options::skip_existing, errorCode);
+		}
+		if (!std::filesystem::exists(filePath, errorCode))
+		{
+			return CTomlManager::OpenDocumentError::FileNotFound;
+		}
+	}
+
+	return filePath;
+}
+
+std::variant<int, CTomlManager::OpenDocumentError> CTomlManager::OpenDocumentLazy(const std::string& fileName, const std::string& directoryName)
+{
+	// Get file path.
+	const auto filePathResult = GetDocumentFileToOpen(fileName, directoryName);
+	if (std::holds_alternative<CTomlManager::OpenDocumentError>(filePathResult))
+	{
+		return std::get<CTomlManager::OpenDocumentError>(filePathResult);
+	}
+	const auto& filePath = std::get<std::filesystem::path>(filePathResult);
+
+	// Use the cached document if the file was not modified (it is already fully parsed).
+	SDocument cachedDocument;
+	if (FindCachedDocument(filePath, cachedDocument))
+	{
+		std::scoped_lock guard(m_mtxTomlDocuments);
+		const auto documentId = NewDocument();
+		*GetDocument(documentId) = std::move(cachedDocument);
+		return documentId;
+	}
+
+	// Read file.
+	auto pLazySource = std::make_shared<SLazySource>();
+	{
+		std::ifstream file(filePath, std::ios::binary);
+		if (!file.is_open())
+		{
+			return CTomlManager::OpenDocumentError::FileNotFound;
+		}
+		std::ostringstream stream;
+		stream << file.rdbuf();
+		pLazySource->text = std::move(stream).str();
+	}
+	const auto& text = pLazySource->text;
+
+	// Find byte ranges of top-level tables.
+	auto tables = CTomlHeaderScanner::FindTopLevelTables(text);
+	const auto rootEnd = tables.rootEnd;
+	pLazySource->tableOrder = std::move(tables.tableOrder);
+	pLazySource->tableRanges = std::move(tables.tableRanges);
+
+	// Parse root key/values.
+	toml::value tomlData;
+	try
+	{
+		std::istringstream stream(text.substr(0, rootEnd));
+		tomlData = toml::parse(stream, filePath.string());
+	}
+	catch (std::exception& exception)
+	{
+		CryLogAlways("[%s]: failed to parse file at \"%s\", error: %s", m_logCategory, filePath.string().c_str(), exception.what());
+		return CTomlManager::OpenDocumentError::ParsingFailed;
+	}
+
+	std::scoped_lock guard(m_mtxTomlDocuments);
+
+	// Register new document.
+	const auto documentId = NewDocument();
+	auto pDocument = GetDocument(documentId);
+	SetDocumentData(*pDocument, std::move(tomlData));
+	if (!pLazySource->tableRanges.empty())
+	{
+		for (const auto& [tableName, ranges] : pLazySource->tableRanges)
+		{
+			pDocument->unparsedLazyTables.insert(tableName);
+		}
+		pDocument->pLazySource = std::move(pLazySource);
+	}
+
+	// Store large numeric arrays contiguously.
+	PackDocumentArrays(*pDocument);
+
+	return documentId;
+}
+
+std::vector<CTomlManager::SOpenDocumentResult> CTomlManager::OpenDocuments(const std::vector<SDocumentToOpen>& documents)
+{
+	using Clock = std::chrono::steady_clock;
+	const auto getElapsedMs = [](Clock::time_point start)
+	{
+		return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+	};
+	const auto startTime = Clock::now();
+
+	std::vector<SOpenDocumentResult> results(documents.size());
+	std::vector<SDocument> openedDocuments(documents.size());
+
+	// Read and parse files (without locking documents).
+	const auto openDocument = [&](size_t index)
+	{
+		const auto& documentToOpen = documents[index];
+		auto& result = results[index];
+
+		// Get file path.
+		const auto filePathResult = GetDocumentFileToOpen(documentToOpen.fileName, documentToOpen.directoryName);
+		if (std::holds_alternative<CTomlManager::OpenDocumentError>(filePathResult))
+		{
+			result.result = std::get<CTomlManager::OpenDocumentError>(filePathResult);
+			return;
+		}
+		const auto& filePath = std::get<std::filesystem::path>(filePathResult);
+
+		// Use the cached document if the file was not modified.
+		auto& document = openedDocuments[index];
+		auto stageStartTime = Clock::now();
+		if (FindCachedDocument(filePath, document))
+		{
+			result.readTimeMs = getElapsedMs(stageStartTime);
+			result.source = CTomlManager::OpenDocumentSource::Cache;
+			result.result = -1;
+			return;
+		}
+
+		// Load binary snapshot if the file was not modified.
+		stageStartTime = Clock::now();
+		auto optionalSnapshotData = ReadDocumentSnapshot(filePath);
+		if (optionalSnapshotData.has_value())
+		{
+			SetDocumentData(document, std::move(optionalSnapshotData.value()));
+			PackDocumentArrays(document);
+			SetDocumentSource(document, filePath, nullptr);
+			result.readTimeMs = getElapsedMs(stageStartTime);
+			result.source = CTomlManager::OpenDocumentSource::Snapshot;
+			AddCachedDocument(filePath, document);
+			result.result = -1;
+			return;
+		}
+
+		// Read file.
+		stageStartTime = Clock::now();
+		std::string text;
+		{
+			std::ifstream file(filePath, std::ios::binary);
+			if (!file.is_open())
+			{
+				result.result = CTomlManager::OpenDocumentError::FileNotFound;
+				return;
+			}
+			std::ostringstream stream;
+			stream << file.rdbuf();
+			text = std::move(stream).str();
+		}
+		result.readTimeMs = getElapsedMs(stageStartTime);
+
+		// Parse file.
+		stageStartTime = Clock::now();
+		toml::value parsedData;
+		try
+		{
+			std::istringstream stream(text);
+			parsedData = toml::parse(stream, filePath.string());
+		}
+		catch (std::exception& exception)
+		{
+			CryLogAlways("[%s]: failed to parse file at \"%s\", error: %s", m_logCategory, filePath.string().c_str(), exception.what());
+			result.result = CTomlManager::OpenDocumentError::ParsingFailed;
+			return;
+		}
+		WriteDocumentSnapshot(filePath, parsedData);
+		SetDocumentSource(document, filePath, &parsedData);
+		SetDocumentData(document, std::move(parsedData));
+
+		// Store large numeric arrays contiguously.
+		PackDocumentArrays(document);
+		result.parseTimeMs = getElapsedMs(stageStartTime);
+
+		// Share parsed content with the document cache.
+		AddCachedDocument(filePath, document);
+
+		// Mark as successfully opened, ID is assigned on registration.
+		result.result = -1;
+	};
+	GetWorkerPool().ParallelFor(documents.size(), [&](size_t index)
+	{
+		// Report an unexpected error as the error of this file so that results of other files are kept.
+		try
+		{
+			openDocument(index);
+		}
+		catch (std::exception& exception)
+		{
+			CryLogAlways("[%s]: failed to open document \"%s\" of directory \"%s\", error: %s", m_logCategory,
+				documents[index].fileName.c_str(), documents[index].directoryName.c_str(), exception.what());
+			results[index].result = CTomlManager::OpenDocumentError::FileNotFound;
+		}
+	});
+
+	// Register opened documents.
+	{
+		std::scoped_lock guard(m_mtxTomlDocuments);
+
+		for (size_t i = 0; i < documents.size(); i++)
+		{
+			if (!std::holds_alternative<int>(results[i].result))
+			{
+				continue;
+			}
+
+			const auto documentId = NewDocument();
+			*GetDocument(documentId) = std::move(openedDocuments[i]);
+			results[i].result = documentId;
+		}
+	}
+
+	CryLogAlways("[%s]: opened %zu document(s) in %.1f ms", m_logCategory, documents.size(), getElapsedMs(startTime));
+
+	return results;
+}
+
+std::variant<int, CTomlManager::OpenDocumentError> CTomlManager::OpenDocumentParallel(const std::string& fileName, const std::string& directoryName)
+{
+	// Get file path.
+	const auto filePathResult = GetDocumentFileToOpen(fileName, directoryName);
+	if (std::holds_alternative<CTomlManager::OpenDocumentError>(filePathResult))
+	{
+		return std::get<CTomlManager::OpenDocumentError>(filePathResult);
+	}
+	const auto& filePath = std::get<std::filesystem::path>(filePathResult);
+
+	// Use the cached document if the file was not modified.
+	SDocument cachedDocument;
+	if (FindCachedDocument(filePath, cachedDocument))
+	{
+		std::scoped_lock guard(m_mtxTomlDocuments);
+
+		const auto documentId = NewDocument();
+		*GetDocument(documentId) = std::move(cachedDocument);
+		return documentId;
+	}
+
+	// Load binary snapshot if the file was not modified.
+	toml::value tomlData;
+	auto optionalSnapshotData = ReadDocumentSnapshot(filePath);
+	if (optionalSnapshotData.has_value())
+	{
+		tomlData = std::move(optionalSnapshotData.value());
+	}
+	else
+	{
+		// Read file.
+		std::string text;
+		{
+			std::ifstream file(filePath, std::ios::binary);
+			if (!file.is_open())
+			{
+				return CTomlManager::OpenDocumentError::FileNotFound;
+			}
+			std::ostringstream stream;
+			stream << file.rdbuf();
+			text = std::move(stream).str();
+		}
+
+		// Parse file (without locking documents).
+		try
+		{
+			tomlData = CTomlParallelParser::Parse(text, filePath.string(), GetWorkerPool());
+		}
+		catch (std::exception& exception)
+		{
+			CryLogAlways("[%s]: failed to parse file at \"%s\", error: %s", m_logCategory, filePath.string().c_str(), exception.what());
+			return CTomlManager::OpenDocumentError::ParsingFailed;
+		}
+
+		WriteDocumentSnapshot(filePath, tomlData);
+	}
+
+	std::scoped_lock guard(m_mtxTomlDocuments);
+
+	// Register new document.
+	const auto documentId = NewDocument();
+	auto pDocument = GetDocument(documentId);
+	SetDocumentData(*pDocument, std::move(tomlData));
+
+	// Store large numeric arrays contiguously.
+	PackDocumentArrays(*pDocument);
+
+	// Values parsed in parallel point to parts of the text, the file is read again when saving.
+	SetDocumentSource(*pDocument, filePath, nullptr);
+
+	// Share parsed content with the document cache.
+	AddCachedDocument(filePath, *pDocument);
+
+	return documentId;
+}
+
+std::variant<int, CTomlManager::OpenDocumentError> CTomlManager::OpenFrozenDocument(const std::string& fileName, const std::string& directoryName)
+{
+	// Get file path.
+	const auto filePathResult = GetDocumentFileToOpen(fileName, directoryName);
+	if (std::holds_alternative<CTomlManager::OpenDocumentError>(filePathResult))
+	{
+		return std::get<CTomlManager::OpenDocumentError>(filePathResult);
+	}
+	const auto& filePath = std::get<std::filesystem::path>(filePathResult);
+	auto frozenPath = filePath;
+	frozenPath += m_frozenFileExtension;
+
+	// Map frozen buffer if the file was not modified.
+	std::shared_ptr<const CTomlFrozenDocument> pFrozenDocument = CTomlFrozenDocument::Map(frozenPath, filePath);
+	if (pFrozenDocument == nullptr)
+	{
+		// Load binary snapshot or parse the file.
+		toml::value tomlData;
+		auto optionalSnapshotData = ReadDocumentSnapshot(filePath);
+		if (optionalSnapshotData.has_value())
+		{
+			tomlData = std::move(optionalSnapshotData.value());
+		}
+		else
+		{
+			try
+			{
+				tomlData = toml::parse(filePath);
+			}
+			catch (std::exception& exception)
+			{
+				CryLogAlways("[%s]: failed to parse file at \"%s\", error: %s", m_logCategory, filePath.string().c_str(), exception.what());
+				return CTomlManager::OpenDocumentError::ParsingFailed;
+			}
+
+			WriteDocumentSnapshot(filePath, tomlData);
+		}
+
+		// Freeze data and store the buffer next to the file.
+		const auto optionalVersion = CTomlBinarySnapshot::GetFileVersion(filePath);
+		auto optionalBuffer = CTomlFrozenDocument::Freeze(
+			tomlData, optionalVersion.has_value() ? optionalVersion->first : 0, optionalVersion.has_value() ? optionalVersion->second : 0);
+		if (!optionalBuffer.has_value())
+		{
+			CryLogAlways("[%s]: file at \"%s\" is too large to freeze", m_logCategory, filePath.string().c_str());
+			return CTomlManager::OpenDocumentError::ParsingFailed;
+		}
+		if (!CTomlFrozenDocument::WriteFile(frozenPath, optionalBuffer.value()))
+		{
+			CryLogAlways("[%s]: failed to write frozen document at \"%s\"", m_logCategory, frozenPath.string().c_str());
+		}
+		pFrozenDocument = CTomlFrozenDocument::Load(std::move(optionalBuffer.value()));
+	}
+
+	std::scoped_lock guard(m_mtxTomlDocuments);
+
+	// Register new document.
+	const auto documentId = NewDocument();
+	GetDocument(documentId)->pFrozenDocument = std::move(pFrozenDocument);
+
+	return documentId;
+}
+
+std::variant<int, CTomlManager::OpenDocumentError> CTomlManager::OpenEmbeddedDocument(const void* pBuffer, size_t size)
+{
+	std::shared_ptr<const CTomlFrozenDocument> pFrozenDocument = CTomlFrozenDocument::LoadView(pBuffer, size);
+	if (pFrozenDocument == nullptr)
+	{
+		CryLogAlways("[%s]: failed to open embedded document, the buffer is not a frozen document", m_logCategory);
+		return CTomlManager::OpenDocumentError::ParsingFailed;
+	}
+
+	std::scoped_lock guard(m_mtxTomlDocuments);
+
+	// Register new document.
+	const auto documentId = NewDocument();
+	GetDocument(documentId)->pFrozenDocument = std::move(pFrozenDocument);
+
+	return documentId;
+}
+
+std::variant<int, CTomlManager::OpenDocumentError> CTomlManager::OpenDocumentPartial(
+	const std::string& fileName, const std::string& directoryName, const std::vector<std::string>& tableNames)
+{
+	// Get file path.
+	const auto filePathResult = GetDocumentFileToOpen(fileName, directoryName);
+	if (std::holds_alternative<CTomlManager::OpenDocumentError>(filePathResult))
+	{
+		return std::get<CTomlManager::OpenDocumentError>(filePathResult);
+	}
+	const auto& filePath = std::get<std::filesystem::path>(filePathResult);
+
+	// Read only the needed part of the file.
+	const auto optionalText = CTomlHeaderScanner::ReadTopLevelTables(filePath, tableNames);
+	if (!optionalText.has_value())
+	{
+		return CTomlManager::OpenDocumentError::FileNotFound;
+	}
+
+	// Try parsing text.
+	toml::value tomlData;
+	try
+	{
+		std::istringstream stream(optionalText.value());
+		tomlData = toml::parse(stream, filePath.string());
+	}
+	catch (std::exception& exception)
+	{
+		CryLogAlways("[%s]: failed to parse file at \"%s\", error: %s", m_logCategory, filePath.string().c_str(), exception.what());
+		return CTomlManager::OpenDocumentError::ParsingFailed;
+	}
+
+	std::scoped_lock guard(m_mtxTomlDocuments);
+
+	// Register new document.
+	const auto documentId = NewDocument();
+	auto pDocument = GetDocument(documentId);
+	SetDocumentData(*pDocument, std::move(tomlData));
+	pDocument->partialFilePath = filePath;
+
+	// Store large numeric arrays contiguously.
+	PackDocumentArrays(*pDocument);
+
+	return documentId;
+}
+
+std::variant<int, CTomlManager::OpenDocumentError> CTomlManager::OpenDocumentsMetadata(const std::string& directoryName)
+{
+	// Check that directory name is not empty.
+	if (directoryName.empty())
+	{
+		return CTomlManager::OpenDocumentError::DirectoryNameEmpty;
+	}
+
+	// Get directory path.
+	const auto optionalDirectoryPath = GetDirectoryPathForDocuments(directoryName);
+	if (!optionalDirectoryPath.has_value())
+	{
+		return CTomlManager::OpenDocumentError::FailedToGetBasePath;
+	}
+	const auto& directoryPath = optionalDirectoryPath.value();
+
+	// Get document names.
+	const auto listingResult = GetCachedDocumentListing(directoryName);
+	if (std::holds_alternative<CTomlManager::GetAllDocumentsError>(listingResult))
+	{
+		switch (std::get<CTomlManager::GetAllDocumentsError>(listingResult))
+		{
+		case CTomlManager::GetAllDocumentsError::DirectoryNameEmpty:
+			return CTomlManager::OpenDocumentError::DirectoryNameEmpty;
+		case CTomlManager::GetAllDocumentsError::FailedToGetBasePath:
+			return CTomlManager::OpenDocumentError::FailedToGetBasePath;
+		}
+	}
+	const auto& documentNames = *std::get<std::shared_ptr<const std::vector<std::string>>>(listingResult);
+
+	// Get name of the metadata section.
+	std::string metadataSectionName;
+	{
+		std::scoped_lock guard(m_mtxTomlDocuments);
+		metadataSectionName = m_metadataSectionName;
+	}
+
+	std::unique_lock indexGuard(m_mtxMetadataIndex);
+
+	// Read index (an index of another section is rebuilt).
+	auto index = ReadMetadataIndex(directoryPath);
+	auto& indexedSectionName = index.as_table(std::nothrow)[m_metadataIndexSectionKeyName].as_string(std::nothrow).str;
+	auto& indexTable = index.as_table(std::nothrow)[m_metadataIndexDocumentsKeyName].as_table(std::nothrow);
+	bool bIndexModified = false;
+	if (indexedSectionName != metadataSectionName)
+	{
+		indexedSectionName = metadataSectionName;
+		indexTable.clear();
+		bIndexModified = true;
+	}
+
+	toml::table metadata;
+	for (const auto& documentName : documentNames)
+	{
+		const auto it = indexTable.find(documentName);
+		if (it != indexTable.end())
+		{
+			metadata[documentName] = it->second;
+			continue;
+		}
+
+		// Document is not in the index, parse it once (or its backup if the file is missing).
+		auto filePath = directoryPath / (documentName + ".toml");
+		if (!std::filesystem::exists(filePath))
+		{
+			filePath += m_backupFileExtension;
+		}
+		toml::value documentMetadata = toml::table();
+		try
+		{
+			const auto documentData = toml::parse(filePath);
+			const auto& documentTable = documentData.as_table(std::nothrow);
+			const auto metadataIt = documentTable.find(metadataSectionName);
+			if (metadataIt != documentTable.end() && metadataIt->second.is_table())
+			{
+				documentMetadata = metadataIt->second;
+			}
+		}
+		catch (std::exception& exception)
+		{
+			CryLogAlways("[%s]: failed to read metadata of the document \"%s\", error: %s", m_logCategory, documentName.c_str(), exception.what());
+			continue;
+		}
+
+		metadata[documentName] = documentMetadata;
+		indexTable[documentName] = std::move(documentMetadata);
+		bIndexModified = true;
+	}
+
+	// Remove documents that no longer exist from the index.
+	if (metadata.size() != indexTable.size())
+	{
+		for (auto it = indexTable.begin(); it != indexTable.end();)
+		{
+			if (metadata.find(it->first) == metadata.end())
+			{
+				it = indexTable.erase(it);
+				bIndexModified = true;
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+
+	if (bIndexModified)
+	{
+		WriteMetadataIndex(directoryPath, index);
+	}
+
+	indexGuard.unlock();
+
+	std::scoped_lock guard(m_mtxTomlDocuments);
+
+	// Register new document.
+	const auto documentId = NewDocument();
+	SetDocumentData(*GetDocument(documentId), toml::value(std::move(metadata)));
+
+	return documentId;
+}
+
+toml::value CTomlManager::ReadMetadataIndex(const std::filesystem::path& directoryPath)
+{
+	// Index without documents.
+	toml::table emptyIndex;
+	emptyIndex[m_metadataIndexSectionKeyName] = "";
+	emptyIndex[m_metadataIndexDocumentsKeyName] = toml::table();
+
+	const auto indexPath = directoryPath / m_metadataIndexFileName;
+	if (!std::filesystem::exists(indexPath))
+	{
+		return emptyIndex;
+	}
+
+	try
+	{
+		// Load binary snapshot if the index was not modified, otherwise parse the index and update the snapshot.
+		auto optionalIndex = ReadDocumentSnapshot(indexPath);
+		if (!optionalIndex.has_value())
+		{
+			optionalIndex = toml::parse(indexPath);
+			WriteDocumentSnapshot(indexPath, optionalIndex.value());
+		}
+		auto& index = optionalIndex.value();
+		if (index.is_table() && index.contains(m_metadataIndexSectionKeyName) && index.at(m_metadataIndexSectionKeyName).is_string()
+			&& index.contains(m_metadataIndexDocumentsKeyName) && index.at(m_metadataIndexDocumentsKeyName).is_table())
+		{
+			return std::move(index);
+		}
+	}
+	catch (std::exception& exception)
+	{
+		CryLogAlways("[%s]: failed to parse metadata index at \"%s\", error: %s", m_logCategory, indexPath.string().c_str(), exception.what());
+	}
+
+	return emptyIndex;
+}
+
+void CTomlManager::WriteMetadataIndex(const std::filesystem::path& directoryPath, const toml::value& index)
+{
+	const auto indexPath = directoryPath / m_metadataIndexFileName;
+	auto tempIndexPath = indexPath;
+	tempIndexPath += ".tmp";
+
+	// Write to a temporary file first so that the index is never left half-written.
+	std::ofstream outFile(tempIndexPath, std::ios::binary);
+	if (!outFile.is_open())
+	{
+		CryLogAlways("[%s]: failed to write metadata index at \"%s\"", m_logCategory, tempIndexPath.string().c_str());
+		return;
+	}
+	outFile << index;
+	outFile.close();
+
+	std::error_code errorCode;
+	std::filesystem::rename(tempIndexPath, indexPath, errorCode);
+	if (errorCode)
+	{
+		CryLogAlways("[%s]: failed to replace metadata index at \"%s\", error: %s", m_logCategory, indexPath.string().c_str(), errorCode.message().c_str());
+		return;
+	}
+
+	// Next reads of the index don't need to parse it.
+	WriteDocumentSnapshot(indexPath, index);
+}
+
+void CTomlManager::UpdateMetadataIndex(const std::filesystem::path& directoryPath, const std::string& sectionName, const std::string& fileName,
+	const toml::value* pMetadata)
+{
+	std::scoped_lock guard(m_mtxMetadataIndex);
+
+	auto index = ReadMetadataIndex(directoryPath);
+	const auto& indexedSectionName = index.as_table(std::nothrow)[m_metadataIndexSectionKeyName].as_string(std::nothrow).str;
+	auto& indexTable = index.as_table(std::nothrow)[m_metadataIndexDocumentsKeyName].as_table(std::nothrow);
+
+	if (sectionName.empty() || sectionName != indexedSectionName)
+	{
+		// Metadata of another section, the document is read again when the index is opened.
+		if (indexTable.erase(fileName) == 0)
+		{
+			return;
+		}
+	}
+	else if (pMetadata != nullptr)
+	{
+		indexTable[fileName] = *pMetadata;
+	}
+	else if (std::filesystem::exists(directoryPath / (fileName + ".toml")))
+	{
+		// Document without metadata section, keep an empty entry so that the document is not parsed later.
+		indexTable[fileName] = toml::table();
+	}
+	else if (indexTable.erase(fileName) == 0)
+	{
+		// Nothing to remove.
+		return;
+	}
+
+	WriteMetadataIndex(directoryPath, index);
+}
+
+bool CTomlManager::CloseDocument(int documentId)
+{
+	std::scoped_lock guard(m_mtxTomlDocuments);
+
+	// Write the whole journaled document to its file.
+	const auto pDocument = GetDocument(documentId);
+	if (pDocument != nullptr && pDocument->pSaveJournal != nullptr)
+	{
+		DisableSaveJournal(documentId);
+	}
+
+	// Stop watching the file of a hot reloaded document.
+	if (pDocument != nullptr && pDocument->pHotReload != nullptr)
+	{
+		DisableHotReload(documentId);
+	}
+
+	// Find document with this ID.
+	const auto it = m_tomlDocuments.find(documentId);
+	if (it == m_tomlDocuments.end())
+	{
+		return false;
+	}
+
+	// Drop queued notifications of the document.
+	DeactivateSubscriptions(it->second);
+
+	// Remove the document from the layered documents index (as a layer and as a layered document).
+	m_layeredDocumentIds.erase(documentId);
+	if (it->second.pLayers != nullptr)
+	{
+		for (const auto layerId : it->second.pLayers->documentIds)
+		{
+			const auto layeredDocumentsIt = m_layeredDocumentIds.find(layerId);
+			if (layeredDocumentsIt == m_layeredDocumentIds.end())
+			{
+				continue;
+			}
+			auto& layeredDocumentIds = layeredDocumentsIt->second;
+			layeredDocumentIds.erase(std::remove(layeredDocumentIds.begin(), layeredDocumentIds.end(), documentId), layeredDocumentIds.end());
+			if (layeredDocumentIds.empty())
+			{
+				m_layeredDocumentIds.erase(layeredDocumentsIt);
+			}
+		}
+	}
+
+	// Remove document ID.
+	m_tomlDocuments.erase(it);
+
+	return true;
+}
+
+bool CTomlManager::RemoveDocument(const std::string& fileName, const std::string& directoryName)
+{
+	// Check that file name is not empty.
+	if (fileName.empty())
+	{
+		return false;
+	}
+
+	// Check that directory name is not empty.
+	if (directoryName.empty())
+	{
+		return false;
+	}
+
+	// Get base directory to store configs.
+	const auto optionalBasePath = GetDirectoryForConfigs();
+	if (!optionalBasePath.has_value())
+	{
+		return false;
+	}
+
+	// Construct directory path.
+	const auto directoryPath = optionalBasePath.value() / std::string(directoryName);
+	if (!std::filesystem::exists(directoryPath)) {
+		return false;
+	}
+
+	// Construct file path.
+	const auto filePath = directoryPath / (std::string(fileName) + ".toml");
+
+	// Handle backup.
+	std::filesystem::path backupFile = filePath;
+	backupFile += m_backupFileExtension;
+
+	// Check that at least one exists.
+	if (!std::filesystem::exists(filePath) && !std::filesystem::exists(backupFile))
+	{
+		return false;
+	}
+
+	// Remove original file.
+	if (std::filesystem::exists(filePath))
+	{
+		std::filesystem::remove(filePath);
+	}
+
+	// Remove backup.
+	if (std::filesystem::exists(backupFile))
+	{
+		std::filesystem::remove(backupFile);
+	}
+
+	// Remove binary snapshot and frozen buffer.
+	RemoveDocumentSnapshot(filePath);
+
+	// Remove save journal (unless a document writes to it).
+	auto saveJournalPath = filePath;
+	saveJournalPath += m_saveJournalFileExtension;
+	if (std::filesystem::exists(saveJournalPath) && !CTomlJournal::IsOpen(saveJournalPath))
+	{
+		std::filesystem::remove(saveJournalPath);
+	}
+
+	// Remove from metadata index.
+	UpdateMetadataIndex(directoryPath, "", fileName, nullptr);
+
+	return true;
+}
+
+std::optional<toml::value> CTomlManager::ReadDocumentSnapshot(const std::filesystem::path& filePath)
+{
+	auto snapshotPath = filePath;
+	snapshotPath += m_snapshotFileExtension;
+
+	return CTomlBinarySnapshot::Read(snapshotPath, filePath);
+}
+
+void CTomlManager::WriteDocumentSnapshot(const std::filesystem::path& filePath, const toml::value& data)
+{
+	auto snapshotPath = filePath;
+	snapshotPath += m_snapshotFileExtension;
+
+	if (!CTomlBinarySnapshot::Write(snapshotPath, filePath, data))
+	{
+		CryLogAlways("[%s]: failed to write binary snapshot at \"%s\"", m_logCategory, snapshotPath.string().c_str());
+	}
+}
+
+void CTomlManager::RemoveDocumentSnapshot(const std::filesystem::path& filePath)
+{
+	auto snapshotPath = filePath;
+	snapshotPath += m_snapshotFileExtension;
+	auto frozenPath = filePath;
+	frozenPath += m_frozenFileExtension;
+
+	std::error_code errorCode;
+	std::filesystem::remove(snapshotPath, errorCode);
+	std::filesystem::remove(frozenPath, errorCode);
+}
+
+void CTomlManager::RecoverSaveJournal(const std::filesystem::path& directoryPath, const std::string& fileName)
+{
+	const auto filePath = directoryPath / (fileName + ".toml");
+	auto saveJournalPath = filePath;
+	saveJournalPath += m_saveJournalFileExtension;
+
+	// Skip journals of open documents.
+	if (!std::filesystem::exists(saveJournalPath) || CTomlJournal::IsOpen(saveJournalPath))
+	{
+		return;
+	}
+
+	std::scoped_lock guard(m_mtxSaveJournalRecovery);
+	if (!std::filesystem::exists(saveJournalPath))
+	{
+		// Recovered by another thread.
+		return;
+	}
+
+	// Read the file that the journal was started for (or its backup).
+	auto sourcePath = filePath;
+	if (!std::filesystem::exists(sourcePath))
+	{
+		sourcePath += m_backupFileExtension;
+	}
+	toml::value data = toml::table();
+	std::string text;
+	if (std::filesystem::exists(sourcePath))
+	{
+		try
+		{
+			std::ifstream file(sourcePath, std::ios::binary);
+			std::ostringstream textStream;
+			textStream << file.rdbuf();
+			text = std::move(textStream).str();
+
+			std::istringstream stream(text);
+			data = toml::parse(stream, sourcePath.string());
+		}
+		catch (std::exception& exception)
+		{
+			CryLogAlways("[%s]: failed to parse file at \"%s\" to apply its save journal, error: %s", m_logCategory, sourcePath.string().c_str(), exception.what());
+			return;
+		}
+	}
+
+	// Apply the journal (only if it was started for this version of the file).
+	const auto optionalRecordCount = CTomlJournal::Replay(saveJournalPath, CTomlJournal::GetChecksum(text), data);
+	if (!optionalRecordCount.has_value())
+	{
+		CryLogAlways("[%s]: failed to read save journal at \"%s\"", m_logCategory, saveJournalPath.string().c_str());
+		return;
+	}
+	if (optionalRecordCount.value() > 0)
+	{
+		std::ostringstream stream;
+		stream << data;
+		if (!CTomlJournal::WriteFile(filePath, std::move(stream).str()))
+		{
+			CryLogAlways("[%s]: failed to write file at \"%s\" to apply its save journal", m_logCategory, filePath.string().c_str());
+			return;
+		}
+		RemoveDocumentSnapshot(filePath);
+
+		// Metadata section of the manager that opens the file is not known, the index reads the file again.
+		UpdateMetadataIndex(directoryPath, "", fileName, nullptr);
+	}
+
+	std::error_code errorCode;
+	std::filesystem::remove(saveJournalPath, errorCode);
+
+	CryLogAlways("[%s]: applied %zu journaled changes to TOML document at \"%s\"", m_logCategory, optionalRecordCount.value(), filePath.string().c_str());
+}
+
+bool CTomlManager::WriteSaveJournalDocument(int documentId)
+{
+	// Take the values of the document (sections are shared, not copied) and the journal size they include.
+	SDocument snapshot;
+	std::filesystem::path directoryPath;
+	std::string fileName;
+	std::string metadataSectionName;
+	const CTomlJournal* pJournal = nullptr;
+	size_t journalSize = 0;
+	size_t rebaseCount = 0;
+	{
+		std::scoped_lock guard(m_mtxTomlDocuments);
+
+		const auto pDocument = GetDocument(documentId);
+		if (pDocument == nullptr || pDocument->pSaveJournal == nullptr)
+		{
+			return false;
+		}
+		auto& saveJournal = *pDocument->pSaveJournal;
+		saveJournal.bCompactionQueued = false;
+		directoryPath = saveJournal.directoryPath;
+		fileName = saveJournal.fileName;
+		metadataSectionName = m_metadataSectionName;
+		pJournal = saveJournal.pJournal.get();
+		journalSize = pJournal->GetSize();
+		rebaseCount = pJournal->GetRebaseCount();
+
+		ShareDocumentContent(*pDocument);
+		snapshot.content = pDocument->content;
+		snapshot.sharedSectionNames = pDocument->sharedSectionNames;
+		snapshot.pFrozenDocument = pDocument->pFrozenDocument;
+		snapshot.pSource = pDocument->pSource;
+		snapshot.modifiedSourceKeys = pDocument->modifiedSourceKeys;
+		snapshot.pLazySource = pDocument->pLazySource;
+		snapshot.unparsedLazyTables = pDocument->unparsedLazyTables;
+	}
+
+	// Get text and metadata of the document without blocking other threads (the snapshot copies sections
+	// before modifying them, so the document itself keeps its values).
+	const auto filePath = directoryPath / (fileName + ".toml");
+	const auto bEmpty = snapshot.content.sections.empty() && snapshot.pFrozenDocument == nullptr && snapshot.pLazySource == nullptr;
+	const auto text = bEmpty ? std::string() : GetDocumentText(snapshot);
+	UnfreezeDocument(snapshot);
+	ParseLazyTable(snapshot, metadataSectionName);
+	auto metadata = CopyDocumentValue(snapshot, metadataSectionName, "");
+	if (metadata.has_value() && !metadata->is_table())
+	{
+		metadata.reset();
+	}
+	const auto optionalNewFilePath = CTomlJournal::WriteNewFile(filePath, text);
+
+	// Replace the file and remove the journal records it contains (records appended meanwhile are kept).
+	bool bWritten = false;
+	if (optionalNewFilePath.has_value())
+	{
+		std::scoped_lock guard(m_mtxTomlDocuments);
+
+		// The journal was disabled or the file was replaced by a newer snapshot meanwhile.
+		const auto pDocument = GetDocument(documentId);
+		if (pDocument == nullptr || pDocument->pSaveJournal == nullptr || pDocument->pSaveJournal->pJournal.get() != pJournal
+			|| pJournal->GetRebaseCount() != rebaseCount)
+		{
+			std::error_code errorCode;
+			std::filesystem::remove(optionalNewFilePath.value(), errorCode);
+			return true;
+		}
+		bWritten = pDocument->pSaveJournal->pJournal->Rebase(filePath, optionalNewFilePath.value(), CTomlJournal::GetChecksum(text), journalSize);
+	}
+	if (!bWritten)
+	{
+		if (optionalNewFilePath.has_value())
+		{
+			std::error_code errorCode;
+			std::filesystem::remove(optionalNewFilePath.value(), errorCode);
+		}
+		CryLogAlways("[%s]: failed to write journaled TOML document at \"%s\" (document %i)", m_logCategory, filePath.string().c_str(), documentId);
+		return false;
+	}
+	RemoveCachedDocument(filePath);
+	RemoveDocumentSnapshot(filePath);
+	UpdateMetadataIndex(directoryPath, metadataSectionName, fileName, metadata.has_value() ? &metadata.value() : nullptr);
+
+	return true;
+}
+
+std::optional<toml::value> CTomlManager::CopyDocumentElement(const SDocument& document, const std::string& keyName, const std::string& sectionName, size_t index)
+{
+	// Read packed arrays directly.
+	if (const auto pSection = FindSection(document, sectionName))
+	{
+		const auto arrayIt = pSection->packedArrays.find(keyName);
+		if (arrayIt != pSection->packedArrays.end())
+		{
+			return std::visit([index](const auto& packedElements) -> std::optional<toml::value>
+			{
+				using Element = typename std::decay_t<decltype(packedElements)>::value_type;
+
+				if (index >= packedElements.size())
+				{
+					return {};
+				}
+				if constexpr (std::is_same_v<Element, std::uint8_t>)
+				{
+					return toml::value(packedElements[index] != 0);
+				}
+				else
+				{
+					return toml::value(packedElements[index]);
+				}
+			}, arrayIt->second);
+		}
+	}
+
+	const auto pValue = FindDocumentValue(document, keyName, sectionName);
+	if (pValue == nullptr || !pValue->is_array() || index >= pValue->as_array().size())
+	{
+		return {};
+	}
+
+	return pValue->as_array()[index];
+}
+
+std::optional<toml::value> CTomlManager::CopyDocumentValue(const SDocument& document, const std::string& keyName, const std::string& sectionName)
+{
+	// See if the value is a packed array.
+	const auto pSection = FindSection(document, sectionName);
+	if (pSection != nullptr)
+	{
+		const auto arrayIt = pSection->packedArrays.find(keyName);
+		if (arrayIt != pSection->packedArrays.end())
+		{
+			return UnpackArray(arrayIt->second);
+		}
+	}
+
+	// Find the value in TOML data.
+	std::optional<toml::value> value;
+	if (const auto pValue = FindDocumentValue(document, keyName, sectionName))
+	{
+		value = *pValue;
+	}
+
+	// A section also contains its packed arrays.
+	const auto pKeySection = sectionName.empty() && !keyName.empty() ? FindSection(document, keyName) : nullptr;
+	if (pKeySection != nullptr)
+	{
+		for (const auto& [arrayKeyName, packedArray] : pKeySection->packedArrays)
+		{
+			value->as_table(std::nothrow)[arrayKeyName] = UnpackArray(packedArray);
+		}
+	}
+
+	return value;
+}
+
+std::string CTomlManager::GetDocumentText(const SDocument& document)
+{
+	// Keep formatting and comments of the file if only values were modified.
+	if (auto optionalText = GetPatchedDocumentText(document))
+	{
+		return std::move(optionalText.value());
+	}
+
+	std::ostringstream stream;
+	stream << GetDocumentData(document);
+	auto text = std::move(stream).str();
+	if (document.pLazySource == nullptr)
+	{
+		return text;
+	}
+
+	// Copy text of tables that were not parsed.
+	const auto& lazySource = *document.pLazySource;
+	for (const auto& tableName : lazySource.tableOrder)
+	{
+		const auto tableIt = lazySource.tableRanges.find(tableName);
+		if (tableIt == lazySource.tableRanges.end() || document.unparsedLazyTables.count(tableName) == 0)
+		{
+			continue;
+		}
+
+		for (const auto& [begin, end] : tableIt->second)
+		{
+			if (!text.empty() && text.back() != '\n')
+			{
+				text += '\n';
+			}
+			text.append(lazySource.text, begin, end - begin);
+		}
+	}
+
+	return text;
+}
+
+void CTomlManager::SetDocumentSource(SDocument& document, const std::filesystem::path& filePath, const toml::value* pParsedData)
+{
+	const auto optionalFileVersion = CTomlBinarySnapshot::GetFileVersion(filePath);
+	if (!optionalFileVersion.has_value())
+	{
+		return;
+	}
+
+	auto pSource = std::make_shared<SDocumentSource>();
+	pSource->filePath = filePath;
+	pSource->fileVersion = optionalFileVersion.value();
+
+	// Parsed values keep the file text alive anyway, so keeping it costs nothing.
+	if (pParsedData != nullptr)
+	{
+		const auto pRootRegion = dynamic_cast<const toml::detail::region*>(toml::detail::get_region(*pParsedData));
+		if (pRootRegion != nullptr && pRootRegion->source() != nullptr)
+		{
+			const auto& pText = pRootRegion->source();
+			pSource->text = std::string_view(pText->data(), pText->size());
+			pSource->pTextOwner = pText;
+		}
+	}
+
+	document.pSource = std::move(pSource);
+	document.modifiedSourceKeys.clear();
+}
+
+std::optional<std::string> CTomlManager::GetPatchedDocumentText(const SDocument& document)
+{
+	if (document.pSource == nullptr || document.pLazySource != nullptr)
+	{
+		return {};
+	}
+	const auto& source = *document.pSource;
+
+	// Read the file again if the document was not parsed from the text (the file must be the same).
+	std::string fileText;
+	auto sourceText = source.text;
+	if (source.pTextOwner == nullptr)
+	{
+		if (CTomlBinarySnapshot::GetFileVersion(source.filePath) != source.fileVersion)
+		{
+			return {};
+		}
+
+		std::ifstream file(source.filePath, std::ios::binary);
+		if (!file.is_open())
+		{
+			return {};
+		}
+		std::ostringstream stream;
+		stream << file.rdbuf();
+		fileText = std::move(stream).str();
+		sourceText = fileText;
+	}
+
+	// Unmodified document has the same text.
+	if (document.modifiedSourceKeys.empty())
+	{
+		return std::string(sourceText);
+	}
+	if (document.pFrozenDocument != nullptr)
+	{
+		return {};
+	}
+
+	// Find tables that contain modified values (a whole section is compared as a root key).
+	std::unordered_set<std::string> rootKeyNames;
+	const auto rootKeysIt = document.modifiedSourceKeys.find("");
+	if (rootKeysIt != document.modifiedSourceKeys.end())
+	{
+		rootKeyNames = rootKeysIt->second;
+	}
+	std::unordered_set<std::string> tableNames = rootKeyNames;
+	for (const auto& [sectionName, keyNames] : document.modifiedSourceKeys)
+	{
+		tableNames.insert(sectionName);
+	}
+
+	// Parse only the root key/values and these tables, remember where each part of the text is in the file.
+	struct SSegment
+	{
+		size_t partBegin = 0;
+		size_t fileBegin = 0;
+		size_t size = 0;
+	};
+	const auto tables = CTomlHeaderScanner::FindTopLevelTables(sourceText);
+	std::vector<std::pair<size_t, size_t>> ranges = { { 0, tables.rootEnd } };
+	for (const auto& tableName : tableNames)
+	{
+		const auto rangesIt = tables.tableRanges.find(tableName);
+		if (rangesIt != tables.tableRanges.end())
+		{
+			ranges.insert(ranges.end(), rangesIt->second.begin(), rangesIt->second.end());
+		}
+	}
+	std::sort(ranges.begin(), ranges.end());
+	std::string partText;
+	std::vector<SSegment> segments;
+	for (const auto& [begin, end] : ranges)
+	{
+		if (!partText.empty() && partText.back() != '\n')
+		{
+			partText += '\n';
+		}
+		segments.push_back({ partText.size(), begin, end - begin });
+		partText.append(sourceText.data() + begin, end - begin);
+	}
+
+	toml::value parsedData;
+	try
+	{
+		std::istringstream stream(partText);
+		parsedData = toml::parse(stream, source.filePath.string());
+	}
+	catch (std::exception&)
+	{
+		return {};
+	}
+	const auto pRootRegion = dynamic_cast<const toml::detail::region*>(toml::detail::get_region(parsedData));
+	if (!parsedData.is_table() || pRootRegion == nullptr || pRootRegion->source() == nullptr)
+	{
+		return {};
+	}
+	const auto& parsedText = *pRootRegion->source();
+	const auto& parsedTable = parsedData.as_table();
+
+	// Compares a parsed value with the current value of the document, both can be missing.
+	std::vector<STextPatch> patches;
+	const auto collect = [&document, &parsedText, &patches](const toml::value* pParsedValue, const std::string& keyName, const std::string& sectionName)
+	{
+		const auto optionalValue = CopyDocumentValue(document, keyName, sectionName);
+		if (pParsedValue == nullptr || !optionalValue.has_value())
+		{
+			return pParsedValue == nullptr && !optionalValue.has_value();
+		}
+		return CollectTextPatches(*pParsedValue, optionalValue.value(), parsedText, patches);
+	};
+	const auto isInlineTable = [](const toml::value& value)
+	{
+		const auto pRegion = dynamic_cast<const toml::detail::region*>(toml::detail::get_region(value));
+		return value.is_table() && pRegion != nullptr && pRegion->size() != 0 && pRegion->front() == '{';
+	};
+
+	// Collect changed values.
+	for (const auto& [sectionName, keyNames] : document.modifiedSourceKeys)
+	{
+		if (sectionName.empty() || rootKeyNames.count(sectionName) != 0)
+		{
+			continue;
+		}
+
+		// Inline tables can't have keys added, so they are compared as a whole.
+		const auto sectionIt = parsedTable.find(sectionName);
+		if (sectionIt != parsedTable.end() && (!sectionIt->second.is_table() || isInlineTable(sectionIt->second)))
+		{
+			rootKeyNames.insert(sectionName);
+			continue;
+		}
+
+		const auto* pParsedSection = sectionIt != parsedTable.end() ? &sectionIt->second.as_table() : nullptr;
+		for (const auto& keyName : keyNames)
+		{
+			const toml::value* pParsedValue = nullptr;
+			if (pParsedSection != nullptr)
+			{
+				const auto valueIt = pParsedSection->find(keyName);
+				pParsedValue = valueIt != pParsedSection->end() ? &valueIt->second : nullptr;
+			}
+			if (!collect(pParsedValue, keyName, sectionName))
+			{
+				return {};
+			}
+		}
+	}
+	for (const auto& keyName : rootKeyNames)
+	{
+		const auto valueIt = parsedTable.find(keyName);
+		if (!collect(valueIt != parsedTable.end() ? &valueIt->second : nullptr, keyName, ""))
+		{
+			return {};
+		}
+	}
+
+	// Move offsets from the parsed text to the file text.
+	for (auto& patch : patches)
+	{
+		const auto segmentIt = std::upper_bound(segments.begin(), segments.end(), patch.begin,
+			[](size_t offset, const SSegment& segment) { return offset < segment.partBegin; });
+		if (segmentIt == segments.begin() || patch.end > std::prev(segmentIt)->partBegin + std::prev(segmentIt)->size)
+		{
+			return {};
+		}
+		const auto& segment = *std::prev(segmentIt);
+		patch.begin = patch.begin - segment.partBegin + segment.fileBegin;
+		patch.end = patch.end - segment.partBegin + segment.fileBegin;
+	}
+
+	// Replace them in the file text.
+	std::sort(patches.begin(), patches.end(), [](const STextPatch& first, const STextPatch& second) { return first.begin < second.begin; });
+	std::string text;
+	text.reserve(sourceText.size());
+	size_t position = 0;
+	for (const auto& patch : patches)
+	{
+		if (patch.begin < position || patch.end > sourceText.size())
+		{
+			return {};
+		}
+		text.append(sourceText.data() + position, patch.begin - position);
+		text += patch.text;
+		position = patch.end;
+	}
+	text.append(sourceText.data() + position, sourceText.size() - position);
+
+	return text;
+}
+
+bool CTomlManager::CollectTextPatches(const toml::value& parsedValue, const toml::value& value, const std::vector<char>& sourceText,
+	std::vector<STextPatch>& patches)
+{
+	if (parsedValue.is_table() && value.is_table())
+	{
+		// Added or removed keys change the structure (unless the table is written inline).
+		const auto& parsedTable = parsedValue.as_table();
+		const auto& table = value.as_table();
+		bool bSameKeys = parsedTable.size() == table.size();
+		for (auto it = table.begin(); bSameKeys && it != table.end(); ++it)
+		{
+			bSameKeys = parsedTable.find(it->first) != parsedTable.end();
+		}
+		if (!bSameKeys)
+		{
+			return CollectValueReplacement(parsedValue, value, sourceText, patches);
+		}
+
+		for (const auto& [keyName, childValue] : table)
+		{
+			if (!CollectTextPatches(parsedTable.at(keyName), childValue, sourceText, patches))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	if (parsedValue.is_array() && value.is_array())
+	{
+		const auto& parsedArray = parsedValue.as_array();
+		const auto& array = value.as_array();
+		if (parsedArray.size() != array.size())
+		{
+			return CollectValueReplacement(parsedValue, value, sourceText, patches);
+		}
+
+		for (size_t i = 0; i < array.size(); i++)
+		{
+			if (!CollectTextPatches(parsedArray[i], array[i], sourceText, patches))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	if (IsSameScalar(parsedValue, value))
+	{
+		return true;
+	}
+
+	return CollectValueReplacement(parsedValue, value, sourceText, patches);
+}
+
+bool CTomlManager::CollectValueReplacement(const toml::value& parsedValue, const toml::value& value, const std::vector<char>& sourceText,
+	std::vector<STextPatch>& patches)
+{
+	const auto pRegion = dynamic_cast<const toml::detail::region*>(toml::detail::get_region(parsedValue));
+	if (pRegion == nullptr || pRegion->source().get() != &sourceText || pRegion->size() == 0)
+	{
+		return false;
+	}
+
+	// Only inline values can be replaced ([table] sections and arrays of tables span several lines).
+	const auto containsTable = [](const toml::value& arrayValue)
+	{
+		const auto& array = arrayValue.as_array();
+		return std::any_of(array.begin(), array.end(), [](const toml::value& element) { return element.is_table(); });
+	};
+	if ((parsedValue.is_table() && pRegion->front() != '{') || (parsedValue.is_array() && containsTable(parsedValue))
+		|| (value.is_array() && containsTable(value)))
+	{
+		return false;
+	}
+
+	// Format the value inline (use the same float precision as when serializing the whole document).
+	const auto floatPrecision = static_cast<int>(std::ostringstream().precision());
+	auto text = toml::visit(toml::serializer<toml::value>(std::numeric_limits<size_t>::max(), floatPrecision, true, true), value);
+	while (!text.empty() && text.back() == '\n')
+	{
+		text.pop_back();
+	}
+	if (value.is_table() && text.find('\n') != std::string::npos)
+	{
+		return false;
+	}
+
+	STextPatch patch;
+	patch.begin = static_cast<size_t>(pRegion->first() - pRegion->begin());
+	patch.end = static_cast<size_t>(pRegion->last() - pRegion->begin());
+	patch.text = std::move(text);
+	patches.push_back(std::move(patch));
+
+	return true;
+}
+
+bool CTomlManager::IsSameScalar(const toml::value& first, const toml::value& second)
+{
+	if (first.type() != second.type())
+	{
+		return false;
+	}
+
+	switch (first.type())
+	{
+	case toml::value_t::boolean:
+		return first.as_boolean() == second.as_boolean();
+	case toml::value_t::integer:
+		return first.as_integer() == second.as_integer();
+	case toml::value_t::floating:
+		return first.as_floating() == second.as_floating() || (std::isnan(first.as_floating()) && std::isnan(second.as_floating()));
+	case toml::value_t::string:
+		return first.as_string().str == second.as_string().str;
+	case toml::value_t::offset_datetime:
+		return first.as_offset_datetime() == second.as_offset_datetime();
+	case toml::value_t::local_datetime:
+		return first.as_local_datetime() == second.as_local_datetime();
+	case toml::value_t::local_date:
+		return first.as_local_date() == second.as_local_date();
+	case toml::value_t::local_time:
+		return first.as_local_time() == second.as_local_time();
+	default:
+		return false;
+	}
+}
+
 std::optional<std::filesystem::path> CTomlManager::GetDirectoryForConfigs()
 {
 	std::filesystem::path directoryPath;
@@ -407,7 +4876,7 @@ std::optional<std::filesystem::path> CTomlManager::GetDirectoryForConfigs()
 
 	const auto sHomePath = std::string(getenv("HOME"));
 	if (sHomePath.empty()) {
-		CryLogAlways("[%s]: environment variable HOME is not set", GetName());
+		CryLogAlways("[%s]: environment variable HOME is not set", m_logCategory);
 		return {};
 	}
 
@@ -1,11 +1,31 @@
 #pragma once
 
 #include <unordered_map>
+#include <unordered_set>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <optional>
+#include <string_view>
+#include <thread>
 #include <filesystem>
 #include <variant>
+#include <vector>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
 #include "External/toml11/toml.hpp"
+#include "TomlCryMathTypes.h"
+#include "TomlDirectoryWatcher.h"
+#include "TomlFileWatcher.h"
+#include "TomlFrozenDocument.h"
+#include "TomlHeaderScanner.h"
+#include "TomlJournal.h"
+#include "TomlPatch.h"
+#include "TomlWorkerPool.h"
 
 //! Allows working with TOML files.
 class CTomlManager
@@ -25,6 +45,37 @@ public:
 		ValueTypeMismatch  //!< Type for the specified key/section value is not the same as the specified T parameter.
 	};
 
+	//! Describes TOML manager's operation error.
+	enum class GetArrayError {
+		DocumentNotFound,    //!< Document ID is not registered or this document was saved (and ID is no longer valid).
+		KeyEmpty,            //!< Key parameter is empty.
+		ValueNotFound,       //!< Array for the specified key/section is not found.
+		ValueTypeMismatch,   //!< Value for the specified key/section is not an array.
+		ElementTypeMismatch, //!< Type of an array element is not the same as the specified T parameter.
+		BufferTooSmall,      //!< Array has more elements than the specified buffer can hold.
+	};
+
+	//! Describes TOML manager's operation error.
+	enum class ArrayOperationError {
+		DocumentNotFound,  //!< Document ID is not registered or this document was saved (and ID is no longer valid).
+		KeyEmpty,          //!< Key parameter is empty.
+		ValueNotFound,     //!< Array for the specified key/section is not found.
+		ValueTypeMismatch, //!< Value for the specified key/section is not an array.
+		IndexOutOfRange,   //!< The specified element index is out of array bounds.
+	};
+
+	//! Describes TOML manager's operation error.
+	enum class SubscribeError {
+		DocumentNotFound, //!< Document ID is not registered or this document was saved (and ID is no longer valid).
+		KeyEmpty,         //!< Key parameter is empty.
+	};
+
+	//! Describes TOML manager's operation error.
+	enum class GetChangesError {
+		DocumentNotFound, //!< Document ID is not registered or this document was saved (and ID is no longer valid).
+		JournalOverflow,  //!< Changes made after the specified revision are no longer stored in the change journal.
+	};
+
 	//! Describes TOML manager's operation error.
 	enum class SaveDocumentError {
 		DocumentNotFound,    //!< Document ID is not registered or this document was saved (and ID is no longer valid).
@@ -33,6 +84,37 @@ public:
 		DirectoryNameEmpty,  //!< Directory name parameter is empty.
 		FailedToGetBasePath, //!< Failed to get base path for storing your document (see logs for details).
 		UnableToCreateFile,  //!< Unable to create/open file.
+		PartialDocument,     //!< Document was opened partially from this file (see \ref OpenDocumentPartial).
+	};
+
+	//! Describes TOML manager's operation error.
+	enum class SaveJournalError {
+		DocumentNotFound,    //!< Document ID is not registered or this document was saved (and ID is no longer valid).
+		FileNameEmpty,       //!< File name parameter is empty.
+		DirectoryNameEmpty,  //!< Directory name parameter is empty.
+		FailedToGetBasePath, //!< Failed to get base path for storing your document (see logs for details).
+		JournalNotEnabled,   //!< Save journal of the document is not enabled (see \ref EnableSaveJournal).
+		JournalInUse,        //!< Another document already writes to the journal of this file.
+		UnableToCreateFile,  //!< Unable to create/open file.
+		PartialDocument,     //!< Document was opened partially from this file (see \ref OpenDocumentPartial).
+	};
+
+	//! Describes TOML manager's operation error.
+	enum class HotReloadError {
+		DocumentNotFound,    //!< Document ID is not registered or this document was saved (and ID is no longer valid).
+		FileNameEmpty,       //!< File name parameter is empty.
+		DirectoryNameEmpty,  //!< Directory name parameter is empty.
+		FailedToGetBasePath, //!< Failed to get base path for storing your document (see logs for details).
+	};
+
+	//! Describes TOML manager's operation error.
+	enum class ApplyPatchError {
+		DocumentNotFound,  //!< Document ID is not registered or this document was saved (and ID is no longer valid).
+		KeyEmpty,          //!< Key of a patch operation is empty.
+		ValueNotFound,     //!< Value (or array) of a patch operation is not found.
+		ValueTypeMismatch, //!< Value of an array operation is not an array or section of a patch operation is not a table.
+		IndexOutOfRange,   //!< Elements of an array operation are out of array bounds.
+		InvalidPatch,      //!< New elements of an array operation are not an array (the patch was not created by Diff or Deserialize).
 	};
 
 	//! Describes TOML manager's operation error.
@@ -50,6 +132,85 @@ public:
 		FailedToGetBasePath, //!< Failed to get base path for storing your document (see logs for details).
 	};
 
+	//! Describes a modification of a document's value.
+	struct SValueChange
+	{
+		//! Document's revision after the modification (see \ref GetDocumentRevision).
+		size_t revision = 0;
+
+		//! Section name of the modified value (empty for the root table).
+		std::string sectionName;
+
+		//! Key name of the modified value.
+		std::string keyName;
+	};
+
+	//! Document file to open with \ref OpenDocuments.
+	struct SDocumentToOpen
+	{
+		//! Name of the file without ".toml" extension for the document.
+		std::string fileName;
+
+		//! Usually your game name. Directory for file (will be appended to the base path).
+		std::string directoryName;
+	};
+
+	//! Where the values of a document opened with \ref OpenDocuments were taken from.
+	enum class OpenDocumentSource {
+		File,     //!< The file was read and parsed.
+		Snapshot, //!< Binary snapshot of the unmodified file was read (see \ref CTomlBinarySnapshot), nothing was parsed.
+		Cache,    //!< Parsed values of the unmodified file were shared with the document cache (see \ref SetDocumentCacheMemoryLimit).
+	};
+
+	//! Result of opening a document with \ref OpenDocuments.
+	struct SOpenDocumentResult
+	{
+		//! ID of the opened document if successful, otherwise error.
+		std::variant<int, OpenDocumentError> result = OpenDocumentError::FileNotFound;
+
+		//! Where the values of the document were taken from.
+		OpenDocumentSource source = OpenDocumentSource::File;
+
+		//! Time spent reading the file, its binary snapshot or the document cache (in milliseconds).
+		float readTimeMs = 0.0f;
+
+		//! Time spent parsing the file (in milliseconds), 0 if the values were not taken from the file.
+		float parseTimeMs = 0.0f;
+	};
+
+	//! Statistics of the cache of parsed documents (see \ref SetDocumentCacheMemoryLimit).
+	struct SDocumentCacheStats
+	{
+		//! Number of opens that used a cached document.
+		size_t hitCount = 0;
+
+		//! Number of opens that parsed the file.
+		size_t missCount = 0;
+
+		//! Number of cached documents.
+		size_t documentCount = 0;
+
+		//! Approximate memory used by cached documents (in bytes).
+		size_t memorySize = 0;
+
+		//! Maximum memory that cached documents can use (in bytes).
+		size_t memoryLimit = 0;
+	};
+
+	//! Called when an observed value is modified.
+	//! 
+	//! \param documentId  Modified document.
+	//! \param sectionName Section name of the modified value (empty for the root table).
+	//! \param keyName     Key name of the modified value.
+	using ValueChangedCallback = std::function<void(int documentId, const std::string& sectionName, const std::string& keyName)>;
+
+	//! Called when a hot reloaded document was updated from its file (see \ref EnableHotReload).
+	//! 
+	//! \param documentId Updated document.
+	//! \param changes    Modified values (a section that was added, removed or replaced by a value is reported
+	//! as a root key with the section name).
+	using DocumentReloadedCallback = std::function<void(int documentId, const std::vector<SValueChange>& changes)>;
+
 	//! Constructor.
 	CTomlManager() = default;
 
@@ -84,6 +245,50 @@ public:
 	//! \return 'true' if found and removed the document, 'false' if not found.
 	static bool RemoveDocument(const std::string& fileName, const std::string& directoryName);
 
+	//! Returns sorted names of documents of the specified directory (see \ref GetAllDocuments) from a cached listing,
+	//! the directory is scanned again only if it was modified since the last scan (detected using OS notifications
+	//! where available, otherwise using directory's last write time).
+	//! 
+	//! \param directoryName Usually your game name. Directory for documents (will be appended to the base path).
+	//! \param bForceRefresh Whether to scan the directory even if it looks unchanged.
+	//! 
+	//! \remark The returned listing is never modified (a new one is created when the directory changes),
+	//! so it can be kept and iterated without locking.
+	//! 
+	//! \remark Unlike \ref GetAllDocuments, missing files are not restored from their backups (a document that has
+	//! only a backup is listed, opening it restores the file).
+	//! 
+	//! \return Error if something went wrong, otherwise document names (without extensions).
+	std::variant<std::shared_ptr<const std::vector<std::string>>, GetAllDocumentsError> GetCachedDocumentListing(
+		const std::string& directoryName, bool bForceRefresh = false);
+
+	//! Sets maximum memory that the cache of parsed documents can use, least recently opened documents
+	//! are removed from the cache when the limit is exceeded.
+	//! 
+	//! \param memoryLimit Maximum memory in bytes, 0 to disable the cache.
+	//! 
+	//! \remark \ref OpenDocument, \ref OpenDocuments and \ref OpenDocumentParallel look for the file in the cache
+	//! (by path, size and last write time) and share the parsed tree with the cache instead of parsing
+	//! an unchanged file again, the tree is copied to the document on its first modification.
+	void SetDocumentCacheMemoryLimit(size_t memoryLimit);
+
+	//! Removes all documents from the cache of parsed documents (opened documents are not affected).
+	void ClearDocumentCache();
+
+	//! Sets name of the document section that is stored in the metadata index (see \ref OpenDocumentsMetadata),
+	//! "metadata" by default.
+	//! 
+	//! \param sectionName Name of the section.
+	//! 
+	//! \remark Metadata index of a directory stores one section, opening metadata of another section rebuilds
+	//! the index (every document of the directory is parsed once).
+	void SetMetadataSectionName(const std::string& sectionName);
+
+	//! Returns statistics of the cache of parsed documents.
+	//! 
+	//! \return Cache statistics.
+	SDocumentCacheStats GetDocumentCacheStats();
+
 	//! Initializes a fresh new TOML document and returns this document's unique ID.
 	//! 
 	//! \return New document ID.
@@ -96,6 +301,134 @@ public:
 	//! \return 'true' if registered, 'false' if not.
 	bool IsDocumentRegistered(int documentId);
 
+	//! Creates a copy of a document and returns ID of the copy.
+	//! 
+	//! \param documentId Document to copy.
+	//! 
+	//! \remark The copy shares document's top-level sections and the source text of a lazily opened document
+	//! (the copy is created without copying values, only pointers to sections are copied so the cost depends on
+	//! the number of top-level tables). Sharing is per top-level section, not per subtree: a shared section is
+	//! copied as a whole when it is modified in one of the documents and only the modified sections are copied.
+	//! Change journal and subscriptions of the document are not copied.
+	//! 
+	//! \return Empty if the document was not found, otherwise ID of the new document.
+	std::optional<int> CloneDocument(int documentId);
+
+	//! Converts a document to its frozen representation (see \ref CTomlFrozenDocument): all values are flattened
+	//! into one contiguous buffer with sorted keys that \ref GetValue, \ref GetArraySize and \ref GetArrayInto
+	//! read directly without allocating TOML values.
+	//! 
+	//! \param documentId Document to freeze.
+	//! 
+	//! \remark Use this function for documents that are read often and no longer modified (for example
+	//! game balance tables), modifying a frozen document converts it back to TOML data first.
+	//! Freezing an already frozen document does nothing.
+	//! 
+	//! \return 'false' if the document was not found or is too large to freeze, 'true' otherwise.
+	bool FreezeDocument(int documentId);
+
+	//! Creates a layered document: a view of a stack of documents (for example defaults, user settings and mod
+	//! overrides) where values are read from the top-most layer that has them, and returns its ID.
+	//! 
+	//! \param layerDocumentIds Documents to stack, bottom layer first (the last one is the top layer).
+	//! 
+	//! \remark Layers are not copied or merged, resolved layers of values are cached until one of the layers
+	//! is modified. Tables are not merged either: reading a whole table returns it from the top-most layer that has it.
+	//! 
+	//! \remark Values written to the layered document go to its top layer and \ref SaveDocument saves only
+	//! the top layer (and closes it), so the saved file contains only the values that override lower layers.
+	//! 
+	//! \remark Layer documents stay open and can be used directly, closing the layered document doesn't close them.
+	//! Closed layers are skipped.
+	//! 
+	//! \return Empty if no layers were specified or one of the layers is not registered or is a layered document,
+	//! otherwise ID of the new document.
+	std::optional<int> CreateLayeredDocument(const std::vector<int>& layerDocumentIds);
+
+	//! Returns document's revision, the revision is changed every time a value of the document is modified
+	//! so it can be used to check whether previously read values are still up to date.
+	//! 
+	//! \remark Revision of a layered document is incremented if any of its layers was modified or closed since
+	//! the previous call (revisions never decrease).
+	//! 
+	//! \param documentId Document to get revision of.
+	//! 
+	//! \return Empty if the document is not registered, otherwise document's revision.
+	std::optional<size_t> GetDocumentRevision(int documentId);
+
+	//! Returns modifications of a document made after the specified revision.
+	//! 
+	//! \param documentId Document to get modifications of.
+	//! \param revision   Revision returned by \ref GetDocumentRevision earlier.
+	//! 
+	//! \remark Only the last \ref m_maxChangeJournalSize modifications are stored.
+	//! 
+	//! \return Error if something went wrong, otherwise modifications (oldest first).
+	std::variant<std::vector<SValueChange>, GetChangesError> GetChangesSince(int documentId, size_t revision);
+
+	//! Compares two documents and returns operations that turn the first document into the second one
+	//! (for example to replicate a modified document or to log what was changed between two saves).
+	//! 
+	//! \param documentId      Document to compare (the patch is applied to this document).
+	//! \param otherDocumentId Document to compare with.
+	//! 
+	//! \remark Documents are compared in one pass by sections and keys, modified arrays are compared element-wise
+	//! (elements are overwritten, inserted or erased unless it's smaller to set the whole array). Only top-level
+	//! sections that both documents share (the same section object, see \ref CloneDocument) are skipped without
+	//! comparing their values, all other values are compared (documents parsed independently are compared fully).
+	//! 
+	//! \remark Layered documents are compared by their top layers.
+	//! 
+	//! \return Empty if one of the documents was not found, otherwise the patch (see \ref CTomlPatch::Serialize
+	//! to send or store it).
+	std::optional<CTomlPatch> Diff(int documentId, int otherDocumentId);
+
+	//! Applies operations of a patch (see \ref Diff) to a document, subscribers are notified after all values are set.
+	//! 
+	//! \param documentId Document to modify.
+	//! \param patch      Patch to apply.
+	//! 
+	//! \remark The document is not modified if one of the operations fails. Layered documents are modified
+	//! in their top layer.
+	//! 
+	//! \return Error if something went wrong.
+	std::optional<ApplyPatchError> ApplyPatch(int documentId, const CTomlPatch& patch);
+
+	//! Registers a callback that will be called every time the specified value is modified.
+	//! 
+	//! \param documentId  Document to observe.
+	//! \param keyName     Name of the key of the value.
+	//! \param sectionName Section name of the value (can be empty).
+	//! \param callback    Callback to call.
+	//! 
+	//! \remark The callback is called on the thread that modified the value after documents are unlocked (it can
+	//! read and modify documents), overwriting the whole section (or the root key with the section name) also
+	//! triggers the callback.
+	//! 
+	//! \remark For a layered document (see \ref CreateLayeredDocument) the callback is called when any of its layers
+	//! modifies the value and no higher layer overrides it (the callback receives the ID of the layered document).
+	//! 
+	//! \remark Subscriptions are removed when the document is closed, call \ref Unsubscribe anyway before destroying
+	//! objects captured by the callback (it waits for a callback that is running on another thread).
+	//! 
+	//! \return Error if something went wrong, otherwise subscription ID (used in \ref Unsubscribe).
+	std::variant<size_t, SubscribeError> Subscribe(
+		int documentId, const std::string& keyName, const std::string& sectionName, ValueChangedCallback callback);
+
+	//! Removes a callback registered with \ref Subscribe.
+	//! 
+	//! \param documentId     Observed document.
+	//! \param subscriptionId ID returned by \ref Subscribe.
+	//! 
+	//! \remark After this function returns the callback is not running and is never called again (notifications
+	//! that were already queued are dropped), so objects captured by the callback can be destroyed. If the callback
+	//! is running on another thread this function waits for it to finish (don't call it while documents are locked
+	//! by a callback of another thread that waits for this thread). Calling it from the callback itself doesn't wait.
+	//! This also holds if the document was already closed.
+	//! 
+	//! \return 'true' if the subscription was found and removed, 'false' otherwise.
+	bool Unsubscribe(int documentId, size_t subscriptionId);
+
 	//! Sets a value into a TOML documents.
 	//! 
 	//! \param documentId  Document to write value to.
@@ -110,12 +443,34 @@ public:
 	//! - std::string,
 	//! - date / time,
 	//! - array containers(vector, list, deque, etc.),
-	//! - map containers(unordered_map, etc.).
+	//! - map containers(unordered_map, etc.),
+	//! - CRYENGINE math types (Vec2, Vec3, Vec4, Quat, ColorF, Matrix34) that are stored as arrays of numbers.
+	//! 
+	//! \remark std::vector of integers, floats or booleans with at least \ref m_minPackedArraySize elements
+	//! is stored as a packed array (elements are stored contiguously instead of being separate TOML values),
+	//! this is transparent to other functions.
+	//! 
+	//! \remark Pass the value as an rvalue (std::move) to move strings, containers and maps
+	//! into the document instead of copying them.
 	//! 
 	//! \return Error if something went wrong.
 	template<typename T>
 	std::optional<SetValueError> SetValue(int documentId, const std::string& keyName, T value, const std::string& sectionName = "");
 
+	//! Constructs a value in place in a TOML document from the specified arguments.
+	//! 
+	//! \param documentId  Document to write value to.
+	//! \param keyName     Name of the key for the value.
+	//! \param sectionName Section name for the value (can be empty).
+	//! \param args        Arguments that are perfectly forwarded to the toml::value constructor.
+	//! 
+	//! \remark Unlike \ref SetValue no intermediate copy of the value is created, rvalue arguments
+	//! (strings, containers, maps) are moved straight into the document.
+	//! 
+	//! \return Error if something went wrong.
+	template<typename... Args>
+	std::optional<SetValueError> EmplaceValue(int documentId, const std::string& keyName, const std::string& sectionName, Args&&... args);
+
 	//! Returns a string value from TOML document.
 	//! 
 	//! \param documentId  Document to get value from.
@@ -126,8 +481,106 @@ public:
 	template<typename T>
 	std::variant<T, GetValueError> GetValue(int documentId, const std::string& keyName, const std::string& sectionName = "");
 
+	//! Returns number of elements in an array of TOML document.
+	//! 
+	//! \param documentId  Document to get array from.
+	//! \param keyName     Name of the key of the array.
+	//! \param sectionName Optional. Section name of the array.
+	//! 
+	//! \return Error if something went wrong, otherwise number of elements in the array.
+	std::variant<size_t, GetArrayError> GetArraySize(int documentId, const std::string& keyName, const std::string& sectionName = "");
+
+	//! Reads elements of an array from TOML document into the specified buffer without allocating memory.
+	//! 
+	//! \param documentId               Document to get array from.
+	//! \param keyName                  Name of the key of the array.
+	//! \param pBuffer                  Buffer to write array elements to.
+	//! \param bufferSize               Number of elements the buffer can hold.
+	//! \param sectionName              Optional. Section name of the array.
+	//! \param pMismatchedElementIndex  Optional. If an element has wrong type its index will be written here.
+	//! 
+	//! Possible types for T: integer types, float / double, bool, std::string.
+	//! 
+	//! \remark Packed arrays (see \ref SetValue) are converted in one tight loop without per-element type checks.
+	//! 
+	//! \return Error if something went wrong (some elements might be already written), otherwise number
+	//! of elements written to the buffer.
+	template<typename T>
+	std::variant<size_t, GetArrayError> GetArrayInto(
+		int documentId, const std::string& keyName, T* pBuffer, size_t bufferSize,
+		const std::string& sectionName = "", size_t* pMismatchedElementIndex = nullptr);
+
+	//! Reads elements of an array from TOML document into the specified vector reusing its capacity.
+	//! 
+	//! \param documentId               Document to get array from.
+	//! \param keyName                  Name of the key of the array.
+	//! \param outArray                 Vector that will be resized to the array size and filled with array elements.
+	//! \param sectionName              Optional. Section name of the array.
+	//! \param pMismatchedElementIndex  Optional. If an element has wrong type its index will be written here.
+	//! 
+	//! Possible types for T: integer types, float / double, bool, std::string.
+	//! 
+	//! \return Error if something went wrong.
+	template<typename T>
+	std::optional<GetArrayError> GetArrayInto(
+		int documentId, const std::string& keyName, std::vector<T>& outArray,
+		const std::string& sectionName = "", size_t* pMismatchedElementIndex = nullptr);
+
+	//! Appends a value to the end of an array in TOML document (the array is modified in place).
+	//! 
+	//! \param documentId  Document to write value to.
+	//! \param keyName     Name of the key of the array.
+	//! \param value       Value to append (see \ref SetValue for possible value types, pass a map container
+	//! to append to an array of tables).
+	//! \param sectionName Optional. Section name of the array.
+	//! 
+	//! \remark If the array does not exist it will be created.
+	//! 
+	//! \return Error if something went wrong.
+	template<typename T>
+	std::optional<ArrayOperationError> AppendValue(int documentId, const std::string& keyName, T value, const std::string& sectionName = "");
+
+	//! Inserts a value into an array in TOML document before the specified element (the array is modified in place).
+	//! 
+	//! \param documentId  Document to write value to.
+	//! \param keyName     Name of the key of the array.
+	//! \param index       Index of the element to insert the value before (array size to append).
+	//! \param value       Value to insert (see \ref SetValue for possible value types).
+	//! \param sectionName Optional. Section name of the array.
+	//! 
+	//! \return Error if something went wrong.
+	template<typename T>
+	std::optional<ArrayOperationError> InsertAt(int documentId, const std::string& keyName, size_t index, T value, const std::string& sectionName = "");
+
+	//! Replaces an element of an array in TOML document (the array is modified in place).
+	//! 
+	//! \param documentId  Document to write value to.
+	//! \param keyName     Name of the key of the array.
+	//! \param index       Index of the element to replace.
+	//! \param value       New value of the element (see \ref SetValue for possible value types).
+	//! \param sectionName Optional. Section name of the array.
+	//! 
+	//! \return Error if something went wrong.
+	template<typename T>
+	std::optional<ArrayOperationError> SetAt(int documentId, const std::string& keyName, size_t index, T value, const std::string& sectionName = "");
+
+	//! Removes an element from an array in TOML document (the array is modified in place).
+	//! 
+	//! \param documentId  Document to remove value from.
+	//! \param keyName     Name of the key of the array.
+	//! \param index       Index of the element to remove.
+	//! \param sectionName Optional. Section name of the array.
+	//! 
+	//! \return Error if something went wrong.
+	std::optional<ArrayOperationError> EraseAt(int documentId, const std::string& keyName, size_t index, const std::string& sectionName = "");
+
 	//! Saves document to file and closes the document (so you don't need to call \ref CloseDocument).
 	//! 
+	//! \remark For a layered document (see \ref CreateLayeredDocument) only its top layer is saved and closed.
+	//! 
+	//! \remark If the document has a metadata section (see \ref SetMetadataSectionName) it is also stored
+	//! in the metadata index of the directory (see \ref OpenDocumentsMetadata).
+	//! 
 	//! \param documentId    Document to write value to.
 	//! \param fileName      Name of the file without ".toml" extension for the document.
 	//! \param directoryName Usually your game name. Directory for file (will be appended to the base path).
@@ -137,14 +590,184 @@ public:
 	//! \return Error if something went wrong.
 	std::optional<SaveDocumentError> SaveDocument(int documentId, const std::string& fileName, const std::string& directoryName, bool bEnableBackup);
 
+	//! Persists a document incrementally: writes the whole document to a file once, then every modification
+	//! only appends the change (the new value or the changed array element) to a journal file ("<file>.toml.journal")
+	//! and flushes it to the disk. The change is written after documents are unlocked, so other documents are
+	//! not blocked while the disk is flushed (the modifying function returns after the flush).
+	//! 
+	//! \param documentId     Document to persist (for a layered document its top layer is persisted).
+	//! \param fileName       Name of the file without ".toml" extension for the document.
+	//! \param directoryName  Usually your game name. Directory for file (will be appended to the base path).
+	//! \param compactionSize Size of the journal in bytes after which the whole document is written to the file
+	//! again and the journal is cleared (see \ref CompactSaveJournal). The document is written after the modification
+	//! that exceeded the size returns, without blocking other documents.
+	//! 
+	//! \remark Use this instead of calling \ref SaveDocument after every change of a document that is saved
+	//! often (for example game state that is saved after every room). The document stays open, \ref CloseDocument
+	//! writes the whole document to the file and removes the journal.
+	//! 
+	//! \remark If the process stops before the document was closed, the journal is applied to the file the next time
+	//! the file is opened (by any of the OpenDocument functions).
+	//! 
+	//! \return Error if something went wrong.
+	std::optional<SaveJournalError> EnableSaveJournal(int documentId, const std::string& fileName, const std::string& directoryName,
+		size_t compactionSize = m_defaultSaveJournalCompactionSize);
+
+	//! Writes the whole document to the file of its save journal and clears the journal.
+	//! 
+	//! \param documentId Document with the save journal (see \ref EnableSaveJournal).
+	//! 
+	//! \return Error if something went wrong.
+	std::optional<SaveJournalError> CompactSaveJournal(int documentId);
+
+	//! Writes the whole document to the file of its save journal and stops journaling the document
+	//! (the journal file is removed).
+	//! 
+	//! \param documentId Document with the save journal (see \ref EnableSaveJournal).
+	//! 
+	//! \return Error if something went wrong.
+	std::optional<SaveJournalError> DisableSaveJournal(int documentId);
+
+	//! Starts updating a document when its file is modified on the disk (for example tuning values edited
+	//! while the game runs). The file is parsed and compared with the document on worker threads,
+	//! \ref UpdateHotReload applies the modified values.
+	//! 
+	//! \param documentId    Document to update (for a layered document its top layer is updated).
+	//! \param fileName      Name of the file without ".toml" extension for the document.
+	//! \param directoryName Usually your game name. Directory for file (will be appended to the base path).
+	//! \param callback      Optional. Called with the modified values after the document was updated.
+	//! 
+	//! \remark Values that differ from the file are replaced with values of the file, except for values that were
+	//! modified after the file modification was detected. Tables of a lazily opened document are parsed by this call.
+	//! 
+	//! \remark Hot reload stops when the document is closed.
+	//! 
+	//! \return Error if something went wrong.
+	std::optional<HotReloadError> EnableHotReload(int documentId, const std::string& fileName, const std::string& directoryName,
+		DocumentReloadedCallback callback = nullptr);
+
+	//! Stops updating a document from its file.
+	//! 
+	//! \param documentId Document with hot reload (see \ref EnableHotReload).
+	//! 
+	//! \return 'true' if hot reload was enabled for the document, 'false' otherwise.
+	bool DisableHotReload(int documentId);
+
+	//! Applies files reloaded since the last call to their documents (each document is updated
+	//! at once, callbacks are called after that) and starts reloading modified files. Call it regularly (for example once per frame).
+	//! 
+	//! \remark Does not block and does not parse files, parsing (and freeing of the parsed files) is done on worker threads.
+	//! 
+	//! \return Number of updated documents.
+	size_t UpdateHotReload();
+
 	//! Opens a document file and returns its new ID.
 	//! 
 	//! \param fileName      Name of the file without ".toml" extension for the document.
 	//! \param directoryName Usually your game name. Directory for file (will be appended to the base path).
 	//! 
+	//! \remark A binary snapshot of the parsed file is stored next to it (see \ref CTomlBinarySnapshot)
+	//! and loaded instead of parsing the file while the file is not modified.
+	//! 
 	//! \return ID of the opened document if successful, otherwise error.
 	std::variant<int, OpenDocumentError> OpenDocument(const std::string& fileName, const std::string& directoryName);
 
+	//! Opens only the root key/values and the specified top-level tables of a document file and returns its new ID,
+	//! the file is read only until all specified tables were read.
+	//! 
+	//! \param fileName      Name of the file without ".toml" extension for the document.
+	//! \param directoryName Usually your game name. Directory for file (will be appended to the base path).
+	//! \param tableNames    Names of top-level tables to read (empty to only read the root key/values).
+	//! 
+	//! \remark Use this function when only a small part of a large document is needed (for example its header table),
+	//! see \ref CTomlHeaderScanner::ReadTopLevelTables for limitations. A partially opened document can't be saved
+	//! to the file it was read from (\ref SaveDocument and \ref EnableSaveJournal return an error) as other tables
+	//! would be lost, it can be saved to another file.
+	//! 
+	//! \return ID of the opened document if successful, otherwise error.
+	std::variant<int, OpenDocumentError> OpenDocumentPartial(
+		const std::string& fileName, const std::string& directoryName, const std::vector<std::string>& tableNames);
+
+	//! Opens a document file and returns its new ID, top-level tables of the document are parsed
+	//! on first access (only the root key/values are parsed when opening).
+	//! 
+	//! \param fileName      Name of the file without ".toml" extension for the document.
+	//! \param directoryName Usually your game name. Directory for file (will be appended to the base path).
+	//! 
+	//! \remark Use this function for large documents when only some tables are accessed, \ref SaveDocument
+	//! copies text of tables that were never accessed without parsing them.
+	//! 
+	//! \remark If the document cache (see \ref SetDocumentCacheMemoryLimit) has the file, the cached (fully parsed)
+	//! document is returned. Otherwise binary snapshots are not used because they decode the whole document,
+	//! and the lazily opened document is not added to the cache and has no \ref SDocument::pSource (the unparsed
+	//! text of its tables is kept instead).
+	//! 
+	//! \return ID of the opened document if successful, otherwise error.
+	std::variant<int, OpenDocumentError> OpenDocumentLazy(const std::string& fileName, const std::string& directoryName);
+
+	//! Opens multiple document files at once, files are read and parsed concurrently on worker threads
+	//! and all documents are registered at the end.
+	//! 
+	//! \param documents Document files to open.
+	//! 
+	//! \remark Use this function instead of calling \ref OpenDocument for each file when many documents
+	//! are opened at the same time (for example on level start).
+	//! 
+	//! \return Result of each document (in the same order as the specified documents).
+	std::vector<SOpenDocumentResult> OpenDocuments(const std::vector<SDocumentToOpen>& documents);
+
+	//! Opens a document file and returns its new ID, large files are split at top-level table headers
+	//! and parsed on multiple threads (see \ref CTomlParallelParser).
+	//! 
+	//! \param fileName      Name of the file without ".toml" extension for the document.
+	//! \param directoryName Usually your game name. Directory for file (will be appended to the base path).
+	//! 
+	//! \remark Use this function for large documents with many top-level tables or large arrays of tables,
+	//! the opened document is the same as the one opened with \ref OpenDocument.
+	//! 
+	//! \return ID of the opened document if successful, otherwise error.
+	std::variant<int, OpenDocumentError> OpenDocumentParallel(const std::string& fileName, const std::string& directoryName);
+
+	//! Opens a document file as a frozen document (see \ref FreezeDocument) and returns its new ID.
+	//! 
+	//! \param fileName      Name of the file without ".toml" extension for the document.
+	//! \param directoryName Usually your game name. Directory for file (will be appended to the base path).
+	//! 
+	//! \remark The frozen buffer is stored next to the file and memory-mapped instead of parsing the file
+	//! while the file is not modified, so opening only touches the pages that are read later.
+	//! 
+	//! \return ID of the opened document if successful, otherwise error.
+	std::variant<int, OpenDocumentError> OpenFrozenDocument(const std::string& fileName, const std::string& directoryName);
+
+	//! Opens a document that is embedded into the binary and returns its new ID.
+	//! 
+	//! \param pBuffer Frozen document generated at build time by the TomlEmbed tool (see "Tools/TomlEmbed"),
+	//! must stay valid while the document (or its clones) is open, usually static data of the generated header.
+	//! \param size    Size of the buffer in bytes.
+	//! 
+	//! \remark The document is opened as a frozen document (see \ref FreezeDocument) that reads values straight
+	//! from the buffer, nothing is parsed or copied. Use this function for default configs shipped with the game.
+	//! 
+	//! \return ID of the opened document if successful, otherwise error (ParsingFailed if the buffer is not a frozen document).
+	std::variant<int, OpenDocumentError> OpenEmbeddedDocument(const void* pBuffer, size_t size);
+
+	//! Opens metadata of all documents of a directory as a new document without opening the documents themselves.
+	//! 
+	//! \param directoryName Usually your game name. Directory for documents (will be appended to the base path).
+	//! 
+	//! \remark The returned document has a section per document (section name is the document file name without
+	//! extension) that contains values of document's metadata section (see \ref SetMetadataSectionName, empty if
+	//! the document has no such section), use \ref GetValue to read them (for example name, timestamp and playtime
+	//! of a save file).
+	//! 
+	//! \remark Metadata is read from the index file of the directory that is updated by \ref SaveDocument,
+	//! only documents that are missing in the index (for example saved by an older version) are parsed
+	//! and then added to the index.
+	//! 
+	//! \return ID of the opened document if successful, otherwise error (errors of listing the directory are
+	//! returned as is, see \ref GetCachedDocumentListing).
+	std::variant<int, OpenDocumentError> OpenDocumentsMetadata(const std::string& directoryName);
+
 	//! Invalidates document ID and clears internal data related to it.
 	//! 
 	//! \param documentId Document to invalidate.
@@ -159,107 +782,1817 @@ public:
 
 private:
 
-	//! Returns directory path to store config files.
-	//! 
-	//! \return Empty if something went wrong (see logs), otherwise directory path,
-	//! "%localappdata%" on Windows, "%HOME%/.config" on Linux.
-	static std::optional<std::filesystem::path> GetDirectoryForConfigs();
+	//! Homogeneous array of integers, floats or booleans that is stored contiguously (outside of document's
+	//! TOML data) to avoid the per-element overhead of toml::value (type tag, region info, comments).
+	using PackedArray = std::variant<std::vector<toml::integer>, std::vector<toml::floating>, std::vector<std::uint8_t>>;
 
-	//! Returns document's TOML data.
-	//! 
-	//! \param documentId Document for which to get TOML data.
-	//! 
-	//! \return nullptr if no document was registered for the specified ID, valid pointer otherwise.
-	toml::value* GetTomlData(int documentId);
+	//! Top-level table of a document (or key/values of the root table that are not tables) with its packed arrays.
+	struct SDocumentSection
+	{
+		//! TOML table of the section.
+		toml::value data = toml::table();
 
-	//! Text that we add before log text.
-	static inline const auto m_logCategory = "TomlManager";
+		//! Packed arrays of the section (key name -> array), arrays stored here are not present in \ref data.
+		std::unordered_map<std::string, PackedArray> packedArrays;
+	};
+
+	//! TOML data of a document split into sections, each section can be shared with other documents and
+	//! the document cache (see \ref SDocument::sharedSectionNames) so that modifying a document copies only
+	//! the modified section.
+	struct SDocumentContent
+	{
+		//! Sections of the document (section name -> section), key/values of the root table use an empty section name.
+		std::unordered_map<std::string, std::shared_ptr<SDocumentSection>> sections;
+	};
+
+	//! Text of a lazily opened document with byte ranges of its top-level tables, never modified after the document
+	//! was opened so that clones of the document share it (see \ref SDocument::unparsedLazyTables).
+	struct SLazySource
+	{
+		//! Original text of the document.
+		std::string text;
+
+		//! Names of top-level tables in the order of their first appearance in \ref text.
+		std::vector<std::string> tableOrder;
+
+		//! Top-level tables (table name -> byte ranges [begin, end) of \ref text that define the table).
+		std::unordered_map<std::string, std::vector<std::pair<size_t, size_t>>> tableRanges;
+	};
+
+	//! File that a document was read from, used to save the document by patching the file text
+	//! (see \ref GetPatchedDocumentText).
+	struct SDocumentSource
+	{
+		//! Path to the file.
+		std::filesystem::path filePath;
+
+		//! Size and last write time of the file when the document was read.
+		std::pair<std::uint64_t, std::int64_t> fileVersion;
+
+		//! Text of the file, empty if the document was not parsed from the text (the file is read again when saving).
+		std::string_view text;
+
+		//! Owner of \ref text (the text that parsed values point to), nullptr if the document has no text.
+		std::shared_ptr<const void> pTextOwner;
+	};
+
+	//! Replacement of a part of a document file text.
+	struct STextPatch
+	{
+		//! Offset of the first replaced character.
+		size_t begin = 0;
+
+		//! Offset after the last replaced character.
+		size_t end = 0;
+
+		//! New text.
+		std::string text;
+	};
+
+	//! Save journal of a document (see \ref EnableSaveJournal).
+	struct SSaveJournal
+	{
+		//! Opened journal file (shared with \ref m_pendingJournalFlushes).
+		std::shared_ptr<CTomlJournal> pJournal;
+
+		//! Directory of the document file.
+		std::filesystem::path directoryPath;
+
+		//! Name of the document file without extension.
+		std::string fileName;
+
+		//! Size of the journal after which the document is compacted.
+		size_t compactionSize = 0;
+
+		//! Whether the document is queued to be compacted (see \ref m_pendingCompactions).
+		bool bCompactionQueued = false;
+	};
+
+	//! Hot reload of a document (see \ref EnableHotReload).
+	struct SHotReload
+	{
+		//! Path to the document file.
+		std::filesystem::path filePath;
+
+		//! Called after the document was updated, can be empty.
+		DocumentReloadedCallback callback;
+
+		//! Number of the last requested reload, results of older reloads are ignored.
+		size_t reloadNumber = 0;
+	};
+
+	//! Document that a reloaded file is compared with (see \ref RequestHotReload).
+	struct SHotReloadTarget
+	{
+		//! Document to update.
+		int documentId = -1;
+
+		//! Number of the reload (see \ref SHotReload::reloadNumber).
+		size_t reloadNumber = 0;
+
+		//! Revision of the document when its content was taken.
+		size_t revision = 0;
+
+		//! Content of the document (its sections are shared, see \ref ShareDocumentContent), empty if the document is frozen.
+		SDocumentContent content;
+
+		//! Content of a frozen document.
+		std::shared_ptr<const CTomlFrozenDocument> pFrozenDocument;
+	};
+
+	//! File that was reloaded and compared with a document on a worker thread.
+	struct SHotReloadResult
+	{
+		//! The document and its content that was compared with the file.
+		SHotReloadTarget target;
+
+		//! Path to the file.
+		std::filesystem::path filePath;
+
+		//! Data parsed from the file, nullptr if failed to parse the file.
+		std::shared_ptr<const toml::value> pData;
+
+		//! Values that differ (section name and key name, sections that were added, removed or replaced
+		//! are root keys).
+		std::vector<std::pair<std::string, std::string>> changedKeys;
+	};
+
+	//! Results of hot reloads that are waiting for \ref UpdateHotReload (shared with worker tasks).
+	struct SHotReloadQueue
+	{
+		//! Finished reloads.
+		std::vector<SHotReloadResult> results;
+
+		//! Mutex for \ref results.
+		std::mutex mtxResults;
+	};
+
+	//! Layers of a layered document.
+	struct SLayers
+	{
+		//! IDs of layer documents (bottom layer first).
+		std::vector<int> documentIds;
+
+		//! Revisions of layer documents when \ref resolvedLayers was filled (see \ref FindValueLayer).
+		std::vector<size_t> revisions;
+
+		//! Cached lookups (section name -> key name -> ID of the top-most layer that has the value, empty if no layer has it).
+		std::unordered_map<std::string, std::unordered_map<std::string, std::optional<int>>> resolvedLayers;
+
+		//! Revisions of layer documents when the layered document's revision was last checked (see \ref GetDocumentRevision),
+		//! the revision of the layered document is incremented when they differ.
+		std::vector<size_t> checkedRevisions;
+	};
+
+	//! Callback registered with \ref Subscribe, shared with queued notifications (see \ref m_pendingNotifications).
+	struct SSubscription
+	{
+		//! ID of the subscription.
+		size_t id = 0;
+
+		//! Callback to call.
+		ValueChangedCallback callback;
+
+		//! Whether the callback can be called, cleared when the subscription is removed (protected by \ref m_mtxNotifications).
+		bool bActive = true;
+	};
+
+	//! Describes a registered TOML document.
+	struct SDocument
+	{
+		//! Document's TOML data (empty while the document is frozen or layered).
+		SDocumentContent content;
+
+		//! Sections of \ref content that are shared with other documents or the document cache (see \ref ShareDocumentContent),
+		//! a shared section is never modified, it's copied on the first modification instead (see \ref GetSectionForModification).
+		std::unordered_set<std::string> sharedSectionNames;
+
+		//! Incremented every time the document is modified.
+		size_t revision = 0;
+
+		//! Last modifications of the document (oldest first), stores at most \ref m_maxChangeJournalSize entries.
+		std::deque<SValueChange> changeJournal;
+
+		//! Source of a lazily opened document (see \ref OpenDocumentLazy), nullptr if all tables are parsed.
+		//! Shared with clones of the document.
+		std::shared_ptr<const SLazySource> pLazySource;
+
+		//! Tables of \ref pLazySource that were not parsed yet, empty if \ref pLazySource is nullptr.
+		std::unordered_set<std::string> unparsedLazyTables;
+
+		//! Frozen content of the document (see \ref FreezeDocument), nullptr if the document is not frozen. While set,
+		//! \ref content is empty and values are read from the frozen buffer.
+		std::shared_ptr<const CTomlFrozenDocument> pFrozenDocument;
+
+		//! File a partially opened document was read from (see \ref OpenDocumentPartial), the document is not saved
+		//! to this file. Empty if the document has all values of its file.
+		std::filesystem::path partialFilePath;
+
+		//! Layers of a layered document (see \ref CreateLayeredDocument), nullptr if the document is not layered.
+		std::unique_ptr<SLayers> pLayers;
+
+		//! File the document was read from (see \ref SetDocumentSource), nullptr if the document was not read from a file
+		//! or was opened lazily (see \ref OpenDocumentLazy).
+		std::shared_ptr<const SDocumentSource> pSource;
+
+		//! Keys modified since the document was read from \ref pSource (section name -> key names, replaced sections
+		//! are root keys), only these values are compared when the file text is patched.
+		std::unordered_map<std::string, std::unordered_set<std::string>> modifiedSourceKeys;
+
+		//! Save journal of the document (see \ref EnableSaveJournal), nullptr if the document is not journaled.
+		std::unique_ptr<SSaveJournal> pSaveJournal;
+
+		//! Hot reload of the document (see \ref EnableHotReload), nullptr if the document is not reloaded.
+		std::unique_ptr<SHotReload> pHotReload;
+
+		//! Observers of the document's values (section name -> key name -> subscription ID -> subscription).
+		//! Keys of the root table use an empty section name.
+		std::unordered_map<std::string, std::unordered_map<std::string, std::unordered_map<size_t, std::shared_ptr<SSubscription>>>> subscriptions;
+	};
+
+	//! Array of a frozen document.
+	struct SFrozenArray
+	{
+		//! Frozen document that contains the array.
+		const CTomlFrozenDocument* pFrozenDocument = nullptr;
+
+		//! The array.
+		CTomlFrozenDocument::SValue array;
+	};
+
+	//! Checks whether T is an std::vector of numbers/booleans that can be stored as a packed array.
+	template<typename T>
+	struct IsPackableArray : std::false_type {};
+
+	//! Checks whether T is an std::vector of numbers/booleans that can be stored as a packed array.
+	template<typename T, typename Alloc>
+	struct IsPackableArray<std::vector<T, Alloc>> : std::is_arithmetic<T> {};
+
+	//! Returns index of the PackedArray alternative that stores elements of type T.
+	//! 
+	//! \return Index of the alternative.
+	template<typename T>
+	static constexpr size_t GetPackedArrayIndex();
+
+	//! Converts values of a container to a packed array.
+	//! 
+	//! \param values Values to pack (moved without conversion if the type matches the packed storage).
+	//! 
+	//! \return Packed array.
+	template<typename T>
+	static PackedArray PackValues(T values);
+
+	//! Converts a packed array to the specified type.
+	//! 
+	//! \param packedArray Array to convert.
+	//! 
+	//! \return Error if the type of the array elements differs from T, otherwise converted value.
+	template<typename T>
+	static std::variant<T, GetValueError> GetPackedArrayValue(const PackedArray& packedArray);
+
+	//! Converts elements of a packed array in one tight (vectorizable) loop.
+	//! 
+	//! \param pSource      Elements to convert.
+	//! \param pDestination Buffer to write converted elements to.
+	//! \param count        Number of elements to convert.
+	template<typename From, typename To>
+	static void CopyPackedElements(const From* pSource, To* pDestination, size_t count);
+
+	//! Converts elements of an array to the specified type.
+	//! 
+	//! \param array                   Array to convert.
+	//! \param output                  Pointer or vector (already resized) to write elements to.
+	//! \param pMismatchedElementIndex Optional. If an element has wrong type its index will be written here.
+	//! 
+	//! \return Error if something went wrong.
+	template<typename T, typename Output>
+	static std::optional<GetArrayError> ConvertArrayElements(const toml::array& array, Output& output, size_t* pMismatchedElementIndex);
+
+	//! Converts elements of a packed array to the specified type.
+	//! 
+	//! \param packedArray             Array to convert.
+	//! \param output                  Pointer or vector (already resized) to write elements to.
+	//! \param pMismatchedElementIndex Optional. If elements have wrong type 0 will be written here.
+	//! 
+	//! \return Error if something went wrong.
+	template<typename T, typename Output>
+	static std::optional<GetArrayError> ConvertPackedElements(const PackedArray& packedArray, Output& output, size_t* pMismatchedElementIndex);
+
+	//! Converts elements of an array of a frozen document to the specified type.
+	//! 
+	//! \param frozenArray             Array to convert.
+	//! \param output                  Pointer or vector (already resized) to write elements to.
+	//! \param pMismatchedElementIndex Optional. If an element has wrong type its index will be written here.
+	//! 
+	//! \return Error if something went wrong.
+	template<typename T, typename Output>
+	static std::optional<GetArrayError> ConvertFrozenElements(const SFrozenArray& frozenArray, Output& output, size_t* pMismatchedElementIndex);
+
+	//! Reads a value of a frozen document.
+	//! 
+	//! \param frozenDocument Document to read.
+	//! \param keyName        Name of the key of the value.
+	//! \param sectionName    Section name of the value (can be empty).
+	//! 
+	//! \return Error if something went wrong, otherwise found value.
+	template<typename T>
+	static std::variant<T, GetValueError> GetFrozenValue(
+		const CTomlFrozenDocument& frozenDocument, const std::string& keyName, const std::string& sectionName);
+
+	//! Checks whether TOML array can be converted to a packed array (it's homogeneous, numeric or boolean and large enough).
+	//! 
+	//! \param array Array to check.
+	//! 
+	//! \return 'true' if the array can be packed, 'false' otherwise.
+	static bool CanPackArray(const toml::array& array);
+
+	//! Converts TOML array to a packed array if the array is homogeneous and large enough.
+	//! 
+	//! \param array Array to convert.
+	//! 
+	//! \return Empty if the array can't be packed, otherwise packed array.
+	static std::optional<PackedArray> TryPackArray(const toml::array& array);
+
+	//! Converts a packed array to TOML array.
+	//! 
+	//! \param packedArray Array to convert.
+	//! 
+	//! \return TOML array.
+	static toml::value UnpackArray(const PackedArray& packedArray);
+
+	//! Scans a directory for documents (see \ref GetAllDocuments).
+	//! 
+	//! \param directoryPath   Directory of the documents.
+	//! \param bRestoreBackups Whether to restore missing files from their backups.
+	//! 
+	//! \return Document names (without extensions) in directory order, empty if the directory does not exist.
+	static std::vector<std::string> ScanDocumentDirectory(const std::filesystem::path& directoryPath, bool bRestoreBackups);
+
+	//! Returns path to a document file to open (restores the file from backup and applies its save journal if needed).
+	//! 
+	//! \param fileName      Name of the file without ".toml" extension for the document.
+	//! \param directoryName Usually your game name. Directory for file (will be appended to the base path).
+	//! 
+	//! \return Error if something went wrong, otherwise path to existing document file.
+	static std::variant<std::filesystem::path, OpenDocumentError> GetDocumentFileToOpen(const std::string& fileName, const std::string& directoryName);
+
+	//! Reads metadata index of a directory.
+	//! 
+	//! \param directoryPath Directory of the documents.
+	//! 
+	//! \remark The index is loaded from its binary snapshot (see \ref ReadDocumentSnapshot) if the index was not
+	//! modified since the snapshot was written.
+	//! 
+	//! \return Index table (name of the indexed section and table of documents: document name -> metadata table),
+	//! without documents if the index does not exist or is corrupted.
+	static toml::value ReadMetadataIndex(const std::filesystem::path& directoryPath);
+
+	//! Writes metadata index of a directory.
+	//! 
+	//! \param directoryPath Directory of the documents.
+	//! \param index         Index table (see \ref ReadMetadataIndex).
+	static void WriteMetadataIndex(const std::filesystem::path& directoryPath, const toml::value& index);
+
+	//! Updates document's entry in the metadata index of a directory.
+	//! 
+	//! \param directoryPath Directory of the documents.
+	//! \param sectionName   Name of the metadata section of the document, the entry is removed (and read again
+	//! when the index is opened) if the index stores another section or the name is empty.
+	//! \param fileName      Name of the document file without extension.
+	//! \param pMetadata     Document's metadata table, nullptr if the document has no metadata section.
+	static void UpdateMetadataIndex(const std::filesystem::path& directoryPath, const std::string& sectionName, const std::string& fileName,
+		const toml::value* pMetadata);
+
+	//! Reads binary snapshot of a document file (see \ref CTomlBinarySnapshot).
+	//! 
+	//! \param filePath Path to the document file.
+	//! 
+	//! \return Empty if there is no valid snapshot for the current version of the file, otherwise TOML data.
+	static std::optional<toml::value> ReadDocumentSnapshot(const std::filesystem::path& filePath);
+
+	//! Writes binary snapshot of a document file (see \ref CTomlBinarySnapshot).
+	//! 
+	//! \param filePath Path to the document file.
+	//! \param data     TOML data parsed from the file.
+	static void WriteDocumentSnapshot(const std::filesystem::path& filePath, const toml::value& data);
+
+	//! Removes binary snapshot and frozen buffer of a document file (if exist).
+	//! 
+	//! \param filePath Path to the document file.
+	static void RemoveDocumentSnapshot(const std::filesystem::path& filePath);
+
+	//! Applies a save journal left by a process that did not close its document (see \ref EnableSaveJournal)
+	//! to the document file and removes the journal.
+	//! 
+	//! \param directoryPath Directory of the document file.
+	//! \param fileName      Name of the document file without extension.
+	static void RecoverSaveJournal(const std::filesystem::path& directoryPath, const std::string& fileName);
+
+	//! Writes the whole document to the file of its save journal and clears the journal. The file is written
+	//! without locking documents (unless the caller holds the lock), changes made meanwhile stay in the journal.
+	//! 
+	//! \param documentId Document with the save journal.
+	//! 
+	//! \return 'false' if failed to write the file or to clear the journal, 'true' otherwise.
+	bool WriteSaveJournalDocument(int documentId);
+
+	//! Copies an element of an array of a document (packed arrays included).
+	//! 
+	//! \param document    Document to read.
+	//! \param keyName     Name of the key of the array.
+	//! \param sectionName Section name of the array (can be empty).
+	//! \param index       Index of the element.
+	//! 
+	//! \return Empty if there is no such element, otherwise copy of the element.
+	static std::optional<toml::value> CopyDocumentElement(const SDocument& document, const std::string& keyName, const std::string& sectionName, size_t index);
+
+	//! Copies a value of a document (packed arrays of the value are unpacked, a section includes its packed arrays).
+	//! 
+	//! \param document    Document that contains the value.
+	//! \param keyName     Name of the key of the value.
+	//! \param sectionName Section name of the value (can be empty).
+	//! 
+	//! \return Empty if the value does not exist, otherwise the value.
+	static std::optional<toml::value> CopyDocumentValue(const SDocument& document, const std::string& keyName, const std::string& sectionName);
+
+	//! Marks all sections of a document as shared so that its content can be referenced by other documents or
+	//! the document cache without copying (frozen content is shared as is).
+	//! 
+	//! \param document Document to share.
+	static void ShareDocumentContent(SDocument& document);
+
+	//! Splits TOML data into sections (tables of the root table become sections, other root key/values
+	//! are stored in the section with an empty name).
+	//! 
+	//! \param data TOML data (the root table).
+	//! 
+	//! \return Content with the data, empty if the data is not a table.
+	static SDocumentContent CreateDocumentContent(toml::value data);
+
+	//! Replaces content of a document with TOML data (see \ref CreateDocumentContent).
+	//! 
+	//! \param document Document to modify.
+	//! \param data     New TOML data of the document.
+	static void SetDocumentData(SDocument& document, toml::value data);
+
+	//! Returns TOML data of the whole document (packed arrays are unpacked).
+	//! 
+	//! \param document Document to convert.
+	//! 
+	//! \return Uninitialized value if the document has no data, otherwise the root table.
+	static toml::value GetDocumentData(const SDocument& document);
+
+	//! Returns a section of a document to read it.
+	//! 
+	//! \param document    Document that contains the section.
+	//! \param sectionName Name of the section (empty for key/values of the root table).
+	//! 
+	//! \return nullptr if the document has no such section, valid pointer otherwise.
+	static const SDocumentSection* FindSection(const SDocument& document, const std::string& sectionName);
+
+	//! Returns a section of a document to modify it, copies the section if it's shared with other documents
+	//! (see \ref SDocument::sharedSectionNames).
+	//! 
+	//! \param document    Document that contains the section.
+	//! \param sectionName Name of the section (empty for key/values of the root table).
+	//! 
+	//! \return The section (an empty section is added if the document has no such section).
+	static SDocumentSection& GetSectionForModification(SDocument& document, const std::string& sectionName);
+
+	//! Looks for a value of a document that is stored in TOML data (not in a packed array).
+	//! 
+	//! \param document    Document to look in.
+	//! \param keyName     Name of the key of the value (a root key can refer to a section).
+	//! \param sectionName Section name of the value (can be empty).
+	//! 
+	//! \return nullptr if the value does not exist, valid pointer otherwise (a section does not contain its packed arrays).
+	static const toml::value* FindDocumentValue(const SDocument& document, const std::string& keyName, const std::string& sectionName);
+
+	//! Checks whether a root key of a document refers to a value that is not a section (packed arrays included).
+	//! 
+	//! \param document Document to look in.
+	//! \param keyName  Name of the root key.
+	//! 
+	//! \return 'true' if the key has a value that is not a section, 'false' otherwise.
+	static bool IsRootValue(const SDocument& document, const std::string& keyName);
+
+	//! Checks whether a document was opened partially from a file (see \ref SDocument::partialFilePath).
+	//! 
+	//! \param document Document to check.
+	//! \param filePath Path to the file.
+	//! 
+	//! \return 'true' if the document doesn't have all values of the file, 'false' otherwise.
+	static bool IsPartialDocumentFile(const SDocument& document, const std::filesystem::path& filePath);
+
+	//! Starts reloading a file on a worker thread for documents that are hot reloaded from it.
+	//! 
+	//! \param filePath    Modified file.
+	//! \param pData       Data parsed from the file, nullptr to parse the file.
+	//! \param pDocumentId Optional. Reload only this document.
+	void RequestHotReload(const std::filesystem::path& filePath, std::shared_ptr<const toml::value> pData, const int* pDocumentId = nullptr);
+
+	//! Applies a reloaded file to its document.
+	//! 
+	//! \param result        Reloaded file.
+	//! \param notifications Callback of the document and the applied changes (if the document was updated).
+	//! 
+	//! \return 'true' if the document was updated, 'false' otherwise.
+	bool ApplyHotReload(const SHotReloadResult& result,
+		std::vector<std::tuple<DocumentReloadedCallback, int, std::vector<SValueChange>>>& notifications);
+
+	//! Compares document's content with new TOML data (keys of sections and the root table).
+	//! 
+	//! \param content Content of the document.
+	//! \param data    New TOML data.
+	//! 
+	//! \return Values that differ (section name and key name, sections that were added, removed or replaced
+	//! are root keys), sorted.
+	static std::vector<std::pair<std::string, std::string>> GetChangedKeys(const SDocumentContent& content, const toml::value& data);
+
+	//! Checks whether two values are equal (comments and string kinds are ignored).
+	//! 
+	//! \param first  First value.
+	//! \param second Second value.
+	//! 
+	//! \return 'true' if the values are equal, 'false' otherwise.
+	static bool IsSameValue(const toml::value& first, const toml::value& second);
+
+	//! Adds operations that turn values of one document content into values of another one to a patch.
+	//! 
+	//! \param content      Content of the document that is patched.
+	//! \param otherContent Content of the document to compare with.
+	//! \param patch        Patch to add operations to.
+	static void DiffContents(const SDocumentContent& content, const SDocumentContent& otherContent, CTomlPatch& patch);
+
+	//! Adds operations that turn values of one document into values of another one to a patch when one of the documents
+	//! is frozen: root keys are compared by reading the frozen buffer and only differing ones are converted to be diffed.
+	//! 
+	//! \param pFrozenDocument      Frozen content of the document that is patched, nullptr if the document is not frozen.
+	//! \param content              Content of the document that is patched (if it is not frozen).
+	//! \param pOtherFrozenDocument Frozen content of the document to compare with, nullptr if the document is not frozen.
+	//! \param otherContent         Content of the document to compare with (if it is not frozen).
+	//! \param patch                Patch to add operations to.
+	static void DiffFrozenDocuments(const CTomlFrozenDocument* pFrozenDocument, const SDocumentContent& content,
+		const CTomlFrozenDocument* pOtherFrozenDocument, const SDocumentContent& otherContent, CTomlPatch& patch);
+
+	//! Checks whether a frozen value is equal to a TOML value (see \ref IsSameValue).
+	//! 
+	//! \param frozenDocument Frozen document that contains the frozen value.
+	//! \param frozenValue    Frozen value.
+	//! \param value          TOML value.
+	//! 
+	//! \return 'true' if the values are equal, 'false' otherwise.
+	static bool IsSameFrozenValue(const CTomlFrozenDocument& frozenDocument, const CTomlFrozenDocument::SValue& frozenValue, const toml::value& value);
+
+	//! Checks whether a frozen value is equal to a packed array.
+	//! 
+	//! \param frozenDocument Frozen document that contains the frozen value.
+	//! \param frozenValue    Frozen value.
+	//! \param packedArray    Packed array.
+	//! 
+	//! \return 'true' if the values are equal, 'false' otherwise.
+	static bool IsSameFrozenArray(const CTomlFrozenDocument& frozenDocument, const CTomlFrozenDocument::SValue& frozenValue, const PackedArray& packedArray);
+
+	//! Adds operations that turn a value into another one to a patch.
+	//! 
+	//! \param sectionName       Section name of the value (can be empty).
+	//! \param keyName           Name of the key of the value.
+	//! \param pValue            The value, nullptr if it's packed or does not exist.
+	//! \param pPackedArray      The value if it's packed, nullptr otherwise.
+	//! \param pOtherValue       The new value, nullptr if it's packed or does not exist.
+	//! \param pOtherPackedArray The new value if it's packed, nullptr otherwise.
+	//! \param patch             Patch to add operations to.
+	static void DiffValues(const std::string& sectionName, const std::string& keyName, const toml::value* pValue, const PackedArray* pPackedArray,
+		const toml::value* pOtherValue, const PackedArray* pOtherPackedArray, CTomlPatch& patch);
+
+	//! Adds operations that turn an array into another one to a patch: equal elements at the beginning and
+	//! at the end are skipped, differing elements between them are overwritten and the rest are inserted or erased.
+	//! 
+	//! \param sectionName Section name of the array (can be empty).
+	//! \param keyName     Name of the key of the array.
+	//! \param array       The array.
+	//! \param otherArray  The new array.
+	//! \param isSame      Compares elements of the arrays.
+	//! \param toValue     Converts an element of the new array to TOML value.
+	//! \param patch       Patch to add operations to.
+	//! 
+	//! \return 'false' if the operations would be larger than the new array (nothing is added), 'true' otherwise.
+	template<typename Array, typename OtherArray, typename IsSame, typename ToValue>
+	static bool DiffArrays(const std::string& sectionName, const std::string& keyName, const Array& array, const OtherArray& otherArray,
+		IsSame isSame, ToValue toValue, CTomlPatch& patch);
+
+	//! Sets a value of a document (large numeric arrays are packed, tables of the root table become sections).
+	//! 
+	//! \param document    Document to modify.
+	//! \param keyName     Name of the key of the value.
+	//! \param sectionName Section name of the value (can be empty).
+	//! \param value       New value.
+	static void SetDocumentValue(SDocument& document, const std::string& keyName, const std::string& sectionName, toml::value value);
+
+	//! Replaces a value of a document (see \ref SetDocumentValue).
+	//! 
+	//! \param document    Document to modify.
+	//! \param keyName     Name of the key of the value.
+	//! \param sectionName Section name of the value (can be empty).
+	//! \param pValue      New value (a table for a section), nullptr to remove the value.
+	static void ReplaceDocumentValue(SDocument& document, const std::string& keyName, const std::string& sectionName, const toml::value* pValue);
+
+	//! Converts document's data to TOML text.
+	//! 
+	//! \param document Document to convert.
+	//! 
+	//! \remark If the document was read from a file and only values were modified, the file text is patched
+	//! (see \ref GetPatchedDocumentText) so formatting and comments of the file are kept.
+	//! 
+	//! \return Text of the document (tables of a lazily opened document that were not parsed are copied from its source).
+	static std::string GetDocumentText(const SDocument& document);
+
+	//! Remembers the file that a document was read from so that saving the document patches the file text.
+	//! 
+	//! \param document    Document that was read.
+	//! \param filePath    Path to the file.
+	//! \param pParsedData Data parsed from the file text (only the text is kept), nullptr if the data was not parsed
+	//! from the whole text (read from a snapshot or parsed in parallel).
+	static void SetDocumentSource(SDocument& document, const std::filesystem::path& filePath, const toml::value* pParsedData);
+
+	//! Creates text of a document by replacing the modified values in the text of the file the document was read from.
+	//! 
+	//! \param document Document to convert.
+	//! 
+	//! \remark Only the root key/values and top-level tables that have modified values are parsed again
+	//! (see \ref SDocument::modifiedSourceKeys), the text of an unmodified document is returned as is.
+	//! 
+	//! \return Empty if the document was not read from a file, the file was modified since then (if the document
+	//! has no text) or the structure of the document changed (a table was added/removed or a value of
+	//! a [table] section was replaced), otherwise text of the document.
+	static std::optional<std::string> GetPatchedDocumentText(const SDocument& document);
+
+	//! Collects replacements of modified values of a table/array (recursively).
+	//! 
+	//! \param parsedValue Value parsed from the file text.
+	//! \param value       Current value.
+	//! \param sourceText  Text that parsed values point to.
+	//! \param patches     Collected replacements.
+	//! 
+	//! \return 'false' if the text can't be patched (the structure changed).
+	static bool CollectTextPatches(const toml::value& parsedValue, const toml::value& value, const std::vector<char>& sourceText,
+		std::vector<STextPatch>& patches);
+
+	//! Collects replacement of the whole text of a value.
+	//! 
+	//! \param parsedValue Value parsed from the file text.
+	//! \param value       New value.
+	//! \param sourceText  File text that parsed values point to.
+	//! \param patches     Collected replacements.
+	//! 
+	//! \return 'false' if the value is not written inline (a [table] section or an array of tables).
+	static bool CollectValueReplacement(const toml::value& parsedValue, const toml::value& value, const std::vector<char>& sourceText,
+		std::vector<STextPatch>& patches);
+
+	//! Checks whether two values are equal booleans, numbers, strings or dates (comments and string kinds are ignored).
+	//! 
+	//! \param first  First value.
+	//! \param second Second value.
+	//! 
+	//! \return 'false' if the values are different or are not scalars, 'true' otherwise.
+	static bool IsSameScalar(const toml::value& first, const toml::value& second);
+
+	//! Returns directory path to store config files.
+	//! 
+	//! \return Empty if something went wrong (see logs), otherwise directory path,
+	//! "%localappdata%" on Windows, "%HOME%/.config" on Linux.
+	static std::optional<std::filesystem::path> GetDirectoryForConfigs();
+
+	//! Returns registered document.
+	//! 
+	//! \param documentId Document to look for.
+	//! 
+	//! \return nullptr if no document was registered for the specified ID, valid pointer otherwise.
+	SDocument* GetDocument(int documentId);
+
+	//! Returns registered document to modify it, converts frozen content back to TOML data (shared sections are copied
+	//! when they are modified, see \ref GetSectionForModification).
+	//! 
+	//! \param documentId Document to look for.
+	//! 
+	//! \return nullptr if no document was registered for the specified ID, valid pointer otherwise.
+	SDocument* GetDocumentForModification(int documentId);
+
+	//! Converts frozen content (see \ref FreezeDocument) of a document back to TOML data so that it can be modified.
+	//! 
+	//! \param document Document to convert.
+	static void UnfreezeDocument(SDocument& document);
+
+	//! Returns ID of the document that receives writes to the specified document (top layer of a layered document).
+	//! 
+	//! \param documentId Document to write to.
+	//! 
+	//! \return ID of the top layer if the document is layered, otherwise the specified ID.
+	int GetWriteDocumentId(int documentId);
+
+	//! Looks for the top-most layer of a layered document that has the specified value (uses cached lookups).
+	//! 
+	//! \param layers      Layers of the document.
+	//! \param keyName     Name of the key of the value.
+	//! \param sectionName Section name of the value (can be empty).
+	//! 
+	//! \return Empty if no layer has the value, otherwise ID of the layer document.
+	std::optional<int> FindValueLayer(SLayers& layers, const std::string& keyName, const std::string& sectionName);
+
+	//! Checks whether a document has the specified value.
+	//! 
+	//! \param document    Document to look in (not layered).
+	//! \param keyName     Name of the key of the value.
+	//! \param sectionName Section name of the value (can be empty).
+	//! 
+	//! \return 'true' if the value exists, 'false' otherwise.
+	static bool ContainsValue(SDocument& document, const std::string& keyName, const std::string& sectionName);
+
+	//! Looks for a parsed document file in the document cache and makes a document share the cached content.
+	//! 
+	//! \param filePath Path to the document file.
+	//! \param document Document to set the cached content and source to.
+	//! 
+	//! \return 'false' if the file is not cached or was modified since it was cached, 'true' otherwise.
+	bool FindCachedDocument(const std::filesystem::path& filePath, SDocument& document);
+
+	//! Adds a parsed document to the document cache and makes the document share its content with the cache.
+	//! 
+	//! \param filePath Path to the document file.
+	//! \param document Parsed document (not opened lazily).
+	void AddCachedDocument(const std::filesystem::path& filePath, SDocument& document);
+
+	//! Removes a document file from the document cache (if cached).
+	//! 
+	//! \param filePath Path to the document file.
+	void RemoveCachedDocument(const std::filesystem::path& filePath);
+
+	//! Removes least recently used documents from the document cache until it fits the memory limit.
+	//! 
+	//! \remark Expects \ref m_mtxDocumentCache to be locked.
+	void TrimDocumentCache();
+
+	//! Estimates memory used by a parsed document.
+	//! 
+	//! \param content Parsed document.
+	//! 
+	//! \return Approximate size in bytes.
+	static size_t EstimateMemorySize(const SDocumentContent& content);
+
+	//! Returns worker threads of the manager (starts them on first call).
+	//! 
+	//! \return Worker threads.
+	CTomlWorkerPool& GetWorkerPool();
+
+	//! Parses top-level table of a lazily opened document (if it was not parsed yet).
+	//! 
+	//! \param document  Document that contains the table.
+	//! \param tableName Name of the top-level table.
+	static void ParseLazyTable(SDocument& document, const std::string& tableName);
+
+	//! Parses text of a top-level table of a lazily opened document.
+	//! 
+	//! \param lazySource Source of the document.
+	//! \param tableName  Name of the top-level table.
+	//! 
+	//! \return Empty if the table is parsed already or failed to parse, otherwise parsed table text (a root table).
+	static std::optional<toml::value> ParseLazyTableText(const SLazySource& lazySource, const std::string& tableName);
+
+	//! Adds values of a parsed top-level table to a document.
+	//! 
+	//! \param document  Document to add the values to.
+	//! \param tableData Parsed table text (see \ref ParseLazyTableText).
+	static void MergeLazyTable(SDocument& document, toml::value tableData);
+
+	//! Returns content of a lazily opened document with all of its tables without parsing them into the document.
+	//! 
+	//! \param document Lazily opened document.
+	//! 
+	//! \return Content that shares unmodified sections with the document (valid while the document is not modified).
+	static SDocumentContent GetLazyDocumentContent(const SDocument& document);
+
+	//! Parses all tables of a lazy document.
+	//! 
+	//! \param document Document to parse.
+	static void ParseAllLazyTables(SDocument& document);
+
+	//! Looks for a packed array to read it (parses the top-level table of the array if the document is opened lazily).
+	//! 
+	//! \param document    Document to look in.
+	//! \param keyName     Name of the key of the array.
+	//! \param sectionName Section name of the array (can be empty).
+	//! 
+	//! \return nullptr if there is no packed array for the specified key/section, valid pointer otherwise.
+	static const PackedArray* FindPackedArrayForReading(SDocument& document, const std::string& keyName, const std::string& sectionName);
+
+	//! Looks for a packed array to modify it (copies the section of the array if it's shared and parses the top-level
+	//! table of the array if the document is opened lazily).
+	//! 
+	//! \param document    Document to look in.
+	//! \param keyName     Name of the key of the array.
+	//! \param sectionName Section name of the array (can be empty).
+	//! 
+	//! \return nullptr if there is no packed array for the specified key/section, valid pointer otherwise.
+	static PackedArray* FindPackedArrayForModification(SDocument& document, const std::string& keyName, const std::string& sectionName);
+
+	//! Moves a packed array (if exists) back to document's TOML data.
+	//! 
+	//! \param document    Document that contains the array.
+	//! \param keyName     Name of the key of the array.
+	//! \param sectionName Section name of the array (can be empty).
+	static void UnpackDocumentArray(SDocument& document, const std::string& keyName, const std::string& sectionName);
+
+	//! Converts all large enough homogeneous arrays of a section to packed arrays.
+	//! 
+	//! \param section Section to pack.
+	static void PackSectionArrays(SDocumentSection& section);
+
+	//! Converts all large enough homogeneous arrays of document's root table and sections to packed arrays
+	//! (only sections that have such arrays are copied if they are shared).
+	//! 
+	//! \param document Document to pack.
+	static void PackDocumentArrays(SDocument& document);
+
+	//! Prepares document for overwriting a value: removes the old value (the section with this name for a root key),
+	//! copies only the section that has the old value if it's shared.
+	//! 
+	//! \param document    Document to prepare.
+	//! \param keyName     Name of the key of the value.
+	//! \param sectionName Section name of the value (can be empty).
+	static void PrepareForOverwrite(SDocument& document, const std::string& keyName, const std::string& sectionName);
+
+	//! Should be called after a value of the document was modified,
+	//! updates document's revision and change journal and queues notifications of observers (see \ref CModificationLock).
+	//! 
+	//! \param documentId  ID of the modified document.
+	//! \param document    Modified document.
+	//! \param keyName     Name of the key of the modified value.
+	//! \param sectionName Section name of the modified value (can be empty).
+	//! \param operation   How the value was modified, array operations are written to the save journal with
+	//! the changed element only.
+	//! \param index       Index of the changed element (array operations).
+	void MarkDocumentModified(int documentId, SDocument& document, const std::string& keyName, const std::string& sectionName,
+		CTomlPatch::EOperation operation = CTomlPatch::EOperation::SetValue, size_t index = 0);
+
+	//! Calls (or queues, see \ref CModificationLock) callbacks of observers of a modified value.
+	//! 
+	//! \param documentId     ID of the document to notify observers of.
+	//! \param document       Document to notify observers of.
+	//! \param keyName        Name of the key of the modified value.
+	//! \param sectionName    Section name of the modified value (can be empty).
+	//! \param isValueVisible Optional. Tells whether an observed value (section name, key name) shows the modification,
+	//! used by layered documents to skip values overridden by higher layers.
+	void NotifyValueObservers(int documentId, const SDocument& document, const std::string& keyName, const std::string& sectionName,
+		const std::function<bool(const std::string& observedSectionName, const std::string& observedKeyName)>& isValueVisible);
+
+	//! Calls the callback of a subscription unless the subscription was removed (see \ref Unsubscribe),
+	//! the call is registered in \ref m_runningNotifications while it runs.
+	//! 
+	//! \param subscription Subscription to notify.
+	//! \param documentId   ID of the modified document.
+	//! \param sectionName  Section name of the modified value (can be empty).
+	//! \param keyName      Name of the key of the modified value.
+	void CallValueObserver(SSubscription& subscription, int documentId, const std::string& sectionName, const std::string& keyName);
+
+	//! Marks subscriptions of a document as removed so that queued notifications are dropped.
+	//! 
+	//! \param document Document to remove subscriptions of.
+	void DeactivateSubscriptions(SDocument& document);
+
+	//! Looks for an array in document's TOML data to modify it in place.
+	//! 
+	//! \param documentId       Document to look in.
+	//! \param keyName          Name of the key of the array.
+	//! \param sectionName      Section name of the array (can be empty).
+	//! \param bCreateIfMissing Whether to create an empty array if there is no value for the specified key/section.
+	//! 
+	//! \return Error if something went wrong, otherwise pointer to the array.
+	std::variant<toml::array*, ArrayOperationError> GetArrayForModification(
+		int documentId, const std::string& keyName, const std::string& sectionName, bool bCreateIfMissing);
+
+	//! Looks for an array (TOML, packed or frozen) in a document to read its elements.
+	//! 
+	//! \param documentId  Document to look in.
+	//! \param keyName     Name of the key of the array.
+	//! \param sectionName Section name of the array (can be empty).
+	//! 
+	//! \return Error if something went wrong, otherwise pointer to the array or the frozen array.
+	std::variant<const toml::array*, const PackedArray*, SFrozenArray, GetArrayError> GetArrayForReading(
+		int documentId, const std::string& keyName, const std::string& sectionName);
+
+	//! Text that we add before log text.
+	static inline const auto m_logCategory = "TomlManager";
 
 	//! File extension used for backup files.
 	static inline const auto m_backupFileExtension = ".old";
 
+	//! File extension (appended to document's file name) of binary snapshots of documents.
+	static inline const auto m_snapshotFileExtension = ".cache";
+
+	//! File extension (appended to document's file name) of frozen buffers of documents (see \ref OpenFrozenDocument).
+	static inline const auto m_frozenFileExtension = ".frozen";
+
+	//! File extension (appended to document's file name) of save journals of documents (see \ref EnableSaveJournal).
+	static inline const auto m_saveJournalFileExtension = ".journal";
+
+	//! Default size of a save journal in bytes after which the whole document is written again.
+	static inline const size_t m_defaultSaveJournalCompactionSize = 1024 * 1024;
+
+	//! Default name of the document section that is stored in the metadata index.
+	static inline const auto m_defaultMetadataSectionName = "metadata";
+
+	//! Name of the key of the indexed section name in a metadata index.
+	static inline const auto m_metadataIndexSectionKeyName = "section";
+
+	//! Name of the table of documents in a metadata index.
+	static inline const auto m_metadataIndexDocumentsKeyName = "documents";
+
+	//! Name of the metadata index file (stored next to the documents).
+	static inline const auto m_metadataIndexFileName = "metadata.index";
+
+	//! Mutex for read/write operations on metadata index files.
+	static inline std::mutex m_mtxMetadataIndex;
+
+	//! Mutex for applying save journals left by stopped processes (see \ref RecoverSaveJournal).
+	static inline std::mutex m_mtxSaveJournalRecovery;
+
+	//! Minimum number of elements in a homogeneous array to store it as a packed array.
+	static inline const size_t m_minPackedArraySize = 16;
+
+	//! Maximum number of modifications stored in document's change journal.
+	static inline const size_t m_maxChangeJournalSize = 256;
+
 	//! Created but not saved yet TOML documents.
-	std::unordered_map<size_t, toml::value> m_tomlDocuments;
+	std::unordered_map<size_t, SDocument> m_tomlDocuments;
 
 	//! ID for the next created TOML document.
 	int m_nextTomlDocumentId = 0;
 
+	//! Layered documents of layer documents (layer document ID -> IDs of layered documents that use it),
+	//! used to notify observers of layered documents when a layer is modified.
+	std::unordered_map<int, std::vector<int>> m_layeredDocumentIds;
+
+	//! ID for the next subscription to value changes.
+	size_t m_nextSubscriptionId = 0;
+
 	//! Mutex for read/write operations on TOML documents and IDs.
 	std::recursive_mutex m_mtxTomlDocuments;
+
+	//! Name of the document section that is stored in the metadata index (protected by \ref m_mtxTomlDocuments).
+	std::string m_metadataSectionName = m_defaultMetadataSectionName;
+
+	//! Locks \ref m_mtxTomlDocuments to modify documents, work queued while documents are modified
+	//! (see \ref m_pendingJournalFlushes, \ref m_pendingCompactions and \ref m_pendingNotifications) is done after
+	//! the outermost lock is released.
+	class CModificationLock
+	{
+	public:
+		//! Constructor, locks documents.
+		//! 
+		//! \param manager Manager of the documents.
+		explicit CModificationLock(CTomlManager& manager);
+
+		CModificationLock(const CModificationLock&) = delete;
+		CModificationLock& operator=(const CModificationLock&) = delete;
+
+		//! Destructor, unlocks documents and does the queued work (observers are notified last).
+		~CModificationLock();
+
+	private:
+		//! Manager of the documents.
+		CTomlManager& m_manager;
+	};
+
+	//! Number of nested \ref CModificationLock of the thread that holds \ref m_mtxTomlDocuments.
+	size_t m_modificationLockDepth = 0;
+
+	//! Documents whose save journal has to be compacted when documents are unlocked
+	//! (protected by \ref m_mtxTomlDocuments).
+	std::vector<int> m_pendingCompactions;
+
+	//! Save journals (and IDs of their documents) with records that have to be flushed when documents are unlocked
+	//! (protected by \ref m_mtxTomlDocuments).
+	std::vector<std::pair<int, std::shared_ptr<CTomlJournal>>> m_pendingJournalFlushes;
+
+	//! Observers to notify when documents are unlocked: subscription, document ID, section name and key name
+	//! of the modified value (protected by \ref m_mtxTomlDocuments).
+	std::vector<std::tuple<std::shared_ptr<SSubscription>, int, std::string, std::string>> m_pendingNotifications;
+
+	//! Callbacks of observers that are running (subscription ID -> thread that runs the callback),
+	//! protected by \ref m_mtxNotifications.
+	std::unordered_multimap<size_t, std::thread::id> m_runningNotifications;
+
+	//! Mutex for \ref m_runningNotifications and \ref SSubscription::bActive, never held while documents are locked
+	//! by the same thread afterwards (documents are locked first).
+	std::mutex m_mtxNotifications;
+
+	//! Notified when a callback from \ref m_runningNotifications finishes.
+	std::condition_variable m_cvNotifications;
+
+	//! Worker threads for parallel operations, nullptr until first used (see \ref GetWorkerPool).
+	std::unique_ptr<CTomlWorkerPool> m_pWorkerPool;
+
+	//! Mutex for \ref m_pWorkerPool.
+	std::mutex m_mtxWorkerPool;
+
+	//! Watches files of hot reloaded documents, nullptr until first used (protected by \ref m_mtxTomlDocuments).
+	std::unique_ptr<CTomlFileWatcher> m_pFileWatcher;
+
+	//! Finished hot reloads.
+	std::shared_ptr<SHotReloadQueue> m_pHotReloadQueue = std::make_shared<SHotReloadQueue>();
+
+	//! Number of the next hot reload (protected by \ref m_mtxTomlDocuments).
+	size_t m_nextHotReloadNumber = 1;
+
+	//! Parsed document file in the document cache.
+	struct SCachedDocument
+	{
+		//! Size of the file when it was parsed.
+		std::uintmax_t fileSize = 0;
+
+		//! Last write time of the file when it was parsed.
+		std::filesystem::file_time_type lastWriteTime;
+
+		//! Parsed content.
+		std::shared_ptr<const SDocumentContent> pContent;
+
+		//! Text of the file (see \ref SDocument::pSource).
+		std::shared_ptr<const SDocumentSource> pSource;
+
+		//! Approximate memory used by the content (in bytes).
+		size_t memorySize = 0;
+
+		//! Position in \ref m_documentCacheUsage.
+		std::list<std::string>::iterator usageIt;
+	};
+
+	//! Parsed document files (file path -> cached document).
+	std::unordered_map<std::string, SCachedDocument> m_documentCache;
+
+	//! Paths of cached documents, most recently used first.
+	std::list<std::string> m_documentCacheUsage;
+
+	//! Statistics of the document cache.
+	SDocumentCacheStats m_documentCacheStats = { 0, 0, 0, 0, m_defaultDocumentCacheMemoryLimit };
+
+	//! Mutex for \ref m_documentCache, \ref m_documentCacheUsage and \ref m_documentCacheStats.
+	std::mutex m_mtxDocumentCache;
+
+	//! Default value of \ref SDocumentCacheStats::memoryLimit.
+	static inline const size_t m_defaultDocumentCacheMemoryLimit = 32 * 1024 * 1024;
+
+	//! Describes a cached listing of a directory.
+	struct SDocumentListing
+	{
+		//! Names of documents (sorted).
+		std::shared_ptr<const std::vector<std::string>> pDocumentNames;
+
+		//! Tells when the directory needs to be scanned again.
+		std::unique_ptr<CTomlDirectoryWatcher> pWatcher;
+	};
+
+	//! Cached listings of directories (directory name -> listing).
+	std::unordered_map<std::string, SDocumentListing> m_documentListings;
+
+	//! Mutex for \ref m_documentListings.
+	std::mutex m_mtxDocumentListings;
 };
 
 template<typename T>
-std::optional<CTomlManager::SetValueError> CTomlManager::SetValue(int documentId, const std::string& keyName, T value, const std::string& sectionName)
+std::optional<CTomlManager::SetValueError> CTomlManager::SetValue(int documentId, const std::string& keyName, T value, const std::string& sectionName)
+{
+	CModificationLock guard(*this);
+
+	// Layered documents are written to their top layer.
+	documentId = GetWriteDocumentId(documentId);
+
+	// Check that key is not empty.
+	if (keyName.empty())
+	{
+		return CTomlManager::SetValueError::KeyEmpty;
+	}
+
+	// Check that document exists.
+	if (!IsDocumentRegistered(documentId))
+	{
+		return CTomlManager::SetValueError::DocumentNotFound;
+	}
+
+	// Get document.
+	auto pDocument = GetDocumentForModification(documentId);
+
+	// Store large numeric arrays as packed arrays.
+	if constexpr (IsPackableArray<T>::value)
+	{
+		if (value.size() >= m_minPackedArraySize)
+		{
+			PrepareForOverwrite(*pDocument, keyName, sectionName);
+			GetSectionForModification(*pDocument, sectionName).packedArrays[keyName] = PackValues(std::move(value));
+			MarkDocumentModified(documentId, *pDocument, keyName, sectionName);
+			return {};
+		}
+	}
+
+	// Set value to TOML data.
+	SetDocumentValue(*pDocument, keyName, sectionName, toml::value(std::move(value)));
+
+	MarkDocumentModified(documentId, *pDocument, keyName, sectionName);
+
+	return {};
+}
+
+template<typename... Args>
+std::optional<CTomlManager::SetValueError> CTomlManager::EmplaceValue(int documentId, const std::string& keyName, const std::string& sectionName, Args&&... args)
+{
+	CModificationLock guard(*this);
+
+	// Layered documents are written to their top layer.
+	documentId = GetWriteDocumentId(documentId);
+
+	// Check that key is not empty.
+	if (keyName.empty())
+	{
+		return CTomlManager::SetValueError::KeyEmpty;
+	}
+
+	// Check that document exists.
+	if (!IsDocumentRegistered(documentId))
+	{
+		return CTomlManager::SetValueError::DocumentNotFound;
+	}
+
+	// Get document.
+	auto pDocument = GetDocumentForModification(documentId);
+
+	// Construct value and move it to the TOML data.
+	SetDocumentValue(*pDocument, keyName, sectionName, toml::value(std::forward<Args>(args)...));
+
+	MarkDocumentModified(documentId, *pDocument, keyName, sectionName);
+
+	return {};
+}
+
+template<typename T>
+std::variant<T, CTomlManager::GetValueError> CTomlManager::GetValue(int documentId, const std::string& keyName, const std::string& sectionName)
 {
 	std::scoped_lock guard(m_mtxTomlDocuments);
 
 	// Check that key is not empty.
 	if (keyName.empty())
 	{
-		return CTomlManager::SetValueError::KeyEmpty;
+		return CTomlManager::GetValueError::KeyEmpty;
 	}
 
 	// Check that document exists.
 	if (!IsDocumentRegistered(documentId))
 	{
-		return CTomlManager::SetValueError::DocumentNotFound;
+		return CTomlManager::GetValueError::DocumentNotFound;
 	}
 
-	// Get TOML data.
-	auto pTomlData = GetTomlData(documentId);
+	// Get document.
+	auto pDocument = GetDocument(documentId);
 
-	// Set value to TOML data.
+	// Read the value from the top-most layer that has it.
+	if (pDocument->pLayers != nullptr)
+	{
+		const auto optionalLayerId = FindValueLayer(*pDocument->pLayers, keyName, sectionName);
+		if (!optionalLayerId.has_value())
+		{
+			return CTomlManager::GetValueError::ValueNotFound;
+		}
+		return GetValue<T>(optionalLayerId.value(), keyName, sectionName);
+	}
+
+	// Read frozen documents directly from their buffer.
+	if (pDocument->pFrozenDocument != nullptr)
+	{
+		return GetFrozenValue<T>(*pDocument->pFrozenDocument, keyName, sectionName);
+	}
+
+	// Read packed arrays directly.
+	if (const auto pPackedArray = FindPackedArrayForReading(*pDocument, keyName, sectionName))
+	{
+		return GetPackedArrayValue<T>(*pPackedArray);
+	}
+
+	// Section name might refer to a value that is not a table.
+	if (!sectionName.empty() && IsRootValue(*pDocument, sectionName))
+	{
+		return CTomlManager::GetValueError::ValueTypeMismatch;
+	}
+
+	// Find the value in TOML data.
+	const toml::value* pValue = FindDocumentValue(*pDocument, keyName, sectionName);
+	if (pValue == nullptr)
+	{
+		return CTomlManager::GetValueError::ValueNotFound;
+	}
+
+	// The value might be a section that has packed arrays, read a copy that includes them (the document is not modified).
+	std::optional<toml::value> sectionValue;
 	if (sectionName.empty())
 	{
-		pTomlData->operator[](keyName.data()) = toml::value(value);
+		const auto pSection = FindSection(*pDocument, keyName);
+		if (pSection != nullptr && !pSection->packedArrays.empty())
+		{
+			sectionValue = CopyDocumentValue(*pDocument, keyName, sectionName);
+			pValue = &sectionValue.value();
+		}
 	}
-	else
+
+	// Get value.
+	T value;
+	try
+	{
+		value = toml::get<T>(*pValue);
+	}
+	catch (toml::type_error&)
+	{
+		return CTomlManager::GetValueError::ValueTypeMismatch;
+	}
+	catch (std::out_of_range&)
+	{
+		return CTomlManager::GetValueError::ValueNotFound;
+	}
+
+	return value;
+}
+
+template<typename T>
+std::optional<CTomlManager::ArrayOperationError> CTomlManager::AppendValue(int documentId, const std::string& keyName, T value, const std::string& sectionName)
+{
+	CModificationLock guard(*this);
+
+	// Layered documents are written to their top layer.
+	documentId = GetWriteDocumentId(documentId);
+
+	// Append to a packed array directly if the type matches.
+	if constexpr (std::is_arithmetic_v<T>)
+	{
+		const auto pDocument = GetDocument(documentId);
+		const auto pPackedArray = pDocument != nullptr ? FindPackedArrayForModification(*pDocument, keyName, sectionName) : nullptr;
+		if (pPackedArray != nullptr && pPackedArray->index() == GetPackedArrayIndex<T>())
+		{
+			auto& packedElements = std::get<GetPackedArrayIndex<T>()>(*pPackedArray);
+			packedElements.push_back(static_cast<typename std::decay_t<decltype(packedElements)>::value_type>(value));
+			MarkDocumentModified(documentId, *pDocument, keyName, sectionName, CTomlPatch::EOperation::InsertElements, packedElements.size() - 1);
+			return {};
+		}
+	}
+
+	// Get array.
+	auto result = GetArrayForModification(documentId, keyName, sectionName, true);
+	if (std::holds_alternative<CTomlManager::ArrayOperationError>(result))
 	{
-		pTomlData->operator[](sectionName.data()).operator[](keyName.data()) = toml::value(value);
+		return std::get<CTomlManager::ArrayOperationError>(result);
 	}
+	auto pArray = std::get<toml::array*>(result);
+
+	// Append value.
+	pArray->emplace_back(std::move(value));
+	MarkDocumentModified(documentId, *GetDocument(documentId), keyName, sectionName, CTomlPatch::EOperation::InsertElements, pArray->size() - 1);
 
 	return {};
 }
 
 template<typename T>
-std::variant<T, CTomlManager::GetValueError> CTomlManager::GetValue(int documentId, const std::string& keyName, const std::string& sectionName)
+std::optional<CTomlManager::ArrayOperationError> CTomlManager::InsertAt(int documentId, const std::string& keyName, size_t index, T value, const std::string& sectionName)
+{
+	CModificationLock guard(*this);
+
+	// Layered documents are written to their top layer.
+	documentId = GetWriteDocumentId(documentId);
+
+	// Insert into a packed array directly if the type matches.
+	if constexpr (std::is_arithmetic_v<T>)
+	{
+		const auto pDocument = GetDocument(documentId);
+		const auto pPackedArray = pDocument != nullptr ? FindPackedArrayForModification(*pDocument, keyName, sectionName) : nullptr;
+		if (pPackedArray != nullptr && pPackedArray->index() == GetPackedArrayIndex<T>())
+		{
+			auto& packedElements = std::get<GetPackedArrayIndex<T>()>(*pPackedArray);
+			if (index > packedElements.size())
+			{
+				return CTomlManager::ArrayOperationError::IndexOutOfRange;
+			}
+			packedElements.insert(
+				packedElements.begin() + index, static_cast<typename std::decay_t<decltype(packedElements)>::value_type>(value));
+			MarkDocumentModified(documentId, *pDocument, keyName, sectionName, CTomlPatch::EOperation::InsertElements, index);
+			return {};
+		}
+	}
+
+	// Get array.
+	auto result = GetArrayForModification(documentId, keyName, sectionName, false);
+	if (std::holds_alternative<CTomlManager::ArrayOperationError>(result))
+	{
+		return std::get<CTomlManager::ArrayOperationError>(result);
+	}
+	auto pArray = std::get<toml::array*>(result);
+
+	// Check index (inserting at the end is allowed).
+	if (index > pArray->size())
+	{
+		return CTomlManager::ArrayOperationError::IndexOutOfRange;
+	}
+
+	// Insert value.
+	pArray->insert(pArray->begin() + index, toml::value(std::move(value)));
+	MarkDocumentModified(documentId, *GetDocument(documentId), keyName, sectionName, CTomlPatch::EOperation::InsertElements, index);
+
+	return {};
+}
+
+template<typename T>
+std::optional<CTomlManager::ArrayOperationError> CTomlManager::SetAt(int documentId, const std::string& keyName, size_t index, T value, const std::string& sectionName)
+{
+	CModificationLock guard(*this);
+
+	// Layered documents are written to their top layer.
+	documentId = GetWriteDocumentId(documentId);
+
+	// Replace an element of a packed array directly if the type matches.
+	if constexpr (std::is_arithmetic_v<T>)
+	{
+		const auto pDocument = GetDocument(documentId);
+		const auto pPackedArray = pDocument != nullptr ? FindPackedArrayForModification(*pDocument, keyName, sectionName) : nullptr;
+		if (pPackedArray != nullptr && pPackedArray->index() == GetPackedArrayIndex<T>())
+		{
+			auto& packedElements = std::get<GetPackedArrayIndex<T>()>(*pPackedArray);
+			if (index >= packedElements.size())
+			{
+				return CTomlManager::ArrayOperationError::IndexOutOfRange;
+			}
+			packedElements[index] = static_cast<typename std::decay_t<decltype(packedElements)>::value_type>(value);
+			MarkDocumentModified(documentId, *pDocument, keyName, sectionName, CTomlPatch::EOperation::SetElements, index);
+			return {};
+		}
+	}
+
+	// Get array.
+	auto result = GetArrayForModification(documentId, keyName, sectionName, false);
+	if (std::holds_alternative<CTomlManager::ArrayOperationError>(result))
+	{
+		return std::get<CTomlManager::ArrayOperationError>(result);
+	}
+	auto pArray = std::get<toml::array*>(result);
+
+	// Check index.
+	if (index >= pArray->size())
+	{
+		return CTomlManager::ArrayOperationError::IndexOutOfRange;
+	}
+
+	// Replace value.
+	pArray->operator[](index) = toml::value(std::move(value));
+	MarkDocumentModified(documentId, *GetDocument(documentId), keyName, sectionName, CTomlPatch::EOperation::SetElements, index);
+
+	return {};
+}
+
+template<typename T>
+constexpr size_t CTomlManager::GetPackedArrayIndex()
+{
+	if constexpr (std::is_same_v<T, bool>)
+	{
+		return 2;
+	}
+	else if constexpr (std::is_integral_v<T>)
+	{
+		return 0;
+	}
+	else
+	{
+		return 1;
+	}
+}
+
+template<typename T>
+CTomlManager::PackedArray CTomlManager::PackValues(T values)
+{
+	using PackedElements = std::variant_alternative_t<GetPackedArrayIndex<typename T::value_type>(), PackedArray>;
+
+	if constexpr (std::is_same_v<T, PackedElements>)
+	{
+		return PackedArray(std::move(values));
+	}
+	else
+	{
+		PackedElements packedElements(values.size());
+		for (size_t i = 0; i < values.size(); i++)
+		{
+			packedElements[i] = static_cast<typename PackedElements::value_type>(values[i]);
+		}
+		return packedElements;
+	}
+}
+
+template<typename From, typename To>
+void CTomlManager::CopyPackedElements(const From* pSource, To* pDestination, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		if constexpr (std::is_same_v<To, bool>)
+		{
+			pDestination[i] = pSource[i] != 0;
+		}
+		else
+		{
+			pDestination[i] = static_cast<To>(pSource[i]);
+		}
+	}
+}
+
+template<typename T>
+std::variant<T, CTomlManager::GetValueError> CTomlManager::GetPackedArrayValue(const PackedArray& packedArray)
+{
+	if constexpr (IsPackableArray<T>::value)
+	{
+		using Element = typename T::value_type;
+		constexpr auto packedIndex = GetPackedArrayIndex<Element>();
+
+		// Check type.
+		if (packedArray.index() != packedIndex)
+		{
+			return CTomlManager::GetValueError::ValueTypeMismatch;
+		}
+		const auto& packedElements = std::get<packedIndex>(packedArray);
+
+		// Convert elements.
+		T value(packedElements.size());
+		if constexpr (std::is_same_v<Element, bool>)
+		{
+			for (size_t i = 0; i < packedElements.size(); i++)
+			{
+				value[i] = packedElements[i] != 0;
+			}
+		}
+		else
+		{
+			CopyPackedElements(packedElements.data(), value.data(), packedElements.size());
+		}
+
+		return value;
+	}
+	else
+	{
+		// Convert to TOML array first.
+		try
+		{
+			return toml::get<T>(UnpackArray(packedArray));
+		}
+		catch (toml::type_error&)
+		{
+			return CTomlManager::GetValueError::ValueTypeMismatch;
+		}
+	}
+}
+
+template<typename T>
+std::variant<size_t, CTomlManager::GetArrayError> CTomlManager::GetArrayInto(
+	int documentId, const std::string& keyName, T* pBuffer, size_t bufferSize,
+	const std::string& sectionName, size_t* pMismatchedElementIndex)
 {
 	std::scoped_lock guard(m_mtxTomlDocuments);
 
-	// Check that key is not empty.
-	if (keyName.empty())
+	// Get array.
+	const auto result = GetArrayForReading(documentId, keyName, sectionName);
+	if (std::holds_alternative<CTomlManager::GetArrayError>(result))
 	{
-		return CTomlManager::GetValueError::KeyEmpty;
+		return std::get<CTomlManager::GetArrayError>(result);
 	}
 
-	// Check that document exists.
-	if (!IsDocumentRegistered(documentId))
+	// Convert elements.
+	if (std::holds_alternative<const PackedArray*>(result))
 	{
-		return CTomlManager::GetValueError::DocumentNotFound;
+		const auto pPackedArray = std::get<const PackedArray*>(result);
+		const auto size = std::visit([](const auto& packedElements) { return packedElements.size(); }, *pPackedArray);
+		if (size > bufferSize)
+		{
+			return CTomlManager::GetArrayError::BufferTooSmall;
+		}
+
+		const auto optionalError = ConvertPackedElements<T>(*pPackedArray, pBuffer, pMismatchedElementIndex);
+		if (optionalError.has_value())
+		{
+			return optionalError.value();
+		}
+
+		return size;
 	}
 
-	// Get TOML data.
-	auto pTomlData = GetTomlData(documentId);
+	if (std::holds_alternative<SFrozenArray>(result))
+	{
+		const auto& frozenArray = std::get<SFrozenArray>(result);
+		const auto size = frozenArray.pFrozenDocument->GetSize(frozenArray.array);
+		if (size > bufferSize)
+		{
+			return CTomlManager::GetArrayError::BufferTooSmall;
+		}
+
+		const auto optionalError = ConvertFrozenElements<T>(frozenArray, pBuffer, pMismatchedElementIndex);
+		if (optionalError.has_value())
+		{
+			return optionalError.value();
+		}
 
-	// Get value.
-	T value;
-	try
+		return size;
+	}
+
+	const auto pArray = std::get<const toml::array*>(result);
+	if (pArray->size() > bufferSize)
+	{
+		return CTomlManager::GetArrayError::BufferTooSmall;
+	}
+
+	const auto optionalError = ConvertArrayElements<T>(*pArray, pBuffer, pMismatchedElementIndex);
+	if (optionalError.has_value())
+	{
+		return optionalError.value();
+	}
+
+	return pArray->size();
+}
+
+template<typename T>
+std::optional<CTomlManager::GetArrayError> CTomlManager::GetArrayInto(
+	int documentId, const std::string& keyName, std::vector<T>& outArray,
+	const std::string& sectionName, size_t* pMismatchedElementIndex)
+{
+	std::scoped_lock guard(m_mtxTomlDocuments);
+
+	// Get array.
+	const auto result = GetArrayForReading(documentId, keyName, sectionName);
+	if (std::holds_alternative<CTomlManager::GetArrayError>(result))
+	{
+		return std::get<CTomlManager::GetArrayError>(result);
+	}
+
+	// Convert elements (resizing keeps vector's capacity).
+	if (std::holds_alternative<const PackedArray*>(result))
+	{
+		const auto pPackedArray = std::get<const PackedArray*>(result);
+		outArray.resize(std::visit([](const auto& packedElements) { return packedElements.size(); }, *pPackedArray));
+
+		return ConvertPackedElements<T>(*pPackedArray, outArray, pMismatchedElementIndex);
+	}
+
+	if (std::holds_alternative<SFrozenArray>(result))
+	{
+		const auto& frozenArray = std::get<SFrozenArray>(result);
+		outArray.resize(frozenArray.pFrozenDocument->GetSize(frozenArray.array));
+
+		return ConvertFrozenElements<T>(frozenArray, outArray, pMismatchedElementIndex);
+	}
+
+	const auto pArray = std::get<const toml::array*>(result);
+	outArray.resize(pArray->size());
+
+	return ConvertArrayElements<T>(*pArray, outArray, pMismatchedElementIndex);
+}
+
+template<typename T, typename Output>
+std::optional<CTomlManager::GetArrayError> CTomlManager::ConvertArrayElements(const toml::array& array, Output& output, size_t* pMismatchedElementIndex)
+{
+	static_assert(std::is_arithmetic_v<T> || std::is_same_v<T, std::string>, "unsupported array element type");
+
+	for (size_t i = 0; i < array.size(); i++)
+	{
+		const auto& element = array[i];
+
+		bool bTypeMatches = false;
+		if constexpr (std::is_same_v<T, bool>)
+		{
+			bTypeMatches = element.is_boolean();
+			if (bTypeMatches)
+			{
+				output[i] = element.as_boolean(std::nothrow);
+			}
+		}
+		else if constexpr (std::is_integral_v<T>)
+		{
+			bTypeMatches = element.is_integer();
+			if (bTypeMatches)
+			{
+				output[i] = static_cast<T>(element.as_integer(std::nothrow));
+			}
+		}
+		else if constexpr (std::is_floating_point_v<T>)
+		{
+			bTypeMatches = element.is_floating();
+			if (bTypeMatches)
+			{
+				output[i] = static_cast<T>(element.as_floating(std::nothrow));
+			}
+		}
+		else
+		{
+			bTypeMatches = element.is_string();
+			if (bTypeMatches)
+			{
+				output[i] = element.as_string(std::nothrow).str;
+			}
+		}
+
+		if (!bTypeMatches)
+		{
+			if (pMismatchedElementIndex != nullptr)
+			{
+				*pMismatchedElementIndex = i;
+			}
+			return CTomlManager::GetArrayError::ElementTypeMismatch;
+		}
+	}
+
+	return {};
+}
+
+template<typename T, typename Output>
+std::optional<CTomlManager::GetArrayError> CTomlManager::ConvertPackedElements(const PackedArray& packedArray, Output& output, size_t* pMismatchedElementIndex)
+{
+	static_assert(std::is_arithmetic_v<T> || std::is_same_v<T, std::string>, "unsupported array element type");
+
+	if constexpr (std::is_arithmetic_v<T>)
+	{
+		constexpr auto packedIndex = GetPackedArrayIndex<T>();
+		if (packedArray.index() == packedIndex)
+		{
+			const auto& packedElements = std::get<packedIndex>(packedArray);
+			if constexpr (std::is_pointer_v<Output>)
+			{
+				CopyPackedElements(packedElements.data(), output, packedElements.size());
+			}
+			else if constexpr (!std::is_same_v<T, bool>)
+			{
+				CopyPackedElements(packedElements.data(), output.data(), packedElements.size());
+			}
+			else
+			{
+				for (size_t i = 0; i < packedElements.size(); i++)
+				{
+					output[i] = packedElements[i] != 0;
+				}
+			}
+
+			return {};
+		}
+	}
+
+	// All elements of a packed array have the same type so the first element is mismatched.
+	if (pMismatchedElementIndex != nullptr)
 	{
-		if (sectionName.empty()) {
-			value = toml::find<T>(*pTomlData, keyName.data());
+		*pMismatchedElementIndex = 0;
+	}
+	return CTomlManager::GetArrayError::ElementTypeMismatch;
+}
+
+template<typename T, typename Output>
+std::optional<CTomlManager::GetArrayError> CTomlManager::ConvertFrozenElements(const SFrozenArray& frozenArray, Output& output, size_t* pMismatchedElementIndex)
+{
+	static_assert(std::is_arithmetic_v<T> || std::is_same_v<T, std::string>, "unsupported array element type");
+
+	using EValueTag = CTomlFrozenDocument::EValueTag;
+	const auto& frozenDocument = *frozenArray.pFrozenDocument;
+	const auto size = frozenDocument.GetSize(frozenArray.array);
+	for (size_t i = 0; i < size; i++)
+	{
+		// A corrupted element is read as an empty value (type mismatch).
+		const auto element = frozenDocument.GetElement(frozenArray.array, i).value_or(CTomlFrozenDocument::SValue());
+
+		bool bTypeMatches = false;
+		if constexpr (std::is_same_v<T, bool>)
+		{
+			bTypeMatches = element.tag == EValueTag::Boolean;
+			if (bTypeMatches)
+			{
+				output[i] = CTomlFrozenDocument::GetBoolean(element);
+			}
+		}
+		else if constexpr (std::is_integral_v<T>)
+		{
+			bTypeMatches = element.tag == EValueTag::Integer;
+			if (bTypeMatches)
+			{
+				output[i] = static_cast<T>(CTomlFrozenDocument::GetInteger(element));
+			}
 		}
-		else {
-			value = toml::find<T>(*pTomlData, sectionName.data(), keyName.data());
+		else if constexpr (std::is_floating_point_v<T>)
+		{
+			bTypeMatches = element.tag == EValueTag::Floating;
+			if (bTypeMatches)
+			{
+				output[i] = static_cast<T>(CTomlFrozenDocument::GetFloating(element));
+			}
+		}
+		else
+		{
+			bTypeMatches = element.tag == EValueTag::String;
+			if (bTypeMatches)
+			{
+				output[i] = frozenDocument.GetString(element);
+			}
+		}
+
+		if (!bTypeMatches)
+		{
+			if (pMismatchedElementIndex != nullptr)
+			{
+				*pMismatchedElementIndex = i;
+			}
+			return CTomlManager::GetArrayError::ElementTypeMismatch;
 		}
 	}
-	catch (toml::type_error&)
+
+	return {};
+}
+
+template<typename T>
+std::variant<T, CTomlManager::GetValueError> CTomlManager::GetFrozenValue(
+	const CTomlFrozenDocument& frozenDocument, const std::string& keyName, const std::string& sectionName)
+{
+	using EValueTag = CTomlFrozenDocument::EValueTag;
+
+	// Find table that contains the value.
+	auto table = frozenDocument.GetRoot();
+	if (!sectionName.empty())
+	{
+		if (table.tag != EValueTag::Table)
+		{
+			return CTomlManager::GetValueError::ValueTypeMismatch;
+		}
+
+		const auto optionalSection = frozenDocument.Find(table, sectionName);
+		if (!optionalSection.has_value())
+		{
+			return CTomlManager::GetValueError::ValueNotFound;
+		}
+		table = optionalSection.value();
+	}
+
+	// Find value.
+	if (table.tag != EValueTag::Table)
 	{
 		return CTomlManager::GetValueError::ValueTypeMismatch;
 	}
-	catch (std::out_of_range&)
+	const auto optionalValue = frozenDocument.Find(table, keyName);
+	if (!optionalValue.has_value())
 	{
 		return CTomlManager::GetValueError::ValueNotFound;
 	}
+	const auto& value = optionalValue.value();
 
-	return value;
-}
\ No newline at end of file
+	// Read scalars straight from the buffer, convert other values to TOML values.
+	if constexpr (std::is_same_v<T, bool>)
+	{
+		if (value.tag != EValueTag::Boolean)
+		{
+			return CTomlManager::GetValueError::ValueTypeMismatch;
+		}
+		return CTomlFrozenDocument::GetBoolean(value);
+	}
+	else if constexpr (std::is_integral_v<T>)
+	{
+		if (value.tag != EValueTag::Integer)
+		{
+			return CTomlManager::GetValueError::ValueTypeMismatch;
+		}
+		return static_cast<T>(CTomlFrozenDocument::GetInteger(value));
+	}
+	else if constexpr (std::is_floating_point_v<T>)
+	{
+		if (value.tag != EValueTag::Floating)
+		{
+			return CTomlManager::GetValueError::ValueTypeMismatch;
+		}
+		return static_cast<T>(CTomlFrozenDocument::GetFloating(value));
+	}
+	else if constexpr (std::is_same_v<T, std::string>)
+	{
+		if (value.tag != EValueTag::String)
+		{
+			return CTomlManager::GetValueError::ValueTypeMismatch;
+		}
+		return std::string(frozenDocument.GetString(value));
+	}
+	else
+	{
+		const auto optionalTomlValue = frozenDocument.ToValue(value);
+		if (!optionalTomlValue.has_value())
+		{
+			return CTomlManager::GetValueError::ValueNotFound;
+		}
+
+		try
+		{
+			return toml::get<T>(optionalTomlValue.value());
+		}
+		catch (toml::type_error&)
+		{
+			return CTomlManager::GetValueError::ValueTypeMismatch;
+		}
+		catch (std::out_of_range&)
+		{
+			return CTomlManager::GetValueError::ValueNotFound;
+		}
+	}
+}
@@ -0,0 +1,178 @@
+#include "TomlParallelParser.h"
+
+#include <algorithm>
+#include <exception>
+#include <sstream>
+#include <unordered_set>
+#include "TomlHeaderScanner.h"
+#include "TomlWorkerPool.h"
+
+toml::value CTomlParallelParser::Parse(const std::string& text, const std::string& fileName, CTomlWorkerPool& workerPool)
+{
+	if (text.size() < m_minParallelTextSize || workerPool.GetThreadCount() == 0)
+	{
+		return ParseSequential(text, fileName);
+	}
+
+	const auto tables = CTomlHeaderScanner::FindTopLevelTables(text);
+
+	// Parse root key/values first to find tables that they already define (using dotted keys),
+	// such tables are parsed together with the root key/values so that conflicts are detected.
+	const auto rootText = text.substr(0, tables.rootEnd);
+	auto rootData = ParseSequential(rootText, fileName);
+	const auto& rootTable = rootData.as_table();
+
+	// Create chunks.
+	const auto chunkSize = std::max(text.size() / (workerPool.GetThreadCount() + 1), m_minChunkSize);
+	std::vector<SChunk> chunks;
+	std::unordered_set<std::string> splitTableNames;
+	SChunk rootChunk;
+	for (const auto& tableName : tables.tableOrder)
+	{
+		std::string tableText;
+		for (const auto& [begin, end] : tables.tableRanges.at(tableName))
+		{
+			tableText.append(text, begin, end - begin);
+		}
+
+		if (rootTable.find(tableName) != rootTable.end())
+		{
+			rootChunk.text += tableText;
+			continue;
+		}
+
+		if (tableText.size() > chunkSize && SplitArrayOfTables(tableText, tableName, chunkSize, chunks))
+		{
+			splitTableNames.insert(tableName);
+			continue;
+		}
+
+		chunks.push_back({ std::move(tableText), tableName });
+	}
+	if (chunks.size() <= 1 && rootChunk.text.empty())
+	{
+		return ParseSequential(text, fileName);
+	}
+	if (!rootChunk.text.empty())
+	{
+		rootChunk.text.insert(0, rootText);
+		chunks.push_back(std::move(rootChunk));
+	}
+
+	// Parse chunks.
+	std::vector<toml::value> results(chunks.size());
+	try
+	{
+		workerPool.ParallelFor(chunks.size(), [&](size_t index)
+		{
+			results[index] = ParseSequential(chunks[index].text, fileName);
+		});
+	}
+	catch (std::exception&)
+	{
+		// Parse sequentially to report the error with correct line numbers.
+		return ParseSequential(text, fileName);
+	}
+
+	// Merge chunks.
+	toml::value data(toml::table{});
+	auto& dataTable = data.as_table();
+	if (!chunks.back().tableName.empty())
+	{
+		dataTable = std::move(rootData.as_table());
+	}
+	for (size_t i = 0; i < chunks.size(); i++)
+	{
+		auto& chunkTable = results[i].as_table();
+		const auto& tableName = chunks[i].tableName;
+		if (tableName.empty())
+		{
+			// Root key/values together with conflicting tables.
+			for (auto& [keyName, value] : chunkTable)
+			{
+				dataTable[keyName] = std::move(value);
+			}
+			continue;
+		}
+
+		auto tableIt = chunkTable.find(tableName);
+		if (tableIt == chunkTable.end())
+		{
+			return ParseSequential(text, fileName);
+		}
+
+		if (splitTableNames.find(tableName) == splitTableNames.end())
+		{
+			dataTable[tableName] = std::move(tableIt->second);
+			continue;
+		}
+
+		// Append elements of the array of tables in the original order.
+		if (!tableIt->second.is_array())
+		{
+			return ParseSequential(text, fileName);
+		}
+		auto& arrayValue = dataTable[tableName];
+		if (!arrayValue.is_array())
+		{
+			arrayValue = std::move(tableIt->second);
+			continue;
+		}
+		auto& array = arrayValue.as_array();
+		for (auto& element : tableIt->second.as_array())
+		{
+			array.push_back(std::move(element));
+		}
+	}
+
+	return data;
+}
+
+bool CTomlParallelParser::SplitArrayOfTables(
+	const std::string& tableText, const std::string& tableName, size_t chunkSize, std::vector<SChunk>& chunks)
+{
+	// Find headers that start new elements.
+	std::vector<size_t> elementStarts;
+	CTomlHeaderScanner scanner;
+	for (size_t lineStart = 0; lineStart < tableText.size();)
+	{
+		auto lineEnd = tableText.find('\n', lineStart);
+		lineEnd = lineEnd == std::string::npos ? tableText.size() : lineEnd + 1;
+
+		bool bIsTopLevelArrayElement = false;
+		scanner.ScanLine(std::string_view(tableText).substr(lineStart, lineEnd - lineStart), &bIsTopLevelArrayElement);
+		if (bIsTopLevelArrayElement)
+		{
+			elementStarts.push_back(lineStart);
+		}
+
+		lineStart = lineEnd;
+	}
+
+	// Text before the first element header (such as "[items.a]") belongs to an implicitly created
+	// table that can't be parsed on its own.
+	if (elementStarts.size() < 2 || elementStarts.front() != 0)
+	{
+		return false;
+	}
+
+	// Group elements into chunks of approximately the specified size.
+	size_t chunkStart = 0;
+	for (const auto elementStart : elementStarts)
+	{
+		if (elementStart - chunkStart >= chunkSize)
+		{
+			chunks.push_back({ tableText.substr(chunkStart, elementStart - chunkStart), tableName });
+			chunkStart = elementStart;
+		}
+	}
+	chunks.push_back({ tableText.substr(chunkStart), tableName });
+
+	return true;
+}
+
+toml::value CTomlParallelParser::ParseSequential(const std::string& text, const std::string& fileName)
+{
+	std::istringstream stream(text);
+	return toml::parse(stream, fileName);
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "External/toml11/toml.hpp"
+
+class CTomlWorkerPool;
+
+//! Parses large TOML text on multiple threads: the text is split at top-level table headers
+//! (found with \ref CTomlHeaderScanner), parts are parsed on worker threads and then merged.
+//! 
+//! \remark All headers of a top-level table are always parsed together so that table redefinition
+//! is detected exactly as in a sequential parse, arrays of tables (such as "[[items]]") are additionally
+//! split between elements and merged in the original order.
+class CTomlParallelParser
+{
+public:
+	CTomlParallelParser() = delete;
+
+	//! Parses TOML text.
+	//! 
+	//! \param text       TOML text.
+	//! \param fileName   Name of the file (used in error messages).
+	//! \param workerPool Worker threads to parse on.
+	//! 
+	//! \remark Small texts are parsed sequentially. If parsing of a part fails the whole text is parsed
+	//! sequentially again so that the error message (and thrown exception) is the same as of toml::parse.
+	//! 
+	//! \return Parsed root table.
+	static toml::value Parse(const std::string& text, const std::string& fileName, CTomlWorkerPool& workerPool);
+
+private:
+
+	//! Part of the text that is parsed on its own.
+	struct SChunk
+	{
+		//! TOML text of the chunk.
+		std::string text;
+
+		//! Name of the top-level table of the chunk, empty for the root key/values.
+		std::string tableName;
+	};
+
+	//! Splits text of a top-level array of tables between its elements.
+	//! 
+	//! \param tableText  Text of all headers of the table.
+	//! \param tableName  Name of the table.
+	//! \param chunkSize  Approximate size of a chunk.
+	//! \param chunks     Chunks to add to.
+	//! 
+	//! \return 'false' if the text can't be split (for example it does not start with an element header),
+	//! nothing is added to chunks in this case.
+	static bool SplitArrayOfTables(
+		const std::string& tableText, const std::string& tableName, size_t chunkSize, std::vector<SChunk>& chunks);
+
+	//! Parses TOML text on the calling thread.
+	//! 
+	//! \param text     TOML text.
+	//! \param fileName Name of the file (used in error messages).
+	//! 
+	//! \return Parsed root table.
+	static toml::value ParseSequential(const std::string& text, const std::string& fileName);
+
+	//! Texts smaller than this are parsed sequentially.
+	static inline const size_t m_minParallelTextSize = 256 * 1024;
+
+	//! Minimum size of a chunk that an array of tables is split into.
+	static inline const size_t m_minChunkSize = 64 * 1024;
+};
@@ -0,0 +1,163 @@
+#include "TomlPatch.h"
+
+#include "TomlBinarySnapshot.h"
+
+void CTomlPatch::SetValue(const std::string& sectionName, const std::string& keyName, toml::value value)
+{
+	AddOperation(EOperation::SetValue, sectionName, keyName, 0, 0, std::move(value));
+}
+
+void CTomlPatch::RemoveValue(const std::string& sectionName, const std::string& keyName)
+{
+	AddOperation(EOperation::RemoveValue, sectionName, keyName, 0, 0, toml::value());
+}
+
+void CTomlPatch::SetElements(const std::string& sectionName, const std::string& keyName, size_t index, toml::array elements)
+{
+	AddOperation(EOperation::SetElements, sectionName, keyName, index, 0, std::move(elements));
+}
+
+void CTomlPatch::InsertElements(const std::string& sectionName, const std::string& keyName, size_t index, toml::array elements)
+{
+	AddOperation(EOperation::InsertElements, sectionName, keyName, index, 0, std::move(elements));
+}
+
+void CTomlPatch::EraseElements(const std::string& sectionName, const std::string& keyName, size_t index, size_t count)
+{
+	AddOperation(EOperation::EraseElements, sectionName, keyName, index, count, toml::value());
+}
+
+std::string CTomlPatch::Serialize() const
+{
+	toml::array operations;
+	operations.reserve(m_operations.size());
+	for (const auto& operation : m_operations)
+	{
+		toml::table record;
+		record[m_typeKeyName] = static_cast<toml::integer>(operation.type);
+		if (!operation.sectionName.empty())
+		{
+			record[m_sectionKeyName] = operation.sectionName;
+		}
+		record[m_keyKeyName] = operation.keyName;
+		switch (operation.type)
+		{
+		case EOperation::SetValue:
+			record[m_valueKeyName] = operation.value;
+			break;
+		case EOperation::RemoveValue:
+			break;
+		case EOperation::SetElements:
+		case EOperation::InsertElements:
+			record[m_indexKeyName] = static_cast<toml::integer>(operation.index);
+			record[m_valueKeyName] = operation.value;
+			break;
+		case EOperation::EraseElements:
+			record[m_indexKeyName] = static_cast<toml::integer>(operation.index);
+			record[m_countKeyName] = static_cast<toml::integer>(operation.count);
+			break;
+		}
+		operations.push_back(std::move(record));
+	}
+
+	return CTomlBinarySnapshot::Serialize(toml::value(std::move(operations)), 0, 0);
+}
+
+std::optional<CTomlPatch> CTomlPatch::Deserialize(std::string_view bytes)
+{
+	const auto optionalOperations = CTomlBinarySnapshot::Deserialize(bytes, 0, 0);
+	if (!optionalOperations.has_value() || !optionalOperations->is_array())
+	{
+		return {};
+	}
+
+	const auto findField = [](const toml::table& record, const char* pFieldName, toml::value_t type) -> const toml::value*
+	{
+		const auto it = record.find(pFieldName);
+		return it != record.end() && it->second.type() == type ? &it->second : nullptr;
+	};
+	const auto readSize = [&findField](const toml::table& record, const char* pFieldName) -> std::optional<size_t>
+	{
+		const auto pField = findField(record, pFieldName, toml::value_t::integer);
+		if (pField == nullptr || pField->as_integer() < 0)
+		{
+			return {};
+		}
+		return static_cast<size_t>(pField->as_integer());
+	};
+
+	CTomlPatch patch;
+	for (const auto& recordValue : optionalOperations->as_array())
+	{
+		if (!recordValue.is_table())
+		{
+			return {};
+		}
+		const auto& record = recordValue.as_table();
+
+		// Read common fields.
+		const auto pType = findField(record, m_typeKeyName, toml::value_t::integer);
+		const auto pKeyName = findField(record, m_keyKeyName, toml::value_t::string);
+		const auto pSectionName = findField(record, m_sectionKeyName, toml::value_t::string);
+		if (pType == nullptr || pKeyName == nullptr || (pSectionName == nullptr && record.count(m_sectionKeyName) != 0))
+		{
+			return {};
+		}
+		const auto& keyName = pKeyName->as_string().str;
+		const auto sectionName = pSectionName != nullptr ? pSectionName->as_string().str : std::string();
+
+		// Read fields of the operation.
+		const auto valueIt = record.find(m_valueKeyName);
+		switch (static_cast<EOperation>(pType->as_integer()))
+		{
+		case EOperation::SetValue:
+			if (valueIt == record.end())
+			{
+				return {};
+			}
+			patch.SetValue(sectionName, keyName, valueIt->second);
+			break;
+		case EOperation::RemoveValue:
+			patch.RemoveValue(sectionName, keyName);
+			break;
+		case EOperation::SetElements:
+		case EOperation::InsertElements:
+		{
+			const auto optionalIndex = readSize(record, m_indexKeyName);
+			if (!optionalIndex.has_value() || valueIt == record.end() || !valueIt->second.is_array())
+			{
+				return {};
+			}
+			patch.AddOperation(static_cast<EOperation>(pType->as_integer()), sectionName, keyName, optionalIndex.value(), 0, valueIt->second);
+			break;
+		}
+		case EOperation::EraseElements:
+		{
+			const auto optionalIndex = readSize(record, m_indexKeyName);
+			const auto optionalCount = readSize(record, m_countKeyName);
+			if (!optionalIndex.has_value() || !optionalCount.has_value())
+			{
+				return {};
+			}
+			patch.EraseElements(sectionName, keyName, optionalIndex.value(), optionalCount.value());
+			break;
+		}
+		default:
+			return {};
+		}
+	}
+
+	return patch;
+}
+
+void CTomlPatch::AddOperation(EOperation type, const std::string& sectionName, const std::string& keyName, size_t index, size_t count, toml::value value)
+{
+	SOperation operation;
+	operation.type = type;
+	operation.sectionName = sectionName;
+	operation.keyName = keyName;
+	operation.index = index;
+	operation.count = count;
+	operation.value = std::move(value);
+	m_operations.push_back(std::move(operation));
+}
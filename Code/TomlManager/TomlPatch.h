@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "External/toml11/toml.hpp"
+
+//! Structural difference of two documents: operations that turn one document into the other when applied in order
+//! (see CTomlManager::Diff and CTomlManager::ApplyPatch), values are addressed by section and key like in CTomlManager.
+//! 
+//! \remark Binary format: binary snapshot (see CTomlBinarySnapshot) of an array of operation tables, names of
+//! operation fields are interned once and homogeneous arrays of numbers are stored contiguously.
+class CTomlPatch
+{
+public:
+	//! Type of a patch operation.
+	enum class EOperation : std::uint8_t
+	{
+		SetValue = 0,   //!< Sets the value of a key (a section if the section name is empty and the value is a table).
+		RemoveValue,    //!< Removes a key (a section if the section name is empty).
+		SetElements,    //!< Overwrites consecutive elements of an array.
+		InsertElements, //!< Inserts consecutive elements into an array.
+		EraseElements,  //!< Removes consecutive elements of an array.
+	};
+
+	//! Describes a patch operation.
+	struct SOperation
+	{
+		//! Type of the operation.
+		EOperation type = EOperation::SetValue;
+
+		//! Section name of the value (empty for root keys).
+		std::string sectionName;
+
+		//! Name of the key of the value.
+		std::string keyName;
+
+		//! Index of the first element (array operations).
+		size_t index = 0;
+
+		//! Number of removed elements (\ref EOperation::EraseElements).
+		size_t count = 0;
+
+		//! New value (\ref EOperation::SetValue) or array of new elements (\ref EOperation::SetElements,
+		//! \ref EOperation::InsertElements).
+		toml::value value;
+	};
+
+	//! Adds an operation that sets the value of a key.
+	//! 
+	//! \param sectionName Section name of the value (can be empty).
+	//! \param keyName     Name of the key of the value.
+	//! \param value       New value.
+	void SetValue(const std::string& sectionName, const std::string& keyName, toml::value value);
+
+	//! Adds an operation that removes a key.
+	//! 
+	//! \param sectionName Section name of the value (can be empty).
+	//! \param keyName     Name of the key of the value.
+	void RemoveValue(const std::string& sectionName, const std::string& keyName);
+
+	//! Adds an operation that overwrites consecutive elements of an array.
+	//! 
+	//! \param sectionName Section name of the array (can be empty).
+	//! \param keyName     Name of the key of the array.
+	//! \param index       Index of the first overwritten element.
+	//! \param elements    New elements.
+	void SetElements(const std::string& sectionName, const std::string& keyName, size_t index, toml::array elements);
+
+	//! Adds an operation that inserts consecutive elements into an array.
+	//! 
+	//! \param sectionName Section name of the array (can be empty).
+	//! \param keyName     Name of the key of the array.
+	//! \param index       Index of the first inserted element (can be equal to array size to append elements).
+	//! \param elements    Inserted elements.
+	void InsertElements(const std::string& sectionName, const std::string& keyName, size_t index, toml::array elements);
+
+	//! Adds an operation that removes consecutive elements of an array.
+	//! 
+	//! \param sectionName Section name of the array (can be empty).
+	//! \param keyName     Name of the key of the array.
+	//! \param index       Index of the first removed element.
+	//! \param count       Number of removed elements.
+	void EraseElements(const std::string& sectionName, const std::string& keyName, size_t index, size_t count);
+
+	//! Returns operations of the patch.
+	//! 
+	//! \return Operations in order of application.
+	const std::vector<SOperation>& GetOperations() const { return m_operations; }
+
+	//! Tells whether the patch has no operations (compared documents are equal).
+	//! 
+	//! \return 'true' if the patch is empty, 'false' otherwise.
+	bool IsEmpty() const { return m_operations.empty(); }
+
+	//! Serializes the patch (for example to send it over the network or to store it in a change log).
+	//! 
+	//! \return Patch bytes.
+	std::string Serialize() const;
+
+	//! Deserializes a patch.
+	//! 
+	//! \param bytes Bytes returned by \ref Serialize.
+	//! 
+	//! \return Empty if the bytes are corrupted, otherwise the patch.
+	static std::optional<CTomlPatch> Deserialize(std::string_view bytes);
+
+private:
+
+	//! Adds an operation.
+	//! 
+	//! \param type        Type of the operation.
+	//! \param sectionName Section name of the value.
+	//! \param keyName     Name of the key of the value.
+	//! \param index       Index of the first element.
+	//! \param count       Number of removed elements.
+	//! \param value       New value or elements.
+	void AddOperation(EOperation type, const std::string& sectionName, const std::string& keyName, size_t index, size_t count, toml::value value);
+
+	//! Operations in order of application.
+	std::vector<SOperation> m_operations;
+
+	//! Name of the operation type field of a serialized operation.
+	static inline const auto m_typeKeyName = "t";
+
+	//! Name of the section name field of a serialized operation (omitted if the section name is empty).
+	static inline const auto m_sectionKeyName = "s";
+
+	//! Name of the key name field of a serialized operation.
+	static inline const auto m_keyKeyName = "k";
+
+	//! Name of the element index field of a serialized operation (array operations only).
+	static inline const auto m_indexKeyName = "i";
+
+	//! Name of the element count field of a serialized operation (\ref EOperation::EraseElements only).
+	static inline const auto m_countKeyName = "n";
+
+	//! Name of the value field of a serialized operation.
+	static inline const auto m_valueKeyName = "v";
+};
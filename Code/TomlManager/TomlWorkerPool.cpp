@@ -0,0 +1,136 @@
+#include "TomlWorkerPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+CTomlWorkerPool::CTomlWorkerPool(size_t threadCount)
+{
+	if (threadCount == 0)
+	{
+		const auto hardwareThreadCount = static_cast<size_t>(std::thread::hardware_concurrency());
+		threadCount = std::max<size_t>(hardwareThreadCount, 2) - 1;
+	}
+
+	m_threads.reserve(threadCount);
+	for (size_t i = 0; i < threadCount; i++)
+	{
+		m_threads.emplace_back(&CTomlWorkerPool::WorkerLoop, this);
+	}
+}
+
+CTomlWorkerPool::~CTomlWorkerPool()
+{
+	{
+		std::scoped_lock guard(m_mtxTasks);
+		m_bStop = true;
+	}
+	m_tasksChanged.notify_all();
+
+	for (auto& thread : m_threads)
+	{
+		thread.join();
+	}
+}
+
+void CTomlWorkerPool::ParallelFor(size_t count, const std::function<void(size_t)>& task)
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	std::atomic<size_t> nextIndex{ 0 };
+	std::exception_ptr pException;
+	std::mutex mtxException;
+
+	// Each runner takes tasks until there are none left.
+	const auto runTasks = [&]()
+	{
+		for (auto index = nextIndex++; index < count; index = nextIndex++)
+		{
+			try
+			{
+				task(index);
+			}
+			catch (...)
+			{
+				std::scoped_lock guard(mtxException);
+				if (pException == nullptr)
+				{
+					pException = std::current_exception();
+				}
+			}
+		}
+	};
+
+	// Start helpers on worker threads.
+	const auto helperCount = std::min(m_threads.size(), count - 1);
+	size_t runningHelperCount = helperCount;
+	std::mutex mtxHelpers;
+	std::condition_variable helpersFinished;
+	{
+		std::scoped_lock guard(m_mtxTasks);
+		for (size_t i = 0; i < helperCount; i++)
+		{
+			m_tasks.push_back([&]()
+			{
+				runTasks();
+
+				std::scoped_lock helpersGuard(mtxHelpers);
+				runningHelperCount -= 1;
+				helpersFinished.notify_one();
+			});
+		}
+	}
+	m_tasksChanged.notify_all();
+
+	// Run tasks on this thread too.
+	runTasks();
+
+	// Wait for helpers (they reference local variables).
+	{
+		std::unique_lock guard(mtxHelpers);
+		helpersFinished.wait(guard, [&]() { return runningHelperCount == 0; });
+	}
+
+	if (pException != nullptr)
+	{
+		std::rethrow_exception(pException);
+	}
+}
+
+void CTomlWorkerPool::Run(std::function<void()> task)
+{
+	{
+		std::scoped_lock guard(m_mtxTasks);
+		m_tasks.push_back(std::move(task));
+	}
+	m_tasksChanged.notify_one();
+}
+
+size_t CTomlWorkerPool::GetThreadCount() const
+{
+	return m_threads.size();
+}
+
+void CTomlWorkerPool::WorkerLoop()
+{
+	while (true)
+	{
+		std::function<void()> task;
+		{
+			std::unique_lock guard(m_mtxTasks);
+			m_tasksChanged.wait(guard, [this]() { return m_bStop || !m_tasks.empty(); });
+			if (m_tasks.empty())
+			{
+				return;
+			}
+
+			task = std::move(m_tasks.front());
+			m_tasks.pop_front();
+		}
+
+		task();
+	}
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! Fixed set of worker threads that run tasks of TOML manager in parallel.
+class CTomlWorkerPool
+{
+public:
+	//! Starts worker threads.
+	//! 
+	//! \param threadCount Number of worker threads, 0 to use the number of hardware threads minus one
+	//! (the thread that waits for tasks also runs them).
+	CTomlWorkerPool(size_t threadCount = 0);
+
+	//! Waits for running tasks and stops worker threads.
+	~CTomlWorkerPool();
+
+	CTomlWorkerPool(const CTomlWorkerPool&) = delete;
+	CTomlWorkerPool& operator=(const CTomlWorkerPool&) = delete;
+
+	//! Runs task for every index in range [0, count) on worker threads and the calling thread,
+	//! returns when all tasks are finished.
+	//! 
+	//! \param count Number of tasks.
+	//! \param task  Function that receives task index.
+	//! 
+	//! \remark If a task throws an exception, other tasks are still run and the first exception is rethrown.
+	void ParallelFor(size_t count, const std::function<void(size_t)>& task);
+
+	//! Runs a task on a worker thread, does not wait for it.
+	//! 
+	//! \param task Function to run (should not throw), queued tasks are run before the pool is destroyed.
+	void Run(std::function<void()> task);
+
+	//! Returns number of worker threads.
+	//! 
+	//! \return Number of worker threads.
+	size_t GetThreadCount() const;
+
+private:
+
+	//! Function that worker threads run.
+	void WorkerLoop();
+
+	//! Worker threads.
+	std::vector<std::thread> m_threads;
+
+	//! Tasks to run.
+	std::deque<std::function<void()>> m_tasks;
+
+	//! Mutex for \ref m_tasks and \ref m_bStop.
+	std::mutex m_mtxTasks;
+
+	//! Notified when a task is added or the pool is stopped.
+	std::condition_variable m_tasksChanged;
+
+	//! Whether worker threads should stop.
+	bool m_bStop = false;
+};
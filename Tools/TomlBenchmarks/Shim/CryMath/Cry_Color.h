@@ -0,0 +1,15 @@
+// Stand-in for the CryCommon header so that TomlManager can be built without the engine (see ../../CMakeLists.txt).
+// Only the members used by TomlCryMathTypes.h are declared.
+
+#pragma once
+
+template<typename F>
+struct Color_tpl
+{
+	F r{}, g{}, b{}, a{};
+
+	Color_tpl() = default;
+	Color_tpl(F r, F g, F b, F a) : r(r), g(g), b(b), a(a) {}
+};
+
+typedef Color_tpl<float> ColorF;
@@ -0,0 +1,55 @@
+// Stand-in for the CryCommon header so that TomlManager can be built without the engine (see ../../CMakeLists.txt).
+// Only the members used by TomlCryMathTypes.h are declared.
+
+#pragma once
+
+template<typename F>
+struct Vec2_tpl
+{
+	F x{}, y{};
+
+	Vec2_tpl() = default;
+	Vec2_tpl(F x, F y) : x(x), y(y) {}
+};
+
+template<typename F>
+struct Vec3_tpl
+{
+	F x{}, y{}, z{};
+
+	Vec3_tpl() = default;
+	Vec3_tpl(F x, F y, F z) : x(x), y(y), z(z) {}
+};
+
+template<typename F>
+struct Vec4_tpl
+{
+	F x{}, y{}, z{}, w{};
+
+	Vec4_tpl() = default;
+	Vec4_tpl(F x, F y, F z, F w) : x(x), y(y), z(z), w(w) {}
+};
+
+template<typename F>
+struct Quat_tpl
+{
+	Vec3_tpl<F> v;
+	F w{};
+
+	Quat_tpl() = default;
+	Quat_tpl(F w, F x, F y, F z) : v(x, y, z), w(w) {}
+};
+
+template<typename F>
+struct Matrix34_tpl
+{
+	F m00{}, m01{}, m02{}, m03{};
+	F m10{}, m11{}, m12{}, m13{};
+	F m20{}, m21{}, m22{}, m23{};
+};
+
+typedef Vec2_tpl<float>     Vec2;
+typedef Vec3_tpl<float>     Vec3;
+typedef Vec4_tpl<float>     Vec4;
+typedef Quat_tpl<float>     Quat;
+typedef Matrix34_tpl<float> Matrix34;
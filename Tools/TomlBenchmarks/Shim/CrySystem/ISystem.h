@@ -0,0 +1,16 @@
+// Stand-in for the CryCommon header so that TomlManager can be built without the engine (see ../../CMakeLists.txt).
+
+#pragma once
+
+#include <cstdarg>
+#include <cstdio>
+
+//! Writes a formatted line to the standard error stream (replaces the engine log).
+inline void CryLogAlways(const char* format, ...)
+{
+	va_list arguments;
+	va_start(arguments, format);
+	std::vfprintf(stderr, format, arguments);
+	va_end(arguments);
+	std::fputc('\n', stderr);
+}
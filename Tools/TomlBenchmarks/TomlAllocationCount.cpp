@@ -0,0 +1,185 @@
+// Counts heap allocations made by CTomlManager::SetValue / EmplaceValue for strings, vectors and nested maps
+// and fails if a value passed as an rvalue is copied or a value passed as an lvalue is copied more than once.
+//
+// Usage: TomlAllocationCount
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+#include "TomlManager.h"
+
+//! Number of allocations made by operator new since the program started.
+static size_t allocationCount = 0;
+
+//! Number of bytes allocated by operator new since the program started.
+static size_t allocatedBytes = 0;
+
+void* operator new(size_t size)
+{
+	allocationCount += 1;
+	allocatedBytes += size;
+
+	auto pMemory = std::malloc(size == 0 ? 1 : size);
+	if (pMemory == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+
+	return pMemory;
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* pMemory) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete[](void* pMemory) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete(void* pMemory, size_t) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete[](void* pMemory, size_t) noexcept
+{
+	std::free(pMemory);
+}
+
+//! Allocations made while running a function.
+struct SAllocations
+{
+	//! Number of allocations.
+	size_t count = 0;
+
+	//! Number of allocated bytes.
+	size_t bytes = 0;
+};
+
+//! Counts allocations made by the specified function.
+//!
+//! \param function Function to run.
+//!
+//! \return Allocations made by the function.
+template<typename Function>
+static SAllocations CountAllocations(Function&& function)
+{
+	const auto startCount = allocationCount;
+	const auto startBytes = allocatedBytes;
+
+	function();
+
+	return { allocationCount - startCount, allocatedBytes - startBytes };
+}
+
+//! Prints allocations of a case and checks that they are below the limit.
+//!
+//! \param caseName    Name of the case.
+//! \param allocations Allocations made by the case.
+//! \param maxBytes    Maximum number of bytes the case may allocate.
+//!
+//! \return 'true' if the case is below the limit, 'false' otherwise.
+static bool CheckAllocations(const std::string& caseName, const SAllocations& allocations, size_t maxBytes)
+{
+	const auto bPassed = allocations.bytes <= maxBytes;
+	std::printf(
+		"%-32s %8zu allocations %10zu bytes (limit %zu) %s\n",
+		caseName.c_str(), allocations.count, allocations.bytes, maxBytes, bPassed ? "ok" : "FAILED");
+	return bPassed;
+}
+
+//! Sets a value passed as an rvalue and as an lvalue, checks that the rvalue is not copied
+//! and that the lvalue is copied only once.
+//!
+//! \param manager     Manager to use.
+//! \param documentId  Document to set the value to.
+//! \param caseName    Name of the case.
+//! \param createValue Function that creates the value.
+//! \param dataBytes   Number of bytes of the value data that must not be copied when the value is moved.
+//!
+//! \return 'true' if the case is below the limits, 'false' otherwise.
+template<typename CreateValue>
+static bool CheckSetValue(CTomlManager& manager, int documentId, const std::string& caseName, CreateValue&& createValue, size_t dataBytes)
+{
+	bool bPassed = true;
+
+	// Moved value must not copy the data.
+	auto movedValue = createValue();
+	const auto moved = CountAllocations([&] { manager.SetValue(documentId, "value", std::move(movedValue)); });
+	bPassed &= CheckAllocations(caseName + " (move)", moved, dataBytes - 1);
+
+	// Copied value may allocate one copy of the value in addition to what moving allocates.
+	const auto value = createValue();
+	const auto copy = CountAllocations([&] { auto valueCopy = value; });
+	const auto copied = CountAllocations([&] { manager.SetValue(documentId, "value", value); });
+	bPassed &= CheckAllocations(caseName + " (copy)", copied, copy.bytes + moved.bytes);
+
+	return bPassed;
+}
+
+int main()
+{
+	CTomlManager manager;
+	const auto documentId = manager.NewDocument();
+
+	// Create a key so that later cases only replace its value.
+	manager.SetValue(documentId, "value", 0);
+
+	bool bPassed = true;
+
+	// String (larger than any small string buffer).
+	const auto stringSize = size_t(1024 * 1024);
+	bPassed &= CheckSetValue(manager, documentId, "string", [&] { return std::string(stringSize, 'x'); }, stringSize);
+
+	std::string emplacedValue(stringSize, 'x');
+	const auto emplaced = CountAllocations([&] { manager.EmplaceValue(documentId, "value", "", std::move(emplacedValue)); });
+	bPassed &= CheckAllocations("string (emplace)", emplaced, stringSize - 1);
+
+	// Vector of strings (elements are converted to TOML values, the strings themselves must not be copied).
+	const auto elementCount = size_t(1024);
+	const auto elementSize = size_t(1024);
+	bPassed &= CheckSetValue(
+		manager, documentId, "vector<string>",
+		[&] { return std::vector<std::string>(elementCount, std::string(elementSize, 'x')); },
+		elementCount * elementSize);
+
+	// Large numeric vector (stored as a packed array).
+	const auto numberCount = size_t(256 * 1024);
+	bPassed &= CheckSetValue(
+		manager, documentId, "vector<int64_t>",
+		[&] { return std::vector<std::int64_t>(numberCount, 1); },
+		numberCount * sizeof(std::int64_t));
+
+	// Nested maps of strings.
+	const auto tableCount = size_t(64);
+	const auto keyCount = size_t(64);
+	const auto valueSize = size_t(256);
+	const auto createNestedMap = [&]
+	{
+		std::map<std::string, std::map<std::string, std::string>> value;
+		for (size_t i = 0; i < tableCount; i++)
+		{
+			auto& table = value["table" + std::to_string(i)];
+			for (size_t k = 0; k < keyCount; k++)
+			{
+				table["key" + std::to_string(k)] = std::string(valueSize, 'x');
+			}
+		}
+		return value;
+	};
+	bPassed &= CheckSetValue(manager, documentId, "nested map", createNestedMap, tableCount * keyCount * valueSize);
+
+	manager.CloseDocument(documentId);
+
+	return bPassed ? 0 : 1;
+}
@@ -0,0 +1,101 @@
+// Checks that CTomlManager::ApplyPatch applies operations on a section and on keys of the section in order
+// (a section value set after its keys replaces them), also for patches read with CTomlPatch::Deserialize.
+//
+// Usage: TomlApplyPatchTest
+
+#include <cstdio>
+#include <string>
+#include "TomlManager.h"
+
+//! Creates a table with one integer.
+//!
+//! \param keyName Name of the key.
+//! \param value   Value of the key.
+//!
+//! \return Table value.
+static toml::value CreateTable(const std::string& keyName, int value)
+{
+	toml::table table;
+	table[keyName] = value;
+	return toml::value(std::move(table));
+}
+
+//! Applies a patch (and its deserialized copy) to a document with section "s" and compares the section with the expected one.
+//!
+//! \param caseName        Name of the case.
+//! \param patch           Patch to apply.
+//! \param expectedSection Expected value of section "s".
+//!
+//! \return 'true' if the section is equal to the expected one, 'false' otherwise.
+static bool CheckPatch(const char* caseName, const CTomlPatch& patch, const toml::value& expectedSection)
+{
+	bool bPassed = true;
+	for (const auto bDeserialize : { false, true })
+	{
+		CTomlManager manager;
+		const auto documentId = manager.NewDocument();
+		manager.SetValue(documentId, "k", 0, "s");
+
+		const auto optionalPatch = bDeserialize ? CTomlPatch::Deserialize(patch.Serialize()) : std::optional<CTomlPatch>(patch);
+		const auto optionalError = optionalPatch.has_value() ? manager.ApplyPatch(documentId, optionalPatch.value())
+			: std::optional<CTomlManager::ApplyPatchError>(CTomlManager::ApplyPatchError::InvalidPatch);
+		const auto sectionResult = manager.GetValue<toml::value>(documentId, "s");
+		const auto bSame = !optionalError.has_value() && std::holds_alternative<toml::value>(sectionResult)
+			&& std::get<toml::value>(sectionResult) == expectedSection;
+
+		std::printf("%-48s %s\n", (std::string(caseName) + (bDeserialize ? " (deserialized)" : "")).c_str(), bSame ? "ok" : "FAILED");
+		bPassed &= bSame;
+	}
+
+	return bPassed;
+}
+
+int main()
+{
+	bool bPassed = true;
+
+	// Section, its key, then the section again.
+	{
+		CTomlPatch patch;
+		patch.SetValue("", "s", CreateTable("k", 1));
+		patch.SetValue("s", "k", 2);
+		patch.SetValue("", "s", CreateTable("k", 3));
+		bPassed &= CheckPatch("section -> key -> section", patch, CreateTable("k", 3));
+	}
+
+	// Section, then its key.
+	{
+		CTomlPatch patch;
+		patch.SetValue("", "s", CreateTable("k", 1));
+		patch.SetValue("s", "k", 2);
+		bPassed &= CheckPatch("section -> key", patch, CreateTable("k", 2));
+	}
+
+	// Key, removed section, new key, then the section again.
+	{
+		CTomlPatch patch;
+		patch.SetValue("s", "k", 5);
+		patch.RemoveValue("", "s");
+		patch.SetValue("s", "j", 1);
+		patch.SetValue("", "s", CreateTable("k", 7));
+		bPassed &= CheckPatch("key -> remove -> key -> section", patch, CreateTable("k", 7));
+	}
+
+	// Section modified with array operations after its key was set.
+	{
+		toml::table section;
+		section["a"] = toml::array{ 1, 2 };
+		CTomlPatch patch;
+		patch.SetValue("", "s", toml::value(section));
+		patch.SetValue("s", "k", 4);
+		patch.InsertElements("s", "a", 2, toml::array{ 3 });
+		patch.SetValue("", "s", toml::value(section));
+		patch.InsertElements("s", "a", 0, toml::array{ 0 });
+
+		toml::table expectedSection;
+		expectedSection["a"] = toml::array{ 0, 1, 2 };
+		bPassed &= CheckPatch("section -> keys -> section -> key", patch, toml::value(expectedSection));
+	}
+
+	return bPassed ? 0 : 1;
+}
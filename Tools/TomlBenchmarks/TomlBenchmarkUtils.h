@@ -0,0 +1,81 @@
+// Helpers shared by the benchmarks.
+
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include "TomlManager.h"
+
+//! Runs a function several times and returns its average duration.
+//!
+//! \param repeatCount Number of times to run the function.
+//! \param function    Function to run.
+//!
+//! \return Average duration of one run (in milliseconds).
+template<typename Function>
+double MeasureMs(size_t repeatCount, Function&& function)
+{
+	const auto startTime = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < repeatCount; i++)
+	{
+		function();
+	}
+	const auto duration = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime);
+
+	return duration.count() / static_cast<double>(repeatCount);
+}
+
+//! Creates an empty directory for benchmark documents (see \ref CTomlManager::GetDirectoryPathForDocuments),
+//! exits if the directory can't be created.
+//!
+//! \param directoryName Name of the directory.
+//!
+//! \return Path to the directory.
+inline std::filesystem::path CreateBenchmarkDirectory(const std::string& directoryName)
+{
+	const auto optionalDirectoryPath = CTomlManager::GetDirectoryPathForDocuments(directoryName);
+	if (!optionalDirectoryPath.has_value())
+	{
+		std::fprintf(stderr, "failed to get directory for benchmark documents\n");
+		std::exit(1);
+	}
+
+	std::error_code errorCode;
+	std::filesystem::remove_all(optionalDirectoryPath.value(), errorCode);
+	std::filesystem::create_directories(optionalDirectoryPath.value(), errorCode);
+	if (errorCode)
+	{
+		std::fprintf(stderr, "failed to create directory \"%s\"\n", optionalDirectoryPath->string().c_str());
+		std::exit(1);
+	}
+
+	return optionalDirectoryPath.value();
+}
+
+//! Creates text of a large document with game data (many tables of numbers, strings and arrays).
+//!
+//! \param targetSize Approximate size of the text (in bytes).
+//!
+//! \return TOML text with tables "[entity0]", "[entity1]" and so on.
+inline std::string CreateGameDataText(size_t targetSize)
+{
+	std::string text = "# Game data.\nversion = 3\nname = \"Benchmark\"\n\n";
+
+	for (size_t i = 0; text.size() < targetSize; i++)
+	{
+		const auto index = std::to_string(i);
+		text += "[entity" + index + "]\n";
+		text += "name = \"Entity " + index + "\" # display name\n";
+		text += "health = " + std::to_string(100 + i % 50) + "\n";
+		text += "speed = " + std::to_string(i % 10) + ".25\n";
+		text += "enabled = " + std::string(i % 2 == 0 ? "true" : "false") + "\n";
+		text += "position = [" + std::to_string(i) + ".0, 2.5, -1.0]\n";
+		text += "tags = [\"npc\", \"spawn" + std::to_string(i % 8) + "\"]\n";
+		text += "stats = { strength = " + std::to_string(i % 20) + ", agility = 4 }\n\n";
+	}
+
+	return text;
+}
@@ -0,0 +1,112 @@
+// Measures Diff / ApplyPatch of large documents with small differences: two files (for example an old and a new save, all values are compared)
+// and a clone with a few modified values (sections shared with the original are skipped).
+//
+// Usage: TomlDiffBenchmark [document size in MB (default 5)]
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include "TomlBenchmarkUtils.h"
+
+//! Replaces a value of a table in document text.
+//!
+//! \param text      Document text.
+//! \param tableName Name of the table.
+//! \param keyName   Key of the value.
+//! \param value     New value (TOML text).
+static void ReplaceValue(std::string& text, const std::string& tableName, const std::string& keyName, const std::string& value)
+{
+	const auto tableStart = text.find("[" + tableName + "]\n");
+	const auto valueStart = text.find(keyName + " = ", tableStart) + keyName.size() + 3;
+	const auto valueEnd = text.find('\n', valueStart);
+	text.replace(valueStart, valueEnd - valueStart, value);
+}
+
+//! Compares two documents, applies the patch to the first one and checks that the documents are equal after that.
+//!
+//! \param manager         Manager of the documents.
+//! \param caseName        Name of the case.
+//! \param documentId      Document to patch.
+//! \param otherDocumentId Document to compare with.
+//! \param textSize        Size of the document text (to compare the patch size with).
+//!
+//! \return 'true' if the patched document is equal to the other document, 'false' otherwise.
+static bool MeasureDiff(CTomlManager& manager, const char* caseName, int documentId, int otherDocumentId, size_t textSize)
+{
+	std::optional<CTomlPatch> optionalPatch;
+	const auto diffMs = MeasureMs(5, [&] { optionalPatch = manager.Diff(documentId, otherDocumentId); });
+	const auto& patch = optionalPatch.value();
+
+	std::string bytes;
+	const auto serializeMs = MeasureMs(100, [&] { bytes = patch.Serialize(); });
+	std::optional<CTomlPatch> optionalDeserializedPatch;
+	const auto deserializeMs = MeasureMs(100, [&] { optionalDeserializedPatch = CTomlPatch::Deserialize(bytes); });
+
+	const auto applyMs = MeasureMs(1, [&] { manager.ApplyPatch(documentId, optionalDeserializedPatch.value()); });
+	const auto bEqual = manager.Diff(documentId, otherDocumentId).value().IsEmpty();
+
+	std::printf("%s:\n", caseName);
+	std::printf("  Diff        %10.3f ms, %zu operation(s)\n", diffMs, patch.GetOperations().size());
+	std::printf("  Serialize   %10.3f ms, %zu bytes (document text %zu bytes)\n", serializeMs, bytes.size(), textSize);
+	std::printf("  Deserialize %10.3f ms\n", deserializeMs);
+	std::printf("  ApplyPatch  %10.3f ms%s\n", applyMs, bEqual ? "" : " (DOCUMENTS DIFFER AFTER PATCHING)");
+
+	return bEqual;
+}
+
+int main(int argc, char* argv[])
+{
+	const auto sizeMb = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 5ul;
+	const std::string directoryName = "TomlDiffBenchmark";
+	const auto directoryPath = CreateBenchmarkDirectory(directoryName);
+
+	// Old save and a new save with a few modified values.
+	const auto oldText = CreateGameDataText(sizeMb * 1024 * 1024);
+	auto newText = oldText;
+	for (int i = 0; i < 10; i++)
+	{
+		ReplaceValue(newText, "entity" + std::to_string(i * 1000), "health", std::to_string(10 + i));
+	}
+	ReplaceValue(newText, "entity7", "position", "[7.0, 2.5, 4.0]");
+	ReplaceValue(newText, "entity8", "tags", "[\"npc\", \"spawn0\", \"boss\"]");
+	{
+		std::ofstream oldFile(directoryPath / "old.toml", std::ios::binary);
+		oldFile << oldText;
+		std::ofstream newFile(directoryPath / "new.toml", std::ios::binary);
+		newFile << newText;
+	}
+	std::printf("document of %.1f MB\n", static_cast<double>(oldText.size()) / (1024.0 * 1024.0));
+
+	CTomlManager manager;
+	bool bPassed = true;
+
+	// Separately parsed documents (all values are compared).
+	{
+		const auto oldDocumentId = std::get<int>(manager.OpenDocument("old", directoryName));
+		const auto newDocumentId = std::get<int>(manager.OpenDocument("new", directoryName));
+		bPassed &= MeasureDiff(manager, "old save -> new save", oldDocumentId, newDocumentId, oldText.size());
+		manager.CloseDocument(oldDocumentId);
+		manager.CloseDocument(newDocumentId);
+	}
+
+	// Clone with the same modifications (unmodified sections are shared).
+	{
+		const auto documentId = std::get<int>(manager.OpenDocument("old", directoryName));
+		const auto cloneId = manager.CloneDocument(documentId).value();
+		for (int i = 0; i < 10; i++)
+		{
+			manager.SetValue(cloneId, "health", 10 + i, "entity" + std::to_string(i * 1000));
+		}
+		manager.SetAt(cloneId, "position", 2, 4.0, "entity7");
+		manager.AppendValue(cloneId, "tags", std::string("boss"), "entity8");
+		bPassed &= MeasureDiff(manager, "document -> modified clone", documentId, cloneId, oldText.size());
+		manager.CloseDocument(documentId);
+		manager.CloseDocument(cloneId);
+	}
+
+	std::error_code errorCode;
+	std::filesystem::remove_all(directoryPath, errorCode);
+
+	return bPassed ? 0 : 1;
+}
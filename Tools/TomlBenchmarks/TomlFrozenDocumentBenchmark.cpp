@@ -0,0 +1,101 @@
+// Measures reading values from a frozen document (see CTomlManager::FreezeDocument) compared to a regular
+// document and opening a memory-mapped frozen document (see CTomlManager::OpenFrozenDocument).
+//
+// Usage: TomlFrozenDocumentBenchmark [document size in MB (default 5)]
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include "TomlBenchmarkUtils.h"
+
+//! Reads values of random tables of a document.
+//!
+//! \param manager     Manager of the document.
+//! \param documentId  Document to read.
+//! \param tableNames  Names of tables to read (in random order).
+//!
+//! \return Sum of read values (so that reads are not optimized away).
+static std::int64_t ReadValues(CTomlManager& manager, int documentId, const std::vector<std::string>& tableNames)
+{
+	std::int64_t sum = 0;
+	for (const auto& tableName : tableNames)
+	{
+		const auto healthResult = manager.GetValue<int>(documentId, "health", tableName);
+		if (std::holds_alternative<int>(healthResult))
+		{
+			sum += std::get<int>(healthResult);
+		}
+
+		const auto nameResult = manager.GetValue<std::string>(documentId, "name", tableName);
+		if (std::holds_alternative<std::string>(nameResult))
+		{
+			sum += static_cast<std::int64_t>(std::get<std::string>(nameResult).size());
+		}
+	}
+
+	return sum;
+}
+
+int main(int argc, char* argv[])
+{
+	const auto sizeMb = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 5ul;
+	const std::string directoryName = "TomlFrozenDocumentBenchmark";
+	const auto directoryPath = CreateBenchmarkDirectory(directoryName);
+	const auto text = CreateGameDataText(sizeMb * 1024 * 1024);
+	{
+		std::ofstream file(directoryPath / "data.toml", std::ios::binary);
+		file << text;
+	}
+
+	CTomlManager manager;
+	const auto documentId = std::get<int>(manager.OpenDocument("data", directoryName));
+
+	// Tables to read in random order.
+	size_t tableCount = 0;
+	for (auto position = text.find("[entity"); position != std::string::npos; position = text.find("[entity", position + 1))
+	{
+		tableCount += 1;
+	}
+	std::vector<std::string> tableNames;
+	std::mt19937 random(42);
+	for (size_t i = 0; i < 100000; i++)
+	{
+		tableNames.push_back("entity" + std::to_string(random() % tableCount));
+	}
+	std::printf("%zu tables, %zu random reads of 2 values\n", tableCount, tableNames.size());
+
+	// Regular and frozen document.
+	std::int64_t treeSum = 0;
+	const auto treeMs = MeasureMs(5, [&] { treeSum = ReadValues(manager, documentId, tableNames); });
+	std::printf("%-34s %10.2f ms\n", "GetValue (TOML values)", treeMs);
+
+	const auto freezeMs = MeasureMs(1, [&] { manager.FreezeDocument(documentId); });
+	std::printf("%-34s %10.2f ms\n", "FreezeDocument", freezeMs);
+
+	std::int64_t frozenSum = 0;
+	const auto frozenMs = MeasureMs(5, [&] { frozenSum = ReadValues(manager, documentId, tableNames); });
+	std::printf("%-34s %10.2f ms (%.1fx faster)\n", "GetValue (frozen)", frozenMs, treeMs / frozenMs);
+	manager.CloseDocument(documentId);
+
+	// Opening, the first call writes the frozen buffer (from the snapshot written by OpenDocument), next calls map it.
+	const auto openFrozenDocument = [&]
+	{
+		const auto result = manager.OpenFrozenDocument("data", directoryName);
+		if (std::holds_alternative<int>(result))
+		{
+			manager.CloseDocument(std::get<int>(result));
+		}
+	};
+	const auto firstOpenMs = MeasureMs(1, openFrozenDocument);
+	std::printf("%-34s %10.2f ms\n", "OpenFrozenDocument (write buffer)", firstOpenMs);
+	const auto mappedOpenMs = MeasureMs(10, openFrozenDocument);
+	std::printf("%-34s %10.2f ms\n", "OpenFrozenDocument (mapped)", mappedOpenMs);
+
+	std::error_code errorCode;
+	std::filesystem::remove_all(directoryPath, errorCode);
+
+	return treeSum == frozenSum ? 0 : 1;
+}
@@ -0,0 +1,82 @@
+// Measures hot reload (see CTomlManager::EnableHotReload) of a large document when one value of its file
+// is modified: time until the callback is called, longest UpdateHotReload call (main thread cost)
+// and number of reported changes.
+//
+// Usage: TomlHotReloadBenchmark [document size in MB (default 5)]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include "TomlBenchmarkUtils.h"
+
+int main(int argc, char* argv[])
+{
+	using Clock = std::chrono::steady_clock;
+
+	const auto sizeMb = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 5ul;
+	const std::string directoryName = "TomlHotReloadBenchmark";
+	const auto directoryPath = CreateBenchmarkDirectory(directoryName);
+	const auto filePath = directoryPath / "tuning.toml";
+	auto text = CreateGameDataText(sizeMb * 1024 * 1024);
+	{
+		std::ofstream file(filePath, std::ios::binary);
+		file << text;
+	}
+	std::printf("document of %.1f MB\n", static_cast<double>(text.size()) / (1024.0 * 1024.0));
+
+	// Position of the value that is modified.
+	const auto valueStart = text.find("health = ", text.find("[entity100]\n")) + std::string("health = ").size();
+	const auto valueSize = text.find('\n', valueStart) - valueStart;
+
+	CTomlManager manager;
+	const auto documentId = std::get<int>(manager.OpenDocument("tuning", directoryName));
+
+	size_t reloadCount = 0;
+	size_t changeCount = 0;
+	manager.EnableHotReload(documentId, "tuning", directoryName, [&](int, const std::vector<CTomlManager::SValueChange>& changes)
+	{
+		reloadCount += 1;
+		changeCount += changes.size();
+	});
+
+	bool bPassed = true;
+	for (int i = 0; i < 5; i++)
+	{
+		// Modify the value in the file (values have the same length so the rest of the file is the same).
+		const auto value = std::to_string(900 + i);
+		text.replace(valueStart, valueSize, value);
+		{
+			std::ofstream file(filePath, std::ios::binary);
+			file << text;
+		}
+
+		// Update once per "frame" until the document is updated.
+		const auto startTime = Clock::now();
+		const auto timeout = startTime + std::chrono::seconds(30);
+		const auto expectedReloadCount = reloadCount + 1;
+		double maxUpdateMs = 0.0;
+		while (reloadCount < expectedReloadCount && Clock::now() < timeout)
+		{
+			maxUpdateMs = std::max(maxUpdateMs, MeasureMs(1, [&] { manager.UpdateHotReload(); }));
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		const auto reloadMs = std::chrono::duration<double, std::milli>(Clock::now() - startTime).count();
+
+		const auto bUpdated = manager.GetValue<int>(documentId, "health", "entity100") == std::variant<int, CTomlManager::GetValueError>(900 + i);
+		bPassed &= bUpdated;
+		std::printf(
+			"reload %d: %10.2f ms until callback, longest UpdateHotReload %.3f ms, %zu change(s) so far%s\n",
+			i, reloadMs, maxUpdateMs, changeCount, bUpdated ? "" : " (VALUE NOT UPDATED)");
+	}
+
+	manager.CloseDocument(documentId);
+
+	std::error_code errorCode;
+	std::filesystem::remove_all(directoryPath, errorCode);
+
+	return bPassed ? 0 : 1;
+}
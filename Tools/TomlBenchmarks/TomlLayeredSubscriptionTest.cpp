@@ -0,0 +1,60 @@
+// Checks that observers of a layered document (see CTomlManager::CreateLayeredDocument) are notified when
+// a layer modifies a value that is not overridden by a higher layer.
+//
+// Usage: TomlLayeredSubscriptionTest
+
+#include <cstdio>
+#include <string>
+#include "TomlManager.h"
+
+int main()
+{
+	CTomlManager manager;
+	const auto defaultsId = manager.NewDocument();
+	const auto settingsId = manager.NewDocument();
+	manager.SetValue(defaultsId, "volume", 5, "audio");
+	manager.SetValue(defaultsId, "width", 1280, "video");
+	manager.SetValue(settingsId, "width", 1920, "video");
+	const auto layeredId = manager.CreateLayeredDocument({ defaultsId, settingsId }).value();
+
+	int volumeCount = 0;
+	int widthCount = 0;
+	int audioCount = 0;
+	int notifiedDocumentId = -1;
+	manager.Subscribe(layeredId, "volume", "audio", [&](int documentId, const std::string&, const std::string&)
+	{
+		volumeCount += 1;
+		notifiedDocumentId = documentId;
+	});
+	manager.Subscribe(layeredId, "width", "video", [&](int, const std::string&, const std::string&) { widthCount += 1; });
+	manager.Subscribe(layeredId, "audio", "", [&](int, const std::string&, const std::string&) { audioCount += 1; });
+
+	bool bPassed = true;
+	const auto check = [&bPassed](const char* caseName, bool bCondition)
+	{
+		std::printf("%-48s %s\n", caseName, bCondition ? "ok" : "FAILED");
+		bPassed &= bCondition;
+	};
+
+	// Write through the layered document (goes to the top layer).
+	manager.SetValue(layeredId, "volume", 7, "audio");
+	check("write through the layered document", volumeCount == 1 && audioCount == 1 && notifiedDocumentId == layeredId);
+
+	// Write to the bottom layer, the value is overridden by the top layer now.
+	manager.SetValue(defaultsId, "volume", 6, "audio");
+	check("overridden value of a lower layer", volumeCount == 1 && audioCount == 1);
+
+	// Write to the bottom layer and to the top layer.
+	manager.SetValue(defaultsId, "width", 800, "video");
+	check("overridden width of a lower layer", widthCount == 0);
+	manager.SetValue(settingsId, "width", 2560, "video");
+	check("width of the top layer", widthCount == 1);
+
+	// Remove the override (the section of the top layer is empty), the lower layer shows its value again.
+	manager.SetValue(layeredId, "audio", toml::table());
+	check("overwritten section", volumeCount == 2 && audioCount == 2);
+	manager.SetValue(defaultsId, "volume", 4, "audio");
+	check("value of a lower layer without override", volumeCount == 3 && audioCount == 3);
+
+	return bPassed ? 0 : 1;
+}
@@ -0,0 +1,67 @@
+// Measures listing a directory with many documents (GetAllDocuments, GetCachedDocumentListing)
+// and reading their metadata (OpenDocumentsMetadata).
+//
+// Usage: TomlListingBenchmark [document count (default 10000)]
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include "TomlBenchmarkUtils.h"
+
+int main(int argc, char* argv[])
+{
+	const auto documentCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000ul;
+	const std::string directoryName = "TomlListingBenchmark";
+	const auto directoryPath = CreateBenchmarkDirectory(directoryName);
+
+	// Create documents with a metadata section.
+	for (size_t i = 0; i < documentCount; i++)
+	{
+		std::ofstream file(directoryPath / ("save" + std::to_string(i) + ".toml"));
+		file << "[metadata]\nname = \"Save " << i << "\"\nplaytime = " << i * 60 << "\n\n";
+		file << "[player]\nhealth = 100\nposition = [1.0, 2.0, 3.0]\n";
+	}
+	std::printf("%zu documents in \"%s\"\n", static_cast<size_t>(documentCount), directoryPath.string().c_str());
+
+	CTomlManager manager;
+	size_t listedCount = 0;
+
+	// Full scan.
+	const auto scanMs = MeasureMs(5, [&] { listedCount = std::get<0>(CTomlManager::GetAllDocuments(directoryName)).size(); });
+	std::printf("GetAllDocuments:                      %10.3f ms (%zu documents)\n", scanMs, listedCount);
+
+	// Cached listing.
+	const auto firstListingMs = MeasureMs(1, [&] { listedCount = std::get<0>(manager.GetCachedDocumentListing(directoryName))->size(); });
+	std::printf("GetCachedDocumentListing (first):     %10.3f ms (%zu documents)\n", firstListingMs, listedCount);
+
+	const auto cachedListingMs = MeasureMs(1000, [&] { manager.GetCachedDocumentListing(directoryName); });
+	std::printf("GetCachedDocumentListing (unchanged): %10.3f ms\n", cachedListingMs);
+
+	// Listing after the directory was modified.
+	{
+		std::ofstream file(directoryPath / "added.toml");
+		file << "[metadata]\nname = \"Added\"\n";
+	}
+	const auto modifiedListingMs = MeasureMs(1, [&] { listedCount = std::get<0>(manager.GetCachedDocumentListing(directoryName))->size(); });
+	std::printf("GetCachedDocumentListing (modified):  %10.3f ms (%zu documents)\n", modifiedListingMs, listedCount);
+
+	// Metadata, the first call parses the documents and writes the index, next calls read the index.
+	for (const auto bIndexed : { false, true })
+	{
+		const auto metadataMs = MeasureMs(1, [&]
+		{
+			const auto result = manager.OpenDocumentsMetadata(directoryName);
+			if (std::holds_alternative<int>(result))
+			{
+				manager.CloseDocument(std::get<int>(result));
+			}
+		});
+		std::printf("OpenDocumentsMetadata (%s):    %10.3f ms\n", bIndexed ? "indexed" : "parsed ", metadataMs);
+	}
+
+	std::error_code errorCode;
+	std::filesystem::remove_all(directoryPath, errorCode);
+
+	return 0;
+}
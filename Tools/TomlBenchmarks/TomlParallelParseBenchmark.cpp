@@ -0,0 +1,85 @@
+// Measures parsing of a large document (item database) with CTomlParallelParser for different numbers
+// of worker threads and compares it with the sequential toml::parse.
+//
+// Usage: TomlParallelParseBenchmark [document size in MB (default 20)]
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "TomlBenchmarkUtils.h"
+#include "TomlParallelParser.h"
+#include "TomlWorkerPool.h"
+
+//! Creates text of an item database.
+//!
+//! \param targetSize Approximate size of the text (in bytes).
+//!
+//! \return TOML text.
+static std::string CreateItemDatabase(size_t targetSize)
+{
+	std::string text = "version = 7\nname = \"items\"\n\n";
+
+	size_t tableIndex = 0;
+	size_t itemIndex = 0;
+	while (text.size() < targetSize)
+	{
+		// A few plain tables between large arrays of tables.
+		text += "[category" + std::to_string(tableIndex) + "]\n";
+		text += "title = \"Category " + std::to_string(tableIndex) + "\"\nweights = [1, 2, 3, 4, 5]\n\n";
+		tableIndex += 1;
+
+		for (size_t i = 0; i < 1000 && text.size() < targetSize; i++)
+		{
+			const auto id = std::to_string(itemIndex);
+			text += "[[items]]\nid = " + id + "\nname = \"Item " + id + "\"\ndamage = " + std::to_string(itemIndex % 97) + ".5\n";
+			text += "tags = [\"melee\", \"rare\"]\nstats = { strength = 3, agility = 1 }\n\n";
+			itemIndex += 1;
+		}
+	}
+
+	return text;
+}
+
+int main(int argc, char* argv[])
+{
+	const auto sizeMb = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20ul;
+	const auto text = CreateItemDatabase(sizeMb * 1024 * 1024);
+	std::printf("document of %.1f MB\n", static_cast<double>(text.size()) / (1024.0 * 1024.0));
+
+	// Sequential parse.
+	toml::value sequentialData;
+	const auto sequentialMs = MeasureMs(1, [&]
+	{
+		std::istringstream stream(text);
+		sequentialData = toml::parse(stream, "items.toml");
+	});
+	std::printf("%-22s %10.1f ms\n", "toml::parse", sequentialMs);
+
+	// Parallel parse with 1, 2, 4, ... worker threads up to the number of hardware threads.
+	const auto hardwareThreadCount = std::max(1u, std::thread::hardware_concurrency());
+	std::vector<size_t> threadCounts;
+	for (size_t threadCount = 1; threadCount < hardwareThreadCount; threadCount *= 2)
+	{
+		threadCounts.push_back(threadCount);
+	}
+	threadCounts.push_back(hardwareThreadCount);
+
+	bool bIdentical = true;
+	for (const auto threadCount : threadCounts)
+	{
+		CTomlWorkerPool workerPool(threadCount);
+		toml::value parallelData;
+		const auto parallelMs = MeasureMs(1, [&] { parallelData = CTomlParallelParser::Parse(text, "items.toml", workerPool); });
+		const auto bSame = parallelData == sequentialData;
+		bIdentical &= bSame;
+		std::printf(
+			"%2zu thread(s)            %10.1f ms  speedup %5.2fx%s\n",
+			threadCount, parallelMs, sequentialMs / parallelMs, bSame ? "" : "  (RESULT DIFFERS)");
+	}
+
+	return bIdentical ? 0 : 1;
+}
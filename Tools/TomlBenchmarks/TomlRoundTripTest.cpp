@@ -0,0 +1,73 @@
+// Checks that a document keeps all of its values when it's opened, modified and saved back to its file,
+// also for documents with tables that have unusual names (a table with an empty name is not the root table).
+//
+// Usage: TomlRoundTripTest
+
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include "TomlBenchmarkUtils.h"
+
+//! Opens a document, adds a key to its table "s", saves it and compares the saved file with the expected data.
+//!
+//! \param caseName      Name of the case.
+//! \param directoryPath Directory of the document file.
+//! \param text          Text of the document file.
+//! \param openDocument  Opens the document "document" of the benchmark directory.
+//!
+//! \return 'true' if the saved file has the expected data, 'false' otherwise.
+static bool CheckRoundTrip(const char* caseName, const std::filesystem::path& directoryPath, const std::string& text,
+	const std::function<std::variant<int, CTomlManager::OpenDocumentError>(CTomlManager&)>& openDocument)
+{
+	const auto filePath = directoryPath / "document.toml";
+	std::ofstream(filePath, std::ios::binary) << text;
+
+	// Expected data is the original data with the added key.
+	std::istringstream textStream(text);
+	auto expectedData = toml::parse(textStream, "expected");
+	expectedData.as_table()["s"].as_table()["added"] = 4;
+
+	CTomlManager manager;
+	const auto openResult = openDocument(manager);
+	bool bSame = std::holds_alternative<int>(openResult);
+	if (bSame)
+	{
+		const auto documentId = std::get<int>(openResult);
+		manager.SetValue(documentId, "added", 4, "s");
+		bSame = !manager.SaveDocument(documentId, "document", directoryPath.filename().string(), false).has_value();
+	}
+	if (bSame)
+	{
+		std::ifstream savedFile(filePath, std::ios::binary);
+		std::ostringstream savedText;
+		savedText << savedFile.rdbuf();
+		std::istringstream savedStream(savedText.str());
+		bSame = toml::parse(savedStream, "saved") == expectedData;
+	}
+
+	std::printf("%-48s %s\n", caseName, bSame ? "ok" : "FAILED");
+
+	return bSame;
+}
+
+int main()
+{
+	const std::string directoryName = "TomlRoundTripTest";
+	const auto directoryPath = CreateBenchmarkDirectory(directoryName);
+
+	bool bPassed = true;
+	const std::string emptyNameText = "r = 1\n[\"\"]\nx = 2\n[s]\ny = 3\n";
+	bPassed &= CheckRoundTrip("empty table name", directoryPath, emptyNameText,
+		[&](CTomlManager& manager) { return manager.OpenDocument("document", directoryName); });
+	bPassed &= CheckRoundTrip("empty table name (lazy)", directoryPath, emptyNameText,
+		[&](CTomlManager& manager) { return manager.OpenDocumentLazy("document", directoryName); });
+	bPassed &= CheckRoundTrip("empty table name (parallel)", directoryPath, emptyNameText,
+		[&](CTomlManager& manager) { return manager.OpenDocumentParallel("document", directoryName); });
+
+	std::error_code errorCode;
+	std::filesystem::remove_all(directoryPath, errorCode);
+
+	return bPassed ? 0 : 1;
+}
@@ -0,0 +1,95 @@
+// Measures SaveDocument of a large document after one scalar was changed (the original text is patched in place)
+// compared to a structural change (the whole document is serialized) and counts changed lines of the saved files.
+//
+// Usage: TomlSaveBenchmark [document size in MB (default 5)]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "TomlBenchmarkUtils.h"
+
+//! Reads lines of a file.
+//!
+//! \param filePath Path to the file.
+//!
+//! \return Lines of the file.
+static std::vector<std::string> ReadLines(const std::filesystem::path& filePath)
+{
+	std::vector<std::string> lines;
+	std::ifstream file(filePath, std::ios::binary);
+	std::string line;
+	while (std::getline(file, line))
+	{
+		lines.push_back(std::move(line));
+	}
+
+	return lines;
+}
+
+//! Counts lines that differ between two files (compared line by line).
+//!
+//! \param filePathA Path to the first file.
+//! \param filePathB Path to the second file.
+//!
+//! \return Number of different lines.
+static size_t CountChangedLines(const std::filesystem::path& filePathA, const std::filesystem::path& filePathB)
+{
+	const auto linesA = ReadLines(filePathA);
+	const auto linesB = ReadLines(filePathB);
+
+	size_t changedCount = linesA.size() > linesB.size() ? linesA.size() - linesB.size() : linesB.size() - linesA.size();
+	for (size_t i = 0; i < linesA.size() && i < linesB.size(); i++)
+	{
+		if (linesA[i] != linesB[i])
+		{
+			changedCount += 1;
+		}
+	}
+
+	return changedCount;
+}
+
+int main(int argc, char* argv[])
+{
+	const auto sizeMb = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 5ul;
+	const std::string directoryName = "TomlSaveBenchmark";
+	const auto directoryPath = CreateBenchmarkDirectory(directoryName);
+	{
+		std::ofstream file(directoryPath / "data.toml", std::ios::binary);
+		file << CreateGameDataText(sizeMb * 1024 * 1024);
+	}
+	std::printf("document of %.1f MB\n", static_cast<double>(std::filesystem::file_size(directoryPath / "data.toml")) / (1024.0 * 1024.0));
+
+	CTomlManager manager;
+	const size_t saveCount = 5;
+
+	// Each save closes the document so it is opened again (from the document cache) before every save.
+	const auto measureSave = [&](const char* caseName, const std::string& keyName, const std::string& savedFileName)
+	{
+		double totalMs = 0.0;
+		for (size_t i = 0; i < saveCount; i++)
+		{
+			const auto documentId = std::get<int>(manager.OpenDocument("data", directoryName));
+			manager.SetValue(documentId, keyName, static_cast<int>(1000 + i), "entity100");
+
+			const auto startTime = std::chrono::steady_clock::now();
+			manager.SaveDocument(documentId, savedFileName, directoryName, false);
+			totalMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+		}
+
+		std::printf(
+			"%-40s %10.2f ms, %zu changed line(s)\n", caseName, totalMs / static_cast<double>(saveCount),
+			CountChangedLines(directoryPath / "data.toml", directoryPath / (savedFileName + ".toml")));
+	};
+
+	measureSave("SaveDocument (scalar changed, patched)", "health", "patched");
+	measureSave("SaveDocument (key added, serialized)", "armor", "serialized");
+
+	std::error_code errorCode;
+	std::filesystem::remove_all(directoryPath, errorCode);
+
+	return 0;
+}
@@ -0,0 +1,61 @@
+// Measures loading a document from its binary snapshot (see CTomlBinarySnapshot) compared to parsing its text.
+//
+// Usage: TomlSnapshotBenchmark [document size in MB (default 5)]
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include "TomlBenchmarkUtils.h"
+#include "TomlBinarySnapshot.h"
+
+int main(int argc, char* argv[])
+{
+	const auto sizeMb = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 5ul;
+	const std::string directoryName = "TomlSnapshotBenchmark";
+	const auto directoryPath = CreateBenchmarkDirectory(directoryName);
+	const auto filePath = directoryPath / "data.toml";
+	const auto snapshotPath = directoryPath / "data.snapshot";
+
+	{
+		std::ofstream file(filePath, std::ios::binary);
+		file << CreateGameDataText(sizeMb * 1024 * 1024);
+	}
+	std::printf("document of %.1f MB\n", static_cast<double>(std::filesystem::file_size(filePath)) / (1024.0 * 1024.0));
+
+	// Parse text.
+	toml::value data;
+	const auto parseMs = MeasureMs(3, [&] { data = toml::parse(filePath); });
+	std::printf("%-36s %10.2f ms\n", "toml::parse", parseMs);
+
+	// Write and read snapshot.
+	const auto writeMs = MeasureMs(3, [&] { CTomlBinarySnapshot::Write(snapshotPath, filePath, data); });
+	std::printf("%-36s %10.2f ms (%.1f MB)\n", "CTomlBinarySnapshot::Write", writeMs,
+		static_cast<double>(std::filesystem::file_size(snapshotPath)) / (1024.0 * 1024.0));
+
+	const auto bSame = CTomlBinarySnapshot::Read(snapshotPath, filePath) == data;
+	const auto readMs = MeasureMs(10, [&] { CTomlBinarySnapshot::Read(snapshotPath, filePath); });
+	std::printf("%-36s %10.2f ms (%.1fx faster than parsing)%s\n", "CTomlBinarySnapshot::Read", readMs, parseMs / readMs,
+		bSame ? "" : " (RESULT DIFFERS)");
+
+	// Whole OpenDocument (document cache is cleared so that the file or its snapshot is read every time).
+	CTomlManager manager;
+	const auto openDocument = [&]
+	{
+		manager.ClearDocumentCache();
+		const auto result = manager.OpenDocument("data", directoryName);
+		if (std::holds_alternative<int>(result))
+		{
+			manager.CloseDocument(std::get<int>(result));
+		}
+	};
+	const auto firstOpenMs = MeasureMs(1, openDocument);
+	std::printf("%-36s %10.2f ms\n", "OpenDocument (parse, write snapshot)", firstOpenMs);
+	const auto snapshotOpenMs = MeasureMs(10, openDocument);
+	std::printf("%-36s %10.2f ms (%.1fx faster)\n", "OpenDocument (snapshot)", snapshotOpenMs, firstOpenMs / snapshotOpenMs);
+
+	std::error_code errorCode;
+	std::filesystem::remove_all(directoryPath, errorCode);
+
+	return bSame ? 0 : 1;
+}
@@ -0,0 +1,45 @@
+# Embeds TOML documents into a target at build time (see CTomlManager::OpenEmbeddedDocument).
+#
+# Usage (in the CMakeLists.txt of your project):
+#   include(<path to this directory>/TomlEmbed.cmake)
+#   toml_embed_document(<target> <path to .toml file> <variable name>)
+#
+# Generates "TomlEmbedded/<variable name>.h" in the binary directory (added to include directories of the target)
+# that defines "<variable name>" (frozen document) and "<variable name>Size". The header is regenerated when the
+# .toml file changes.
+#
+# Set TOML_EMBED_MANAGER_DIR to the "TomlManager" directory if it's not in "Code/TomlManager" of this repository.
+
+include_guard(GLOBAL)
+
+set(TOML_EMBED_DIR "${CMAKE_CURRENT_LIST_DIR}")
+if(NOT DEFINED TOML_EMBED_MANAGER_DIR)
+	set(TOML_EMBED_MANAGER_DIR "${CMAKE_CURRENT_LIST_DIR}/../../Code/TomlManager")
+endif()
+
+function(toml_embed_document target tomlFile variableName)
+	# Build the tool once (it only needs the frozen document code and toml11).
+	if(NOT TARGET TomlEmbed)
+		add_executable(TomlEmbed
+			"${TOML_EMBED_DIR}/TomlEmbed.cpp"
+			"${TOML_EMBED_MANAGER_DIR}/TomlFrozenDocument.cpp"
+			"${TOML_EMBED_MANAGER_DIR}/TomlBinarySnapshot.cpp")
+		target_include_directories(TomlEmbed PRIVATE "${TOML_EMBED_MANAGER_DIR}")
+		set_target_properties(TomlEmbed PROPERTIES CXX_STANDARD 17 CXX_STANDARD_REQUIRED ON)
+	endif()
+
+	get_filename_component(tomlPath "${tomlFile}" ABSOLUTE)
+	set(outputDirectory "${CMAKE_CURRENT_BINARY_DIR}/TomlEmbedded")
+	set(outputHeader "${outputDirectory}/${variableName}.h")
+
+	add_custom_command(
+		OUTPUT "${outputHeader}"
+		COMMAND "${CMAKE_COMMAND}" -E make_directory "${outputDirectory}"
+		COMMAND TomlEmbed "${tomlPath}" "${outputHeader}" "${variableName}"
+		DEPENDS TomlEmbed "${tomlPath}"
+		COMMENT "Embedding TOML document ${tomlFile}"
+		VERBATIM)
+
+	target_sources(${target} PRIVATE "${outputHeader}")
+	target_include_directories(${target} PRIVATE "${outputDirectory}")
+endfunction()
@@ -0,0 +1,133 @@
+// Converts a TOML file to a C++ header with a frozen document (see CTomlFrozenDocument) that
+// CTomlManager::OpenEmbeddedDocument opens without parsing.
+//
+// Usage: TomlEmbed <input .toml file> <output .h file> <variable name>
+
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "TomlFrozenDocument.h"
+
+//! Checks that the specified text can be used as a C++ identifier.
+//! 
+//! \param name Text to check.
+//! 
+//! \return 'true' if the text is a valid identifier, 'false' otherwise.
+static bool IsIdentifier(const std::string& name)
+{
+	if (name.empty() || std::isdigit(static_cast<unsigned char>(name.front())))
+	{
+		return false;
+	}
+
+	for (const auto character : name)
+	{
+		if (!std::isalnum(static_cast<unsigned char>(character)) && character != '_')
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//! Creates text of the header.
+//! 
+//! \param buffer       Frozen document.
+//! \param inputName    Name of the TOML file (used in a comment).
+//! \param variableName Name of the array variable.
+//! 
+//! \return Header text.
+static std::string GenerateHeader(const std::string& buffer, const std::string& inputName, const std::string& variableName)
+{
+	static const char* const hexDigits = "0123456789abcdef";
+	static const size_t bytesPerLine = 16;
+
+	std::string header;
+	header.reserve(buffer.size() * 6 + 512);
+	header += "// Generated by TomlEmbed from \"" + inputName + "\", do not edit.\n";
+	header += "#pragma once\n\n";
+	header += "#include <cstddef>\n\n";
+	header += "//! Frozen document, open it with CTomlManager::OpenEmbeddedDocument.\n";
+	header += "alignas(8) inline constexpr unsigned char " + variableName + "[] = {";
+	for (size_t i = 0; i < buffer.size(); i++)
+	{
+		const auto byte = static_cast<unsigned char>(buffer[i]);
+		header += i % bytesPerLine == 0 ? "\n\t" : " ";
+		header += "0x";
+		header += hexDigits[byte >> 4];
+		header += hexDigits[byte & 0xF];
+		header += ',';
+	}
+	header += "\n};\n\n";
+	header += "//! Size of \\ref " + variableName + " in bytes.\n";
+	header += "inline constexpr std::size_t " + variableName + "Size = sizeof(" + variableName + ");\n";
+
+	return header;
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc != 4)
+	{
+		std::cerr << "usage: TomlEmbed <input .toml file> <output .h file> <variable name>\n";
+		return 1;
+	}
+	const std::filesystem::path inputPath = argv[1];
+	const std::filesystem::path outputPath = argv[2];
+	const std::string variableName = argv[3];
+
+	if (!IsIdentifier(variableName))
+	{
+		std::cerr << "TomlEmbed: \"" << variableName << "\" is not a valid C++ identifier\n";
+		return 1;
+	}
+
+	// Parse file.
+	toml::value data;
+	try
+	{
+		data = toml::parse(inputPath);
+	}
+	catch (std::exception& exception)
+	{
+		std::cerr << "TomlEmbed: failed to parse \"" << inputPath.string() << "\", error: " << exception.what() << "\n";
+		return 1;
+	}
+
+	// Freeze (embedded documents are not tied to a file version).
+	const auto optionalBuffer = CTomlFrozenDocument::Freeze(data, 0, 0);
+	if (!optionalBuffer.has_value())
+	{
+		std::cerr << "TomlEmbed: \"" << inputPath.string() << "\" is too large to embed\n";
+		return 1;
+	}
+	const auto header = GenerateHeader(optionalBuffer.value(), inputPath.filename().string(), variableName);
+
+	// Don't touch the header if it's up to date (so that dependent sources are not rebuilt).
+	{
+		std::ifstream existingFile(outputPath, std::ios::binary);
+		if (existingFile.is_open())
+		{
+			std::ostringstream stream;
+			stream << existingFile.rdbuf();
+			if (stream.str() == header)
+			{
+				return 0;
+			}
+		}
+	}
+
+	std::ofstream outputFile(outputPath, std::ios::binary);
+	outputFile << header;
+	if (!outputFile.good())
+	{
+		std::cerr << "TomlEmbed: failed to write \"" << outputPath.string() << "\"\n";
+		return 1;
+	}
+
+	return 0;
+}